@@ -0,0 +1,518 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+#include <filesystem>
+
+#include "OpenCLUtil.h"
+
+#include "../../Common/FreeImage/x64/FreeImage.h"
+
+#define To_String(x) #x
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+const int COLOR_RANGE = 256;
+const int DEFAULT_BATCH_SIZE = 256;
+
+/**
+ * Host side batch: images are decoded and packed back to back in BGRA order.
+ */
+struct ImageBatch
+{
+    std::vector<std::string> names;
+    std::vector<cl_uint4> info;       // x: pixel offset, y: pixel count, z: width, w: height
+    std::vector<uint8_t> pixels;
+    std::vector<cl_uint> histograms;
+};
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_command_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+cl_program ocl_program = nullptr;
+cl_kernel fn_histogram_batch_rgba_unorm8 = nullptr;
+
+cl_mem ocl_pixel_buffer = nullptr;
+cl_mem ocl_image_info_buffer = nullptr;
+cl_mem ocl_histogram_buffer = nullptr;
+
+size_t pixel_buffer_capacity = 0;
+size_t image_info_capacity = 0;
+
+const int num_pixels_per_work_item = 32;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    void DecodeBatch( const std::vector<std::string> &files, size_t first, size_t count, ImageBatch *batch);
+    bool EnqueueBatch( ImageBatch *batch);
+    bool SaveHistograms( std::ofstream &out_file, const ImageBatch &batch);
+    void  cleanup();
+
+    // variable declaration
+    std::vector<std::string> input_images;
+    std::string out_file_name = "histograms.txt";
+    size_t batch_size = DEFAULT_BATCH_SIZE;
+
+    ImageBatch batches[2];
+
+    size_t total_images = 0;
+    size_t total_pixels = 0;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--input") && (i + 1 < argc))
+        {
+            input_images.push_back( std::string( argv[++i]));
+        }
+        else if( !input.compare( "--input-dir") && (i + 1 < argc))
+        {
+            std::error_code err;
+            for( const auto &entry : std::filesystem::directory_iterator( argv[++i], err))
+            {
+                if( entry.is_regular_file())
+                {
+                    input_images.push_back( entry.path().string());
+                }
+            }
+        }
+        else if( !input.compare( "--batch") && (i + 1 < argc))
+        {
+            batch_size = std::max( 1, atoi( argv[++i]));
+        }
+        else if( !input.compare( "--output") && (i + 1 < argc))
+        {
+            out_file_name = std::string( argv[++i]);
+        }
+    }
+
+    if( input_images.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " --input <input_image_name> [--input <input_image_name> ...] | --input-dir <directory>\n";
+        std::cerr << "options: " << "\n"
+                  << "   --batch <n>: number of images histogrammed per kernel launch (default " << DEFAULT_BATCH_SIZE << ")\n"
+                  << "   --output <file>: histogram output file (default histograms.txt)"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    std::sort( input_images.begin(), input_images.end());
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( 0);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_command_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_command_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_program = CreateProgram( ocl_context, ocl_device, "histogram.cl");
+    if( ocl_program == nullptr)
+    {
+        std::cerr << "CreateProgram() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cl_int ocl_err;
+    fn_histogram_batch_rgba_unorm8 = clCreateKernel( ocl_program, "histogram_batch_rgba_unorm8", &ocl_err);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clCreateKernel() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    std::ofstream out_file( out_file_name, std::ios::out);
+    if( !out_file.is_open())
+    {
+        std::cerr << "Failed to open file for writing: " << out_file_name << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        /********* COMPUTE HISTOGRAMS ****************/
+        // The device works on batch 'n' while the host threads decode batch 'n + 1'.
+    size_t num_batches = ( input_images.size() + batch_size - 1) / batch_size;
+
+    DecodeBatch( input_images, 0, batch_size, &batches[0]);
+
+    for( size_t b = 0; b < num_batches; ++b)
+    {
+        ImageBatch *current = &batches[ b % 2];
+        ImageBatch *next = &batches[ (b + 1) % 2];
+
+        if( !EnqueueBatch( current))
+        {
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        std::thread decode_thread;
+        if( b + 1 < num_batches)
+        {
+            decode_thread = std::thread( DecodeBatch, std::cref( input_images), (b + 1) * batch_size, batch_size, next);
+        }
+
+        ocl_err = clFinish( ocl_command_queue);
+
+        if( decode_thread.joinable())
+        {
+            decode_thread.join();
+        }
+
+        if( ocl_err)
+        {
+            std::cerr << "clFinish() Failed." << ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        SaveHistograms( out_file, *current);
+
+        total_images += current->names.size();
+        total_pixels += current->pixels.size() / 4;
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  elapsed_seconds = end - start;
+
+    std::cout << To_String( total_images) << " : " << total_images << "\n";
+    std::cout << To_String( num_batches) << " : " << num_batches << "\n";
+    std::cout << "Time Required for Histogram by OpenCL is: " << elapsed_seconds.count() << "s" << "\n";
+    std::cout << "Images per second : " << total_images / elapsed_seconds.count() << "\n";
+    std::cout << "MPixels per second : " << total_pixels / elapsed_seconds.count() / 1.0e6 << std::endl;
+
+    cleanup();
+
+    return 0;
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // code
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+    RELEASE_CL_OBJECT( ocl_command_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+    RELEASE_CL_OBJECT( fn_histogram_batch_rgba_unorm8, clReleaseKernel);
+
+    RELEASE_CL_OBJECT( ocl_pixel_buffer, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_info_buffer, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_histogram_buffer, clReleaseMemObject);
+}
+
+/**
+ * @brief EnsureBufferCapacity() : (re)create device buffers when a batch does not fit in them.
+ */
+bool EnsureBufferCapacity( size_t pixel_bytes, size_t num_images)
+{
+    // variable declaration
+    cl_int ocl_err;
+
+    // code
+    if( pixel_bytes > pixel_buffer_capacity)
+    {
+        RELEASE_CL_OBJECT( ocl_pixel_buffer, clReleaseMemObject);
+
+        ocl_pixel_buffer = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY, pixel_bytes, nullptr, &ocl_err);
+        if( !ocl_pixel_buffer || ocl_err)
+        {
+            std::cerr << "clCreateBuffer() Failed.\n";
+            return false;
+        }
+        pixel_buffer_capacity = pixel_bytes;
+    }
+
+    if( num_images > image_info_capacity)
+    {
+        RELEASE_CL_OBJECT( ocl_image_info_buffer, clReleaseMemObject);
+        RELEASE_CL_OBJECT( ocl_histogram_buffer, clReleaseMemObject);
+
+        ocl_image_info_buffer = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY, num_images * sizeof( cl_uint4), nullptr, &ocl_err);
+        if( !ocl_image_info_buffer || ocl_err)
+        {
+            std::cerr << "clCreateBuffer() Failed.\n";
+            return false;
+        }
+
+        ocl_histogram_buffer = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, num_images * COLOR_RANGE * 3 * sizeof( cl_uint), nullptr, &ocl_err);
+        if( !ocl_histogram_buffer || ocl_err)
+        {
+            std::cerr << "clCreateBuffer() Failed.\n";
+            return false;
+        }
+        image_info_capacity = num_images;
+    }
+
+    return true;
+}
+
+/**
+ * @brief EnqueueBatch() : enqueue upload, histogram kernel and read back of one batch without waiting for completion.
+ */
+bool EnqueueBatch( ImageBatch *batch)
+{
+    // function declaration
+    bool EnsureBufferCapacity( size_t pixel_bytes, size_t num_images);
+
+    // variable declaration
+    cl_int ocl_err;
+    size_t workgroup_size;
+    size_t global_work_size[2];
+    size_t local_work_size[2];
+    cl_uint zero = 0;
+
+    size_t num_images = batch->names.size();
+    size_t max_pixels = 0;
+
+    // code
+    if( num_images == 0)
+    {
+        return true;
+    }
+
+    if( !EnsureBufferCapacity( std::max( batch->pixels.size(), (size_t)4), num_images))
+    {
+        return false;
+    }
+
+    for( size_t i = 0; i < num_images; ++i)
+    {
+        max_pixels = std::max( max_pixels, (size_t)batch->info[i].y);
+    }
+
+    batch->histograms.assign( num_images * COLOR_RANGE * 3, 0);
+
+    if( !batch->pixels.empty())
+    {
+        ocl_err = clEnqueueWriteBuffer( ocl_command_queue, ocl_pixel_buffer, CL_FALSE, 0, batch->pixels.size(), batch->pixels.data(), 0, nullptr, nullptr);
+        if( ocl_err)
+        {
+            std::cerr << "clEnqueueWriteBuffer() Failed." << ocl_err << "\n";
+            return false;
+        }
+    }
+
+    ocl_err = clEnqueueWriteBuffer( ocl_command_queue, ocl_image_info_buffer, CL_FALSE, 0, num_images * sizeof( cl_uint4), batch->info.data(), 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueWriteBuffer() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    ocl_err = clEnqueueFillBuffer( ocl_command_queue, ocl_histogram_buffer, &zero, sizeof( cl_uint), 0, num_images * COLOR_RANGE * 3 * sizeof( cl_uint), 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueFillBuffer() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+        // one row of work-groups per image, enough groups per row to cover the largest image
+    clGetKernelWorkGroupInfo( fn_histogram_batch_rgba_unorm8, ocl_device, CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &workgroup_size, nullptr);
+
+    local_work_size[0] = ( workgroup_size > 256) ? 256 : workgroup_size;
+    local_work_size[1] = 1;
+
+    size_t pixels_per_group = local_work_size[0] * num_pixels_per_work_item;
+    size_t groups_per_image = ( max_pixels + pixels_per_group - 1) / pixels_per_group;
+
+    global_work_size[0] = std::max( groups_per_image, (size_t)1) * local_work_size[0];
+    global_work_size[1] = num_images;
+
+    ocl_err = clSetKernelArg( fn_histogram_batch_rgba_unorm8, 0, sizeof( cl_mem), &ocl_pixel_buffer);
+    ocl_err |= clSetKernelArg( fn_histogram_batch_rgba_unorm8, 1, sizeof( cl_mem), &ocl_image_info_buffer);
+    ocl_err |= clSetKernelArg( fn_histogram_batch_rgba_unorm8, 2, sizeof( cl_mem), &ocl_histogram_buffer);
+    if( ocl_err)
+    {
+        std::cerr << "clSetKernelArg() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    ocl_err = clEnqueueNDRangeKernel(
+                ocl_command_queue,
+                fn_histogram_batch_rgba_unorm8,
+                2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    ocl_err = clEnqueueReadBuffer( ocl_command_queue, ocl_histogram_buffer, CL_FALSE, 0, num_images * COLOR_RANGE * 3 * sizeof( cl_uint), batch->histograms.data(), 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueReadBuffer() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    clFlush( ocl_command_queue);
+
+    return true;
+}
+
+/**
+ * @brief DecodeBatch() : decode images [first, first + count) on all host threads and pack them into batch.
+ *                        Images which cannot be opened are skipped.
+ */
+void DecodeBatch( const std::vector<std::string> &files, size_t first, size_t count, ImageBatch *batch)
+{
+    // function declaration
+    uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height);
+
+    // variable declaration
+    size_t last = std::min( first + count, files.size());
+    size_t num_files = ( last > first) ? ( last - first) : 0;
+
+    std::vector<uint8_t*> decoded( num_files, nullptr);
+    std::vector<int> widths( num_files, 0);
+    std::vector<int> heights( num_files, 0);
+
+    unsigned int num_threads = std::max( 1u, std::thread::hardware_concurrency());
+    std::vector<std::thread> threads;
+
+    // code
+    batch->names.clear();
+    batch->info.clear();
+    batch->pixels.clear();
+
+    for( unsigned int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back( [&, t]()
+        {
+            for( size_t i = t; i < num_files; i += num_threads)
+            {
+                decoded[i] = LoadImage( files[ first + i].c_str(), &widths[i], &heights[i]);
+            }
+        });
+    }
+
+    for( std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+    size_t total_pixels = 0;
+    for( size_t i = 0; i < num_files; ++i)
+    {
+        if( decoded[i])
+        {
+            total_pixels += (size_t)widths[i] * heights[i];
+        }
+    }
+
+    batch->pixels.resize( total_pixels * 4);
+
+    size_t offset = 0;
+    for( size_t i = 0; i < num_files; ++i)
+    {
+        if( decoded[i] == nullptr)
+        {
+            std::cerr << "Cannot open image \"" << files[ first + i] << "\"" << std::endl;
+            continue;
+        }
+
+        size_t num_pixels = (size_t)widths[i] * heights[i];
+        memcpy( batch->pixels.data() + offset * 4, decoded[i], num_pixels * 4);
+
+        cl_uint4 info;
+        info.s[0] = (cl_uint)offset;
+        info.s[1] = (cl_uint)num_pixels;
+        info.s[2] = (cl_uint)widths[i];
+        info.s[3] = (cl_uint)heights[i];
+
+        batch->names.push_back( files[ first + i]);
+        batch->info.push_back( info);
+
+        offset += num_pixels;
+
+        delete[] decoded[i];
+    }
+}
+
+/**
+ * @brief SaveHistograms() : write one line per image "<name> <256 R bins> <256 G bins> <256 B bins>"
+ */
+bool SaveHistograms( std::ofstream &out_file, const ImageBatch &batch)
+{
+    // code
+    for( size_t i = 0; i < batch.names.size(); ++i)
+    {
+        const cl_uint *histogram = batch.histograms.data() + i * COLOR_RANGE * 3;
+
+        out_file << batch.names[i];
+        for( int j = 0; j < COLOR_RANGE * 3; ++j)
+        {
+            out_file << " " << histogram[j];
+        }
+        out_file << "\n";
+    }
+
+    return out_file.good();
+}
+
+/**
+ * @brief LoadImage() : Load Image and returns image width, image height and image data in 32-bit format. Delete image data when work is done.
+ */
+uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height)
+{
+    // code
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( file_name, 0);
+    FIBITMAP *image = FreeImage_Load( format, file_name);
+    if( image == nullptr)
+    {
+        *image_width = 0;
+        *image_height = 0;
+        return nullptr;
+    }
+
+        // convert to 32-bit image
+    FIBITMAP *temp = image;
+    image = FreeImage_ConvertTo32Bits( image);
+    FreeImage_Unload( temp);
+
+    *image_width = FreeImage_GetWidth( image);
+    *image_height = FreeImage_GetHeight( image);
+
+    uint8_t *image_bits = FreeImage_GetBits( image);
+
+    uint8_t *ret_image_bits = new uint8_t[ (*image_width) * (*image_height) * 4];
+    memcpy( ret_image_bits, image_bits, (*image_width) * (*image_height) * 4 * sizeof( uint8_t));
+
+    FreeImage_Unload( image);
+
+    return ret_image_bits;
+}
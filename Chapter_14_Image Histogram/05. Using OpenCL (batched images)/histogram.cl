@@ -0,0 +1,66 @@
+#pragma OPENCL EXTENSION cl_khr_local_int32_base_atomics : enable
+#pragma OPENCL EXTENSION cl_khr_global_int32_base_atomics : enable
+
+/**
+ * @brief histogram_batch_rgba_unorm8():
+ *      This kernel computes R, G and B histograms for a batch of BGRA 8-bit-per-channel images
+ * packed back to back in a single buffer.
+ *
+ * @param pixels is the packed pixel data of all images in the batch.
+ *
+ * @param image_info has one entry per image,
+ *              x : offset of first pixel of the image in pixels
+ *              y : number of pixels in the image ( width * height)
+ *              z : image width
+ *              w : image height
+ *
+ * @param histogram is an array of num_images * 256 * 3 entries, for each image we store 256 R bins,
+ *                  followed by 256 G bins, and then 256 B bins. It must be zero-initialized.
+ *
+ * The second dimension of the NDRange selects the image, the work-groups along the first dimension
+ * stride over the pixels of that image and merge their local histogram into the image histogram.
+ */
+__kernel void histogram_batch_rgba_unorm8( __global const uchar4 *pixels, __global const uint4 *image_info, __global uint *histogram)
+{
+    // variable declaration
+    int local_size = (int)get_local_size(0);
+    int tid = (int)get_local_id(0);
+    int image_indx = (int)get_global_id(1);
+
+    uint4 info = image_info[ image_indx];
+    __global const uchar4 *image_pixels = pixels + info.x;
+    __global uint *image_histogram = histogram + image_indx * 256 * 3;
+
+    local uint tmp_histogram[256 * 3];
+
+    // code
+        // clear the local buffer that will generate the partial histogram
+    for( int i = tid; i < 256 * 3; i += local_size)
+    {
+        tmp_histogram[i] = 0;
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    for( uint i = get_global_id(0); i < info.y; i += get_global_size(0))
+    {
+            // pixels are stored as B, G, R, A
+        uchar4 clr = image_pixels[i];
+
+        atomic_inc( &tmp_histogram[ clr.z]);
+        atomic_inc( &tmp_histogram[ 256 + (uint)clr.y]);
+        atomic_inc( &tmp_histogram[ 512 + (uint)clr.x]);
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+        // merge the partial histogram into the histogram of this image
+    for( int i = tid; i < 256 * 3; i += local_size)
+    {
+        uint count = tmp_histogram[i];
+        if( count)
+        {
+            atomic_add( &image_histogram[i], count);
+        }
+    }
+}
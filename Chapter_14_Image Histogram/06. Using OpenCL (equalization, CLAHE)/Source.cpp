@@ -0,0 +1,577 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * Histogram equalization on the device.
+ *
+ * The whole pipeline ( histogram -> prefix-sum CDF -> LUT -> remap) is enqueued on one command-queue,
+ * intermediate histograms and LUTs never leave the device, only the final image is read back.
+ *
+ * With --clahe the image is split into tiles, every tile gets its own clipped histogram and LUT,
+ * and each pixel is remapped with a bilinear blend of the four nearest tile LUTs.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+
+#include "OpenCLUtil.h"
+
+#include "../../Common/FreeImage/x64/FreeImage.h"
+
+#define To_String(x) #x
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+const int COLOR_RANGE = 256;
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_command_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+cl_program ocl_program = nullptr;
+
+cl_kernel fn_histogram_partial_image_rgba_unorm8 = nullptr;
+cl_kernel fn_histogram_sum_partial_results_unorm8 = nullptr;
+cl_kernel fn_histogram_equalization_lut = nullptr;
+cl_kernel fn_histogram_equalization_remap = nullptr;
+cl_kernel fn_clahe_tile_histogram = nullptr;
+cl_kernel fn_clahe_tile_lut = nullptr;
+cl_kernel fn_clahe_apply = nullptr;
+
+cl_mem ocl_input_image = nullptr;
+cl_mem ocl_output_image = nullptr;
+cl_mem ocl_histogram_buffer = nullptr;
+cl_mem ocl_partial_histogram_buffer = nullptr;
+cl_mem ocl_lut_buffer = nullptr;
+
+uint8_t *image_bits = nullptr;
+uint8_t *output_image_bits = nullptr;
+
+const int num_pixels_per_work_item = 32;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool SaveImage( const char *out_file_name, uint8_t *image_data, int image_width, int image_height);
+    uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height);
+    bool EnqueueEqualization( int image_width, int image_height);
+    bool EnqueueCLAHE( int image_width, int image_height, int num_tiles, float clip_limit);
+    void  cleanup();
+
+    // variable declaration
+    int image_width = 0;
+    int image_height = 0;
+
+    bool b_clahe = false;
+    int num_tiles = 8;
+    float clip_limit = 4.0f;
+
+    std::string input_image;
+    std::string output_image = "out.png";
+
+    size_t workgroup_size;
+    cl_int ocl_err;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--input") && (i + 1 < argc))
+        {
+            input_image = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--output") && (i + 1 < argc))
+        {
+            output_image = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--clahe"))
+        {
+            b_clahe = true;
+        }
+        else if( !input.compare( "--tiles") && (i + 1 < argc))
+        {
+            num_tiles = std::max( 1, atoi( argv[++i]));
+        }
+        else if( !input.compare( "--clip") && (i + 1 < argc))
+        {
+            clip_limit = std::max( 1.0f, (float)atof( argv[++i]));
+        }
+    }
+
+    if( input_image.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " --input <input_image_name>\n";
+        std::cerr << "options: " << "\n"
+                  << "   --output <output_image_name>: equalized image (default out.png)\n"
+                  << "   --clahe: contrast limited adaptive histogram equalization\n"
+                  << "   --tiles <n>: CLAHE tiles along each axis (default 8)\n"
+                  << "   --clip <f>: CLAHE clip limit relative to the mean bin height (default 4.0)"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( 0);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_command_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_command_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_program = CreateProgram( ocl_context, ocl_device, "equalization.cl");
+    if( ocl_program == nullptr)
+    {
+        std::cerr << "CreateProgram() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    struct
+    {
+        cl_kernel *kernel;
+        const char *name;
+    } kernels[] =
+    {
+        { &fn_histogram_partial_image_rgba_unorm8, "histogram_partial_image_rgba_unorm8"},
+        { &fn_histogram_sum_partial_results_unorm8, "histogram_sum_partial_results_unorm8"},
+        { &fn_histogram_equalization_lut, "histogram_equalization_lut"},
+        { &fn_histogram_equalization_remap, "histogram_equalization_remap"},
+        { &fn_clahe_tile_histogram, "clahe_tile_histogram"},
+        { &fn_clahe_tile_lut, "clahe_tile_lut"},
+        { &fn_clahe_apply, "clahe_apply"},
+    };
+
+    for( auto &k : kernels)
+    {
+        *k.kernel = clCreateKernel( ocl_program, k.name, &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            std::cerr << "clCreateKernel() Failed for " << k.name << ".\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    }
+
+        // LUT kernels scan 256 bins with one work-group of 256 work-items
+    clGetKernelWorkGroupInfo( b_clahe ? fn_clahe_tile_lut : fn_histogram_equalization_lut, ocl_device, CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &workgroup_size, nullptr);
+    if( workgroup_size < 256)
+    {
+        std::cerr << "A minimum of 256 work-items in work-group needed for LUT kernels. \n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** IMAGE LOADING ***********/
+    image_bits = LoadImage( input_image.c_str(), &image_width, &image_height);
+    if( image_bits == nullptr)
+    {
+        std::cerr << "Cannot open image \"" << input_image << "\"" << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cl_image_format ocl_image_format = { };
+    ocl_image_format.image_channel_order = CL_BGRA;
+    ocl_image_format.image_channel_data_type = CL_UNORM_INT8;
+
+    cl_image_desc ocl_image_desc = { };
+    ocl_image_desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    ocl_image_desc.image_width = image_width;
+    ocl_image_desc.image_height = image_height;
+    ocl_image_desc.mem_object = nullptr;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        // input image
+    ocl_image_desc.image_row_pitch = image_width * 4;
+    ocl_input_image = clCreateImage( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, &ocl_image_format, &ocl_image_desc, image_bits, &ocl_err);
+    if( !ocl_input_image || ocl_err)
+    {
+        std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        // output image
+    ocl_image_desc.image_row_pitch = 0;
+    ocl_output_image = clCreateImage( ocl_context, CL_MEM_WRITE_ONLY, &ocl_image_format, &ocl_image_desc, nullptr, &ocl_err);
+    if( !ocl_output_image || ocl_err)
+    {
+        std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /********* EQUALIZE ****************/
+    bool result = b_clahe ? EnqueueCLAHE( image_width, image_height, num_tiles, clip_limit) : EnqueueEqualization( image_width, image_height);
+    if( !result)
+    {
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        // read result, the only transfer back to the host
+    output_image_bits = new uint8_t[ image_width * image_height * 4];
+    size_t origin[3] = { 0, 0, 0};
+    size_t region[3] = { (size_t)image_width, (size_t)image_height, 1};
+    size_t row_pitch = image_width * 4;
+
+    ocl_err = clEnqueueReadImage( ocl_command_queue, ocl_output_image, CL_TRUE, origin, region, row_pitch, 0, output_image_bits, 0, nullptr, nullptr);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clEnqueueReadImage() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  elapsed_seconds = end - start;
+    std::cout << "Time Required for " << ( b_clahe ? "CLAHE" : "Histogram Equalization") << " by OpenCL is: " << elapsed_seconds.count() << "s" << std::endl;
+
+    SaveImage( output_image.c_str(), output_image_bits, image_width, image_height);
+
+    cleanup();
+
+    return 0;
+}
+
+/**
+ * @brief EnqueueEqualization() : histogram -> CDF/LUT -> remap, all on the device.
+ */
+bool EnqueueEqualization( int image_width, int image_height)
+{
+    // variable declaration
+    cl_int ocl_err;
+    size_t workgroup_size;
+    size_t global_work_size[2];
+    size_t local_work_size[2];
+    size_t lut_global_work_size[1];
+    size_t lut_local_work_size[1];
+    int num_groups;
+
+    // code
+    clGetKernelWorkGroupInfo( fn_histogram_partial_image_rgba_unorm8, ocl_device, CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &workgroup_size, nullptr);
+
+    local_work_size[0] = 16;
+    local_work_size[1] = std::max( (size_t)1, std::min( workgroup_size, (size_t)256) / 16);
+
+    int w = ( image_width + num_pixels_per_work_item - 1) / num_pixels_per_work_item;
+    global_work_size[0] = ( w + local_work_size[0] - 1) / local_work_size[0];
+    global_work_size[1] = ( image_height + local_work_size[1] - 1) / local_work_size[1];
+
+    num_groups = (int)( global_work_size[0] * global_work_size[1]);
+    global_work_size[0] *= local_work_size[0];
+    global_work_size[1] *= local_work_size[1];
+
+    ocl_partial_histogram_buffer = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, num_groups * COLOR_RANGE * 3 * sizeof( cl_uint), nullptr, &ocl_err);
+    if( !ocl_partial_histogram_buffer || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed.\n";
+        return false;
+    }
+
+    ocl_histogram_buffer = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, COLOR_RANGE * 3 * sizeof( cl_uint), nullptr, &ocl_err);
+    if( !ocl_histogram_buffer || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed.\n";
+        return false;
+    }
+
+    ocl_lut_buffer = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, COLOR_RANGE * 3 * sizeof( cl_uchar), nullptr, &ocl_err);
+    if( !ocl_lut_buffer || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed.\n";
+        return false;
+    }
+
+        // partial histograms
+    ocl_err = clSetKernelArg( fn_histogram_partial_image_rgba_unorm8, 0, sizeof( cl_mem), &ocl_input_image);
+    ocl_err |= clSetKernelArg( fn_histogram_partial_image_rgba_unorm8, 1, sizeof( int), &num_pixels_per_work_item);
+    ocl_err |= clSetKernelArg( fn_histogram_partial_image_rgba_unorm8, 2, sizeof( cl_mem), &ocl_partial_histogram_buffer);
+    if( ocl_err)
+    {
+        std::cerr << "clSetKernelArg() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, fn_histogram_partial_image_rgba_unorm8, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+        // final histogram
+    ocl_err = clSetKernelArg( fn_histogram_sum_partial_results_unorm8, 0, sizeof( cl_mem), &ocl_partial_histogram_buffer);
+    ocl_err |= clSetKernelArg( fn_histogram_sum_partial_results_unorm8, 1, sizeof( int), &num_groups);
+    ocl_err |= clSetKernelArg( fn_histogram_sum_partial_results_unorm8, 2, sizeof( cl_mem), &ocl_histogram_buffer);
+    if( ocl_err)
+    {
+        std::cerr << "clSetKernelArg() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    lut_global_work_size[0] = COLOR_RANGE * 3;
+    lut_local_work_size[0] = 256;
+
+    ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, fn_histogram_sum_partial_results_unorm8, 1, nullptr, lut_global_work_size, lut_local_work_size, 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+        // CDF and LUT
+    ocl_err = clSetKernelArg( fn_histogram_equalization_lut, 0, sizeof( cl_mem), &ocl_histogram_buffer);
+    ocl_err |= clSetKernelArg( fn_histogram_equalization_lut, 1, sizeof( cl_mem), &ocl_lut_buffer);
+    if( ocl_err)
+    {
+        std::cerr << "clSetKernelArg() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, fn_histogram_equalization_lut, 1, nullptr, lut_global_work_size, lut_local_work_size, 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+        // remap
+    ocl_err = clSetKernelArg( fn_histogram_equalization_remap, 0, sizeof( cl_mem), &ocl_input_image);
+    ocl_err |= clSetKernelArg( fn_histogram_equalization_remap, 1, sizeof( cl_mem), &ocl_lut_buffer);
+    ocl_err |= clSetKernelArg( fn_histogram_equalization_remap, 2, sizeof( cl_mem), &ocl_output_image);
+    if( ocl_err)
+    {
+        std::cerr << "clSetKernelArg() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    local_work_size[0] = 16;
+    local_work_size[1] = 16;
+    global_work_size[0] = ( ( image_width + 15) / 16) * 16;
+    global_work_size[1] = ( ( image_height + 15) / 16) * 16;
+
+    ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, fn_histogram_equalization_remap, 2, nullptr, global_work_size, ( workgroup_size >= 256) ? local_work_size : nullptr, 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief EnqueueCLAHE() : per-tile clipped histograms -> tile LUTs -> bilinear remap, all on the device.
+ */
+bool EnqueueCLAHE( int image_width, int image_height, int num_tiles, float clip_limit)
+{
+    // variable declaration
+    cl_int ocl_err;
+    size_t global_work_size[3];
+    size_t local_work_size[3];
+
+    cl_int2 tiles;
+    cl_int2 tile_size;
+
+    // code
+    tiles.s[0] = std::min( num_tiles, image_width);
+    tiles.s[1] = std::min( num_tiles, image_height);
+    tile_size.s[0] = ( image_width + tiles.s[0] - 1) / tiles.s[0];
+    tile_size.s[1] = ( image_height + tiles.s[1] - 1) / tiles.s[1];
+
+    size_t total_tiles = (size_t)tiles.s[0] * tiles.s[1];
+
+    std::cout << To_String( tiles) << " : " << tiles.s[0] << " x " << tiles.s[1] << "\n";
+    std::cout << To_String( tile_size) << " : " << tile_size.s[0] << " x " << tile_size.s[1] << "\n";
+    std::cout << To_String( clip_limit) << " : " << clip_limit << "\n\n";
+
+    ocl_histogram_buffer = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, total_tiles * COLOR_RANGE * 3 * sizeof( cl_uint), nullptr, &ocl_err);
+    if( !ocl_histogram_buffer || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed.\n";
+        return false;
+    }
+
+    ocl_lut_buffer = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, total_tiles * COLOR_RANGE * 3 * sizeof( cl_uchar), nullptr, &ocl_err);
+    if( !ocl_lut_buffer || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed.\n";
+        return false;
+    }
+
+        // tile histograms, one work-group per tile
+    ocl_err = clSetKernelArg( fn_clahe_tile_histogram, 0, sizeof( cl_mem), &ocl_input_image);
+    ocl_err |= clSetKernelArg( fn_clahe_tile_histogram, 1, sizeof( cl_int2), &tile_size);
+    ocl_err |= clSetKernelArg( fn_clahe_tile_histogram, 2, sizeof( cl_mem), &ocl_histogram_buffer);
+    if( ocl_err)
+    {
+        std::cerr << "clSetKernelArg() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    local_work_size[0] = 16;
+    local_work_size[1] = 16;
+    global_work_size[0] = tiles.s[0] * local_work_size[0];
+    global_work_size[1] = tiles.s[1] * local_work_size[1];
+
+    ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, fn_clahe_tile_histogram, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+        // clipped tile LUTs
+    ocl_err = clSetKernelArg( fn_clahe_tile_lut, 0, sizeof( cl_mem), &ocl_histogram_buffer);
+    ocl_err |= clSetKernelArg( fn_clahe_tile_lut, 1, sizeof( float), &clip_limit);
+    ocl_err |= clSetKernelArg( fn_clahe_tile_lut, 2, sizeof( cl_mem), &ocl_lut_buffer);
+    if( ocl_err)
+    {
+        std::cerr << "clSetKernelArg() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    global_work_size[0] = 256;
+    global_work_size[1] = 3;
+    global_work_size[2] = total_tiles;
+    local_work_size[0] = 256;
+    local_work_size[1] = 1;
+    local_work_size[2] = 1;
+
+    ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, fn_clahe_tile_lut, 3, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+        // bilinear blend of the tile LUTs
+    ocl_err = clSetKernelArg( fn_clahe_apply, 0, sizeof( cl_mem), &ocl_input_image);
+    ocl_err |= clSetKernelArg( fn_clahe_apply, 1, sizeof( cl_mem), &ocl_lut_buffer);
+    ocl_err |= clSetKernelArg( fn_clahe_apply, 2, sizeof( cl_int2), &tiles);
+    ocl_err |= clSetKernelArg( fn_clahe_apply, 3, sizeof( cl_int2), &tile_size);
+    ocl_err |= clSetKernelArg( fn_clahe_apply, 4, sizeof( cl_mem), &ocl_output_image);
+    if( ocl_err)
+    {
+        std::cerr << "clSetKernelArg() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    global_work_size[0] = image_width;
+    global_work_size[1] = image_height;
+
+    ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, fn_clahe_apply, 2, nullptr, global_work_size, nullptr, 0, nullptr, nullptr);
+    if( ocl_err)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // code
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+    RELEASE_CL_OBJECT( ocl_command_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+
+    RELEASE_CL_OBJECT( fn_histogram_partial_image_rgba_unorm8, clReleaseKernel);
+    RELEASE_CL_OBJECT( fn_histogram_sum_partial_results_unorm8, clReleaseKernel);
+    RELEASE_CL_OBJECT( fn_histogram_equalization_lut, clReleaseKernel);
+    RELEASE_CL_OBJECT( fn_histogram_equalization_remap, clReleaseKernel);
+    RELEASE_CL_OBJECT( fn_clahe_tile_histogram, clReleaseKernel);
+    RELEASE_CL_OBJECT( fn_clahe_tile_lut, clReleaseKernel);
+    RELEASE_CL_OBJECT( fn_clahe_apply, clReleaseKernel);
+
+    RELEASE_CL_OBJECT( ocl_input_image, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_output_image, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_histogram_buffer, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_partial_histogram_buffer, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_lut_buffer, clReleaseMemObject);
+
+    RELEASE_CL_OBJECT( image_bits, delete[]);
+    RELEASE_CL_OBJECT( output_image_bits, delete[]);
+}
+
+/**
+ * @brief LoadImage() : Load Image and returns image width, image height and image data in 32-bit format. Delete image data when work is done.
+ */
+uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height)
+{
+    // code
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( file_name, 0);
+    FIBITMAP *image = FreeImage_Load( format, file_name);
+    if( image == nullptr)
+    {
+        *image_width = 0;
+        *image_height = 0;
+        return nullptr;
+    }
+
+        // convert to 32-bit image
+    FIBITMAP *temp = image;
+    image = FreeImage_ConvertTo32Bits( image);
+    FreeImage_Unload( temp);
+
+    *image_width = FreeImage_GetWidth( image);
+    *image_height = FreeImage_GetHeight( image);
+
+    uint8_t *image_bits = FreeImage_GetBits( image);
+
+    uint8_t *ret_image_bits = new uint8_t[ (*image_width) * (*image_height) * 4];
+    memcpy( ret_image_bits, image_bits, (*image_width) * (*image_height) * 4 * sizeof( uint8_t));
+
+    FreeImage_Unload( image);
+
+    return ret_image_bits;
+}
+
+/**
+ * @brief SaveImage()
+ */
+bool SaveImage( const char *out_file_name, uint8_t *image_bits, int image_width, int image_height)
+{
+    // save image
+    FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_file_name);
+    if( format == FREE_IMAGE_FORMAT::FIF_UNKNOWN)
+    {
+        return false;
+    }
+
+    int row_pitch = 4 * image_width;
+    FIBITMAP *image = FreeImage_ConvertFromRawBits( image_bits, image_width, image_height, row_pitch, 32, 0xFF000000, 0x00FF0000, 0x0000FF00);
+    FreeImage_Save( format, image, out_file_name);
+    FreeImage_Unload( image);
+
+    return true;
+}
@@ -0,0 +1,344 @@
+#pragma OPENCL EXTENSION cl_khr_local_int32_base_atomics : enable
+
+/************************
+ *
+ * Histogram equalization and CLAHE ( Contrast Limited Adaptive Histogram Equalization) for RGBA 8-bit-per-channel images.
+ *
+ * Every channel ( R, G, B) is equalized independently. Histograms and LUTs use the same layout as
+ * the other Chapter 14 samples: 256 R bins, followed by 256 G bins, and then 256 B bins.
+ *
+ * Global equalization:
+ *      histogram_partial_image_rgba_unorm8()  -> histogram_sum_partial_results_unorm8()
+ *      -> histogram_equalization_lut()        -> histogram_equalization_remap()
+ *
+ * CLAHE:
+ *      clahe_tile_histogram() -> clahe_tile_lut() -> clahe_apply()
+ *
+ * Kernels computing LUTs must be launched with a work-group size of 256.
+ */
+
+const sampler_t sampler_ = CLK_NORMALIZED_COORDS_FALSE | CLK_ADDRESS_CLAMP_TO_EDGE | CLK_FILTER_NEAREST;
+
+/**
+ * @brief local_inclusive_scan_256(): Hillis-Steele inclusive prefix sum over 256 work-items.
+ *
+ * Returns the prefix sum for the calling work-item, scan[255] holds the total on return.
+ */
+uint local_inclusive_scan_256( __local uint *scan, uint value)
+{
+    // variable declaration
+    int lid = (int)get_local_id(0);
+
+    // code
+    barrier( CLK_LOCAL_MEM_FENCE);
+    scan[lid] = value;
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    for( int offset = 1; offset < 256; offset <<= 1)
+    {
+        uint v = ( lid >= offset) ? scan[ lid - offset] : 0;
+        barrier( CLK_LOCAL_MEM_FENCE);
+        scan[lid] += v;
+        barrier( CLK_LOCAL_MEM_FENCE);
+    }
+
+    return scan[lid];
+}
+
+/**
+ * @brief histogram_partial_image_rgba_unorm8():
+ *      Partial R, G and B histogram for the image tile covered by one work-group.
+ */
+__kernel void histogram_partial_image_rgba_unorm8( read_only image2d_t img, int num_pixels_per_workitem, __global uint *histogram)
+{
+    // variable declaration
+    int local_size = (int)get_local_size(0) * (int)get_local_size(1);
+
+    int image_width = get_image_width( img);
+    int image_height = get_image_height( img);
+
+    int group_indx = mad24( (int)get_group_id(1), (int)get_num_groups(0), (int)get_group_id(0)) * 256 * 3;
+
+    int x = get_global_id(0);
+    int y = get_global_id(1);
+
+    local uint tmp_histogram[256 * 3];
+
+    int tid = mad24( (int)get_local_id(1), (int)get_local_size(0), (int)get_local_id(0));
+
+    // code
+    for( int i = tid; i < 256 * 3; i += local_size)
+    {
+        tmp_histogram[i] = 0;
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    int i, idx;
+    for( i = 0, idx = x; i < num_pixels_per_workitem; i++, idx += get_global_size(0))
+    {
+        if( (idx < image_width) && ( y < image_height))
+        {
+            uint4 clr = convert_uint4_sat( read_imagef( img, sampler_, (int2)( idx, y)) * 255.0f + 0.5f);
+
+            atomic_inc( &tmp_histogram[ clr.x]);
+            atomic_inc( &tmp_histogram[ 256 + clr.y]);
+            atomic_inc( &tmp_histogram[ 512 + clr.z]);
+        }
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    for( int i = tid; i < 256 * 3; i += local_size)
+    {
+        histogram[ group_indx + i] = tmp_histogram[i];
+    }
+}
+
+/**
+ * @brief histogram_sum_partial_results_unorm8():  This kernel sums partial histogram results into a final histogram result.
+ */
+__kernel void histogram_sum_partial_results_unorm8( __global uint *partial_histogram, int num_groups, __global uint *histogram)
+{
+    // variable declaration
+    int tid = ( int) get_global_id( 0);
+    int group_indx;
+    int n = num_groups;
+    uint tmp_histogram;
+
+    // code
+    tmp_histogram = partial_histogram[tid];
+
+    group_indx = 256 * 3;
+    while( --n > 0)
+    {
+        tmp_histogram += partial_histogram[ group_indx + tid];
+        group_indx += 256 * 3;
+    }
+
+    histogram[tid] = tmp_histogram;
+}
+
+/**
+ * @brief histogram_equalization_lut(): builds the equalization LUT from the image histogram.
+ *
+ *      lut[v] = ( cdf[v] - cdf_min) * 255 / ( num_pixels - cdf_min)
+ *
+ * One work-group of 256 work-items per channel ( global size 256 * 3).
+ */
+__kernel void histogram_equalization_lut( __global const uint *histogram, __global uchar *lut)
+{
+    // variable declaration
+    int lid = (int)get_local_id(0);
+    int channel_indx = (int)get_group_id(0) * 256;
+
+    local uint scan[256];
+    local uint cdf_min;
+
+    // code
+    uint h = histogram[ channel_indx + lid];
+    uint cdf = local_inclusive_scan_256( scan, h);
+    uint total = scan[255];
+
+        // the first non-empty bin gives the smallest non-zero cdf value
+    if( lid == 0)
+    {
+        cdf_min = 0;
+    }
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    if( (h != 0) && (cdf == h))
+    {
+        cdf_min = cdf;
+    }
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    if( total > cdf_min)
+    {
+        float scale = 255.0f / (float)( total - cdf_min);
+        lut[ channel_indx + lid] = convert_uchar_sat( (float)( cdf - cdf_min) * scale + 0.5f);
+    }
+    else
+    {
+        lut[ channel_indx + lid] = (uchar)lid;
+    }
+}
+
+/**
+ * @brief histogram_equalization_remap(): applies the R, G, B LUTs to every pixel.
+ */
+__kernel void histogram_equalization_remap( read_only image2d_t src, __global const uchar *lut, write_only image2d_t dst)
+{
+    // variable declaration
+    int x = ( int) get_global_id(0);
+    int y = ( int) get_global_id(1);
+
+    int local_size = (int)get_local_size(0) * (int)get_local_size(1);
+    int tid = mad24( (int)get_local_id(1), (int)get_local_size(0), (int)get_local_id(0));
+
+    local uchar tmp_lut[256 * 3];
+
+    // code
+    for( int i = tid; i < 256 * 3; i += local_size)
+    {
+        tmp_lut[i] = lut[i];
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    if( (x >= get_image_width(src)) || (y >= get_image_height(src)))
+    {
+        return;
+    }
+
+    float4 clr = read_imagef( src, sampler_, (int2)( x, y));
+    uint4 v = convert_uint4_sat( clr * 255.0f + 0.5f);
+
+    float4 out_clr = (float4)( tmp_lut[ v.x], tmp_lut[ 256 + v.y], tmp_lut[ 512 + v.z], 255.0f) / 255.0f;
+    out_clr.w = clr.w;
+
+    write_imagef( dst, (int2)( x, y), out_clr);
+}
+
+/**
+ * @brief clahe_tile_histogram(): R, G, B histogram of one tile per work-group.
+ *
+ * The work-group ( get_group_id(0), get_group_id(1)) covers the tile at the same position,
+ * work-items stride over the tile pixels.
+ */
+__kernel void clahe_tile_histogram( read_only image2d_t src, int2 tile_size, __global uint *tile_histogram)
+{
+    // variable declaration
+    int image_width = get_image_width( src);
+    int image_height = get_image_height( src);
+
+    int local_size = (int)get_local_size(0) * (int)get_local_size(1);
+    int tid = mad24( (int)get_local_id(1), (int)get_local_size(0), (int)get_local_id(0));
+
+    int tile_indx = mad24( (int)get_group_id(1), (int)get_num_groups(0), (int)get_group_id(0));
+
+    int x0 = (int)get_group_id(0) * tile_size.x;
+    int y0 = (int)get_group_id(1) * tile_size.y;
+    int x1 = min( x0 + tile_size.x, image_width);
+    int y1 = min( y0 + tile_size.y, image_height);
+
+    local uint tmp_histogram[256 * 3];
+
+    // code
+    for( int i = tid; i < 256 * 3; i += local_size)
+    {
+        tmp_histogram[i] = 0;
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    for( int y = y0 + (int)get_local_id(1); y < y1; y += (int)get_local_size(1))
+    {
+        for( int x = x0 + (int)get_local_id(0); x < x1; x += (int)get_local_size(0))
+        {
+            uint4 clr = convert_uint4_sat( read_imagef( src, sampler_, (int2)( x, y)) * 255.0f + 0.5f);
+
+            atomic_inc( &tmp_histogram[ clr.x]);
+            atomic_inc( &tmp_histogram[ 256 + clr.y]);
+            atomic_inc( &tmp_histogram[ 512 + clr.z]);
+        }
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    for( int i = tid; i < 256 * 3; i += local_size)
+    {
+        tile_histogram[ tile_indx * 256 * 3 + i] = tmp_histogram[i];
+    }
+}
+
+/**
+ * @brief clahe_tile_lut(): clips the tile histogram, redistributes the clipped excess uniformly
+ *                          over all bins and builds the tile LUT from the resulting cdf.
+ *
+ * @param clip_limit is relative to the average bin height, clip = clip_limit * num_pixels / 256.
+ *
+ * NDRange ( 256, 3, num_tiles) with work-group size ( 256, 1, 1).
+ */
+__kernel void clahe_tile_lut( __global const uint *tile_histogram, float clip_limit, __global uchar *tile_lut)
+{
+    // variable declaration
+    int lid = (int)get_local_id(0);
+    int indx = ( (int)get_global_id(2) * 3 + (int)get_global_id(1)) * 256;
+
+    local uint scan[256];
+
+    // code
+    uint h = tile_histogram[ indx + lid];
+
+    local_inclusive_scan_256( scan, h);
+    uint total = scan[255];
+
+    if( total == 0)
+    {
+        tile_lut[ indx + lid] = (uchar)lid;
+        return;
+    }
+
+    uint limit = max( 1u, (uint)( clip_limit * (float)total / 256.0f));
+    uint excess = ( h > limit) ? ( h - limit) : 0;
+    h = min( h, limit);
+
+    local_inclusive_scan_256( scan, excess);
+    excess = scan[255];
+
+    h += ( excess / 256) + ( ( (uint)lid < ( excess % 256)) ? 1 : 0);
+
+    uint cdf = local_inclusive_scan_256( scan, h);
+
+    tile_lut[ indx + lid] = convert_uchar_sat( (float)cdf * 255.0f / (float)total + 0.5f);
+}
+
+/**
+ * @brief clahe_apply(): maps every pixel through the LUTs of the four nearest tile centers
+ *                       and blends the results bilinearly.
+ */
+__kernel void clahe_apply( read_only image2d_t src, __global const uchar *tile_lut, int2 num_tiles, int2 tile_size, write_only image2d_t dst)
+{
+    // variable declaration
+    int x = ( int) get_global_id(0);
+    int y = ( int) get_global_id(1);
+
+    // code
+    if( (x >= get_image_width(src)) || (y >= get_image_height(src)))
+    {
+        return;
+    }
+
+    float4 clr = read_imagef( src, sampler_, (int2)( x, y));
+    uint4 v = convert_uint4_sat( clr * 255.0f + 0.5f);
+
+        // position relative to tile centers
+    float fx = ( (float)x + 0.5f) / (float)tile_size.x - 0.5f;
+    float fy = ( (float)y + 0.5f) / (float)tile_size.y - 0.5f;
+
+    int tx0 = (int)floor( fx);
+    int ty0 = (int)floor( fy);
+
+    float ax = fx - (float)tx0;
+    float ay = fy - (float)ty0;
+
+    int tx1 = clamp( tx0 + 1, 0, num_tiles.x - 1);
+    int ty1 = clamp( ty0 + 1, 0, num_tiles.y - 1);
+    tx0 = clamp( tx0, 0, num_tiles.x - 1);
+    ty0 = clamp( ty0, 0, num_tiles.y - 1);
+
+    __global const uchar *lut00 = tile_lut + ( ty0 * num_tiles.x + tx0) * 256 * 3;
+    __global const uchar *lut10 = tile_lut + ( ty0 * num_tiles.x + tx1) * 256 * 3;
+    __global const uchar *lut01 = tile_lut + ( ty1 * num_tiles.x + tx0) * 256 * 3;
+    __global const uchar *lut11 = tile_lut + ( ty1 * num_tiles.x + tx1) * 256 * 3;
+
+    float3 c00 = (float3)( lut00[ v.x], lut00[ 256 + v.y], lut00[ 512 + v.z]);
+    float3 c10 = (float3)( lut10[ v.x], lut10[ 256 + v.y], lut10[ 512 + v.z]);
+    float3 c01 = (float3)( lut01[ v.x], lut01[ 256 + v.y], lut01[ 512 + v.z]);
+    float3 c11 = (float3)( lut11[ v.x], lut11[ 256 + v.y], lut11[ 512 + v.z]);
+
+    float3 c = mix( mix( c00, c10, ax), mix( c01, c11, ax), ay) / 255.0f;
+
+    write_imagef( dst, (int2)( x, y), (float4)( c, clr.w));
+}
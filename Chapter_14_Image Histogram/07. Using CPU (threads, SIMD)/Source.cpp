@@ -0,0 +1,550 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * Multithreaded CPU histogram.
+ *
+ *  - every thread owns a private histogram for its band of pixels, the private histograms are merged at the end.
+ *  - every private histogram is split into 4 sub-histograms, consecutive pixels go to different sub-histograms
+ *    so that repeated values do not serialize on the same counter ( store-to-load forwarding stalls).
+ *  - BGRA pixels are de-interleaved 16 at a time with SSE2 into B, G and R byte planes.
+ *
+ * Throughput is reported in GB/s of input image data, so it can be compared with the OpenCL variants.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <algorithm>
+
+#if defined(_M_X64) || defined(__SSE2__)
+    #include <emmintrin.h>
+    #define HISTOGRAM_USE_SSE2 1
+#endif
+
+#include "../../Common/FreeImage/x64/FreeImage.h"
+
+const int OUT_IMAGE_WIDTH = 256;
+const int OUT_IMAGE_HEIGHT = 1024;
+const int BIN_COUNT = 256;
+const int COLOR_RANGE = 256;
+
+const int NUM_SUB_HISTOGRAMS = 4;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool SaveHistogramGraphImage( uint32_t *red_channel_data, uint32_t *green_channel_data, uint32_t *blue_channel_data, bool b_filled_graph, bool b_sepated_output);
+    uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height);
+    void HistogramReference( const uint8_t *image_bits, size_t num_pixels, uint32_t *histogram);
+    void HistogramThreaded( const uint8_t *image_bits, size_t num_pixels, unsigned int num_threads, uint32_t *histogram);
+
+    // variable declaration
+    uint8_t *image_bits = nullptr;
+    int image_width = 0;
+    int image_height = 0;
+
+    uint32_t *ref_histogram_results = nullptr;
+    uint32_t *histogram_results = nullptr;
+
+    bool b_save_filled_graph = true;
+    bool b_save_separate_channel_graph = false;
+
+    unsigned int num_threads = std::max( 1u, std::thread::hardware_concurrency());
+    int num_iterations = 10;
+
+    std::string input_image;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--input") && (i + 1 < argc))
+        {
+            input_image = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--threads") && (i + 1 < argc))
+        {
+            num_threads = std::max( 1, atoi( argv[++i]));
+        }
+        else if( !input.compare( "--iterations") && (i + 1 < argc))
+        {
+            num_iterations = std::max( 1, atoi( argv[++i]));
+        }
+        else if( !input.compare( "-d"))
+        {
+            b_save_filled_graph = false;
+        }
+        else if( !input.compare( "-s"))
+        {
+            b_save_separate_channel_graph = true;
+        }
+    }
+
+    if( input_image.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " --input <input_image_name>\n";
+        std::cerr << "options: " << "\n"
+                  << "   --threads <n>: number of host threads (default: hardware concurrency)\n"
+                  << "   --iterations <n>: number of timed runs (default 10)\n"
+                  << "   -d: show dotted graph output\n"
+                  << "   -s: separate output for each color channel"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+        /******** IMAGE LOADING ***********/
+    image_bits = LoadImage( input_image.c_str(), &image_width, &image_height);
+    if( image_bits == nullptr)
+    {
+        std::cerr << "Cannot open image \"" << input_image << "\"" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    size_t num_pixels = (size_t)image_width * image_height;
+    double image_gb = (double)num_pixels * 4 / 1.0e9;
+
+    ref_histogram_results = new uint32_t[ COLOR_RANGE * 3];
+    histogram_results = new uint32_t[ COLOR_RANGE * 3];
+
+        /********* CREATE HISTOGRAM ***********/
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    for( int i = 0; i < num_iterations; ++i)
+    {
+        HistogramReference( image_bits, num_pixels, ref_histogram_results);
+    }
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  reference_seconds = ( end - start) / num_iterations;
+
+    start = std::chrono::steady_clock::now();
+    for( int i = 0; i < num_iterations; ++i)
+    {
+        HistogramThreaded( image_bits, num_pixels, num_threads, histogram_results);
+    }
+    end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  threaded_seconds = ( end - start) / num_iterations;
+
+    if( memcmp( ref_histogram_results, histogram_results, COLOR_RANGE * 3 * sizeof( uint32_t)) != 0)
+    {
+        std::cerr << "Threaded histogram does not match the reference histogram." << std::endl;
+    }
+
+    std::cout << "Threads : " << num_threads << "\n";
+    std::cout << "Time Required for Histogram by CPU (scalar) is: " << reference_seconds.count() << "s ("
+              << image_gb / reference_seconds.count() << " GB/s)\n";
+    std::cout << "Time Required for Histogram by CPU (threaded) is: " << threaded_seconds.count() << "s ("
+              << image_gb / threaded_seconds.count() << " GB/s)" << std::endl;
+
+        /******** SAVE HISTOGRAM *******************/
+    SaveHistogramGraphImage( histogram_results, histogram_results + 256, histogram_results + 512, b_save_filled_graph, b_save_separate_channel_graph);
+
+    delete[] ref_histogram_results;
+    delete[] histogram_results;
+    delete[] image_bits;
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief HistogramReference() : single-threaded scalar histogram ( same loop as "01. Using CPU").
+ */
+void HistogramReference( const uint8_t *image_bits, size_t num_pixels, uint32_t *histogram)
+{
+    // code
+    memset( histogram, 0x0, COLOR_RANGE * 3 * sizeof( uint32_t));
+
+    for( size_t i = 0; i < num_pixels; ++i)
+    {
+        histogram[ image_bits[ 4 * i + 2]]++;
+        histogram[ 256 + image_bits[ 4 * i + 1]]++;
+        histogram[ 512 + image_bits[ 4 * i + 0]]++;
+    }
+}
+
+/**
+ * @brief HistogramBand() : histogram of pixels [first, last) into 4 interleaved sub-histograms of 768 bins each.
+ */
+void HistogramBand( const uint8_t *image_bits, size_t first, size_t last, uint32_t *sub_histograms)
+{
+    // variable declaration
+    uint32_t *h0 = sub_histograms;
+    uint32_t *h1 = sub_histograms + 1 * COLOR_RANGE * 3;
+    uint32_t *h2 = sub_histograms + 2 * COLOR_RANGE * 3;
+    uint32_t *h3 = sub_histograms + 3 * COLOR_RANGE * 3;
+
+    size_t i = first;
+
+    // code
+#if HISTOGRAM_USE_SSE2
+    alignas(16) uint8_t blue[16];
+    alignas(16) uint8_t green[16];
+    alignas(16) uint8_t red[16];
+
+    const __m128i byte_mask = _mm_set1_epi32( 0xFF);
+
+    for( ; i + 16 <= last; i += 16)
+    {
+        const __m128i *src = (const __m128i *)( image_bits + 4 * i);
+
+        __m128i p0 = _mm_loadu_si128( src + 0);
+        __m128i p1 = _mm_loadu_si128( src + 1);
+        __m128i p2 = _mm_loadu_si128( src + 2);
+        __m128i p3 = _mm_loadu_si128( src + 3);
+
+            // B is the low byte of every 32-bit pixel, G and R follow
+        __m128i b = _mm_packus_epi16(
+                        _mm_packs_epi32( _mm_and_si128( p0, byte_mask), _mm_and_si128( p1, byte_mask)),
+                        _mm_packs_epi32( _mm_and_si128( p2, byte_mask), _mm_and_si128( p3, byte_mask)));
+
+        __m128i g = _mm_packus_epi16(
+                        _mm_packs_epi32( _mm_and_si128( _mm_srli_epi32( p0, 8), byte_mask), _mm_and_si128( _mm_srli_epi32( p1, 8), byte_mask)),
+                        _mm_packs_epi32( _mm_and_si128( _mm_srli_epi32( p2, 8), byte_mask), _mm_and_si128( _mm_srli_epi32( p3, 8), byte_mask)));
+
+        __m128i r = _mm_packus_epi16(
+                        _mm_packs_epi32( _mm_and_si128( _mm_srli_epi32( p0, 16), byte_mask), _mm_and_si128( _mm_srli_epi32( p1, 16), byte_mask)),
+                        _mm_packs_epi32( _mm_and_si128( _mm_srli_epi32( p2, 16), byte_mask), _mm_and_si128( _mm_srli_epi32( p3, 16), byte_mask)));
+
+        _mm_store_si128( (__m128i *)blue, b);
+        _mm_store_si128( (__m128i *)green, g);
+        _mm_store_si128( (__m128i *)red, r);
+
+        for( int j = 0; j < 16; j += 4)
+        {
+            h0[ red[j + 0]]++;  h1[ red[j + 1]]++;  h2[ red[j + 2]]++;  h3[ red[j + 3]]++;
+            h0[ 256 + green[j + 0]]++;  h1[ 256 + green[j + 1]]++;  h2[ 256 + green[j + 2]]++;  h3[ 256 + green[j + 3]]++;
+            h0[ 512 + blue[j + 0]]++;  h1[ 512 + blue[j + 1]]++;  h2[ 512 + blue[j + 2]]++;  h3[ 512 + blue[j + 3]]++;
+        }
+    }
+#endif
+
+    for( ; i + 4 <= last; i += 4)
+    {
+        const uint8_t *p = image_bits + 4 * i;
+
+        h0[ p[2]]++;   h1[ p[6]]++;   h2[ p[10]]++;   h3[ p[14]]++;
+        h0[ 256 + p[1]]++;   h1[ 256 + p[5]]++;   h2[ 256 + p[9]]++;   h3[ 256 + p[13]]++;
+        h0[ 512 + p[0]]++;   h1[ 512 + p[4]]++;   h2[ 512 + p[8]]++;   h3[ 512 + p[12]]++;
+    }
+
+    for( ; i < last; ++i)
+    {
+        h0[ image_bits[ 4 * i + 2]]++;
+        h0[ 256 + image_bits[ 4 * i + 1]]++;
+        h0[ 512 + image_bits[ 4 * i + 0]]++;
+    }
+}
+
+/**
+ * @brief HistogramThreaded() : split the image in bands, one private histogram per thread, merge at the end.
+ */
+void HistogramThreaded( const uint8_t *image_bits, size_t num_pixels, unsigned int num_threads, uint32_t *histogram)
+{
+    // variable declaration
+    std::vector<uint32_t> sub_histograms( (size_t)num_threads * NUM_SUB_HISTOGRAMS * COLOR_RANGE * 3, 0);
+    std::vector<std::thread> threads;
+
+        // bands are multiples of 16 pixels so every thread stays on the SIMD path
+    size_t band = ( ( num_pixels / num_threads) + 15) & ~(size_t)15;
+
+    // code
+    for( unsigned int t = 0; t < num_threads; ++t)
+    {
+        size_t first = std::min( num_pixels, t * band);
+        size_t last = ( t == num_threads - 1) ? num_pixels : std::min( num_pixels, first + band);
+
+        threads.emplace_back( HistogramBand, image_bits, first, last, sub_histograms.data() + (size_t)t * NUM_SUB_HISTOGRAMS * COLOR_RANGE * 3);
+    }
+
+    for( std::thread &thread : threads)
+    {
+        thread.join();
+    }
+
+        // merge
+    for( int bin = 0; bin < COLOR_RANGE * 3; ++bin)
+    {
+        uint32_t sum = 0;
+        for( size_t h = 0; h < (size_t)num_threads * NUM_SUB_HISTOGRAMS; ++h)
+        {
+            sum += sub_histograms[ h * COLOR_RANGE * 3 + bin];
+        }
+        histogram[bin] = sum;
+    }
+}
+
+/**
+ * @brief LoadImage() : Load Image and returns image width, image height and image data in 32-bit format. Delete image data when work is done.
+ */
+uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height)
+{
+    // code
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( file_name, 0);
+    FIBITMAP *image = FreeImage_Load( format, file_name);
+    if( image == nullptr)
+    {
+        *image_width = 0;
+        *image_height = 0;
+        return nullptr;
+    }
+
+        // convert to 32-bit image
+    FIBITMAP *temp = image;
+    image = FreeImage_ConvertTo32Bits( image);
+    FreeImage_Unload( temp);
+
+    *image_width = FreeImage_GetWidth( image);
+    *image_height = FreeImage_GetHeight( image);
+
+    uint8_t *image_bits = FreeImage_GetBits( image);
+
+    uint8_t *ret_image_bits = new uint8_t[ (*image_width) * (*image_height) * 4];
+    memcpy( ret_image_bits, image_bits, (*image_width) * (*image_height) * 4 * sizeof( uint8_t));
+
+    FreeImage_Unload( image);
+
+    return ret_image_bits;
+}
+
+/**
+ * @brief SaveHistogramGraphImage()
+ */
+bool SaveHistogramGraphImage( uint32_t *red_channel_data, uint32_t *green_channel_data, uint32_t *blue_channel_data, bool b_filled_graph, bool b_sepated_output)
+{
+    // function declaration
+    bool SaveHistogramImage( uint32_t *red_data, uint32_t *green_data, uint32_t *blue_data, bool b_filled_graph);
+    bool SaveSeparateHistogramImage( uint32_t *red_data, uint32_t *green_data, uint32_t *blue_data, bool b_filled_graph);
+
+    // variable declaration
+    int max_red = 0;
+    int max_green = 0;
+    int max_blue = 0;
+
+    bool result = true;
+
+    // code
+        // normalize image [0 - 256]
+    for( int i = 0; i < BIN_COUNT; ++i)
+    {
+        if( max_red < red_channel_data[i])
+        {
+            max_red = red_channel_data[i];
+        }
+
+        if( max_green < green_channel_data[i])
+        {
+            max_green = green_channel_data[i];
+        }
+
+        if( max_blue < blue_channel_data[i])
+        {
+            max_blue = blue_channel_data[i];
+        }
+    }
+
+    for( int i = 0; i < BIN_COUNT; ++i)
+    {
+        red_channel_data[i]   = ( (float)red_channel_data[i] / (float)max_red) * (OUT_IMAGE_HEIGHT - 1);
+        green_channel_data[i] = ( (float)green_channel_data[i] / (float)max_green) * (OUT_IMAGE_HEIGHT - 1);
+        blue_channel_data[i]  = ( (float)blue_channel_data[i] / (float)max_blue) * (OUT_IMAGE_HEIGHT - 1);
+    }
+
+
+    if( b_sepated_output)
+    {
+        result = SaveSeparateHistogramImage( red_channel_data, green_channel_data, blue_channel_data, b_filled_graph);
+    }
+    else
+    {
+        result = SaveHistogramImage( red_channel_data, green_channel_data, blue_channel_data, b_filled_graph);
+    }
+
+
+    return result;
+}
+
+/**
+ * @brief SaveHistogramImage()
+ */
+bool SaveHistogramImage( uint32_t *red_data, uint32_t *green_data, uint32_t *blue_data, bool b_filled_graph)
+{
+    // variable declaration
+    uint8_t *image_buffer = nullptr;
+
+    // code
+    image_buffer = new uint8_t[ OUT_IMAGE_WIDTH * OUT_IMAGE_HEIGHT * 3]();
+
+    for( int i = 0; i < BIN_COUNT; ++i)
+    {
+        int j;
+
+        if( b_filled_graph)
+        {
+            // red
+            for( j = 0; j < red_data[i]; ++j)
+            {
+                image_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 2] = 0xFF;
+            }
+
+            // green
+            for( j = 0; j < green_data[i]; ++j)
+            {
+                image_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 1] = 0xFF;
+            }
+
+            // blue
+            for( j = 0; j < blue_data[i]; ++j)
+            {
+                image_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 0] = 0xFF;
+            }
+        }
+        else
+        {
+            // red
+            j = red_data[i] - 1;
+            if( j >= 0)
+            {
+                image_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 2] = 0xFF;
+            }
+
+            // green
+            j = green_data[i] - 1;
+            if( j >= 0)
+            {
+                image_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 1] = 0xFF;
+            }
+
+            // blue
+            j = blue_data[i] - 1;
+            if( j >= 0)
+            {
+                image_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 0] = 0xFF;
+            }
+        }
+    }
+
+    // save image
+    std::string out_image = "out.png";
+    FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_image.c_str());
+    int row_pitch = 3 * OUT_IMAGE_WIDTH;
+    FIBITMAP *image = FreeImage_ConvertFromRawBits( image_buffer, OUT_IMAGE_WIDTH, OUT_IMAGE_HEIGHT, row_pitch, 24, 0xFF000000, 0x00FF0000, 0x0000FF00);
+    FreeImage_Save( format, image, out_image.c_str());
+    FreeImage_Unload( image);
+
+    delete[] image_buffer;
+    image_buffer = nullptr;
+
+    return true;
+}
+
+/**
+ * @brief SaveSeparateHistogramImage()
+ */
+bool SaveSeparateHistogramImage( uint32_t *red_data, uint32_t *green_data, uint32_t *blue_data, bool b_filled_graph)
+{
+    // variable declaration
+    uint8_t *image_red_buffer = nullptr;
+    uint8_t *image_green_buffer = nullptr;
+    uint8_t *image_blue_buffer = nullptr;
+
+    // code
+    image_red_buffer   = new uint8_t[ OUT_IMAGE_WIDTH * OUT_IMAGE_HEIGHT * 3]();
+    image_green_buffer = new uint8_t[ OUT_IMAGE_WIDTH * OUT_IMAGE_HEIGHT * 3]();
+    image_blue_buffer  = new uint8_t[ OUT_IMAGE_WIDTH * OUT_IMAGE_HEIGHT * 3]();
+
+    for( int i = 0; i < BIN_COUNT; ++i)
+    {
+        int j;
+
+        if( b_filled_graph)
+        {
+            // red
+            for( j = 0; j < red_data[i]; ++j)
+            {
+                image_red_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 2] = 0xFF;
+            }
+
+            // green
+            for( j = 0; j < green_data[i]; ++j)
+            {
+                image_green_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 1] = 0xFF;
+            }
+
+            // blue
+            for( j = 0; j < blue_data[i]; ++j)
+            {
+                image_blue_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 0] = 0xFF;
+            }
+        }
+        else
+        {
+            // red
+            j = red_data[i] - 1;
+            if( j >= 0)
+            {
+                image_red_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 2] = 0xFF;
+            }
+
+            // green
+            j = green_data[i] - 1;
+            if( j >= 0)
+            {
+                image_green_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 1] = 0xFF;
+            }
+
+            // blue
+            j = blue_data[i] - 1;
+            if( j >= 0)
+            {
+                image_blue_buffer[ 3 * (j * OUT_IMAGE_WIDTH + i) + 0] = 0xFF;
+            }
+        }
+    }
+
+    // save images
+    {
+        std::string out_image = "out_red.png";
+        FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_image.c_str());
+        int row_pitch = 3 * OUT_IMAGE_WIDTH;
+        FIBITMAP *image = FreeImage_ConvertFromRawBits( image_red_buffer, OUT_IMAGE_WIDTH, OUT_IMAGE_HEIGHT, row_pitch, 24, 0xFF000000, 0x00FF0000, 0x0000FF00);
+        FreeImage_Save( format, image, out_image.c_str());
+        FreeImage_Unload( image);
+    }
+
+    {
+        std::string out_image = "out_green.png";
+        FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_image.c_str());
+        int row_pitch = 3 * OUT_IMAGE_WIDTH;
+        FIBITMAP *image = FreeImage_ConvertFromRawBits( image_green_buffer, OUT_IMAGE_WIDTH, OUT_IMAGE_HEIGHT, row_pitch, 24, 0xFF000000, 0x00FF0000, 0x0000FF00);
+        FreeImage_Save( format, image, out_image.c_str());
+        FreeImage_Unload( image);
+    }
+
+    {
+        std::string out_image = "out_blue.png";
+        FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_image.c_str());
+        int row_pitch = 3 * OUT_IMAGE_WIDTH;
+        FIBITMAP *image = FreeImage_ConvertFromRawBits( image_blue_buffer, OUT_IMAGE_WIDTH, OUT_IMAGE_HEIGHT, row_pitch, 24, 0xFF000000, 0x00FF0000, 0x0000FF00);
+        FreeImage_Save( format, image, out_image.c_str());
+        FreeImage_Unload( image);
+    }
+
+    delete[] image_red_buffer;
+    image_red_buffer = nullptr;
+
+    delete[] image_green_buffer;
+    image_green_buffer = nullptr;
+
+    delete[] image_blue_buffer;
+    image_blue_buffer = nullptr;
+
+    return true;
+}
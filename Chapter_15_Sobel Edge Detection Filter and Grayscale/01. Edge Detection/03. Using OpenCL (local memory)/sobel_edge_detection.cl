@@ -0,0 +1,258 @@
+/************************
+ *
+ * The operator uses two 3x3 kernels which are convolved with the original image to compute derivatives,
+ * one for horizontal changes and another for vertical.
+ *
+ * Gx, the horizontal derivatives is,
+ *
+ *               [ -1  0  +1]
+ *          Gx = [ -2  0  +2]
+ *               [ -1  0  +1]
+ *
+ * Gy, the vertical derivatives is,
+ *
+ *               [ -1  -2  -1]
+ *          Gy = [  0   0   0]
+ *               [ +1  +2  +1]
+ *
+ *
+ * The gradient magnitude is computed as
+ *      G = sqrt( Gx^2 + Gy^2)
+ *
+ * Tiled variant:
+ *      A work-group of TILE_WIDTH x TILE_HEIGHT work-items produces TILE_WIDTH x ( TILE_HEIGHT * ROWS_PER_ITEM)
+ * output pixels. The input block plus a 1 pixel halo is loaded cooperatively into local memory once,
+ * every work-item then slides a 3x3 window down ROWS_PER_ITEM consecutive rows, so each step reads only
+ * one new row of three texels from local memory.
+ *
+ *      The work-group size must be ( TILE_WIDTH, TILE_HEIGHT).
+ *
+ * 8-bit integer variant ( sobel_edge_detection_tiled_int8):
+ *      The tile is cached as uchar4, Gx and Gy are computed in short ( | Gx |, | Gy | <= 4 * 255) and the
+ * magnitude is approximated without sqrt as
+ *      G ~= max( |Gx|, |Gy|) + 3/8 * min( |Gx|, |Gy|)      ( within 7% of the exact value)
+ * using saturating integer ops.
+ */
+
+#ifndef TILE_WIDTH
+    #define TILE_WIDTH      16
+#endif
+
+#ifndef TILE_HEIGHT
+    #define TILE_HEIGHT     16
+#endif
+
+#ifndef ROWS_PER_ITEM
+    #define ROWS_PER_ITEM   4
+#endif
+
+#define CACHE_WIDTH     ( TILE_WIDTH + 2)
+#define CACHE_HEIGHT    ( TILE_HEIGHT * ROWS_PER_ITEM + 2)
+
+const sampler_t sampler_ = CLK_NORMALIZED_COORDS_FALSE | CLK_ADDRESS_CLAMP_TO_EDGE | CLK_FILTER_NEAREST;
+
+/**
+ * @brief sobel_rows(): runs the 3x3 window down ROWS_PER_ITEM rows of the local cache
+ *                      and returns the gradient magnitude through out_g.
+ */
+inline void sobel_rows( __local const float4 *cache, float3 *out_g)
+{
+    // variable declaration
+    int lx = (int)get_local_id(0) + 1;
+    int ly = (int)get_local_id(1) * ROWS_PER_ITEM + 1;
+
+    __local const float4 *row = cache + ( ly - 1) * CACHE_WIDTH + lx;
+
+    // code
+        // window rows: top ( t), middle ( m), bottom ( b)
+    float3 t0 = row[-1].xyz, t1 = row[0].xyz, t2 = row[1].xyz;
+    row += CACHE_WIDTH;
+    float3 m0 = row[-1].xyz, m1 = row[0].xyz, m2 = row[1].xyz;
+
+    for( int r = 0; r < ROWS_PER_ITEM; ++r)
+    {
+        row += CACHE_WIDTH;
+        float3 b0 = row[-1].xyz, b1 = row[0].xyz, b2 = row[1].xyz;
+
+        float3 Gx = ( t2 - t0) + 2.0f * ( m2 - m0) + ( b2 - b0);
+        float3 Gy = ( b0 - t0) + 2.0f * ( b1 - t1) + ( b2 - t2);
+
+        out_g[r] = native_sqrt( Gx * Gx + Gy * Gy);
+
+        t0 = m0; t1 = m1; t2 = m2;
+        m0 = b0; m1 = b1; m2 = b2;
+    }
+}
+
+/**
+ * @brief sobel_edge_detection_tiled_image(): image input and output.
+ */
+__kernel void sobel_edge_detection_tiled_image( read_only image2d_t src, write_only image2d_t dst)
+{
+    // variable declaration
+    int width = get_image_width( src);
+    int height = get_image_height( src);
+
+    int tid = mad24( (int)get_local_id(1), TILE_WIDTH, (int)get_local_id(0));
+
+    int x0 = (int)get_group_id(0) * TILE_WIDTH - 1;
+    int y0 = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM - 1;
+
+    __local float4 cache[ CACHE_WIDTH * CACHE_HEIGHT];
+    float3 g[ ROWS_PER_ITEM];
+
+    // code
+        // cooperative load of block + halo, the sampler clamps at the image border
+    for( int i = tid; i < CACHE_WIDTH * CACHE_HEIGHT; i += TILE_WIDTH * TILE_HEIGHT)
+    {
+        int cy = i / CACHE_WIDTH;
+        int cx = i - cy * CACHE_WIDTH;
+
+        cache[i] = read_imagef( src, sampler_, (int2)( x0 + cx, y0 + cy));
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    sobel_rows( cache, g);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM + (int)get_local_id(1) * ROWS_PER_ITEM;
+
+    if( x >= width)
+    {
+        return;
+    }
+
+    for( int r = 0; r < ROWS_PER_ITEM; ++r)
+    {
+        if( y + r < height)
+        {
+            write_imagef( dst, (int2)( x, y + r), (float4)( g[r], 1.0f));
+        }
+    }
+}
+
+/**
+ * @brief sobel_edge_detection_tiled_buffer(): packed 8-bit BGRA buffer input and output.
+ */
+__kernel void sobel_edge_detection_tiled_buffer( __global const uchar4 *src, int width, int height, __global uchar4 *dst)
+{
+    // variable declaration
+    int tid = mad24( (int)get_local_id(1), TILE_WIDTH, (int)get_local_id(0));
+
+    int x0 = (int)get_group_id(0) * TILE_WIDTH - 1;
+    int y0 = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM - 1;
+
+    __local float4 cache[ CACHE_WIDTH * CACHE_HEIGHT];
+    float3 g[ ROWS_PER_ITEM];
+
+    // code
+        // cooperative load of block + halo, coordinates are clamped to the image border
+    for( int i = tid; i < CACHE_WIDTH * CACHE_HEIGHT; i += TILE_WIDTH * TILE_HEIGHT)
+    {
+        int cy = i / CACHE_WIDTH;
+        int cx = i - cy * CACHE_WIDTH;
+
+        int sx = clamp( x0 + cx, 0, width - 1);
+        int sy = clamp( y0 + cy, 0, height - 1);
+
+        cache[i] = convert_float4( src[ mad24( sy, width, sx)]) * ( 1.0f / 255.0f);
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    sobel_rows( cache, g);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM + (int)get_local_id(1) * ROWS_PER_ITEM;
+
+    if( x >= width)
+    {
+        return;
+    }
+
+    for( int r = 0; r < ROWS_PER_ITEM; ++r)
+    {
+        if( y + r < height)
+        {
+            uchar3 c = convert_uchar3_sat( g[r] * 255.0f + 0.5f);
+            dst[ mad24( y + r, width, x)] = (uchar4)( c, 255);
+        }
+    }
+}
+
+/**
+ * @brief sobel_magnitude_int8(): integer approximation of sqrt( Gx^2 + Gy^2), saturated to 8-bit.
+ */
+inline uchar3 sobel_magnitude_int8( short3 Gx, short3 Gy)
+{
+    // code
+    ushort3 ax = abs( Gx);
+    ushort3 ay = abs( Gy);
+
+    ushort3 hi = max( ax, ay);
+    ushort3 lo = min( ax, ay);
+
+    return convert_uchar3_sat( add_sat( hi, ( lo * (ushort)3) >> (ushort)3));
+}
+
+/**
+ * @brief sobel_edge_detection_tiled_int8(): packed 8-bit BGRA buffer input and output, integer arithmetic only.
+ */
+__kernel void sobel_edge_detection_tiled_int8( __global const uchar4 *src, int width, int height, __global uchar4 *dst)
+{
+    // variable declaration
+    int tid = mad24( (int)get_local_id(1), TILE_WIDTH, (int)get_local_id(0));
+
+    int x0 = (int)get_group_id(0) * TILE_WIDTH - 1;
+    int y0 = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM - 1;
+
+    __local uchar4 cache[ CACHE_WIDTH * CACHE_HEIGHT];
+
+    // code
+        // cooperative load of block + halo, coordinates are clamped to the image border
+    for( int i = tid; i < CACHE_WIDTH * CACHE_HEIGHT; i += TILE_WIDTH * TILE_HEIGHT)
+    {
+        int cy = i / CACHE_WIDTH;
+        int cx = i - cy * CACHE_WIDTH;
+
+        int sx = clamp( x0 + cx, 0, width - 1);
+        int sy = clamp( y0 + cy, 0, height - 1);
+
+        cache[i] = src[ mad24( sy, width, sx)];
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM + (int)get_local_id(1) * ROWS_PER_ITEM;
+
+    if( x >= width)
+    {
+        return;
+    }
+
+    __local const uchar4 *row = cache + (int)get_local_id(1) * ROWS_PER_ITEM * CACHE_WIDTH + (int)get_local_id(0) + 1;
+
+        // window rows: top ( t), middle ( m), bottom ( b)
+    short3 t0 = convert_short3( row[-1].xyz), t1 = convert_short3( row[0].xyz), t2 = convert_short3( row[1].xyz);
+    row += CACHE_WIDTH;
+    short3 m0 = convert_short3( row[-1].xyz), m1 = convert_short3( row[0].xyz), m2 = convert_short3( row[1].xyz);
+
+    for( int r = 0; r < ROWS_PER_ITEM; ++r)
+    {
+        row += CACHE_WIDTH;
+        short3 b0 = convert_short3( row[-1].xyz), b1 = convert_short3( row[0].xyz), b2 = convert_short3( row[1].xyz);
+
+        short3 Gx = ( t2 - t0) + ( ( m2 - m0) << (short)1) + ( b2 - b0);
+        short3 Gy = ( b0 - t0) + ( ( b1 - t1) << (short)1) + ( b2 - t2);
+
+        if( y + r < height)
+        {
+            dst[ mad24( y + r, width, x)] = (uchar4)( sobel_magnitude_int8( Gx, Gy), 255);
+        }
+
+        t0 = m0; t1 = m1; t2 = m2;
+        m0 = b0; m1 = b1; m2 = b2;
+    }
+}
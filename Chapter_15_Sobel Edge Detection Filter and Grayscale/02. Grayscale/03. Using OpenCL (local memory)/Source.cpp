@@ -0,0 +1,376 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * The operator uses two 3x3 kernels which are convolved with the original image to compute derivatives,
+ * one for horizontal changes and another for vertical.
+ *
+ * Gx, the horizontal derivatives is,
+ *
+ *               [ -1  0  +1]
+ *          Gx = [ -2  0  +2]
+ *               [ -1  0  +1]
+ *
+ * Gy, the vertical derivatives is,
+ *
+ *               [ -1  -2  -1]
+ *          Gy = [  0   0   0]
+ *               [ +1  +2  +1]
+ *
+ *
+ * Local memory variant: each work-group caches its input block plus a 1 pixel halo in local memory,
+ * each work-item computes ROWS_PER_ITEM output pixels. Input can be an image ( default) or
+ * a packed 8-bit BGRA buffer ( --buffer).
+ *
+ * --int8 selects the integer path: packed 8-bit buffers, gradients in short and a saturating
+ * integer approximation of the magnitude, single-channel 8-bit output.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+
+#include "OpenCLUtil.h"
+
+#include "../../../Common/FreeImage/x64/FreeImage.h"
+
+#define To_String(x) #x
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+    // must match the defaults in sobel_grayscale.cl
+const int TILE_WIDTH = 16;
+const int TILE_HEIGHT = 16;
+const int ROWS_PER_ITEM = 4;
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_command_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+cl_program ocl_program = nullptr;
+
+cl_kernel sobel_grayscale = nullptr;
+
+cl_mem ocl_input = nullptr;
+cl_mem ocl_output = nullptr;
+
+uint8_t *image_bits = nullptr;
+uint8_t *output_image_bits = nullptr;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool SaveImage( const char *out_file_name, uint8_t *image_data, int image_width, int image_height, int bits_per_pixel);
+    uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height);
+    void  cleanup();
+
+    // variable declaration
+    int image_width = 0;
+    int image_height = 0;
+
+    bool b_use_buffer = false;
+    bool b_use_int8 = false;
+    int num_iterations = 1;
+
+    std::string input_image;
+
+    cl_int ocl_err;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--input") && (i + 1 < argc))
+        {
+            input_image = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--buffer"))
+        {
+            b_use_buffer = true;
+        }
+        else if( !input.compare( "--int8"))
+        {
+            b_use_buffer = true;
+            b_use_int8 = true;
+        }
+        else if( !input.compare( "--iterations") && (i + 1 < argc))
+        {
+            num_iterations = std::max( 1, atoi( argv[++i]));
+        }
+    }
+
+    if( input_image.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " --input <input_image_name>\n";
+        std::cerr << "options: " << "\n"
+                  << "   --buffer: use packed 8-bit buffers instead of images\n"
+                  << "   --int8: integer Sobel on packed 8-bit buffers with single-channel output\n"
+                  << "   --iterations <n>: number of timed kernel launches (default 1)"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( 0);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_command_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_command_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_program = CreateProgram( ocl_context, ocl_device, "sobel_grayscale.cl");
+    if( ocl_program == nullptr)
+    {
+        std::cerr << "CreateProgram() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    const char *kernel_name = b_use_int8 ? "sobel_grayscale_tiled_int8" : ( b_use_buffer ? "sobel_grayscale_tiled_buffer" : "sobel_grayscale_tiled_image");
+
+    sobel_grayscale = clCreateKernel( ocl_program, kernel_name, &ocl_err);
+    if( !sobel_grayscale || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    size_t workgroup_size;
+    clGetKernelWorkGroupInfo( sobel_grayscale, ocl_device, CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &workgroup_size, nullptr);
+    if( workgroup_size < TILE_WIDTH * TILE_HEIGHT)
+    {
+        std::cerr << "A minimum of " << TILE_WIDTH * TILE_HEIGHT << " work-items in work-group needed for tiled sobel kernel. \n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** IMAGE LOADING ***********/
+    image_bits = LoadImage( input_image.c_str(), &image_width, &image_height);
+    if( image_bits == nullptr)
+    {
+        std::cerr << "Cannot open image \"" << input_image << "\"" << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    size_t image_size = (size_t)image_width * image_height * 4;
+
+        // the integer path writes one gray byte per pixel
+    size_t output_size = b_use_int8 ? (size_t)image_width * image_height : image_size;
+
+    if( b_use_buffer)
+    {
+        ocl_input = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, image_size, image_bits, &ocl_err);
+        if( !ocl_input || ocl_err)
+        {
+            std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        ocl_output = clCreateBuffer( ocl_context, CL_MEM_WRITE_ONLY, output_size, nullptr, &ocl_err);
+        if( !ocl_output || ocl_err)
+        {
+            std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        ocl_err = clSetKernelArg( sobel_grayscale, 0, sizeof( cl_mem), &ocl_input);
+        ocl_err |= clSetKernelArg( sobel_grayscale, 1, sizeof( int), &image_width);
+        ocl_err |= clSetKernelArg( sobel_grayscale, 2, sizeof( int), &image_height);
+        ocl_err |= clSetKernelArg( sobel_grayscale, 3, sizeof( cl_mem), &ocl_output);
+    }
+    else
+    {
+        cl_image_format ocl_image_format = { };
+        ocl_image_format.image_channel_order = CL_BGRA;
+        ocl_image_format.image_channel_data_type = CL_UNORM_INT8;
+
+        cl_image_desc ocl_image_desc = { };
+        ocl_image_desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+        ocl_image_desc.image_width = image_width;
+        ocl_image_desc.image_height = image_height;
+        ocl_image_desc.image_row_pitch = image_width * 4;
+        ocl_image_desc.mem_object = nullptr;
+
+        ocl_input = clCreateImage( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, &ocl_image_format, &ocl_image_desc, image_bits, &ocl_err);
+        if( !ocl_input || ocl_err)
+        {
+            std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        ocl_image_desc.image_row_pitch = 0;
+        ocl_output = clCreateImage( ocl_context, CL_MEM_WRITE_ONLY, &ocl_image_format, &ocl_image_desc, nullptr, &ocl_err);
+        if( !ocl_output || ocl_err)
+        {
+            std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        ocl_err = clSetKernelArg( sobel_grayscale, 0, sizeof( cl_mem), &ocl_input);
+        ocl_err |= clSetKernelArg( sobel_grayscale, 1, sizeof( cl_mem), &ocl_output);
+    }
+
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clSetKernelArg() Failed.\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        // each work-group covers TILE_WIDTH x ( TILE_HEIGHT * ROWS_PER_ITEM) pixels
+    size_t local_work_size[2] = { TILE_WIDTH, TILE_HEIGHT};
+    size_t global_work_size[2];
+
+    global_work_size[0] = ( ( image_width + TILE_WIDTH - 1) / TILE_WIDTH) * TILE_WIDTH;
+    global_work_size[1] = ( ( image_height + TILE_HEIGHT * ROWS_PER_ITEM - 1) / ( TILE_HEIGHT * ROWS_PER_ITEM)) * TILE_HEIGHT;
+
+    std::cout << To_String( image_width) << " : " << image_width << "\n";
+    std::cout << To_String( image_height) << " : " << image_height << "\n\n";
+
+    std::cout << To_String( global_work_size[0]) << " : " << global_work_size[0] << "\n";
+    std::cout << To_String( global_work_size[1]) << " : " << global_work_size[1] << "\n\n";
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < num_iterations; ++i)
+    {
+        ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, sobel_grayscale, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    }
+    clFinish( ocl_command_queue);
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  elapsed_seconds = ( end - start) / num_iterations;
+    std::cout << "Time Required for Sobel Grayscale by OpenCL is: " << elapsed_seconds.count() << "s" << std::endl;
+
+        // read result
+    output_image_bits = new uint8_t[ output_size];
+
+    if( b_use_buffer)
+    {
+        ocl_err = clEnqueueReadBuffer( ocl_command_queue, ocl_output, CL_TRUE, 0, output_size, output_image_bits, 0, nullptr, nullptr);
+    }
+    else
+    {
+        size_t origin[3] = { 0, 0, 0};
+        size_t region[3] = { (size_t)image_width, (size_t)image_height, 1};
+        size_t row_pitch = image_width * 4;
+
+        ocl_err = clEnqueueReadImage( ocl_command_queue, ocl_output, CL_TRUE, origin, region, row_pitch, 0, output_image_bits, 0, nullptr, nullptr);
+    }
+
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "Reading result Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    SaveImage( "Out.png", output_image_bits, image_width, image_height, b_use_int8 ? 8 : 32);
+
+    cleanup();
+
+    return 0;
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // code
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+    RELEASE_CL_OBJECT( ocl_command_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+    RELEASE_CL_OBJECT( sobel_grayscale, clReleaseKernel);
+    RELEASE_CL_OBJECT( ocl_input, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_output, clReleaseMemObject);
+    RELEASE_CL_OBJECT( image_bits, delete[]);
+    RELEASE_CL_OBJECT( output_image_bits, delete[]);
+}
+
+/**
+ * @brief LoadImage() : Load Image and returns image width, image height and image data in 32-bit format. Delete image data when work is done.
+ */
+uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height)
+{
+    // code
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( file_name, 0);
+    FIBITMAP *image = FreeImage_Load( format, file_name);
+    if( image == nullptr)
+    {
+        *image_width = 0;
+        *image_height = 0;
+        return nullptr;
+    }
+
+        // convert to 32-bit image
+    FIBITMAP *temp = image;
+    image = FreeImage_ConvertTo32Bits( image);
+    FreeImage_Unload( temp);
+
+    *image_width = FreeImage_GetWidth( image);
+    *image_height = FreeImage_GetHeight( image);
+
+    uint8_t *image_bits = FreeImage_GetBits( image);
+
+    uint8_t *ret_image_bits = new uint8_t[ (*image_width) * (*image_height) * 4];
+    memcpy( ret_image_bits, image_bits, (*image_width) * (*image_height) * 4 * sizeof( uint8_t));
+
+    FreeImage_Unload( image);
+
+    return ret_image_bits;
+}
+
+/**
+ * @brief SaveImage() : bits_per_pixel is 32 for BGRA data or 8 for single-channel gray data.
+ */
+bool SaveImage( const char *out_file_name, uint8_t *image_bits, int image_width, int image_height, int bits_per_pixel)
+{
+    // save image
+    FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_file_name);
+    if( format == FREE_IMAGE_FORMAT::FIF_UNKNOWN)
+    {
+        return false;
+    }
+
+    int row_pitch = ( bits_per_pixel / 8) * image_width;
+    FIBITMAP *image = FreeImage_ConvertFromRawBits( image_bits, image_width, image_height, row_pitch, bits_per_pixel, 0xFF000000, 0x00FF0000, 0x0000FF00);
+    FreeImage_Save( format, image, out_file_name);
+    FreeImage_Unload( image);
+
+    return true;
+}
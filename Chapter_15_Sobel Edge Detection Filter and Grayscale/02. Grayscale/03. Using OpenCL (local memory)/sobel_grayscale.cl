@@ -0,0 +1,259 @@
+/************************
+ *
+ * The operator uses two 3x3 kernels which are convolved with the original image to compute derivatives,
+ * one for horizontal changes and another for vertical.
+ *
+ * Gx, the horizontal derivatives is,
+ *
+ *               [ -1  0  +1]
+ *          Gx = [ -2  0  +2]
+ *               [ -1  0  +1]
+ *
+ * Gy, the vertical derivatives is,
+ *
+ *               [ -1  -2  -1]
+ *          Gy = [  0   0   0]
+ *               [ +1  +2  +1]
+ *
+ *
+ * Tiled variant:
+ *      A work-group of TILE_WIDTH x TILE_HEIGHT work-items produces TILE_WIDTH x ( TILE_HEIGHT * ROWS_PER_ITEM)
+ * output pixels. The input block plus a 1 pixel halo is loaded cooperatively into local memory once,
+ * every work-item then slides a 3x3 window down ROWS_PER_ITEM consecutive rows, so each step reads only
+ * one new row of three texels from local memory.
+ *      Sobel is linear, so the channels are averaged while loading and only one float per texel is cached.
+ *
+ *      The work-group size must be ( TILE_WIDTH, TILE_HEIGHT).
+ *
+ * 8-bit integer variant ( sobel_grayscale_tiled_int8):
+ *      The gray value is computed as ( ( B + G + R) * 85 + 128) >> 8 ( ~0.3333 * sum) and cached as uchar,
+ * Gx and Gy are computed in short and the magnitude is approximated without sqrt as
+ *      G ~= max( |Gx|, |Gy|) + 3/8 * min( |Gx|, |Gy|)      ( within 7% of the exact value)
+ * using saturating integer ops. The output is a single-channel uchar buffer, a quarter of the BGRA output.
+ */
+
+#ifndef TILE_WIDTH
+    #define TILE_WIDTH      16
+#endif
+
+#ifndef TILE_HEIGHT
+    #define TILE_HEIGHT     16
+#endif
+
+#ifndef ROWS_PER_ITEM
+    #define ROWS_PER_ITEM   4
+#endif
+
+#define CACHE_WIDTH     ( TILE_WIDTH + 2)
+#define CACHE_HEIGHT    ( TILE_HEIGHT * ROWS_PER_ITEM + 2)
+
+const sampler_t sampler_ = CLK_NORMALIZED_COORDS_FALSE | CLK_ADDRESS_CLAMP_TO_EDGE | CLK_FILTER_NEAREST;
+
+/**
+ * @brief sobel_rows(): runs the 3x3 window down ROWS_PER_ITEM rows of the local cache
+ *                      and returns the gradient magnitude through out_g.
+ */
+inline void sobel_rows( __local const float *cache, float *out_g)
+{
+    // variable declaration
+    int lx = (int)get_local_id(0) + 1;
+    int ly = (int)get_local_id(1) * ROWS_PER_ITEM + 1;
+
+    __local const float *row = cache + ( ly - 1) * CACHE_WIDTH + lx;
+
+    // code
+        // window rows: top ( t), middle ( m), bottom ( b)
+    float t0 = row[-1], t1 = row[0], t2 = row[1];
+    row += CACHE_WIDTH;
+    float m0 = row[-1], m1 = row[0], m2 = row[1];
+
+    for( int r = 0; r < ROWS_PER_ITEM; ++r)
+    {
+        row += CACHE_WIDTH;
+        float b0 = row[-1], b1 = row[0], b2 = row[1];
+
+        float Gx = ( t2 - t0) + 2.0f * ( m2 - m0) + ( b2 - b0);
+        float Gy = ( b0 - t0) + 2.0f * ( b1 - t1) + ( b2 - t2);
+
+        out_g[r] = native_sqrt( Gx * Gx + Gy * Gy);
+
+        t0 = m0; t1 = m1; t2 = m2;
+        m0 = b0; m1 = b1; m2 = b2;
+    }
+}
+
+/**
+ * @brief sobel_grayscale_tiled_image(): image input and output.
+ */
+__kernel void sobel_grayscale_tiled_image( read_only image2d_t src, write_only image2d_t dst)
+{
+    // variable declaration
+    int width = get_image_width( src);
+    int height = get_image_height( src);
+
+    int tid = mad24( (int)get_local_id(1), TILE_WIDTH, (int)get_local_id(0));
+
+    int x0 = (int)get_group_id(0) * TILE_WIDTH - 1;
+    int y0 = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM - 1;
+
+    __local float cache[ CACHE_WIDTH * CACHE_HEIGHT];
+    float g[ ROWS_PER_ITEM];
+
+    // code
+        // cooperative load of block + halo, the sampler clamps at the image border
+    for( int i = tid; i < CACHE_WIDTH * CACHE_HEIGHT; i += TILE_WIDTH * TILE_HEIGHT)
+    {
+        int cy = i / CACHE_WIDTH;
+        int cx = i - cy * CACHE_WIDTH;
+
+        float4 clr = read_imagef( src, sampler_, (int2)( x0 + cx, y0 + cy));
+        cache[i] = 0.3333f * ( clr.x + clr.y + clr.z);
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    sobel_rows( cache, g);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM + (int)get_local_id(1) * ROWS_PER_ITEM;
+
+    if( x >= width)
+    {
+        return;
+    }
+
+    for( int r = 0; r < ROWS_PER_ITEM; ++r)
+    {
+        if( y + r < height)
+        {
+            write_imagef( dst, (int2)( x, y + r), (float4)( g[r], g[r], g[r], 1.0f));
+        }
+    }
+}
+
+/**
+ * @brief sobel_grayscale_tiled_buffer(): packed 8-bit BGRA buffer input and output.
+ */
+__kernel void sobel_grayscale_tiled_buffer( __global const uchar4 *src, int width, int height, __global uchar4 *dst)
+{
+    // variable declaration
+    int tid = mad24( (int)get_local_id(1), TILE_WIDTH, (int)get_local_id(0));
+
+    int x0 = (int)get_group_id(0) * TILE_WIDTH - 1;
+    int y0 = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM - 1;
+
+    __local float cache[ CACHE_WIDTH * CACHE_HEIGHT];
+    float g[ ROWS_PER_ITEM];
+
+    // code
+        // cooperative load of block + halo, coordinates are clamped to the image border
+    for( int i = tid; i < CACHE_WIDTH * CACHE_HEIGHT; i += TILE_WIDTH * TILE_HEIGHT)
+    {
+        int cy = i / CACHE_WIDTH;
+        int cx = i - cy * CACHE_WIDTH;
+
+        int sx = clamp( x0 + cx, 0, width - 1);
+        int sy = clamp( y0 + cy, 0, height - 1);
+
+        float4 clr = convert_float4( src[ mad24( sy, width, sx)]);
+        cache[i] = ( 0.3333f / 255.0f) * ( clr.x + clr.y + clr.z);
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    sobel_rows( cache, g);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM + (int)get_local_id(1) * ROWS_PER_ITEM;
+
+    if( x >= width)
+    {
+        return;
+    }
+
+    for( int r = 0; r < ROWS_PER_ITEM; ++r)
+    {
+        if( y + r < height)
+        {
+            uchar c = convert_uchar_sat( g[r] * 255.0f + 0.5f);
+            dst[ mad24( y + r, width, x)] = (uchar4)( c, c, c, 255);
+        }
+    }
+}
+
+/**
+ * @brief sobel_magnitude_int8(): integer approximation of sqrt( Gx^2 + Gy^2), saturated to 8-bit.
+ */
+inline uchar sobel_magnitude_int8( short Gx, short Gy)
+{
+    // code
+    ushort ax = abs( Gx);
+    ushort ay = abs( Gy);
+
+    ushort hi = max( ax, ay);
+    ushort lo = min( ax, ay);
+
+    return convert_uchar_sat( add_sat( hi, (ushort)( ( lo * 3) >> 3)));
+}
+
+/**
+ * @brief sobel_grayscale_tiled_int8(): packed 8-bit BGRA buffer input, single-channel 8-bit output, integer arithmetic only.
+ */
+__kernel void sobel_grayscale_tiled_int8( __global const uchar4 *src, int width, int height, __global uchar *dst)
+{
+    // variable declaration
+    int tid = mad24( (int)get_local_id(1), TILE_WIDTH, (int)get_local_id(0));
+
+    int x0 = (int)get_group_id(0) * TILE_WIDTH - 1;
+    int y0 = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM - 1;
+
+    __local uchar cache[ CACHE_WIDTH * CACHE_HEIGHT];
+
+    // code
+        // cooperative load of block + halo, coordinates are clamped to the image border
+    for( int i = tid; i < CACHE_WIDTH * CACHE_HEIGHT; i += TILE_WIDTH * TILE_HEIGHT)
+    {
+        int cy = i / CACHE_WIDTH;
+        int cx = i - cy * CACHE_WIDTH;
+
+        int sx = clamp( x0 + cx, 0, width - 1);
+        int sy = clamp( y0 + cy, 0, height - 1);
+
+        uchar4 clr = src[ mad24( sy, width, sx)];
+        cache[i] = (uchar)( mad24( (int)clr.x + (int)clr.y + (int)clr.z, 85, 128) >> 8);
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_group_id(1) * TILE_HEIGHT * ROWS_PER_ITEM + (int)get_local_id(1) * ROWS_PER_ITEM;
+
+    if( x >= width)
+    {
+        return;
+    }
+
+    __local const uchar *row = cache + (int)get_local_id(1) * ROWS_PER_ITEM * CACHE_WIDTH + (int)get_local_id(0) + 1;
+
+        // window rows: top ( t), middle ( m), bottom ( b)
+    short t0 = row[-1], t1 = row[0], t2 = row[1];
+    row += CACHE_WIDTH;
+    short m0 = row[-1], m1 = row[0], m2 = row[1];
+
+    for( int r = 0; r < ROWS_PER_ITEM; ++r)
+    {
+        row += CACHE_WIDTH;
+        short b0 = row[-1], b1 = row[0], b2 = row[1];
+
+        short Gx = ( t2 - t0) + 2 * ( m2 - m0) + ( b2 - b0);
+        short Gy = ( b0 - t0) + 2 * ( b1 - t1) + ( b2 - t2);
+
+        if( y + r < height)
+        {
+            dst[ mad24( y + r, width, x)] = sobel_magnitude_int8( Gx, Gy);
+        }
+
+        t0 = m0; t1 = m1; t2 = m2;
+        m0 = b0; m1 = b1; m2 = b2;
+    }
+}
@@ -0,0 +1,336 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <algorithm>
+
+#include <cmath>
+
+#if defined(_M_X64) || defined(__SSE2__)
+    #include <emmintrin.h>
+    #define SOBEL_USE_SSE2 1
+#endif
+
+#include "../../../Common/FreeImage/x64/FreeImage.h"
+
+/************************
+ *
+ * The operator uses two 3x3 kernels which are convolved with the original image to compute derivatives,
+ * one for horizontal changes and another for vertical.
+ *
+ * Gx, the horizontal derivatives is,
+ *
+ *               [ -1  0  +1]
+ *          Gx = [ -2  0  +2]
+ *               [ -1  0  +1]
+ *
+ * Gy, the vertical derivatives is,
+ *
+ *               [ -1  -2  -1]
+ *          Gy = [  0   0   0]
+ *               [ +1  +2  +1]
+ *
+ *
+ * The gradient magnitude is computed as
+ *      G = sqrt( Gx^2 + Gy^2)
+ *
+ * Grayscale variant, Sobel runs on gs = 0.3333 * ( R + G + B) and writes G to all three channels.
+ *
+ * Multithreaded variant:
+ *  - rows are processed in bands, threads pull the next band from a shared counter.
+ *  - every thread keeps a sliding window of 3 padded gray rows ( R + G + B in 16-bit, 1 replicated
+ *    value on each side), so the border clamp is done once per row and the inner loop has no bounds checks.
+ *  - the inner loop computes 8 pixels per step with SSE2 in 16-bit integers.
+ */
+
+const int ROWS_PER_BAND = 32;
+
+    // 0.3333 for the gray average, the 1 / 255 of the input and the * 255 of the output cancel
+const float GRAY_SCALE = 0.3333f;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool SaveImage( const char *out_file_name, uint8_t *image_data, int image_width, int image_height);
+    uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height);
+    void SobelGrayscaleThreaded( const uint8_t *image_bits, int image_width, int image_height, unsigned int num_threads, uint8_t *output_image_bits);
+
+    // variable declaration
+    uint8_t *image_bits = nullptr;
+    uint8_t *output_image_bits = nullptr;
+    int image_width = 0;
+    int image_height = 0;
+
+    unsigned int num_threads = std::max( 1u, std::thread::hardware_concurrency());
+    int num_iterations = 10;
+
+    std::string input_image;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--input") && (i + 1 < argc))
+        {
+            input_image = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--threads") && (i + 1 < argc))
+        {
+            num_threads = std::max( 1, atoi( argv[++i]));
+        }
+        else if( !input.compare( "--iterations") && (i + 1 < argc))
+        {
+            num_iterations = std::max( 1, atoi( argv[++i]));
+        }
+    }
+
+    if( input_image.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " --input <input_image_name>\n";
+        std::cerr << "options: " << "\n"
+                  << "   --threads <n>: number of host threads (default: hardware concurrency)\n"
+                  << "   --iterations <n>: number of timed runs (default 10)"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+        /******** IMAGE LOADING ***********/
+    image_bits = LoadImage( input_image.c_str(), &image_width, &image_height);
+    if( image_bits == nullptr)
+    {
+        std::cerr << "Cannot open image \"" << input_image << "\"" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    output_image_bits = new uint8_t[ image_width * image_height * 4];
+
+        /***************** START COMPUTATION **********************/
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < num_iterations; ++i)
+    {
+        SobelGrayscaleThreaded( image_bits, image_width, image_height, num_threads, output_image_bits);
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  elapsed_seconds = ( end - start) / num_iterations;
+
+        // one read and one write of the image per run
+    double traffic_gb = 2.0 * image_width * image_height * 4 / 1.0e9;
+
+    std::cout << "Threads : " << num_threads << "\n";
+    std::cout << "Time Required for Sobel Grayscale by CPU is: " << elapsed_seconds.count() << "s ("
+              << traffic_gb / elapsed_seconds.count() << " GB/s)" << std::endl;
+
+    SaveImage( "out.png", output_image_bits, image_width, image_height);
+
+    delete[] output_image_bits;
+    delete[] image_bits;
+
+    return EXIT_SUCCESS;
+}
+
+/**
+ * @brief GrayRow() : sum B + G + R of one BGRA row into 16-bit, replicating the first and last value on either side.
+ */
+inline void GrayRow( const uint8_t *src_row, int image_width, int16_t *padded_row)
+{
+    // code
+    for( int x = 0; x < image_width; ++x)
+    {
+        padded_row[ x + 1] = (int16_t)( src_row[ 4 * x + 0] + src_row[ 4 * x + 1] + src_row[ 4 * x + 2]);
+    }
+    padded_row[0] = padded_row[1];
+    padded_row[ image_width + 1] = padded_row[ image_width];
+}
+
+/**
+ * @brief GrayPixel() : scalar Sobel for one pixel, t/m/b point at the left neighbour in the padded rows.
+ */
+inline uint32_t GrayPixel( const int16_t *t, const int16_t *m, const int16_t *b)
+{
+    // code
+    int gx = ( t[2] - t[0]) + 2 * ( m[2] - m[0]) + ( b[2] - b[0]);
+    int gy = ( b[0] - t[0]) + 2 * ( b[1] - t[1]) + ( b[2] - t[2]);
+
+    float g = GRAY_SCALE * sqrtf( (float)( gx * gx + gy * gy));
+    uint32_t v = (uint32_t)std::min( g + 0.5f, 255.0f);
+
+    return 0xFF000000 | ( v << 16) | ( v << 8) | v;
+}
+
+/**
+ * @brief SobelRow() : one output row from three padded gray rows.
+ */
+void SobelRow( const int16_t *t, const int16_t *m, const int16_t *b, int image_width, uint8_t *out)
+{
+    // variable declaration
+    uint32_t *out_pixels = (uint32_t *)out;
+    int x = 0;
+
+    // code
+#if SOBEL_USE_SSE2
+    const __m128 scale = _mm_set1_ps( GRAY_SCALE);
+    const __m128i alpha = _mm_set1_epi32( (int)0xFF000000);
+
+    for( ; x + 8 <= image_width; x += 8)
+    {
+            // left ( 0), center ( 1) and right ( 2) neighbours of 8 pixels
+        __m128i t0 = _mm_loadu_si128( (const __m128i *)( t + x));
+        __m128i t1 = _mm_loadu_si128( (const __m128i *)( t + x + 1));
+        __m128i t2 = _mm_loadu_si128( (const __m128i *)( t + x + 2));
+        __m128i m0 = _mm_loadu_si128( (const __m128i *)( m + x));
+        __m128i m2 = _mm_loadu_si128( (const __m128i *)( m + x + 2));
+        __m128i b0 = _mm_loadu_si128( (const __m128i *)( b + x));
+        __m128i b1 = _mm_loadu_si128( (const __m128i *)( b + x + 1));
+        __m128i b2 = _mm_loadu_si128( (const __m128i *)( b + x + 2));
+
+            // | gx |, | gy | <= 4 * 765, fits in 16-bit
+        __m128i gx = _mm_add_epi16( _mm_add_epi16( _mm_sub_epi16( t2, t0), _mm_slli_epi16( _mm_sub_epi16( m2, m0), 1)), _mm_sub_epi16( b2, b0));
+        __m128i gy = _mm_add_epi16( _mm_add_epi16( _mm_sub_epi16( b0, t0), _mm_slli_epi16( _mm_sub_epi16( b1, t1), 1)), _mm_sub_epi16( b2, t2));
+
+        __m128 fx_lo = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( gx, gx), 16));
+        __m128 fx_hi = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( gx, gx), 16));
+        __m128 fy_lo = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpacklo_epi16( gy, gy), 16));
+        __m128 fy_hi = _mm_cvtepi32_ps( _mm_srai_epi32( _mm_unpackhi_epi16( gy, gy), 16));
+
+        __m128 g_lo = _mm_mul_ps( scale, _mm_sqrt_ps( _mm_add_ps( _mm_mul_ps( fx_lo, fx_lo), _mm_mul_ps( fy_lo, fy_lo))));
+        __m128 g_hi = _mm_mul_ps( scale, _mm_sqrt_ps( _mm_add_ps( _mm_mul_ps( fx_hi, fx_hi), _mm_mul_ps( fy_hi, fy_hi))));
+
+            // saturate to 8-bit, then v -> ( v, v, v, 255)
+        __m128i v16 = _mm_packs_epi32( _mm_cvtps_epi32( g_lo), _mm_cvtps_epi32( g_hi));
+        __m128i v8 = _mm_packus_epi16( v16, v16);
+
+        __m128i vv = _mm_unpacklo_epi8( v8, v8);
+        __m128i lo = _mm_or_si128( _mm_unpacklo_epi16( vv, vv), alpha);
+        __m128i hi = _mm_or_si128( _mm_unpackhi_epi16( vv, vv), alpha);
+
+        _mm_storeu_si128( (__m128i *)( out_pixels + x), lo);
+        _mm_storeu_si128( (__m128i *)( out_pixels + x + 4), hi);
+    }
+#endif
+
+    for( ; x < image_width; ++x)
+    {
+        out_pixels[x] = GrayPixel( t + x, m + x, b + x);
+    }
+}
+
+/**
+ * @brief SobelGrayscaleThreaded() : grayscale Sobel over row bands on num_threads threads.
+ */
+void SobelGrayscaleThreaded( const uint8_t *image_bits, int image_width, int image_height, unsigned int num_threads, uint8_t *output_image_bits)
+{
+    // variable declaration
+    std::atomic<int> next_band( 0);
+    std::vector<std::thread> threads;
+
+    int num_bands = ( image_height + ROWS_PER_BAND - 1) / ROWS_PER_BAND;
+    size_t row_bytes = (size_t)image_width * 4;
+    size_t padded_row_size = (size_t)image_width + 2;
+
+    // code
+    auto worker = [&]()
+    {
+        std::vector<int16_t> window( 3 * padded_row_size);
+        int16_t *rows[3] = { window.data(), window.data() + padded_row_size, window.data() + 2 * padded_row_size};
+
+        for( int band = next_band++; band < num_bands; band = next_band++)
+        {
+            int y_begin = band * ROWS_PER_BAND;
+            int y_end = std::min( y_begin + ROWS_PER_BAND, image_height);
+
+                // prime the window with rows y - 1 and y ( clamped)
+            GrayRow( image_bits + std::max( y_begin - 1, 0) * row_bytes, image_width, rows[0]);
+            GrayRow( image_bits + y_begin * row_bytes, image_width, rows[1]);
+
+            for( int y = y_begin; y < y_end; ++y)
+            {
+                GrayRow( image_bits + std::min( y + 1, image_height - 1) * row_bytes, image_width, rows[2]);
+
+                SobelRow( rows[0], rows[1], rows[2], image_width, output_image_bits + y * row_bytes);
+
+                    // slide the window down one row
+                int16_t *tmp = rows[0];
+                rows[0] = rows[1];
+                rows[1] = rows[2];
+                rows[2] = tmp;
+            }
+        }
+    };
+
+    for( unsigned int t = 0; t < num_threads; ++t)
+    {
+        threads.emplace_back( worker);
+    }
+
+    for( std::thread &thread : threads)
+    {
+        thread.join();
+    }
+}
+
+/**
+ * @brief LoadImage() : Load Image and returns image width, image height and image data in 32-bit format. Delete image data when work is done.
+ */
+uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height)
+{
+    // code
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( file_name, 0);
+    FIBITMAP *image = FreeImage_Load( format, file_name);
+    if( image == nullptr)
+    {
+        *image_width = 0;
+        *image_height = 0;
+        return nullptr;
+    }
+
+        // convert to 32-bit image
+    FIBITMAP *temp = image;
+    image = FreeImage_ConvertTo32Bits( image);
+    FreeImage_Unload( temp);
+
+    *image_width = FreeImage_GetWidth( image);
+    *image_height = FreeImage_GetHeight( image);
+
+    uint8_t *image_bits = FreeImage_GetBits( image);
+
+    uint8_t *ret_image_bits = new uint8_t[ (*image_width) * (*image_height) * 4];
+    memcpy( ret_image_bits, image_bits, (*image_width) * (*image_height) * 4 * sizeof( uint8_t));
+
+    FreeImage_Unload( image);
+
+    return ret_image_bits;
+}
+
+/**
+ * @brief SaveImage()
+ */
+bool SaveImage( const char *out_file_name, uint8_t *image_bits, int image_width, int image_height)
+{
+    // save image
+    FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_file_name);
+    if( format == FREE_IMAGE_FORMAT::FIF_UNKNOWN)
+    {
+        return false;
+    }
+
+    int row_pitch = 4 * image_width;
+    FIBITMAP *image = FreeImage_ConvertFromRawBits( image_bits, image_width, image_height, row_pitch, 32, 0xFF000000, 0x00FF0000, 0x0000FF00);
+    FreeImage_Save( format, image, out_file_name);
+    FreeImage_Unload( image);
+
+    return true;
+}
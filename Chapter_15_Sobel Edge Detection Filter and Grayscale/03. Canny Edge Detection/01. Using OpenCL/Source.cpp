@@ -0,0 +1,404 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * Canny edge detector on the device.
+ *
+ *      grayscale + Gaussian + Sobel ( one fused pass) -> non-maximum suppression + double threshold
+ *      -> hysteresis ( iterative label propagation) -> edge map
+ *
+ * Gradient magnitude, direction and labels stay in device memory, only the final edge map is read back.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <algorithm>
+
+#include "OpenCLUtil.h"
+
+#include "../../../Common/FreeImage/x64/FreeImage.h"
+
+#define To_String(x) #x
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+    // must match canny.cl
+const int TILE_SIZE = 16;
+const int MAX_HYSTERESIS_ITERATIONS = 1000;
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_command_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+cl_program ocl_program = nullptr;
+
+cl_kernel canny_gradient = nullptr;
+cl_kernel canny_nms = nullptr;
+cl_kernel canny_hysteresis = nullptr;
+cl_kernel canny_output = nullptr;
+
+cl_mem ocl_input = nullptr;
+cl_mem ocl_magnitude = nullptr;
+cl_mem ocl_direction = nullptr;
+cl_mem ocl_labels = nullptr;
+cl_mem ocl_changed = nullptr;
+cl_mem ocl_output = nullptr;
+
+uint8_t *image_bits = nullptr;
+uint8_t *output_image_bits = nullptr;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool SaveImage( const char *out_file_name, uint8_t *image_data, int image_width, int image_height);
+    uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height);
+    void  cleanup();
+
+    // variable declaration
+    int image_width = 0;
+    int image_height = 0;
+
+    float low_threshold = 0.1f;
+    float high_threshold = 0.3f;
+
+    std::string input_image;
+
+    cl_int ocl_err;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--input") && (i + 1 < argc))
+        {
+            input_image = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--low") && (i + 1 < argc))
+        {
+            low_threshold = (float)atof( argv[++i]);
+        }
+        else if( !input.compare( "--high") && (i + 1 < argc))
+        {
+            high_threshold = (float)atof( argv[++i]);
+        }
+    }
+
+    if( input_image.empty())
+    {
+        std::cerr << "usage: " << argv[0] << " --input <input_image_name>\n";
+        std::cerr << "options: " << "\n"
+                  << "   --low <f>: weak edge threshold on gradient magnitude (default 0.1)\n"
+                  << "   --high <f>: strong edge threshold on gradient magnitude (default 0.3)"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+    if( low_threshold > high_threshold)
+    {
+        std::swap( low_threshold, high_threshold);
+    }
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( 0);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_command_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_command_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_program = CreateProgram( ocl_context, ocl_device, "canny.cl");
+    if( ocl_program == nullptr)
+    {
+        std::cerr << "CreateProgram() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    canny_gradient = clCreateKernel( ocl_program, "canny_gradient", &ocl_err);
+    if( !canny_gradient || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    canny_nms = clCreateKernel( ocl_program, "canny_nms", &ocl_err);
+    if( !canny_nms || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    canny_hysteresis = clCreateKernel( ocl_program, "canny_hysteresis", &ocl_err);
+    if( !canny_hysteresis || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    canny_output = clCreateKernel( ocl_program, "canny_output", &ocl_err);
+    if( !canny_output || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        // canny_gradient() and canny_hysteresis() work on TILE_SIZE x TILE_SIZE work-groups
+    cl_kernel tiled_kernels[] = { canny_gradient, canny_hysteresis};
+    const char *tiled_kernel_names[] = { "canny_gradient", "canny_hysteresis"};
+
+    for( int i = 0; i < 2; ++i)
+    {
+        size_t max_work_group_size = 0;
+
+        ocl_err = clGetKernelWorkGroupInfo( tiled_kernels[i], ocl_device, CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &max_work_group_size, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            std::cerr << "clGetKernelWorkGroupInfo() Failed." << ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        if( max_work_group_size < (size_t)( TILE_SIZE * TILE_SIZE))
+        {
+            std::cerr << tiled_kernel_names[i] << "() needs a work-group of " << TILE_SIZE << " x " << TILE_SIZE
+                      << " work-items, the device allows " << max_work_group_size << ".\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    }
+
+        /******** IMAGE LOADING ***********/
+    image_bits = LoadImage( input_image.c_str(), &image_width, &image_height);
+    if( image_bits == nullptr)
+    {
+        std::cerr << "Cannot open image \"" << input_image << "\"" << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    size_t num_pixels = (size_t)image_width * image_height;
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    ocl_input = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, num_pixels * 4, image_bits, &ocl_err);
+    ocl_magnitude = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, num_pixels * sizeof( float), nullptr, &ocl_err);
+    ocl_direction = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, num_pixels, nullptr, &ocl_err);
+    ocl_labels = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, num_pixels, nullptr, &ocl_err);
+    ocl_changed = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, sizeof( cl_int), nullptr, &ocl_err);
+    ocl_output = clCreateBuffer( ocl_context, CL_MEM_WRITE_ONLY, num_pixels * 4, nullptr, &ocl_err);
+    if( !ocl_input || !ocl_magnitude || !ocl_direction || !ocl_labels || !ocl_changed || !ocl_output)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    size_t local_work_size[2] = { TILE_SIZE, TILE_SIZE};
+    size_t global_work_size[2];
+
+    global_work_size[0] = ( ( image_width + TILE_SIZE - 1) / TILE_SIZE) * TILE_SIZE;
+    global_work_size[1] = ( ( image_height + TILE_SIZE - 1) / TILE_SIZE) * TILE_SIZE;
+
+    std::cout << To_String( image_width) << " : " << image_width << "\n";
+    std::cout << To_String( image_height) << " : " << image_height << "\n\n";
+
+        // 1. fused grayscale + gaussian + sobel
+    ocl_err = clSetKernelArg( canny_gradient, 0, sizeof( cl_mem), &ocl_input);
+    ocl_err |= clSetKernelArg( canny_gradient, 1, sizeof( int), &image_width);
+    ocl_err |= clSetKernelArg( canny_gradient, 2, sizeof( int), &image_height);
+    ocl_err |= clSetKernelArg( canny_gradient, 3, sizeof( cl_mem), &ocl_magnitude);
+    ocl_err |= clSetKernelArg( canny_gradient, 4, sizeof( cl_mem), &ocl_direction);
+
+        // 2. non-maximum suppression + double threshold
+    ocl_err |= clSetKernelArg( canny_nms, 0, sizeof( cl_mem), &ocl_magnitude);
+    ocl_err |= clSetKernelArg( canny_nms, 1, sizeof( cl_mem), &ocl_direction);
+    ocl_err |= clSetKernelArg( canny_nms, 2, sizeof( int), &image_width);
+    ocl_err |= clSetKernelArg( canny_nms, 3, sizeof( int), &image_height);
+    ocl_err |= clSetKernelArg( canny_nms, 4, sizeof( float), &low_threshold);
+    ocl_err |= clSetKernelArg( canny_nms, 5, sizeof( float), &high_threshold);
+    ocl_err |= clSetKernelArg( canny_nms, 6, sizeof( cl_mem), &ocl_labels);
+
+        // 3. hysteresis
+    ocl_err |= clSetKernelArg( canny_hysteresis, 0, sizeof( cl_mem), &ocl_labels);
+    ocl_err |= clSetKernelArg( canny_hysteresis, 1, sizeof( int), &image_width);
+    ocl_err |= clSetKernelArg( canny_hysteresis, 2, sizeof( int), &image_height);
+    ocl_err |= clSetKernelArg( canny_hysteresis, 3, sizeof( cl_mem), &ocl_changed);
+
+        // 4. edge map
+    ocl_err |= clSetKernelArg( canny_output, 0, sizeof( cl_mem), &ocl_labels);
+    ocl_err |= clSetKernelArg( canny_output, 1, sizeof( int), &image_width);
+    ocl_err |= clSetKernelArg( canny_output, 2, sizeof( int), &image_height);
+    ocl_err |= clSetKernelArg( canny_output, 3, sizeof( cl_mem), &ocl_output);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clSetKernelArg() Failed.\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, canny_gradient, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+    ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, canny_nms, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        // relaunch until no tile promotes a label, only a single int is read back per iteration
+    int hysteresis_iterations = 0;
+    cl_int changed = 1;
+    const cl_int zero = 0;
+
+    while( changed && ( hysteresis_iterations < MAX_HYSTERESIS_ITERATIONS))
+    {
+        ocl_err = clEnqueueWriteBuffer( ocl_command_queue, ocl_changed, CL_FALSE, 0, sizeof( cl_int), &zero, 0, nullptr, nullptr);
+        ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, canny_hysteresis, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+        ocl_err |= clEnqueueReadBuffer( ocl_command_queue, ocl_changed, CL_TRUE, 0, sizeof( cl_int), &changed, 0, nullptr, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            std::cerr << "Hysteresis Failed." << ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+
+        ++hysteresis_iterations;
+    }
+
+    if( changed)
+    {
+        std::cerr << "Warning: hysteresis stopped after " << MAX_HYSTERESIS_ITERATIONS << " iterations with labels still changing, the edge map is incomplete.\n";
+    }
+
+    ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, canny_output, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        // read result
+    output_image_bits = new uint8_t[ num_pixels * 4];
+
+    ocl_err = clEnqueueReadBuffer( ocl_command_queue, ocl_output, CL_TRUE, 0, num_pixels * 4, output_image_bits, 0, nullptr, nullptr);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clEnqueueReadBuffer() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  elapsed_seconds = end - start;
+    std::cout << To_String( hysteresis_iterations) << " : " << hysteresis_iterations << "\n";
+    std::cout << "Time Required for Canny Edge Detection by OpenCL is: " << elapsed_seconds.count() << "s" << std::endl;
+
+    SaveImage( "Out.png", output_image_bits, image_width, image_height);
+
+    cleanup();
+
+    return 0;
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // code
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+    RELEASE_CL_OBJECT( ocl_command_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+    RELEASE_CL_OBJECT( canny_gradient, clReleaseKernel);
+    RELEASE_CL_OBJECT( canny_nms, clReleaseKernel);
+    RELEASE_CL_OBJECT( canny_hysteresis, clReleaseKernel);
+    RELEASE_CL_OBJECT( canny_output, clReleaseKernel);
+    RELEASE_CL_OBJECT( ocl_input, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_magnitude, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_direction, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_labels, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_changed, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_output, clReleaseMemObject);
+    RELEASE_CL_OBJECT( image_bits, delete[]);
+    RELEASE_CL_OBJECT( output_image_bits, delete[]);
+}
+
+/**
+ * @brief LoadImage() : Load Image and returns image width, image height and image data in 32-bit format. Delete image data when work is done.
+ */
+uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height)
+{
+    // code
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( file_name, 0);
+    FIBITMAP *image = FreeImage_Load( format, file_name);
+    if( image == nullptr)
+    {
+        *image_width = 0;
+        *image_height = 0;
+        return nullptr;
+    }
+
+        // convert to 32-bit image
+    FIBITMAP *temp = image;
+    image = FreeImage_ConvertTo32Bits( image);
+    FreeImage_Unload( temp);
+
+    *image_width = FreeImage_GetWidth( image);
+    *image_height = FreeImage_GetHeight( image);
+
+    uint8_t *image_bits = FreeImage_GetBits( image);
+
+    uint8_t *ret_image_bits = new uint8_t[ (*image_width) * (*image_height) * 4];
+    memcpy( ret_image_bits, image_bits, (*image_width) * (*image_height) * 4 * sizeof( uint8_t));
+
+    FreeImage_Unload( image);
+
+    return ret_image_bits;
+}
+
+/**
+ * @brief SaveImage()
+ */
+bool SaveImage( const char *out_file_name, uint8_t *image_bits, int image_width, int image_height)
+{
+    // save image
+    FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_file_name);
+    if( format == FREE_IMAGE_FORMAT::FIF_UNKNOWN)
+    {
+        return false;
+    }
+
+    int row_pitch = 4 * image_width;
+    FIBITMAP *image = FreeImage_ConvertFromRawBits( image_bits, image_width, image_height, row_pitch, 32, 0xFF000000, 0x00FF0000, 0x0000FF00);
+    FreeImage_Save( format, image, out_file_name);
+    FreeImage_Unload( image);
+
+    return true;
+}
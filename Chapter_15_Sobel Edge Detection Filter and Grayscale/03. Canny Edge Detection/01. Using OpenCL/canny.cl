@@ -0,0 +1,273 @@
+/************************
+ *
+ * Canny edge detector
+ *
+ *  1. canny_gradient()   : grayscale -> 5x5 Gaussian ( binomial [1 4 6 4 1] / 16, separable) -> Sobel,
+ *                          fused in one pass over a local memory tile.
+ *                          Writes gradient magnitude and quantized gradient direction.
+ *  2. canny_nms()        : non-maximum suppression along the gradient direction and double threshold,
+ *                          every pixel is labelled NONE, WEAK or STRONG.
+ *  3. canny_hysteresis() : WEAK pixels connected to STRONG pixels become STRONG. Every launch propagates
+ *                          labels inside a work-group tile until the tile is stable, the host relaunches
+ *                          until no label changes globally.
+ *  4. canny_output()     : STRONG pixels -> white, everything else -> black.
+ *
+ * Sobel kernels,
+ *               [ -1  0  +1]                [ -1  -2  -1]
+ *          Gx = [ -2  0  +2]           Gy = [  0   0   0]
+ *               [ -1  0  +1]                [ +1  +2  +1]
+ *
+ * canny_gradient() and canny_hysteresis() must be launched with a work-group size of ( TILE_SIZE, TILE_SIZE).
+ */
+
+#define TILE_SIZE       16
+
+#define LABEL_NONE      0
+#define LABEL_WEAK      1
+#define LABEL_STRONG    2
+
+    // gray tile: 2 pixels of Gaussian halo + 1 pixel of Sobel halo on each side
+#define GRAY_TILE       ( TILE_SIZE + 6)
+#define BLUR_TILE       ( TILE_SIZE + 2)
+
+/**
+ * @brief canny_gradient(): fused grayscale, Gaussian smoothing and Sobel gradient.
+ *
+ * @param direction 0: horizontal, 1: diagonal (+x, +y), 2: vertical, 3: diagonal (+x, -y)
+ */
+__kernel void canny_gradient( __global const uchar4 *src, int width, int height, __global float *magnitude, __global uchar *direction)
+{
+    // variable declaration
+    int lx = (int)get_local_id(0);
+    int ly = (int)get_local_id(1);
+    int tid = mad24( ly, TILE_SIZE, lx);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    int x0 = (int)get_group_id(0) * TILE_SIZE - 3;
+    int y0 = (int)get_group_id(1) * TILE_SIZE - 3;
+
+    __local float gray[ GRAY_TILE * GRAY_TILE];
+    __local float blur_h[ GRAY_TILE * BLUR_TILE];
+    __local float blur[ BLUR_TILE * BLUR_TILE];
+
+    // code
+        // grayscale, pixels are stored as B, G, R, A
+    for( int i = tid; i < GRAY_TILE * GRAY_TILE; i += TILE_SIZE * TILE_SIZE)
+    {
+        int cy = i / GRAY_TILE;
+        int cx = i - cy * GRAY_TILE;
+
+        int sx = clamp( x0 + cx, 0, width - 1);
+        int sy = clamp( y0 + cy, 0, height - 1);
+
+        float4 clr = convert_float4( src[ mad24( sy, width, sx)]) * ( 1.0f / 255.0f);
+        gray[i] = 0.114f * clr.x + 0.587f * clr.y + 0.299f * clr.z;
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+        // horizontal Gaussian: GRAY_TILE rows x BLUR_TILE columns
+    for( int i = tid; i < GRAY_TILE * BLUR_TILE; i += TILE_SIZE * TILE_SIZE)
+    {
+        int cy = i / BLUR_TILE;
+        int cx = i - cy * BLUR_TILE;
+
+        __local const float *g = gray + cy * GRAY_TILE + cx;
+        blur_h[i] = ( g[0] + 4.0f * g[1] + 6.0f * g[2] + 4.0f * g[3] + g[4]) * ( 1.0f / 16.0f);
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+        // vertical Gaussian: BLUR_TILE rows x BLUR_TILE columns
+    for( int i = tid; i < BLUR_TILE * BLUR_TILE; i += TILE_SIZE * TILE_SIZE)
+    {
+        int cy = i / BLUR_TILE;
+        int cx = i - cy * BLUR_TILE;
+
+        __local const float *g = blur_h + cy * BLUR_TILE + cx;
+        blur[i] = ( g[0] + 4.0f * g[BLUR_TILE] + 6.0f * g[2 * BLUR_TILE] + 4.0f * g[3 * BLUR_TILE] + g[4 * BLUR_TILE]) * ( 1.0f / 16.0f);
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    if( (x >= width) || (y >= height))
+    {
+        return;
+    }
+
+        // Sobel
+    __local const float *t = blur + ly * BLUR_TILE + lx;
+    __local const float *m = t + BLUR_TILE;
+    __local const float *b = m + BLUR_TILE;
+
+    float gx = ( t[2] - t[0]) + 2.0f * ( m[2] - m[0]) + ( b[2] - b[0]);
+    float gy = ( b[0] - t[0]) + 2.0f * ( b[1] - t[1]) + ( b[2] - t[2]);
+
+    float ax = fabs( gx);
+    float ay = fabs( gy);
+
+    uchar dir;
+    if( ay <= 0.41421356f * ax)         // < 22.5 degree
+    {
+        dir = 0;
+    }
+    else if( ay >= 2.41421356f * ax)    // > 67.5 degree
+    {
+        dir = 2;
+    }
+    else
+    {
+        dir = ( gx * gy > 0.0f) ? 1 : 3;
+    }
+
+    magnitude[ mad24( y, width, x)] = native_sqrt( gx * gx + gy * gy);
+    direction[ mad24( y, width, x)] = dir;
+}
+
+/**
+ * @brief canny_nms(): non-maximum suppression and double threshold.
+ */
+__kernel void canny_nms( __global const float *magnitude, __global const uchar *direction, int width, int height, float low_threshold, float high_threshold, __global uchar *labels)
+{
+    // variable declaration
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    // code
+    if( (x >= width) || (y >= height))
+    {
+        return;
+    }
+
+    int indx = mad24( y, width, x);
+    float m = magnitude[indx];
+
+    int dx, dy;
+    switch( direction[indx])
+    {
+        case 0:  dx = 1; dy = 0;  break;
+        case 1:  dx = 1; dy = 1;  break;
+        case 2:  dx = 0; dy = 1;  break;
+        default: dx = 1; dy = -1; break;
+    }
+
+    int xa = clamp( x + dx, 0, width - 1);
+    int ya = clamp( y + dy, 0, height - 1);
+    int xb = clamp( x - dx, 0, width - 1);
+    int yb = clamp( y - dy, 0, height - 1);
+
+    float ma = magnitude[ mad24( ya, width, xa)];
+    float mb = magnitude[ mad24( yb, width, xb)];
+
+    uchar label = LABEL_NONE;
+    if( (m >= ma) && (m > mb))
+    {
+        if( m >= high_threshold)
+        {
+            label = LABEL_STRONG;
+        }
+        else if( m >= low_threshold)
+        {
+            label = LABEL_WEAK;
+        }
+    }
+
+    labels[indx] = label;
+}
+
+/**
+ * @brief canny_hysteresis(): propagate STRONG labels to connected WEAK pixels.
+ *
+ * The tile plus a 1 pixel halo is propagated in local memory until it is stable,
+ * *changed is set when any label of the tile was promoted.
+ */
+__kernel void canny_hysteresis( __global uchar *labels, int width, int height, __global int *changed)
+{
+    // variable declaration
+    int lx = (int)get_local_id(0);
+    int ly = (int)get_local_id(1);
+    int tid = mad24( ly, TILE_SIZE, lx);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    int x0 = (int)get_group_id(0) * TILE_SIZE - 1;
+    int y0 = (int)get_group_id(1) * TILE_SIZE - 1;
+
+    bool inside = (x < width) && (y < height);
+
+    __local uchar tile[ BLUR_TILE * BLUR_TILE];
+    __local int local_changed;
+
+    // code
+    for( int i = tid; i < BLUR_TILE * BLUR_TILE; i += TILE_SIZE * TILE_SIZE)
+    {
+        int cy = i / BLUR_TILE;
+        int cx = i - cy * BLUR_TILE;
+
+        int sx = x0 + cx;
+        int sy = y0 + cy;
+
+        tile[i] = ( (sx >= 0) && (sx < width) && (sy >= 0) && (sy < height)) ? labels[ mad24( sy, width, sx)] : LABEL_NONE;
+    }
+
+    int c = ( ly + 1) * BLUR_TILE + ( lx + 1);
+    int iterate = 1;
+
+    while( iterate)
+    {
+        barrier( CLK_LOCAL_MEM_FENCE);
+        if( tid == 0)
+        {
+            local_changed = 0;
+        }
+        barrier( CLK_LOCAL_MEM_FENCE);
+
+        if( inside && (tile[c] == LABEL_WEAK))
+        {
+            if( (tile[ c - BLUR_TILE - 1] == LABEL_STRONG) || (tile[ c - BLUR_TILE] == LABEL_STRONG) || (tile[ c - BLUR_TILE + 1] == LABEL_STRONG) ||
+                (tile[ c - 1] == LABEL_STRONG) || (tile[ c + 1] == LABEL_STRONG) ||
+                (tile[ c + BLUR_TILE - 1] == LABEL_STRONG) || (tile[ c + BLUR_TILE] == LABEL_STRONG) || (tile[ c + BLUR_TILE + 1] == LABEL_STRONG))
+            {
+                tile[c] = LABEL_STRONG;
+                local_changed = 1;
+            }
+        }
+
+        barrier( CLK_LOCAL_MEM_FENCE);
+        iterate = local_changed;
+    }
+
+    if( inside)
+    {
+        int indx = mad24( y, width, x);
+        if( tile[c] != labels[indx])
+        {
+            labels[indx] = tile[c];
+            *changed = 1;
+        }
+    }
+}
+
+/**
+ * @brief canny_output(): edge map as BGRA pixels.
+ */
+__kernel void canny_output( __global const uchar *labels, int width, int height, __global uchar4 *dst)
+{
+    // variable declaration
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    // code
+    if( (x >= width) || (y >= height))
+    {
+        return;
+    }
+
+    int indx = mad24( y, width, x);
+    uchar v = ( labels[indx] == LABEL_STRONG) ? 255 : 0;
+
+    dst[indx] = (uchar4)( v, v, v, 255);
+}
@@ -0,0 +1,14 @@
+DEL Benchmark.exe
+
+CL.exe /EHsc /c /I"%CUDA_PATH%\include" /I"glew\include" Benchmark.cpp^
+ OpenCLUtil.cpp ^
+ Cloth_CL.cpp
+
+LINK.exe /OUT:Benchmark.exe /LIBPATH:"%CUDA_PATH%\lib\x64" /LIBPATH:"glew\lib\Release\x64" opencl.lib ^
+ Benchmark.obj^
+ OpenCLUtil.obj ^
+ Cloth_CL.obj
+
+DEL Benchmark.obj ^
+  OpenCLUtil.obj ^
+  Cloth_CL.obj
@@ -0,0 +1,568 @@
+/************************
+ *
+ * Headless cloth benchmark ( no window, no OpenGL context).
+ *
+ *  Every cloth resolution from --min-size to --max-size ( powers of 2, 64 x 64 .. 2048 x 2048 by default) is run
+ *  with every solver ( or --solver name) for --steps Update()s. The cloth positions are plain OpenCL buffers
+ *  ( CreateCloth( ..., b_headless)), the start state is the flat cloth jittered by a fixed seed ( --seed), so two
+ *  runs on the same device and driver give the same final state.
+ *
+ *  Reported per run : steps per second, kernel time per Update() stage ( ms per step, from the profiling
+ *  command-queue of OpenCLUtil::InitializeHeadless()), and two checksums of the final positions : the sum of
+ *  x + 2y + 3z ( to compare devices, close but not equal) and a hash of the float bits ( to compare runs, exact).
+ *
+ *  With --batch n, every resolution is run as n cloths of one ClothBatch ( SOLVER_COLORED_TILES and SOLVER_XPBD)
+ *  and as n separate cloths, for small sizes ( --min-size 16 --max-size 32). Both give the same positions, the
+ *  hashes match.
+ *
+ *  --record file writes the hash of every run ( "size solver hash" lines, "size solver x n hash" with --batch n),
+ *  --expect file compares every run with the hash recorded for it : a different or missing hash is reported and
+ *  the exit code is 1. A batch run also fails when the batch and separate hashes differ.
+ *
+ *  Run from this directory ( opencl_kernel/cloth/cloth.cl is loaded relative to it), --device cpu for CPU OpenCL.
+ */
+
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include <chrono>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "OGL.h"
+#include "OpenCLUtil.h"
+#include "Cloth_CL.h"
+
+#pragma comment( lib, "glew32.lib")
+#pragma comment( lib, "OpenGL32.lib")
+
+#define CLOTH_SIZE 30
+#define CLOTH_MASS 5.0f
+#define BOUND_DIMENSION 40.0f
+#define DEFAULT_STEPS 300
+#define DEFAULT_SEED 1
+#define DEFAULT_MIN_SIZE 64
+#define DEFAULT_MAX_SIZE 2048
+
+    // start state jitter, fraction of the vertex spacing
+#define JITTER 0.1f
+
+/**
+ * @brief NextRandom() : LCG, same sequence on every platform ( unlike rand())
+ */
+static unsigned int NextRandom( unsigned int *p_state)
+{
+    // code
+    *p_state = *p_state * 1664525u + 1013904223u;
+    return *p_state;
+}
+
+/**
+ * @brief Checksums() : sum of x + 2y + 3z, FNV-1a of the float bits
+ */
+static void Checksums( const std::vector<vmath::vec4> &positions, double *p_sum, unsigned int *p_hash)
+{
+    // code
+    *p_sum = 0.0;
+    *p_hash = 2166136261u;
+
+    for( size_t i = 0; i < positions.size(); ++i)
+    {
+        *p_sum += positions[i][0] + 2.0 * positions[i][1] + 3.0 * positions[i][2];
+
+        const unsigned char *p_bytes = (const unsigned char*) &(positions[i][0]);
+        for( size_t b = 0; b < 3 * sizeof( float); ++b)
+        {
+            *p_hash = (*p_hash ^ p_bytes[b]) * 16777619u;
+        }
+    }
+}
+
+    // "size solver" ( "size solver x n" for a batch) -> hash of --expect, runs of --record
+static std::map<std::string, unsigned int> expected_hashes;
+static bool b_expect = false;
+static FILE *p_record_file = nullptr;
+
+/**
+ * @brief HashKey() : key of a run in the --expect and --record files ( instances_count 0 : not a batch)
+ */
+static std::string HashKey( unsigned int size, ClothSimulation_OpenCL::SOLVER solver, unsigned int instances_count)
+{
+    // code
+    std::ostringstream key;
+    key << size << " " << ClothSimulation_OpenCL::SolverName( solver);
+
+    if( instances_count > 0)
+    {
+        key << " x " << instances_count;
+    }
+
+    return key.str();
+}
+
+/**
+ * @brief LoadExpectedHashes() : lines of a --record file, the hash ( hex) is the last word, solver names have spaces
+ */
+static bool LoadExpectedHashes( const char *file_name)
+{
+    // variable declaration
+    std::ifstream file( file_name);
+    std::string line;
+
+    // code
+    if( !file.is_open())
+    {
+        printf( "Cannot open %s.\n", file_name);
+        return false;
+    }
+
+    while( std::getline( file, line))
+    {
+        size_t separator = line.find_last_of( ' ');
+        if( separator == std::string::npos)
+        {
+            continue;
+        }
+
+        std::istringstream buffer( line.substr( separator + 1));
+        unsigned int hash = 0;
+
+        if( buffer >> std::hex >> hash)
+        {
+            expected_hashes[line.substr( 0, separator)] = hash;
+        }
+    }
+
+    b_expect = true;
+
+    return true;
+}
+
+/**
+ * @brief CheckHash() : records the hash of a run and compares it with the expected one, false on a mismatch
+ */
+static bool CheckHash( unsigned int size, ClothSimulation_OpenCL::SOLVER solver, unsigned int instances_count, unsigned int hash)
+{
+    // code
+    std::string key = HashKey( size, solver, instances_count);
+
+    if( p_record_file)
+    {
+        fprintf( p_record_file, "%s %08x\n", key.c_str(), hash);
+    }
+
+    if( !b_expect)
+    {
+        return true;
+    }
+
+    auto expected = expected_hashes.find( key);
+    if( expected == expected_hashes.end())
+    {
+        printf( "%4u x %-4u  %-20s no expected hash.\n", size, size, ClothSimulation_OpenCL::SolverName( solver));
+        return false;
+    }
+
+    if( expected->second != hash)
+    {
+        printf( "%4u x %-4u  %-20s hash mismatch : %08x, expected %08x.\n", size, size, ClothSimulation_OpenCL::SolverName( solver), hash, expected->second);
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief CloseRecordFile() : flushes the --record file
+ */
+static void CloseRecordFile()
+{
+    // code
+    if( p_record_file)
+    {
+        fclose( p_record_file);
+        p_record_file = nullptr;
+    }
+}
+
+/**
+ * @brief RunBenchmark() : one resolution, one solver, false on a failure or a hash mismatch
+ */
+static bool RunBenchmark( unsigned int size, ClothSimulation_OpenCL::SOLVER solver, int steps, unsigned int seed)
+{
+    // variable declaration
+    ClothSimulation_OpenCL::Cloth cloth = nullptr;
+    std::vector<vmath::vec4> positions;
+    double stage_seconds[ClothSimulation_OpenCL::STAGE_COUNT];
+    double sum = 0.0;
+    unsigned int hash = 0;
+
+    // code
+    cloth = ClothSimulation_OpenCL::CreateCloth( CLOTH_SIZE, CLOTH_SIZE, size, size, 0.0f, CLOTH_MASS, true);
+    if( cloth == nullptr)
+    {
+        printf( "%4u x %-4u  CreateCloth() Failed.\n", size, size);
+        return false;
+    }
+
+    ClothSimulation_OpenCL::SetSolver( cloth, solver);
+    if( ClothSimulation_OpenCL::GetSolver( cloth) != solver)
+    {
+        printf( "%4u x %-4u  %-20s not supported by the device.\n", size, size, ClothSimulation_OpenCL::SolverName( solver));
+        ClothSimulation_OpenCL::DeleteCloth( cloth);
+        return true;
+    }
+
+        // fixed seed jitter, the first row is fixed and stays in place
+    positions.resize( ClothSimulation_OpenCL::GetVerticesCount( cloth));
+    ClothSimulation_OpenCL::ReadPositions( cloth, positions.data());
+
+    float amplitude = JITTER * CLOTH_SIZE / (size - 1);
+    unsigned int random_state = seed;
+
+    for( size_t i = size; i < positions.size(); ++i)
+    {
+        for( int j = 0; j < 3; ++j)
+        {
+            positions[i][j] += amplitude * ((NextRandom( &random_state) >> 8) / 8388608.0f - 1.0f);
+        }
+    }
+
+    ClothSimulation_OpenCL::SetPositions( cloth, positions.data());
+
+    ClothSimulation_OpenCL::SetProfiling( cloth, true);
+    clFinish( OpenCLUtil::GetCommandQueue());
+
+    auto start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < steps; ++i)
+    {
+        ClothSimulation_OpenCL::Update( cloth, 1.0f / 60.0f, vmath::vec3( BOUND_DIMENSION));
+    }
+
+    clFinish( OpenCLUtil::GetCommandQueue());
+
+    double seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start).count();
+
+    ClothSimulation_OpenCL::GetStageTimes( cloth, stage_seconds);
+    ClothSimulation_OpenCL::ReadPositions( cloth, positions.data());
+    Checksums( positions, &sum, &hash);
+
+    printf( "%4u x %-4u  %-20s %10.1f", size, size, ClothSimulation_OpenCL::SolverName( solver), steps / seconds);
+    for( int i = 0; i < ClothSimulation_OpenCL::STAGE_COUNT; ++i)
+    {
+        printf( " %12.3f", 1000.0 * stage_seconds[i] / steps);
+    }
+    printf( "  %18.6f  %08x\n", sum / positions.size(), hash);
+
+    ClothSimulation_OpenCL::DeleteCloth( cloth);
+
+    return CheckHash( size, solver, 0, hash);
+}
+
+/**
+ * @brief RunBatchBenchmark() : instances_count cloths of one resolution, in a batch and separately, false on a
+ *        failure or when the hashes differ
+ */
+static bool RunBatchBenchmark( unsigned int size, ClothSimulation_OpenCL::SOLVER solver, int steps, unsigned int instances_count)
+{
+    // variable declaration
+    ClothSimulation_OpenCL::ClothBatch batch = nullptr;
+    std::vector<ClothSimulation_OpenCL::ClothInstanceInfo> instances( instances_count);
+    std::vector<ClothSimulation_OpenCL::Cloth> cloths;
+    std::vector<vmath::vec4> positions;
+    double sum = 0.0;
+    unsigned int batch_hash = 0;
+    unsigned int separate_hash = 0;
+
+    // code
+    for( unsigned int i = 0; i < instances_count; ++i)
+    {
+        instances[i].cloth_width = CLOTH_SIZE;
+        instances[i].cloth_height = CLOTH_SIZE;
+        instances[i].x_vertices = size;
+        instances[i].y_vertices = size;
+        instances[i].mass = CLOTH_MASS;
+        instances[i].transform = vmath::mat4::identity();
+
+        ClothSimulation_OpenCL::Cloth cloth = ClothSimulation_OpenCL::CreateCloth( CLOTH_SIZE, CLOTH_SIZE, size, size, 0.0f, CLOTH_MASS, true);
+        if( cloth == nullptr)
+        {
+            break;
+        }
+
+        ClothSimulation_OpenCL::SetSolver( cloth, solver);
+        cloths.push_back( cloth);
+    }
+
+    batch = ClothSimulation_OpenCL::CreateClothBatch( instances.data(), instances_count, true);
+
+    if( (batch == nullptr) || (cloths.size() != instances_count))
+    {
+        printf( "%4u x %-4u  %s() Failed.\n", size, size, (batch == nullptr) ? "CreateClothBatch" : "CreateCloth");
+
+        ClothSimulation_OpenCL::DeleteClothBatch( batch);
+        for( size_t i = 0; i < cloths.size(); ++i)
+        {
+            ClothSimulation_OpenCL::DeleteCloth( cloths[i]);
+        }
+
+        return false;
+    }
+
+    ClothSimulation_OpenCL::SetBatchSolver( batch, solver);
+    clFinish( OpenCLUtil::GetCommandQueue());
+
+    auto start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < steps; ++i)
+    {
+        ClothSimulation_OpenCL::UpdateClothBatch( batch, 1.0f / 60.0f, vmath::vec3( BOUND_DIMENSION));
+    }
+
+    clFinish( OpenCLUtil::GetCommandQueue());
+
+    double batch_seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start).count();
+
+    start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < steps; ++i)
+    {
+        for( unsigned int j = 0; j < instances_count; ++j)
+        {
+            ClothSimulation_OpenCL::Update( cloths[j], 1.0f / 60.0f, vmath::vec3( BOUND_DIMENSION));
+        }
+    }
+
+    clFinish( OpenCLUtil::GetCommandQueue());
+
+    double separate_seconds = std::chrono::duration<double>( std::chrono::steady_clock::now() - start).count();
+
+        // instances are in order in the batch, the separate cloths are read back to back
+    positions.resize( ClothSimulation_OpenCL::GetBatchVerticesCount( batch));
+    ClothSimulation_OpenCL::ReadBatchPositions( batch, positions.data());
+    Checksums( positions, &sum, &batch_hash);
+
+    for( unsigned int j = 0; j < instances_count; ++j)
+    {
+        ClothSimulation_OpenCL::ReadPositions( cloths[j], positions.data() + ClothSimulation_OpenCL::GetInstanceFirstVertex( batch, j));
+    }
+    Checksums( positions, &sum, &separate_hash);
+
+    printf( "%4u x %-4u  %-20s %9u %12.1f %12.1f %8.1fx  %08x  %08x\n",
+        size, size, ClothSimulation_OpenCL::SolverName( solver), instances_count,
+        steps / batch_seconds, steps / separate_seconds, separate_seconds / batch_seconds,
+        batch_hash, separate_hash
+    );
+
+    ClothSimulation_OpenCL::DeleteClothBatch( batch);
+    for( unsigned int i = 0; i < instances_count; ++i)
+    {
+        ClothSimulation_OpenCL::DeleteCloth( cloths[i]);
+    }
+
+    if( batch_hash != separate_hash)
+    {
+        printf( "%4u x %-4u  %-20s batch and separate hashes differ.\n", size, size, ClothSimulation_OpenCL::SolverName( solver));
+        return false;
+    }
+
+    return CheckHash( size, solver, instances_count, batch_hash);
+}
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // variable declaration
+    cl_device_type device_type = CL_DEVICE_TYPE_GPU;
+    int steps = DEFAULT_STEPS;
+    unsigned int seed = DEFAULT_SEED;
+    unsigned int min_size = DEFAULT_MIN_SIZE;
+    unsigned int max_size = DEFAULT_MAX_SIZE;
+    unsigned int batch_count = 0;
+    std::string solver_name = "all";
+    std::string expect_file_name;
+    std::string record_file_name;
+    bool b_passed = true;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+
+        if( !input.compare( "--device") && (i + 1 < argc))
+        {
+            input = std::string( argv[++i]);
+            device_type = !input.compare( "cpu") ? CL_DEVICE_TYPE_CPU : CL_DEVICE_TYPE_GPU;
+        }
+        else if( !input.compare( "--steps") && (i + 1 < argc))
+        {
+            std::istringstream buffer( argv[++i]);
+            buffer >> steps;
+        }
+        else if( !input.compare( "--seed") && (i + 1 < argc))
+        {
+            std::istringstream buffer( argv[++i]);
+            buffer >> seed;
+        }
+        else if( !input.compare( "--min-size") && (i + 1 < argc))
+        {
+            std::istringstream buffer( argv[++i]);
+            buffer >> min_size;
+        }
+        else if( !input.compare( "--max-size") && (i + 1 < argc))
+        {
+            std::istringstream buffer( argv[++i]);
+            buffer >> max_size;
+        }
+        else if( !input.compare( "--solver") && (i + 1 < argc))
+        {
+            solver_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--batch") && (i + 1 < argc))
+        {
+            std::istringstream buffer( argv[++i]);
+            buffer >> batch_count;
+        }
+        else if( !input.compare( "--expect") && (i + 1 < argc))
+        {
+            expect_file_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--record") && (i + 1 < argc))
+        {
+            record_file_name = std::string( argv[++i]);
+        }
+        else
+        {
+            printf( "usage: %s --device cpu|gpu --steps n --seed n --min-size n --max-size n --solver all|name --batch n --expect file --record file\n", argv[0]);
+            return 0;
+        }
+    }
+
+    if( (steps <= 0) || (min_size < 3) || (max_size < min_size))
+    {
+        printf( "Invalid steps or sizes.\n");
+        return 1;
+    }
+
+    if( !expect_file_name.empty() && (LoadExpectedHashes( expect_file_name.c_str()) == false))
+    {
+        return 1;
+    }
+
+    if( !record_file_name.empty())
+    {
+        p_record_file = fopen( record_file_name.c_str(), "w");
+        if( p_record_file == nullptr)
+        {
+            printf( "Cannot open %s.\n", record_file_name.c_str());
+            return 1;
+        }
+    }
+
+    if( OpenCLUtil::InitializeHeadless( device_type) == false)
+    {
+        printf( "OpenCLUtil::InitializeHeadless() Failed.\n");
+        CloseRecordFile();
+        return 1;
+    }
+
+    if( ClothSimulation_OpenCL::Initialize() == false)
+    {
+        printf( "ClothSimulation_OpenCL::Initialize() Failed.\n");
+        OpenCLUtil::Unintialize();
+        CloseRecordFile();
+        return 1;
+    }
+
+    char device_name[256] = "";
+    clGetDeviceInfo( OpenCLUtil::GetDevice(), CL_DEVICE_NAME, sizeof( device_name), device_name, nullptr);
+
+    if( batch_count > 0)
+    {
+        printf( "device : %s, %d steps, %u cloths, steps/s of all the cloths\n\n", device_name, steps, batch_count);
+        printf( "%-11s  %-20s %9s %12s %12s %9s  %8s  %8s\n", "size", "solver", "cloths", "batch", "separate", "speedup", "hash", "separate");
+    }
+    else
+    {
+        printf( "device : %s, %d steps, seed %u, stage times in ms per step\n\n", device_name, steps, seed);
+        printf( "%-11s  %-20s %10s", "size", "solver", "steps/s");
+        for( int i = 0; i < ClothSimulation_OpenCL::STAGE_COUNT; ++i)
+        {
+            printf( " %12s", ClothSimulation_OpenCL::StageName( (ClothSimulation_OpenCL::STAGE) i));
+        }
+        printf( "  %18s  %8s\n", "checksum", "hash");
+    }
+
+    bool b_solver_found = false;
+
+    for( unsigned int size = min_size; size <= max_size; size *= 2)
+    {
+        for( int solver = 0; solver < ClothSimulation_OpenCL::SOLVER_COUNT; ++solver)
+        {
+            if( solver_name.compare( "all") && solver_name.compare( ClothSimulation_OpenCL::SolverName( (ClothSimulation_OpenCL::SOLVER) solver)))
+            {
+                continue;
+            }
+
+            if( batch_count > 0)
+            {
+                    // the solvers of a batch
+                if( (solver != ClothSimulation_OpenCL::SOLVER_COLORED_TILES) && (solver != ClothSimulation_OpenCL::SOLVER_XPBD))
+                {
+                    continue;
+                }
+
+                b_solver_found = true;
+                b_passed = RunBatchBenchmark( size, (ClothSimulation_OpenCL::SOLVER) solver, steps, batch_count) && b_passed;
+            }
+            else
+            {
+                b_solver_found = true;
+                b_passed = RunBenchmark( size, (ClothSimulation_OpenCL::SOLVER) solver, steps, seed) && b_passed;
+            }
+        }
+    }
+
+    if( b_solver_found == false)
+    {
+        printf( "Unknown solver : %s\n", solver_name.c_str());
+        b_passed = false;
+    }
+
+    ClothSimulation_OpenCL::Uninitialize();
+    OpenCLUtil::Unintialize();
+    CloseRecordFile();
+
+    if( b_expect)
+    {
+        printf( "\n%s\n", b_passed ? "all hashes match." : "FAILED.");
+    }
+
+    return b_passed ? 0 : 1;
+}
+
+//Error Log
+void PrintLog( int lineNo, char *fileName, char *functionName, char *format, ...)
+{
+    // code
+    if( format[0] == '\0')
+    {
+        return;
+    }
+
+    va_list argList;
+
+    va_start( argList, format);
+
+        fprintf( stderr, "[%s\\%s() : %d]: ", fileName, functionName, lineNo);
+        vfprintf( stderr, format, argList);
+        fprintf( stderr, "\n");
+
+    va_end( argList);
+}
@@ -5,9 +5,29 @@
 
 #include "Cloth_CL.h"
 #include <vector>
+#include <float.h>
 
 #define CONTRAINT_SATISFY_ITERATION 32
 
+// SOLVER_COLORED_TILES : vertices per tile side ( >= 3, sticks reach 2 vertices out of their tile), work-items per tile
+#define COLORED_TILE_SIZE 16
+#define COLORED_TILE_LOCAL_SIZE 128
+#define TILE_PHASE_COUNT 4
+
+// SOLVER_LOCAL_TILES : tile side, halo ( as in cloth.cl), work-items per tile, iterations per launch
+#define LOCAL_TILE_SIZE 16
+#define LOCAL_TILE_HALO 2
+#define LOCAL_TILE_LOCAL_SIZE 128
+#define LOCAL_TILE_INNER_ITERATIONS 4
+
+// SOLVER_XPBD : substeps per frame ( one constraint iteration each), simulated time of a frame
+#define XPBD_SUBSTEPS 8
+#define XPBD_FRAME_TIME (1.0f / 60.0f)
+
+// collisions : work-items ( and slots) per block of the cell scan, cells of the mesh collider grid at most
+#define SCAN_LOCAL_SIZE 256
+#define MESH_GRID_MAX_CELLS (1 << 20)
+
 #define FREE_MEMORY(ptr) \
         if(ptr) \
         {   \
@@ -29,11 +49,35 @@ namespace ClothSimulation_OpenCL
     const float friction = 0.999f;
     const float bounce = 0.9f;
 
+        // SOLVER_XPBD default compliance ( inverse stiffness per unit length, see GroupAlpha()) : stretch, shear and bend sticks
+    const float stretch_compliance = 0.0f;
+    const float shear_compliance = 1.0e-3f;
+    const float bend_compliance = 1.0e-2f;
+
 
     cl_program ocl_cloth_program;
     cl_kernel ocl_update_vertices;
     cl_kernel ocl_constraint_vertices;
     cl_kernel ocl_update_sticks;
+    cl_kernel ocl_satisfy_constraints_tiled;
+    cl_kernel ocl_satisfy_constraints_tiled_xpbd;
+    cl_kernel ocl_satisfy_constraints_local;
+    cl_kernel ocl_normal_calculation;
+    cl_kernel ocl_hash_vertices;
+    cl_kernel ocl_scan_cells;
+    cl_kernel ocl_add_block_offsets;
+    cl_kernel ocl_scatter_vertices;
+    cl_kernel ocl_collide_vertices;
+    cl_kernel ocl_update_vertices_batched;
+    cl_kernel ocl_satisfy_constraints_batched;
+    cl_kernel ocl_satisfy_constraints_batched_xpbd;
+    cl_kernel ocl_normal_calculation_batched;
+
+    size_t tiled_local_size = COLORED_TILE_LOCAL_SIZE;
+    size_t local_tiles_local_size = LOCAL_TILE_LOCAL_SIZE;
+    bool b_local_tiles_supported = false;
+    size_t scan_local_size = SCAN_LOCAL_SIZE;
+    size_t batch_local_size = COLORED_TILE_LOCAL_SIZE;
 
     //////////////////////////////////////////////
     ///////// TYPE DEFINITION
@@ -88,9 +132,75 @@ namespace ClothSimulation_OpenCL
 
         cl_mem ocl_position_graphic_resource = nullptr;
         cl_mem ocl_old_position = nullptr;
+
+            // normal VBO shared with OpenGL, else a plain buffer copied to the VBO after every Update()
+        cl_mem ocl_normal = nullptr;
+        bool b_normal_gl_shared = false;
+        std::vector<vmath::vec4> normal_readback;
+
+            // no OpenGL objects, positions and normals are plain buffers
+        bool b_headless = false;
+
+            // kernel time per stage, the events of an Update() are added up and released at its end
+        bool b_profiling = false;
+        std::vector<cl_event> stage_events;
+        std::vector<STAGE> stage_event_stages;
+        double stage_seconds[STAGE_COUNT] = { 0.0 };
+
         cl_mem ocl_p_fix_point = nullptr;
         cl_mem ocl_p_sticks[STICK_GROUP_ID::GROUP_COUNT] = { nullptr };
 
+            // default solver, see SetSolver()
+        SOLVER solver = SOLVER_COLORED_TILES;
+
+            // SOLVER_COLORED_TILES, tiles are ordered by phase
+        GLuint tiles_x = 0;
+        GLuint tiles_y = 0;
+        unsigned int phase_first_tile[TILE_PHASE_COUNT + 1] = { 0 };
+
+        cl_mem ocl_tiled_sticks = nullptr;
+        cl_mem ocl_tile_stick_offsets = nullptr;
+        cl_mem ocl_tile_ids = nullptr;
+        cl_mem ocl_group_distance = nullptr;
+
+            // SOLVER_XPBD, GroupAlpha() of every group
+        float group_compliance[STICK_GROUP_ID::GROUP_COUNT] = { 0.0f };
+        cl_mem ocl_group_alpha = nullptr;
+
+            // SOLVER_LOCAL_TILES, launches alternate between the position buffer and this one
+        cl_mem ocl_position_scratch = nullptr;
+
+            // collisions, the self collision cells and the distance kept from the colliders are collision_thickness wide
+        float collision_thickness = 0.0f;
+        bool b_self_collision = false;
+
+            // self collision spatial hash, rebuilt every Update() : vertices counting sorted by slot
+        GLuint hash_table_size = 0;
+        cl_mem ocl_cell_start = nullptr;
+        cl_mem ocl_vertex_cell = nullptr;
+        cl_mem ocl_vertex_rank = nullptr;
+        cl_mem ocl_sorted_vertices = nullptr;
+        std::vector<cl_mem> ocl_scan_block_sums;
+        std::vector<cl_uint> scan_level_count;
+
+        unsigned int spheres_count = 0;
+        unsigned int spheres_capacity = 0;
+        cl_mem ocl_spheres = nullptr;
+
+        unsigned int capsules_count = 0;
+        unsigned int capsules_capacity = 0;
+        cl_mem ocl_capsules = nullptr;
+
+            // static mesh collider, kept to bin it again when the thickness changes
+        std::vector<vmath::vec4> mesh_vertices;
+        std::vector<unsigned int> mesh_indices;
+        vmath::vec4 mesh_origin = vmath::vec4( 0.0f);    // w : cell size
+        cl_uint mesh_cells[3] = { 0 };
+        cl_mem ocl_mesh_vertices = nullptr;
+        cl_mem ocl_mesh_indices = nullptr;
+        cl_mem ocl_mesh_cell_start = nullptr;
+        cl_mem ocl_mesh_cell_triangles = nullptr;
+
         ~_Cloth()
         {
             release();
@@ -106,6 +216,7 @@ namespace ClothSimulation_OpenCL
 
             CL_OBJECT_RELEASE( ocl_position_graphic_resource, clReleaseMemObject);
             CL_OBJECT_RELEASE( ocl_old_position, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_normal, clReleaseMemObject);
             CL_OBJECT_RELEASE( ocl_p_fix_point, clReleaseMemObject);
 
             for( int i = 0; i < STICK_GROUP_ID::GROUP_COUNT; ++i)
@@ -113,12 +224,47 @@ namespace ClothSimulation_OpenCL
                 CL_OBJECT_RELEASE( ocl_p_sticks[i], clReleaseMemObject);
             }
 
+            CL_OBJECT_RELEASE( ocl_tiled_sticks, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_tile_stick_offsets, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_tile_ids, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_group_distance, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_group_alpha, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_position_scratch, clReleaseMemObject);
+
+            for( size_t i = 0; i < stage_events.size(); ++i)
+            {
+                CL_OBJECT_RELEASE( stage_events[i], clReleaseEvent);
+            }
+
+            stage_events.clear();
+            stage_event_stages.clear();
+            b_profiling = false;
+            b_headless = false;
+
+            release_collision_grid();
+            release_mesh_collider();
+
+            CL_OBJECT_RELEASE( ocl_spheres, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_capsules, clReleaseMemObject);
+            spheres_count = 0;
+            spheres_capacity = 0;
+            capsules_count = 0;
+            capsules_capacity = 0;
+            mesh_vertices.clear();
+            mesh_indices.clear();
+            collision_thickness = 0.0f;
+            b_self_collision = false;
+
             vertices_count = 0;
             indices_count = 0;
             width = 0;
             height = 0;
             vertices_x = 0;
             vertices_y = 0;
+            tiles_x = 0;
+            tiles_y = 0;
+            b_normal_gl_shared = false;
+            normal_readback.clear();
             damping = 0.0f;
             mass = 0.0f;
 
@@ -127,6 +273,122 @@ namespace ClothSimulation_OpenCL
                 sticks[i].clear();
             }
         }
+
+        void release_collision_grid()
+        {
+            CL_OBJECT_RELEASE( ocl_cell_start, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_vertex_cell, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_vertex_rank, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_sorted_vertices, clReleaseMemObject);
+
+            for( size_t i = 0; i < ocl_scan_block_sums.size(); ++i)
+            {
+                CL_OBJECT_RELEASE( ocl_scan_block_sums[i], clReleaseMemObject);
+            }
+
+            ocl_scan_block_sums.clear();
+            scan_level_count.clear();
+            hash_table_size = 0;
+        }
+
+        void release_mesh_collider()
+        {
+            CL_OBJECT_RELEASE( ocl_mesh_vertices, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_mesh_indices, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_mesh_cell_start, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_mesh_cell_triangles, clReleaseMemObject);
+
+            mesh_cells[0] = mesh_cells[1] = mesh_cells[2] = 0;
+        }
+    };
+
+        // cloth of a batch, layout of struct ClothInstance in cloth.cl
+    struct ClothInstance
+    {
+        cl_uint first_vertex;
+        cl_uint vertices_x;
+        cl_uint vertices_y;
+        cl_float inverse_mass;
+        cl_float gravity[3];
+        cl_float group_distance[STICK_GROUP_ID::GROUP_COUNT];
+        cl_float group_alpha[STICK_GROUP_ID::GROUP_COUNT];
+    };
+
+        // tile of a batch, layout of struct ClothTile in cloth.cl
+    struct ClothTile
+    {
+        cl_uint instance;
+        cl_uint x0;
+        cl_uint y0;
+    };
+
+    struct _ClothBatch
+    {
+        GLuint vao = 0;
+        GLuint vbo_position = 0;
+        GLuint vbo_normal = 0;
+        GLuint vbo_texcoord = 0;
+        GLuint vbo_elements = 0;
+
+        GLuint vertices_count = 0;
+        GLuint indices_count = 0;
+
+        bool b_headless = false;
+
+        SOLVER solver = SOLVER_XPBD;
+
+            // parameter table, written to ocl_instances by the next Update when b_instances_dirty
+        std::vector<ClothInstance> instances;
+        bool b_instances_dirty = false;
+
+            // tiles of all the instances, ordered by phase
+        GLuint tiles_count = 0;
+        unsigned int phase_first_tile[TILE_PHASE_COUNT + 1] = { 0 };
+
+        cl_mem ocl_position_graphic_resource = nullptr;
+        cl_mem ocl_old_position = nullptr;
+
+        cl_mem ocl_normal = nullptr;
+        bool b_normal_gl_shared = false;
+        std::vector<vmath::vec4> normal_readback;
+
+        cl_mem ocl_p_fix_point = nullptr;
+        cl_mem ocl_tiled_sticks = nullptr;
+        cl_mem ocl_tile_stick_offsets = nullptr;
+        cl_mem ocl_tiles = nullptr;
+        cl_mem ocl_instances = nullptr;
+
+        ~_ClothBatch()
+        {
+            release();
+        }
+
+        void release()
+        {
+            DELETE_VERTEX_ARRAY( vao);
+            DELETE_BUFFER(vbo_position);
+            DELETE_BUFFER(vbo_normal);
+            DELETE_BUFFER(vbo_texcoord);
+            DELETE_BUFFER(vbo_elements);
+
+            CL_OBJECT_RELEASE( ocl_position_graphic_resource, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_old_position, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_normal, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_p_fix_point, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_tiled_sticks, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_tile_stick_offsets, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_tiles, clReleaseMemObject);
+            CL_OBJECT_RELEASE( ocl_instances, clReleaseMemObject);
+
+            vertices_count = 0;
+            indices_count = 0;
+            tiles_count = 0;
+            b_headless = false;
+            b_normal_gl_shared = false;
+            b_instances_dirty = false;
+            normal_readback.clear();
+            instances.clear();
+        }
     };
 
     //////////////////////////////////////////////
@@ -178,13 +440,272 @@ namespace ClothSimulation_OpenCL
             return false;
         }
 
+        ocl_satisfy_constraints_tiled = clCreateKernel( ocl_cloth_program, "satisfy_constraints_tiled", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateKernel() Failed(%d).", ocl_err);
+            return false;
+        }
+
+            // one work-group per tile
+        size_t max_work_group_size = 0;
+        ocl_err = clGetKernelWorkGroupInfo( ocl_satisfy_constraints_tiled, OpenCLUtil::GetDevice(), CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &max_work_group_size, nullptr);
+        if( (ocl_err == CL_SUCCESS) && (max_work_group_size < tiled_local_size))
+        {
+            tiled_local_size = max_work_group_size;
+        }
+
+        ocl_satisfy_constraints_tiled_xpbd = clCreateKernel( ocl_cloth_program, "satisfy_constraints_tiled_xpbd", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateKernel() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        ocl_err = clGetKernelWorkGroupInfo( ocl_satisfy_constraints_tiled_xpbd, OpenCLUtil::GetDevice(), CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &max_work_group_size, nullptr);
+        if( (ocl_err == CL_SUCCESS) && (max_work_group_size < tiled_local_size))
+        {
+            tiled_local_size = max_work_group_size;
+        }
+
+        ocl_satisfy_constraints_local = clCreateKernel( ocl_cloth_program, "satisfy_constraints_local", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateKernel() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        ocl_err = clGetKernelWorkGroupInfo( ocl_satisfy_constraints_local, OpenCLUtil::GetDevice(), CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &max_work_group_size, nullptr);
+        if( (ocl_err == CL_SUCCESS) && (max_work_group_size < local_tiles_local_size))
+        {
+            local_tiles_local_size = max_work_group_size;
+        }
+
+        ocl_normal_calculation = clCreateKernel( ocl_cloth_program, "normal_calculation", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateKernel() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        ocl_hash_vertices = clCreateKernel( ocl_cloth_program, "hash_vertices", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateKernel() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        ocl_scan_cells = clCreateKernel( ocl_cloth_program, "scan_cells", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateKernel() Failed(%d).", ocl_err);
+            return false;
+        }
+
+            // one block of slots per work-group, add_block_offsets() uses the same blocks
+        ocl_err = clGetKernelWorkGroupInfo( ocl_scan_cells, OpenCLUtil::GetDevice(), CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &max_work_group_size, nullptr);
+        if( (ocl_err == CL_SUCCESS) && (max_work_group_size < scan_local_size))
+        {
+            scan_local_size = max_work_group_size;
+        }
+
+        ocl_add_block_offsets = clCreateKernel( ocl_cloth_program, "add_block_offsets", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateKernel() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        ocl_err = clGetKernelWorkGroupInfo( ocl_add_block_offsets, OpenCLUtil::GetDevice(), CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &max_work_group_size, nullptr);
+        if( (ocl_err == CL_SUCCESS) && (max_work_group_size < scan_local_size))
+        {
+            scan_local_size = max_work_group_size;
+        }
+
+        ocl_scatter_vertices = clCreateKernel( ocl_cloth_program, "scatter_vertices", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateKernel() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        ocl_collide_vertices = clCreateKernel( ocl_cloth_program, "collide_vertices", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateKernel() Failed(%d).", ocl_err);
+            return false;
+        }
+
+            // batches, one work-group per tile as SOLVER_COLORED_TILES
+        cl_kernel *p_batch_kernels[] = {
+            &ocl_update_vertices_batched,
+            &ocl_satisfy_constraints_batched,
+            &ocl_satisfy_constraints_batched_xpbd,
+            &ocl_normal_calculation_batched
+        };
+
+        const char *batch_kernel_names[] = {
+            "update_vertices_batched",
+            "satisfy_constraints_batched",
+            "satisfy_constraints_batched_xpbd",
+            "normal_calculation_batched"
+        };
+
+        for( int i = 0; i < _ARRAYSIZE( p_batch_kernels); ++i)
+        {
+            *(p_batch_kernels[i]) = clCreateKernel( ocl_cloth_program, batch_kernel_names[i], &ocl_err);
+            if( ocl_err != CL_SUCCESS)
+            {
+                Log("clCreateKernel() Failed(%d).", ocl_err);
+                return false;
+            }
+
+            ocl_err = clGetKernelWorkGroupInfo( *(p_batch_kernels[i]), OpenCLUtil::GetDevice(), CL_KERNEL_WORK_GROUP_SIZE, sizeof( size_t), &max_work_group_size, nullptr);
+            if( (ocl_err == CL_SUCCESS) && (max_work_group_size < batch_local_size))
+            {
+                batch_local_size = max_work_group_size;
+            }
+        }
+
+            // tile + halo : position, old position and state
+        cl_ulong local_memory_size = 0;
+        size_t region = LOCAL_TILE_SIZE + 2 * LOCAL_TILE_HALO;
+
+        ocl_err = clGetDeviceInfo( OpenCLUtil::GetDevice(), CL_DEVICE_LOCAL_MEM_SIZE, sizeof( cl_ulong), &local_memory_size, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clGetDeviceInfo() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        b_local_tiles_supported = (region * region * (2 * sizeof( cl_float4) + sizeof( cl_uchar))) <= local_memory_size;
+        if( !b_local_tiles_supported)
+        {
+            Log("Local memory ( %llu bytes) too small for SOLVER_LOCAL_TILES.", (unsigned long long) local_memory_size);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief TileSlot() : ( tile rank, group) slot of a stick, tiles are cut on the vertex of p0
+     */
+    static unsigned int TileSlot( Cloth cloth, const std::vector<unsigned int> &tile_rank, int group, const Stick &stick)
+    {
+        // code
+        unsigned int x = stick.p0 % cloth->vertices_x;
+        unsigned int y = stick.p0 / cloth->vertices_x;
+
+        return tile_rank[(y / COLORED_TILE_SIZE) * cloth->tiles_x + (x / COLORED_TILE_SIZE)] * STICK_GROUP_ID::GROUP_COUNT + group;
+    }
+
+    /**
+     * @brief CreateTiledSticks() : all stick groups in one buffer for SOLVER_COLORED_TILES
+     * 
+     * @description:
+     *          Sticks are counting-sorted on ( tile, group), tiles being ordered by phase ( parity of tile x and
+     *          tile y) so that the tiles of a phase are one range of work-groups.
+     */
+    static bool CreateTiledSticks( Cloth cloth)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        cloth->tiles_x = (cloth->vertices_x + COLORED_TILE_SIZE - 1) / COLORED_TILE_SIZE;
+        cloth->tiles_y = (cloth->vertices_y + COLORED_TILE_SIZE - 1) / COLORED_TILE_SIZE;
+
+        unsigned int tiles_count = cloth->tiles_x * cloth->tiles_y;
+
+        std::vector<unsigned int> tile_ids;
+        std::vector<unsigned int> tile_rank( tiles_count);
+
+        for( int phase = 0; phase < TILE_PHASE_COUNT; ++phase)
+        {
+            cloth->phase_first_tile[phase] = tile_ids.size();
+
+            for( unsigned int ty = (phase / 2); ty < cloth->tiles_y; ty += 2)
+            {
+                for( unsigned int tx = (phase % 2); tx < cloth->tiles_x; tx += 2)
+                {
+                    tile_rank[ty * cloth->tiles_x + tx] = tile_ids.size();
+                    tile_ids.push_back( ty * cloth->tiles_x + tx);
+                }
+            }
+        }
+
+        cloth->phase_first_tile[TILE_PHASE_COUNT] = tile_ids.size();
+
+            // count, prefix sum, scatter
+        std::vector<unsigned int> offsets( tiles_count * STICK_GROUP_ID::GROUP_COUNT + 1, 0);
+
+        for( int i = 0; i < STICK_GROUP_ID::GROUP_COUNT; ++i)
+        {
+            for( const Stick &s : cloth->sticks[i])
+            {
+                ++offsets[TileSlot( cloth, tile_rank, i, s) + 1];
+            }
+        }
+
+        for( size_t i = 1; i < offsets.size(); ++i)
+        {
+            offsets[i] += offsets[i - 1];
+        }
+
+        std::vector<Stick> tiled_sticks( offsets.back());
+        std::vector<unsigned int> cursor( offsets.begin(), offsets.end() - 1);
+
+        for( int i = 0; i < STICK_GROUP_ID::GROUP_COUNT; ++i)
+        {
+            for( const Stick &s : cloth->sticks[i])
+            {
+                tiled_sticks[cursor[TileSlot( cloth, tile_rank, i, s)]++] = s;
+            }
+        }
+
+        cloth->ocl_tiled_sticks = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, tiled_sticks.size() * sizeof( Stick), tiled_sticks.data(), &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        cloth->ocl_tile_stick_offsets = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, offsets.size() * sizeof( unsigned int), offsets.data(), &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        cloth->ocl_tile_ids = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, tile_ids.size() * sizeof( unsigned int), tile_ids.data(), &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        cloth->ocl_group_distance = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof( cloth->stick_group_distance), cloth->stick_group_distance, &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        cloth->ocl_group_alpha = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY, sizeof( cloth->group_compliance), nullptr, &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            return false;
+        }
+
         return true;
     }
 
     Cloth CreateCloth(
         unsigned int cloth_width, unsigned int cloth_height,
         unsigned int x_vertices_count, unsigned int y_vertices_count,
-        float damping, float mass
+        float damping, float mass,
+        bool b_headless
         )
     {
         // variable declaration
@@ -434,39 +955,43 @@ Log("");
 Log("");
 #pragma region OPENGL_BUFFER
 
-        glGenVertexArrays( 1, &(cloth->vao));
-        glBindVertexArray( cloth->vao);
-
-            // position
-            glGenBuffers( 1, &(cloth->vbo_position));
-            glBindBuffer( GL_ARRAY_BUFFER, cloth->vbo_position);
-                glBufferData( GL_ARRAY_BUFFER, vertices_count * sizeof( vmath::vec4), &(p_position[0][0]), GL_DYNAMIC_DRAW);
-                glVertexAttribPointer( ATTRIBUTE_INDEX::POSITION, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
-                glEnableVertexAttribArray( ATTRIBUTE_INDEX::POSITION);
-            glBindBuffer( GL_ARRAY_BUFFER, 0);
-
-            // normal
-            glGenBuffers( 1, &(cloth->vbo_normal));
-            glBindBuffer( GL_ARRAY_BUFFER, cloth->vbo_normal);
-                glBufferData( GL_ARRAY_BUFFER, vertices_count * sizeof( vmath::vec4), &(p_normal[0][0]), GL_DYNAMIC_DRAW);
-                glVertexAttribPointer( ATTRIBUTE_INDEX::NORMAL, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
-                glEnableVertexAttribArray( ATTRIBUTE_INDEX::NORMAL);
-            glBindBuffer( GL_ARRAY_BUFFER, 0);
-
-            // texcoord
-            glGenBuffers( 1, &(cloth->vbo_texcoord));
-            glBindBuffer( GL_ARRAY_BUFFER, cloth->vbo_texcoord);
-                glBufferData( GL_ARRAY_BUFFER, vertices_count * sizeof( vmath::vec2), &(p_texcoord[0][0]), GL_DYNAMIC_DRAW);
-                glVertexAttribPointer( ATTRIBUTE_INDEX::TEXCOORD2D, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
-                glEnableVertexAttribArray( ATTRIBUTE_INDEX::TEXCOORD2D);
-            glBindBuffer( GL_ARRAY_BUFFER, 0);
-
-            // elements
-            glGenBuffers( 1, &(cloth->vbo_elements));
-            glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, cloth->vbo_elements);
-            glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices_count * sizeof( unsigned int), p_indices, GL_DYNAMIC_DRAW);
-
-        glBindVertexArray( 0);
+        // headless : positions and normals only live in OpenCL buffers
+        if( b_headless == false)
+        {
+            glGenVertexArrays( 1, &(cloth->vao));
+            glBindVertexArray( cloth->vao);
+
+                // position
+                glGenBuffers( 1, &(cloth->vbo_position));
+                glBindBuffer( GL_ARRAY_BUFFER, cloth->vbo_position);
+                    glBufferData( GL_ARRAY_BUFFER, vertices_count * sizeof( vmath::vec4), &(p_position[0][0]), GL_DYNAMIC_DRAW);
+                    glVertexAttribPointer( ATTRIBUTE_INDEX::POSITION, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+                    glEnableVertexAttribArray( ATTRIBUTE_INDEX::POSITION);
+                glBindBuffer( GL_ARRAY_BUFFER, 0);
+
+                // normal
+                glGenBuffers( 1, &(cloth->vbo_normal));
+                glBindBuffer( GL_ARRAY_BUFFER, cloth->vbo_normal);
+                    glBufferData( GL_ARRAY_BUFFER, vertices_count * sizeof( vmath::vec4), &(p_normal[0][0]), GL_DYNAMIC_DRAW);
+                    glVertexAttribPointer( ATTRIBUTE_INDEX::NORMAL, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+                    glEnableVertexAttribArray( ATTRIBUTE_INDEX::NORMAL);
+                glBindBuffer( GL_ARRAY_BUFFER, 0);
+
+                // texcoord
+                glGenBuffers( 1, &(cloth->vbo_texcoord));
+                glBindBuffer( GL_ARRAY_BUFFER, cloth->vbo_texcoord);
+                    glBufferData( GL_ARRAY_BUFFER, vertices_count * sizeof( vmath::vec2), &(p_texcoord[0][0]), GL_DYNAMIC_DRAW);
+                    glVertexAttribPointer( ATTRIBUTE_INDEX::TEXCOORD2D, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+                    glEnableVertexAttribArray( ATTRIBUTE_INDEX::TEXCOORD2D);
+                glBindBuffer( GL_ARRAY_BUFFER, 0);
+
+                // elements
+                glGenBuffers( 1, &(cloth->vbo_elements));
+                glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, cloth->vbo_elements);
+                glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices_count * sizeof( unsigned int), p_indices, GL_DYNAMIC_DRAW);
+
+            glBindVertexArray( 0);
+        }
 
 #pragma endregion
 
@@ -474,10 +999,18 @@ Log("");
 
 #pragma region OPENCL_BUFFER
 
-        cloth->ocl_position_graphic_resource = clCreateFromGLBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE, cloth->vbo_position, &ocl_err);
+        if( b_headless)
+        {
+            cloth->ocl_position_graphic_resource = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, vertices_count * sizeof( vmath::vec4), p_position, &ocl_err);
+        }
+        else
+        {
+            cloth->ocl_position_graphic_resource = clCreateFromGLBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE, cloth->vbo_position, &ocl_err);
+        }
+
         if( ocl_err != CL_SUCCESS)
         {
-            Log("clCreateFromGLBuffer() Failed(%d).", ocl_err);
+            Log("%s() Failed(%d).", b_headless ? "clCreateBuffer" : "clCreateFromGLBuffer", ocl_err);
             
             FREE_MEMORY( p_position);
             FREE_MEMORY( p_normal);
@@ -491,15 +1024,57 @@ Log("");
             }
 
             FREE_MEMORY( cloth);
+
+            return nullptr;
         }
 
 Log("");
 
-        cloth->ocl_old_position = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, vertices_count * sizeof( vmath::vec4), p_position, &ocl_err);
-        if( ocl_err != CL_SUCCESS)
+        if( b_headless == false)
         {
-            Log("clCreateBuffer() Failed(%d).", ocl_err);
-            
+            cloth->ocl_normal = clCreateFromGLBuffer( OpenCLUtil::GetContext(), CL_MEM_WRITE_ONLY, cloth->vbo_normal, &ocl_err);
+            cloth->b_normal_gl_shared = (ocl_err == CL_SUCCESS);
+
+            if( !cloth->b_normal_gl_shared)
+            {
+                Log("clCreateFromGLBuffer() Failed(%d), normals go through a buffer.", ocl_err);
+            }
+        }
+
+        if( !cloth->b_normal_gl_shared)
+        {
+
+            cloth->ocl_normal = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, vertices_count * sizeof( vmath::vec4), p_normal, &ocl_err);
+            if( ocl_err != CL_SUCCESS)
+            {
+                Log("clCreateBuffer() Failed(%d).", ocl_err);
+
+                FREE_MEMORY( p_position);
+                FREE_MEMORY( p_normal);
+                FREE_MEMORY( p_texcoord);
+                FREE_MEMORY( p_is_fixed_vertex);
+                FREE_MEMORY( p_indices);
+
+                cloth->release();
+
+                FREE_MEMORY( cloth);
+
+                return nullptr;
+            }
+
+            if( b_headless == false)
+            {
+                cloth->normal_readback.resize( vertices_count);
+            }
+        }
+
+Log("");
+
+        cloth->ocl_old_position = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, vertices_count * sizeof( vmath::vec4), p_position, &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            
             FREE_MEMORY( p_position);
             FREE_MEMORY( p_normal);
             FREE_MEMORY( p_texcoord);
@@ -514,6 +1089,26 @@ Log("");
             FREE_MEMORY( cloth);
         }
 
+Log("");
+
+        cloth->ocl_position_scratch = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE, vertices_count * sizeof( vmath::vec4), nullptr, &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            
+            FREE_MEMORY( p_position);
+            FREE_MEMORY( p_normal);
+            FREE_MEMORY( p_texcoord);
+            FREE_MEMORY( p_is_fixed_vertex);
+            FREE_MEMORY( p_indices);
+
+            cloth->release();
+
+            FREE_MEMORY( cloth);
+
+            return nullptr;
+        }
+
 Log("");
 
         cloth->ocl_p_fix_point = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, vertices_count * sizeof( bool), p_is_fixed_vertex, &ocl_err);
@@ -575,7 +1170,36 @@ Log("");
 
         cloth->damping = damping;
         cloth->mass = mass;
+
+        cloth->b_headless = b_headless;
+
+            // closest vertices at rest
+        cloth->collision_thickness = cloth->stick_group_distance[STICK_GROUP_ID::HORIZONTAL_DISTANCE_1_EVEN];
+        if( cloth->stick_group_distance[STICK_GROUP_ID::VERTICAL_DISTANCE_1_EVEN] < cloth->collision_thickness)
+        {
+            cloth->collision_thickness = cloth->stick_group_distance[STICK_GROUP_ID::VERTICAL_DISTANCE_1_EVEN];
+        }
 #pragma endregion
+
+        if( CreateTiledSticks( cloth) == false)
+        {
+            Log("CreateTiledSticks() Failed.");
+
+            FREE_MEMORY( p_position);
+            FREE_MEMORY( p_normal);
+            FREE_MEMORY( p_texcoord);
+            FREE_MEMORY( p_is_fixed_vertex);
+            FREE_MEMORY( p_indices);
+
+            cloth->release();
+
+            FREE_MEMORY( cloth);
+
+            return nullptr;
+        }
+
+        SetCompliance( cloth, stretch_compliance, shear_compliance, bend_compliance);
+
 Log("");
         // cleanup
         FREE_MEMORY( p_position);
@@ -596,6 +1220,11 @@ Log("");
             return;
         }
 
+        if( cloth->b_headless)
+        {
+            return;
+        }
+
         glBindVertexArray( cloth->vao);
             glDrawElements( GL_TRIANGLES, cloth->indices_count, GL_UNSIGNED_INT, nullptr);
         glBindVertexArray( 0);
@@ -610,12 +1239,99 @@ Log("");
             return;
         }
 
+        if( cloth->b_headless)
+        {
+            return;
+        }
+
         glBindVertexArray( cloth->vao);
             glDrawArrays( GL_POINTS, 0, cloth->vertices_count);
         glBindVertexArray( 0);
     }
 
-    static void UpdatePoints( Cloth cloth)
+        // event of the next command when profiling, else nullptr ( the pointer is valid until the next StageEvent())
+    static cl_event* StageEvent( Cloth cloth, STAGE stage)
+    {
+        // code
+        if( !cloth->b_profiling)
+        {
+            return nullptr;
+        }
+
+        cloth->stage_events.push_back( nullptr);
+        cloth->stage_event_stages.push_back( stage);
+
+        return &(cloth->stage_events.back());
+    }
+
+        // adds the kernel times of the pending events to stage_seconds and releases them ( waits for the commands)
+    static void CollectStageEvents( Cloth cloth)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        if( cloth->stage_events.empty())
+        {
+            return;
+        }
+
+        ocl_err = clWaitForEvents( (cl_uint) cloth->stage_events.size(), cloth->stage_events.data());
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log( "clWaitForEvents() Failed(%d).", ocl_err);
+        }
+
+        for( size_t i = 0; i < cloth->stage_events.size(); ++i)
+        {
+            cl_ulong start = 0;
+            cl_ulong end = 0;
+
+            ocl_err = clGetEventProfilingInfo( cloth->stage_events[i], CL_PROFILING_COMMAND_START, sizeof( cl_ulong), &start, nullptr);
+            ocl_err |= clGetEventProfilingInfo( cloth->stage_events[i], CL_PROFILING_COMMAND_END, sizeof( cl_ulong), &end, nullptr);
+
+            if( ocl_err == CL_SUCCESS)
+            {
+                cloth->stage_seconds[cloth->stage_event_stages[i]] += (end - start) * 1.0e-9;
+            }
+
+            CL_OBJECT_RELEASE( cloth->stage_events[i], clReleaseEvent);
+        }
+
+        cloth->stage_events.clear();
+        cloth->stage_event_stages.clear();
+    }
+
+        // position ( and normal) VBO for OpenCL, nothing to do headless
+    static cl_int AcquireGLObjects( Cloth cloth)
+    {
+        // code
+        if( cloth->b_headless)
+        {
+            return CL_SUCCESS;
+        }
+
+        cl_mem ocl_gl_objects[] = { cloth->ocl_position_graphic_resource, cloth->ocl_normal};
+        cl_uint gl_objects_count = cloth->b_normal_gl_shared ? 2 : 1;
+
+        return clEnqueueAcquireGLObjects( OpenCLUtil::GetCommandQueue(), gl_objects_count, ocl_gl_objects, 0, nullptr, nullptr);
+    }
+
+    static cl_int ReleaseGLObjects( Cloth cloth)
+    {
+        // code
+        if( cloth->b_headless)
+        {
+            return CL_SUCCESS;
+        }
+
+        cl_mem ocl_gl_objects[] = { cloth->ocl_position_graphic_resource, cloth->ocl_normal};
+        cl_uint gl_objects_count = cloth->b_normal_gl_shared ? 2 : 1;
+
+        return clEnqueueReleaseGLObjects( OpenCLUtil::GetCommandQueue(), gl_objects_count, ocl_gl_objects, 0, nullptr, nullptr);
+    }
+
+    static void UpdatePoints( Cloth cloth, vmath::vec4 step_gravity, float step_friction)
     {
         // variable declaration
         cl_int ocl_err;
@@ -630,17 +1346,17 @@ Log("");
         ocl_err = clSetKernelArg( ocl_update_vertices, 2, sizeof(cl_mem), &(cloth->ocl_p_fix_point));
         CL_CHECK_ERROR( ocl_err, clSetKernelArg);
 
-        ocl_err = clSetKernelArg( ocl_update_vertices, 3, sizeof(cl_float4), &(gravity[0]));
+        ocl_err = clSetKernelArg( ocl_update_vertices, 3, sizeof(cl_float4), &(step_gravity[0]));
         CL_CHECK_ERROR( ocl_err, clSetKernelArg);
 
-        ocl_err = clSetKernelArg( ocl_update_vertices, 4, sizeof(cl_float), &friction);
+        ocl_err = clSetKernelArg( ocl_update_vertices, 4, sizeof(cl_float), &step_friction);
         CL_CHECK_ERROR( ocl_err, clSetKernelArg);
 
         ocl_err = clSetKernelArg( ocl_update_vertices, 5, sizeof(cl_uint), &(cloth->vertices_count));
         CL_CHECK_ERROR( ocl_err, clSetKernelArg);
 
         size_t global_work_size[] = { cloth->vertices_count};
-        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_update_vertices, 1, nullptr, global_work_size, nullptr, 0, nullptr, nullptr);
+        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_update_vertices, 1, nullptr, global_work_size, nullptr, 0, nullptr, StageEvent( cloth, STAGE_PREDICT));
         CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
     }
 
@@ -672,7 +1388,7 @@ Log("");
         CL_CHECK_ERROR( ocl_err, clSetKernelArg);
 
         size_t global_work_size[] = { cloth->vertices_count};
-        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_constraint_vertices, 1, nullptr, global_work_size, nullptr, 0, nullptr, nullptr);
+        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_constraint_vertices, 1, nullptr, global_work_size, nullptr, 0, nullptr, StageEvent( cloth, STAGE_CONSTRAINTS));
         CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
     }
 
@@ -704,62 +1420,2022 @@ Log("");
 
             size_t global_work_size[] = { stick_count};
 
-            ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_update_sticks, 1, nullptr, global_work_size, nullptr, 0, nullptr, nullptr);
+            ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_update_sticks, 1, nullptr, global_work_size, nullptr, 0, nullptr, StageEvent( cloth, STAGE_CONSTRAINTS));
             CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
         }
     }
-    
 
-    void Update( Cloth cloth, float delta_time, vmath::vec3 bound_dimension)
+    static void SatisfyConstraintsTiled( Cloth cloth, vmath::vec3 bound_dimension, bool b_last_iteration)
     {
-#define CL_CHECK_ERROR(result, func_name)  \
-            if( result != CL_SUCCESS) \
-            { \
-                Log( #func_name "() Failed(%d).", result); \
-                return; \
-            }
-
-        // variale declaration
+        // variable declaration
         cl_int ocl_err;
+        cl_uint tile_size = COLORED_TILE_SIZE;
+        cl_uint b_write_normals = b_last_iteration;
 
         // code
-        if( !cloth)
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 0, sizeof( cl_mem), &(cloth->ocl_position_graphic_resource));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 1, sizeof( cl_mem), &(cloth->ocl_old_position));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 2, sizeof( cl_mem), &(cloth->ocl_p_fix_point));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 3, sizeof( cl_mem), &(cloth->ocl_tiled_sticks));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 4, sizeof( cl_mem), &(cloth->ocl_tile_stick_offsets));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 5, sizeof( cl_mem), &(cloth->ocl_tile_ids));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 6, sizeof( cl_mem), &(cloth->ocl_group_distance));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 8, sizeof( cl_uint), &(cloth->vertices_x));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 9, sizeof( cl_uint), &(cloth->vertices_y));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 10, sizeof( cl_uint), &tile_size);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 11, sizeof( cl_float), &friction);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 12, sizeof( cl_float), &bounce);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 13, sizeof( cl_float3), &(bound_dimension[0]));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 14, sizeof( cl_mem), &(cloth->ocl_normal));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            // normals fused into the phases of the last iteration
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 15, sizeof( cl_uint), &b_write_normals);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            // one launch per phase, the tiles of a phase never share a vertex
+        for( int phase = 0; phase < TILE_PHASE_COUNT; ++phase)
         {
-            Log( "Invalid Parameter.");
-            return;
+            cl_uint first_tile = cloth->phase_first_tile[phase];
+            size_t tiles_count = cloth->phase_first_tile[phase + 1] - first_tile;
+
+            if( tiles_count == 0)
+            {
+                continue;
+            }
+
+            ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled, 7, sizeof( cl_uint), &first_tile);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            size_t global_work_size[] = { tiles_count * tiled_local_size};
+            size_t local_work_size[] = { tiled_local_size};
+
+            ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_satisfy_constraints_tiled, 1, nullptr, global_work_size, local_work_size, 0, nullptr, StageEvent( cloth, STAGE_CONSTRAINTS));
+            CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
         }
+    }
+    
 
-        ocl_err = clEnqueueAcquireGLObjects( OpenCLUtil::GetCommandQueue(), 1, &(cloth->ocl_position_graphic_resource), 0, nullptr, nullptr);
-        CL_CHECK_ERROR( ocl_err, clEnqueueAcquireGLObjects);
+    static void SatisfyConstraintsLocal( Cloth cloth, vmath::vec3 bound_dimension)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        cl_uint tile_size = LOCAL_TILE_SIZE;
+        size_t region = LOCAL_TILE_SIZE + 2 * LOCAL_TILE_HALO;
+
+        // code
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 2, sizeof( cl_mem), &(cloth->ocl_old_position));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 3, sizeof( cl_mem), &(cloth->ocl_p_fix_point));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 4, sizeof( cl_mem), &(cloth->ocl_group_distance));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 5, sizeof( cl_uint), &(cloth->vertices_x));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 6, sizeof( cl_uint), &(cloth->vertices_y));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 7, sizeof( cl_uint), &tile_size);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 9, sizeof( cl_float), &friction);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 10, sizeof( cl_float), &bounce);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 11, sizeof( cl_float3), &(bound_dimension[0]));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 12, sizeof( cl_mem), &(cloth->ocl_normal));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 14, region * region * sizeof( cl_float4), nullptr);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 15, region * region * sizeof( cl_float4), nullptr);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 16, region * region * sizeof( cl_uchar), nullptr);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            // every launch runs LOCAL_TILE_INNER_ITERATIONS iterations on-chip, halos are exchanged between launches
+        cl_mem ocl_positions[] = { cloth->ocl_position_graphic_resource, cloth->ocl_position_scratch};
 
-        UpdatePoints( cloth);
+        size_t tiles_count = (size_t)((cloth->vertices_x + LOCAL_TILE_SIZE - 1) / LOCAL_TILE_SIZE) * ((cloth->vertices_y + LOCAL_TILE_SIZE - 1) / LOCAL_TILE_SIZE);
+        size_t global_work_size[] = { tiles_count * local_tiles_local_size};
+        size_t local_work_size[] = { local_tiles_local_size};
 
-        for( int i = 0; i < CONTRAINT_SATISFY_ITERATION; ++i)
+        int launches_count = 0;
+
+        for( int i = 0; i < CONTRAINT_SATISFY_ITERATION; i += LOCAL_TILE_INNER_ITERATIONS, ++launches_count)
         {
-           ConstraintPoints( cloth, bound_dimension);
-           UpdateSticks( cloth);
+            cl_uint inner_iterations = LOCAL_TILE_INNER_ITERATIONS;
+            if( (CONTRAINT_SATISFY_ITERATION - i) < LOCAL_TILE_INNER_ITERATIONS)
+            {
+                inner_iterations = CONTRAINT_SATISFY_ITERATION - i;
+            }
+
+            ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 0, sizeof( cl_mem), &(ocl_positions[launches_count % 2]));
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 1, sizeof( cl_mem), &(ocl_positions[(launches_count + 1) % 2]));
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 8, sizeof( cl_uint), &inner_iterations);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+                // normals fused into the last launch
+            cl_uint b_write_normals = (i + LOCAL_TILE_INNER_ITERATIONS) >= CONTRAINT_SATISFY_ITERATION;
+
+            ocl_err = clSetKernelArg( ocl_satisfy_constraints_local, 13, sizeof( cl_uint), &b_write_normals);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_satisfy_constraints_local, 1, nullptr, global_work_size, local_work_size, 0, nullptr, StageEvent( cloth, STAGE_CONSTRAINTS));
+            CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
         }
 
-        ocl_err = clEnqueueReleaseGLObjects( OpenCLUtil::GetCommandQueue(), 1, &(cloth->ocl_position_graphic_resource), 0, nullptr, nullptr);
-        CL_CHECK_ERROR( ocl_err, clEnqueueReleaseGLObjects);
+            // odd number of launches, the result is in the scratch buffer
+        if( launches_count % 2)
+        {
+            ocl_err = clEnqueueCopyBuffer( OpenCLUtil::GetCommandQueue(), cloth->ocl_position_scratch, cloth->ocl_position_graphic_resource, 0, 0, cloth->vertices_count * sizeof( cl_float4), 0, nullptr, StageEvent( cloth, STAGE_CONSTRAINTS));
+            CL_CHECK_ERROR( ocl_err, clEnqueueCopyBuffer);
+        }
     }
 
-    void DeleteCloth( Cloth cloth)
+        // inverse mass of one of vertices_count vertices sharing mass ( 1 for a massless cloth)
+    static float ParticleInverseMass( float mass, unsigned int vertices_count)
     {
-        if( cloth)
-        {
-            cloth->release();
-            delete cloth;
-            cloth = nullptr;
-        }
+        // code
+        return (mass > 0.0f) ? (float) vertices_count / mass : 1.0f;
     }
-    
+
+    static void SatisfyConstraintsXPBD( Cloth cloth, vmath::vec3 bound_dimension, float step_friction, bool b_last_substep)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        cl_uint tile_size = COLORED_TILE_SIZE;
+        cl_uint b_write_normals = b_last_substep;
+        cl_float inverse_mass = ParticleInverseMass( cloth->mass, cloth->vertices_count);
+
+        // code
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 0, sizeof( cl_mem), &(cloth->ocl_position_graphic_resource));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 1, sizeof( cl_mem), &(cloth->ocl_old_position));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 2, sizeof( cl_mem), &(cloth->ocl_p_fix_point));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 3, sizeof( cl_mem), &(cloth->ocl_tiled_sticks));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 4, sizeof( cl_mem), &(cloth->ocl_tile_stick_offsets));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 5, sizeof( cl_mem), &(cloth->ocl_tile_ids));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 6, sizeof( cl_mem), &(cloth->ocl_group_distance));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 7, sizeof( cl_mem), &(cloth->ocl_group_alpha));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 9, sizeof( cl_uint), &(cloth->vertices_x));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 10, sizeof( cl_uint), &(cloth->vertices_y));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 11, sizeof( cl_uint), &tile_size);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 12, sizeof( cl_float), &inverse_mass);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 13, sizeof( cl_float), &step_friction);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 14, sizeof( cl_float), &bounce);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 15, sizeof( cl_float3), &(bound_dimension[0]));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 16, sizeof( cl_mem), &(cloth->ocl_normal));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            // normals fused into the phases of the last substep
+        ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 17, sizeof( cl_uint), &b_write_normals);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        for( int phase = 0; phase < TILE_PHASE_COUNT; ++phase)
+        {
+            cl_uint first_tile = cloth->phase_first_tile[phase];
+            size_t tiles_count = cloth->phase_first_tile[phase + 1] - first_tile;
+
+            if( tiles_count == 0)
+            {
+                continue;
+            }
+
+            ocl_err = clSetKernelArg( ocl_satisfy_constraints_tiled_xpbd, 8, sizeof( cl_uint), &first_tile);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            size_t global_work_size[] = { tiles_count * tiled_local_size};
+            size_t local_work_size[] = { tiled_local_size};
+
+            ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_satisfy_constraints_tiled_xpbd, 1, nullptr, global_work_size, local_work_size, 0, nullptr, StageEvent( cloth, STAGE_CONSTRAINTS));
+            CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+        }
+    }
+
+    /**
+     * @brief StepXPBD() : XPBD_SUBSTEPS of ( predict, one constraint iteration) for one frame
+     * 
+     * @description:
+     *          The frame keeps the gravity of the Verlet solver, a substep of 1 / n of the frame gets 1 / n^2 of
+     *          its displacement and friction^( 1 / n) of its velocity. Stiffness comes from the compliance of the
+     *          groups ( SetCompliance()), not from the iteration count.
+     */
+    static void StepXPBD( Cloth cloth, vmath::vec3 bound_dimension)
+    {
+        // code
+        vmath::vec4 substep_gravity = gravity * (1.0f / (XPBD_SUBSTEPS * XPBD_SUBSTEPS));
+        float substep_friction = powf( friction, 1.0f / XPBD_SUBSTEPS);
+
+        for( int i = 0; i < XPBD_SUBSTEPS; ++i)
+        {
+            UpdatePoints( cloth, substep_gravity, substep_friction);
+            SatisfyConstraintsXPBD( cloth, bound_dimension, substep_friction, (i + 1) == XPBD_SUBSTEPS);
+        }
+    }
+
+    static bool HasCollisions( Cloth cloth)
+    {
+        // code
+        return cloth->b_self_collision || (cloth->spheres_count > 0) || (cloth->capsules_count > 0) || (cloth->ocl_mesh_cell_start != nullptr);
+    }
+
+    /**
+     * @brief BuildCollisionGrid() : counting sort of the vertices by spatial hash slot
+     * 
+     * @description:
+     *          hash_vertices() counts the vertices of every slot and ranks each vertex in its slot ( atomic),
+     *          the counts are scanned into the first sorted vertex of every slot ( one block per work-group, the block
+     *          totals are scanned the same way level by level, then added back down), scatter_vertices() places
+     *          every vertex at first + rank. All passes are O( vertices).
+     */
+    static void BuildCollisionGrid( Cloth cloth)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        cl_uint zero = 0;
+
+        // code
+        ocl_err = clEnqueueFillBuffer( OpenCLUtil::GetCommandQueue(), cloth->ocl_cell_start, &zero, sizeof( cl_uint), 0, cloth->hash_table_size * sizeof( cl_uint), 0, nullptr, StageEvent( cloth, STAGE_COLLISIONS));
+        CL_CHECK_ERROR( ocl_err, clEnqueueFillBuffer);
+
+            // count
+        ocl_err = clSetKernelArg( ocl_hash_vertices, 0, sizeof( cl_mem), &(cloth->ocl_position_graphic_resource));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_hash_vertices, 1, sizeof( cl_mem), &(cloth->ocl_cell_start));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_hash_vertices, 2, sizeof( cl_mem), &(cloth->ocl_vertex_cell));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_hash_vertices, 3, sizeof( cl_mem), &(cloth->ocl_vertex_rank));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_hash_vertices, 4, sizeof( cl_float), &(cloth->collision_thickness));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_hash_vertices, 5, sizeof( cl_uint), &(cloth->hash_table_size));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_hash_vertices, 6, sizeof( cl_uint), &(cloth->vertices_count));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        size_t global_work_size[] = { cloth->vertices_count};
+        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_hash_vertices, 1, nullptr, global_work_size, nullptr, 0, nullptr, StageEvent( cloth, STAGE_COLLISIONS));
+        CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+
+            // scan, level 0 is the slots, level i + 1 the block totals of level i
+        size_t local_work_size[] = { scan_local_size};
+
+        for( size_t level = 0; level < cloth->scan_level_count.size(); ++level)
+        {
+            cl_mem ocl_data = (level == 0) ? cloth->ocl_cell_start : cloth->ocl_scan_block_sums[level - 1];
+            cl_mem ocl_block_sums = (level < cloth->ocl_scan_block_sums.size()) ? cloth->ocl_scan_block_sums[level] : nullptr;
+            cl_uint count = cloth->scan_level_count[level];
+
+            ocl_err = clSetKernelArg( ocl_scan_cells, 0, sizeof( cl_mem), &ocl_data);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            ocl_err = clSetKernelArg( ocl_scan_cells, 1, sizeof( cl_mem), &ocl_block_sums);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            ocl_err = clSetKernelArg( ocl_scan_cells, 2, sizeof( cl_uint), &count);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            ocl_err = clSetKernelArg( ocl_scan_cells, 3, scan_local_size * sizeof( cl_uint), nullptr);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            size_t global_work_size[] = { ((count + scan_local_size - 1) / scan_local_size) * scan_local_size};
+
+            ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_scan_cells, 1, nullptr, global_work_size, local_work_size, 0, nullptr, StageEvent( cloth, STAGE_COLLISIONS));
+            CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+        }
+
+        for( size_t level = cloth->ocl_scan_block_sums.size(); level > 0; --level)
+        {
+            cl_mem ocl_data = (level == 1) ? cloth->ocl_cell_start : cloth->ocl_scan_block_sums[level - 2];
+            cl_uint count = cloth->scan_level_count[level - 1];
+
+            ocl_err = clSetKernelArg( ocl_add_block_offsets, 0, sizeof( cl_mem), &ocl_data);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            ocl_err = clSetKernelArg( ocl_add_block_offsets, 1, sizeof( cl_mem), &(cloth->ocl_scan_block_sums[level - 1]));
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            ocl_err = clSetKernelArg( ocl_add_block_offsets, 2, sizeof( cl_uint), &count);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            size_t global_work_size[] = { ((count + scan_local_size - 1) / scan_local_size) * scan_local_size};
+
+            ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_add_block_offsets, 1, nullptr, global_work_size, local_work_size, 0, nullptr, StageEvent( cloth, STAGE_COLLISIONS));
+            CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+        }
+
+            // scatter
+        ocl_err = clSetKernelArg( ocl_scatter_vertices, 0, sizeof( cl_mem), &(cloth->ocl_vertex_cell));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_scatter_vertices, 1, sizeof( cl_mem), &(cloth->ocl_vertex_rank));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_scatter_vertices, 2, sizeof( cl_mem), &(cloth->ocl_cell_start));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_scatter_vertices, 3, sizeof( cl_mem), &(cloth->ocl_sorted_vertices));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_scatter_vertices, 4, sizeof( cl_uint), &(cloth->vertices_count));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_scatter_vertices, 1, nullptr, global_work_size, nullptr, 0, nullptr, StageEvent( cloth, STAGE_COLLISIONS));
+        CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+    }
+
+    static void CollideVertices( Cloth cloth)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+            // unused inputs are passed as null buffers
+        cl_mem ocl_cell_start = cloth->b_self_collision ? cloth->ocl_cell_start : nullptr;
+        cl_mem ocl_sorted_vertices = cloth->b_self_collision ? cloth->ocl_sorted_vertices : nullptr;
+        cl_mem ocl_spheres = (cloth->spheres_count > 0) ? cloth->ocl_spheres : nullptr;
+        cl_mem ocl_capsules = (cloth->capsules_count > 0) ? cloth->ocl_capsules : nullptr;
+
+        // code
+        if( cloth->b_self_collision)
+        {
+            BuildCollisionGrid( cloth);
+        }
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 0, sizeof( cl_mem), &(cloth->ocl_position_graphic_resource));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 1, sizeof( cl_mem), &(cloth->ocl_position_scratch));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 2, sizeof( cl_mem), &(cloth->ocl_old_position));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 3, sizeof( cl_mem), &(cloth->ocl_p_fix_point));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 4, sizeof( cl_mem), &ocl_cell_start);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 5, sizeof( cl_mem), &ocl_sorted_vertices);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 6, sizeof( cl_uint), &(cloth->hash_table_size));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 7, sizeof( cl_mem), &ocl_spheres);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 8, sizeof( cl_uint), &(cloth->spheres_count));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 9, sizeof( cl_mem), &ocl_capsules);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 10, sizeof( cl_uint), &(cloth->capsules_count));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 11, sizeof( cl_mem), &(cloth->ocl_mesh_vertices));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 12, sizeof( cl_mem), &(cloth->ocl_mesh_indices));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 13, sizeof( cl_mem), &(cloth->ocl_mesh_cell_start));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 14, sizeof( cl_mem), &(cloth->ocl_mesh_cell_triangles));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 15, sizeof( cl_float4), &(cloth->mesh_origin[0]));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 16, sizeof( cl_uint), &(cloth->mesh_cells[0]));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 17, sizeof( cl_uint), &(cloth->mesh_cells[1]));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 18, sizeof( cl_uint), &(cloth->mesh_cells[2]));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 19, sizeof( cl_float), &(cloth->collision_thickness));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 20, sizeof( cl_uint), &(cloth->vertices_x));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_collide_vertices, 21, sizeof( cl_uint), &(cloth->vertices_count));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        size_t global_work_size[] = { cloth->vertices_count};
+        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_collide_vertices, 1, nullptr, global_work_size, nullptr, 0, nullptr, StageEvent( cloth, STAGE_COLLISIONS));
+        CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+
+            // the self collision reads the neighbours, the result goes through the scratch buffer
+        ocl_err = clEnqueueCopyBuffer( OpenCLUtil::GetCommandQueue(), cloth->ocl_position_scratch, cloth->ocl_position_graphic_resource, 0, 0, cloth->vertices_count * sizeof( cl_float4), 0, nullptr, StageEvent( cloth, STAGE_COLLISIONS));
+        CL_CHECK_ERROR( ocl_err, clEnqueueCopyBuffer);
+    }
+
+    static void UpdateNormals( Cloth cloth)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        ocl_err = clSetKernelArg( ocl_normal_calculation, 0, sizeof( cl_mem), &(cloth->ocl_normal));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_normal_calculation, 1, sizeof( cl_mem), &(cloth->ocl_position_graphic_resource));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_normal_calculation, 2, sizeof( cl_uint), &(cloth->vertices_x));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_normal_calculation, 3, sizeof( cl_uint), &(cloth->vertices_y));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        size_t global_work_size[] = { cloth->vertices_count};
+        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_normal_calculation, 1, nullptr, global_work_size, nullptr, 0, nullptr, StageEvent( cloth, STAGE_NORMALS));
+        CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+    }
+
+    void Update( Cloth cloth, float delta_time, vmath::vec3 bound_dimension)
+    {
+#define CL_CHECK_ERROR(result, func_name)  \
+            if( result != CL_SUCCESS) \
+            { \
+                Log( #func_name "() Failed(%d).", result); \
+                return; \
+            }
+
+        // variale declaration
+        cl_int ocl_err;
+
+        // code
+        if( !cloth)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        ocl_err = AcquireGLObjects( cloth);
+        CL_CHECK_ERROR( ocl_err, clEnqueueAcquireGLObjects);
+
+        switch( cloth->solver)
+        {
+            case SOLVER_XPBD:
+                StepXPBD( cloth, bound_dimension);
+            break;
+
+            case SOLVER_LOCAL_TILES:
+                UpdatePoints( cloth, gravity, friction);
+                SatisfyConstraintsLocal( cloth, bound_dimension);
+            break;
+
+            case SOLVER_COLORED_TILES:
+                UpdatePoints( cloth, gravity, friction);
+
+                for( int i = 0; i < CONTRAINT_SATISFY_ITERATION; ++i)
+                {
+                    SatisfyConstraintsTiled( cloth, bound_dimension, (i + 1) == CONTRAINT_SATISFY_ITERATION);
+                }
+            break;
+
+            default:
+                UpdatePoints( cloth, gravity, friction);
+
+                for( int i = 0; i < CONTRAINT_SATISFY_ITERATION; ++i)
+                {
+                    ConstraintPoints( cloth, bound_dimension);
+                    UpdateSticks( cloth);
+                }
+            break;
+        }
+
+            // colliders and self collision, once per frame on the solved positions
+        bool b_collisions = HasCollisions( cloth);
+        if( b_collisions)
+        {
+            CollideVertices( cloth);
+        }
+
+            // the tiled solvers write the normals in their last iteration, before the collisions
+        if( (cloth->solver == SOLVER_STICK_GROUPS) || b_collisions)
+        {
+            UpdateNormals( cloth);
+        }
+
+        ocl_err = ReleaseGLObjects( cloth);
+        CL_CHECK_ERROR( ocl_err, clEnqueueReleaseGLObjects);
+
+        if( !cloth->b_normal_gl_shared && !cloth->b_headless)
+        {
+            ocl_err = clEnqueueReadBuffer( OpenCLUtil::GetCommandQueue(), cloth->ocl_normal, CL_TRUE, 0, cloth->vertices_count * sizeof( vmath::vec4), cloth->normal_readback.data(), 0, nullptr, nullptr);
+            CL_CHECK_ERROR( ocl_err, clEnqueueReadBuffer);
+
+            glBindBuffer( GL_ARRAY_BUFFER, cloth->vbo_normal);
+                glBufferSubData( GL_ARRAY_BUFFER, 0, cloth->vertices_count * sizeof( vmath::vec4), cloth->normal_readback.data());
+            glBindBuffer( GL_ARRAY_BUFFER, 0);
+        }
+
+            // no event outlives its Update() ( a few hundred per frame)
+        CollectStageEvents( cloth);
+    }
+
+    void SetSolver( Cloth cloth, SOLVER solver)
+    {
+        // code
+        if( !cloth || (solver < 0) || (solver >= SOLVER_COUNT))
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        if( (solver == SOLVER_LOCAL_TILES) && !b_local_tiles_supported)
+        {
+            Log( "SOLVER_LOCAL_TILES not supported by the device.");
+            return;
+        }
+
+        cloth->solver = solver;
+    }
+
+    SOLVER GetSolver( Cloth cloth)
+    {
+        // code
+        return cloth ? cloth->solver : SOLVER_COUNT;
+    }
+
+        // compliance of the sticks of a group : stretch, shear ( diagonal) or bend ( distance 2)
+    static float GroupCompliance( int group, float stretch, float shear, float bend)
+    {
+        // code
+        switch( group)
+        {
+            case STICK_GROUP_ID::HORIZONTAL_DISTANCE_1_EVEN:
+            case STICK_GROUP_ID::HORIZONTAL_DISTANCE_1_ODD:
+            case STICK_GROUP_ID::VERTICAL_DISTANCE_1_EVEN:
+            case STICK_GROUP_ID::VERTICAL_DISTANCE_1_ODD:
+                return stretch;
+
+            case STICK_GROUP_ID::DIAGONAL_DISTANCE_1_EVEN:
+            case STICK_GROUP_ID::DIAGONAL_DISTANCE_1_ODD:
+                return shear;
+
+            default:
+                return bend;
+        }
+    }
+
+    /**
+     * @brief GroupAlpha() : alpha tilde of the sticks of a group for a SOLVER_XPBD substep
+     * 
+     * @description:
+     *          compliance is per unit length and per unit inverse mass : a stick of rest_length between vertices of
+     *          inverse_mass gets compliance * rest_length * inverse_mass. A row of n sticks of length l / n then has
+     *          the compliance of one stick of length l, and alpha_tilde / ( w0 + w1) no longer grows with the mass of
+     *          the vertices, so the same compliance gives about the same softness at every resolution and mass.
+     */
+    static float GroupAlpha( float compliance, float rest_length, float inverse_mass)
+    {
+        // code
+        float substep_time = XPBD_FRAME_TIME / XPBD_SUBSTEPS;
+
+        return compliance * rest_length * inverse_mass / (substep_time * substep_time);
+    }
+
+    void SetCompliance( Cloth cloth, float stretch, float shear, float bend)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        float group_alpha[STICK_GROUP_ID::GROUP_COUNT];
+
+        // code
+        if( !cloth || (stretch < 0.0f) || (shear < 0.0f) || (bend < 0.0f))
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        float inverse_mass = ParticleInverseMass( cloth->mass, cloth->vertices_count);
+
+        for( int i = 0; i < STICK_GROUP_ID::GROUP_COUNT; ++i)
+        {
+            cloth->group_compliance[i] = GroupCompliance( i, stretch, shear, bend);
+            group_alpha[i] = GroupAlpha( cloth->group_compliance[i], cloth->stick_group_distance[i], inverse_mass);
+        }
+
+        ocl_err = clEnqueueWriteBuffer( OpenCLUtil::GetCommandQueue(), cloth->ocl_group_alpha, CL_TRUE, 0, sizeof( group_alpha), group_alpha, 0, nullptr, nullptr);
+        CL_CHECK_ERROR( ocl_err, clEnqueueWriteBuffer);
+    }
+
+    static bool CreateCollisionGrid( Cloth cloth)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        cl_mem *p_ocl_vertex_buffers[] = { &(cloth->ocl_vertex_cell), &(cloth->ocl_vertex_rank), &(cloth->ocl_sorted_vertices)};
+
+        // code
+            // power of 2 slots, at least one per vertex
+        cl_uint table_size = 1;
+        while( table_size < cloth->vertices_count)
+        {
+            table_size <<= 1;
+        }
+
+        cloth->ocl_cell_start = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE, table_size * sizeof( cl_uint), nullptr, &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        for( int i = 0; i < _ARRAYSIZE( p_ocl_vertex_buffers); ++i)
+        {
+            *(p_ocl_vertex_buffers[i]) = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE, cloth->vertices_count * sizeof( cl_uint), nullptr, &ocl_err);
+            if( ocl_err != CL_SUCCESS)
+            {
+                Log("clCreateBuffer() Failed(%d).", ocl_err);
+                return false;
+            }
+        }
+
+            // block totals of every scan level, down to a single block
+        cl_uint count = table_size;
+        cloth->scan_level_count.push_back( count);
+
+        while( count > scan_local_size)
+        {
+            count = (cl_uint)((count + scan_local_size - 1) / scan_local_size);
+
+            cl_mem ocl_block_sums = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE, count * sizeof( cl_uint), nullptr, &ocl_err);
+            if( ocl_err != CL_SUCCESS)
+            {
+                Log("clCreateBuffer() Failed(%d).", ocl_err);
+                return false;
+            }
+
+            cloth->ocl_scan_block_sums.push_back( ocl_block_sums);
+            cloth->scan_level_count.push_back( count);
+        }
+
+        cloth->hash_table_size = table_size;
+
+        return true;
+    }
+
+    static void TriangleBounds( Cloth cloth, unsigned int triangle, float *p_min, float *p_max)
+    {
+        // code
+        for( int i = 0; i < 3; ++i)
+        {
+            p_min[i] = FLT_MAX;
+            p_max[i] = -FLT_MAX;
+        }
+
+        for( int j = 0; j < 3; ++j)
+        {
+            const vmath::vec4 &vertex = cloth->mesh_vertices[cloth->mesh_indices[3 * triangle + j]];
+
+            for( int i = 0; i < 3; ++i)
+            {
+                p_min[i] = (vertex[i] < p_min[i]) ? vertex[i] : p_min[i];
+                p_max[i] = (vertex[i] > p_max[i]) ? vertex[i] : p_max[i];
+            }
+        }
+    }
+
+    /**
+     * @brief BinMeshCollider() : dense uniform grid over the mesh collider, every cell lists the triangles whose
+     *                            bounds + collision_thickness overlap it, so a vertex only reads the triangles of its own cell
+     * 
+     * @description:
+     *          The cell is the mean triangle extent ( at least the thickness), doubled until the grid has at most
+     *          MESH_GRID_MAX_CELLS cells. The mesh is static, the grid is built once on the host ( counting sort).
+     */
+    static bool BinMeshCollider( Cloth cloth)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        float bound_min[3] = { FLT_MAX, FLT_MAX, FLT_MAX};
+        float bound_max[3] = { -FLT_MAX, -FLT_MAX, -FLT_MAX};
+        float triangle_min[3];
+        float triangle_max[3];
+        float extent_sum = 0.0f;
+
+        std::vector<cl_uint> cell_start;
+        std::vector<cl_uint> cell_fill;
+        std::vector<cl_uint> cell_triangles;
+
+        // code
+        cloth->release_mesh_collider();
+
+        unsigned int triangles_count = (unsigned int)(cloth->mesh_indices.size() / 3);
+        if( triangles_count == 0)
+        {
+            return true;
+        }
+
+        float thickness = cloth->collision_thickness;
+
+        for( unsigned int t = 0; t < triangles_count; ++t)
+        {
+            TriangleBounds( cloth, t, triangle_min, triangle_max);
+
+            float extent = 0.0f;
+            for( int i = 0; i < 3; ++i)
+            {
+                bound_min[i] = (triangle_min[i] < bound_min[i]) ? triangle_min[i] : bound_min[i];
+                bound_max[i] = (triangle_max[i] > bound_max[i]) ? triangle_max[i] : bound_max[i];
+                extent = ((triangle_max[i] - triangle_min[i]) > extent) ? (triangle_max[i] - triangle_min[i]) : extent;
+            }
+
+            extent_sum += extent;
+        }
+
+        float cell_size = extent_sum / triangles_count;
+        if( cell_size < thickness)
+        {
+            cell_size = thickness;
+        }
+
+        size_t cells_count = 0;
+        for( ;;)
+        {
+            cells_count = 1;
+            for( int i = 0; i < 3; ++i)
+            {
+                cloth->mesh_cells[i] = (cl_uint)((bound_max[i] - bound_min[i] + 2.0f * thickness) / cell_size) + 1;
+                cells_count *= cloth->mesh_cells[i];
+            }
+
+            if( cells_count <= MESH_GRID_MAX_CELLS)
+            {
+                break;
+            }
+
+            cell_size *= 2.0f;
+        }
+
+        cloth->mesh_origin = vmath::vec4( bound_min[0] - thickness, bound_min[1] - thickness, bound_min[2] - thickness, cell_size);
+
+            // pass 0 counts the triangles of every cell, pass 1 lists them
+        cell_start.assign( cells_count + 1, 0);
+
+        for( int pass = 0; pass < 2; ++pass)
+        {
+            for( unsigned int t = 0; t < triangles_count; ++t)
+            {
+                int first_cell[3];
+                int last_cell[3];
+
+                TriangleBounds( cloth, t, triangle_min, triangle_max);
+
+                for( int i = 0; i < 3; ++i)
+                {
+                    first_cell[i] = (int)((triangle_min[i] - thickness - cloth->mesh_origin[i]) / cell_size);
+                    last_cell[i] = (int)((triangle_max[i] + thickness - cloth->mesh_origin[i]) / cell_size);
+
+                    first_cell[i] = (first_cell[i] < 0) ? 0 : first_cell[i];
+                    last_cell[i] = (last_cell[i] > (int)(cloth->mesh_cells[i] - 1)) ? (int)(cloth->mesh_cells[i] - 1) : last_cell[i];
+                }
+
+                for( int z = first_cell[2]; z <= last_cell[2]; ++z)
+                {
+                    for( int y = first_cell[1]; y <= last_cell[1]; ++y)
+                    {
+                        for( int x = first_cell[0]; x <= last_cell[0]; ++x)
+                        {
+                            size_t cell = ((size_t)z * cloth->mesh_cells[1] + y) * cloth->mesh_cells[0] + x;
+
+                            if( pass == 0)
+                            {
+                                ++cell_start[cell + 1];
+                            }
+                            else
+                            {
+                                cell_triangles[cell_fill[cell]++] = t;
+                            }
+                        }
+                    }
+                }
+            }
+
+            if( pass == 0)
+            {
+                for( size_t i = 1; i <= cells_count; ++i)
+                {
+                    cell_start[i] += cell_start[i - 1];
+                }
+
+                cell_fill = cell_start;
+                cell_triangles.resize( cell_start[cells_count]);
+            }
+        }
+
+        cloth->ocl_mesh_vertices = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, cloth->mesh_vertices.size() * sizeof( vmath::vec4), cloth->mesh_vertices.data(), &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            cloth->release_mesh_collider();
+            return false;
+        }
+
+        cloth->ocl_mesh_indices = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, cloth->mesh_indices.size() * sizeof( cl_uint), cloth->mesh_indices.data(), &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            cloth->release_mesh_collider();
+            return false;
+        }
+
+        cloth->ocl_mesh_cell_triangles = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, cell_triangles.size() * sizeof( cl_uint), cell_triangles.data(), &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            cloth->release_mesh_collider();
+            return false;
+        }
+
+            // last, a mesh collider is present once its cells are
+        cloth->ocl_mesh_cell_start = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, cell_start.size() * sizeof( cl_uint), cell_start.data(), &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clCreateBuffer() Failed(%d).", ocl_err);
+            cloth->release_mesh_collider();
+            return false;
+        }
+
+        return true;
+    }
+
+        // buffer grows only, moving colliders are re-uploaded every frame
+    static bool UploadColliders( cl_mem *p_ocl_colliders, unsigned int *p_capacity, const vmath::vec4 *p_colliders, unsigned int count)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        if( count == 0)
+        {
+            return true;
+        }
+
+        if( count > *p_capacity)
+        {
+            CL_OBJECT_RELEASE( *p_ocl_colliders, clReleaseMemObject);
+            *p_capacity = 0;
+
+            *p_ocl_colliders = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_ONLY, count * sizeof( vmath::vec4), nullptr, &ocl_err);
+            if( ocl_err != CL_SUCCESS)
+            {
+                Log("clCreateBuffer() Failed(%d).", ocl_err);
+                return false;
+            }
+
+            *p_capacity = count;
+        }
+
+        ocl_err = clEnqueueWriteBuffer( OpenCLUtil::GetCommandQueue(), *p_ocl_colliders, CL_TRUE, 0, count * sizeof( vmath::vec4), p_colliders, 0, nullptr, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("clEnqueueWriteBuffer() Failed(%d).", ocl_err);
+            return false;
+        }
+
+        return true;
+    }
+
+    void SetSphereColliders( Cloth cloth, const vmath::vec4 *p_spheres, unsigned int count)
+    {
+        // code
+        if( !cloth || ((count > 0) && !p_spheres))
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        cloth->spheres_count = 0;
+
+        if( UploadColliders( &(cloth->ocl_spheres), &(cloth->spheres_capacity), p_spheres, count) == false)
+        {
+            Log( "UploadColliders() Failed.");
+            return;
+        }
+
+        cloth->spheres_count = count;
+    }
+
+    void SetCapsuleColliders( Cloth cloth, const vmath::vec4 *p_capsules, unsigned int count)
+    {
+        // code
+        if( !cloth || ((count > 0) && !p_capsules))
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        cloth->capsules_count = 0;
+
+        if( UploadColliders( &(cloth->ocl_capsules), &(cloth->capsules_capacity), p_capsules, 2 * count) == false)
+        {
+            Log( "UploadColliders() Failed.");
+            return;
+        }
+
+        cloth->capsules_count = count;
+    }
+
+    void SetMeshCollider( Cloth cloth, const vmath::vec3 *p_vertices, unsigned int vertices_count, const unsigned int *p_indices, unsigned int indices_count)
+    {
+        // code
+        if( !cloth || (indices_count % 3) || ((indices_count > 0) && (!p_vertices || !p_indices)))
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        for( unsigned int i = 0; i < indices_count; ++i)
+        {
+            if( p_indices[i] >= vertices_count)
+            {
+                Log( "Invalid Parameter.");
+                return;
+            }
+        }
+
+        cloth->mesh_vertices.resize( (indices_count > 0) ? vertices_count : 0);
+        for( size_t i = 0; i < cloth->mesh_vertices.size(); ++i)
+        {
+            cloth->mesh_vertices[i] = vmath::vec4( p_vertices[i], 1.0f);
+        }
+
+        cloth->mesh_indices.assign( p_indices, p_indices + indices_count);
+
+        if( BinMeshCollider( cloth) == false)
+        {
+            Log( "BinMeshCollider() Failed.");
+
+            cloth->mesh_vertices.clear();
+            cloth->mesh_indices.clear();
+        }
+    }
+
+    void SetCollisionThickness( Cloth cloth, float thickness)
+    {
+        // code
+        if( !cloth || (thickness <= 0.0f))
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        cloth->collision_thickness = thickness;
+
+            // the triangles are binned with the thickness around them
+        if( !cloth->mesh_indices.empty() && (BinMeshCollider( cloth) == false))
+        {
+            Log( "BinMeshCollider() Failed.");
+
+            cloth->mesh_vertices.clear();
+            cloth->mesh_indices.clear();
+        }
+    }
+
+    void SetSelfCollision( Cloth cloth, bool b_enable)
+    {
+        // code
+        if( !cloth)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        if( b_enable && (cloth->hash_table_size == 0) && (CreateCollisionGrid( cloth) == false))
+        {
+            Log( "CreateCollisionGrid() Failed.");
+
+            cloth->release_collision_grid();
+            return;
+        }
+
+        cloth->b_self_collision = b_enable;
+    }
+
+    unsigned int GetVerticesCount( Cloth cloth)
+    {
+        // code
+        return cloth ? cloth->vertices_count : 0;
+    }
+
+    void ReadPositions( Cloth cloth, vmath::vec4 *p_positions)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        if( !cloth || !p_positions)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        ocl_err = AcquireGLObjects( cloth);
+        CL_CHECK_ERROR( ocl_err, clEnqueueAcquireGLObjects);
+
+        ocl_err = clEnqueueReadBuffer( OpenCLUtil::GetCommandQueue(), cloth->ocl_position_graphic_resource, CL_TRUE, 0, cloth->vertices_count * sizeof( vmath::vec4), p_positions, 0, nullptr, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log( "clEnqueueReadBuffer() Failed(%d).", ocl_err);
+        }
+
+        ocl_err = ReleaseGLObjects( cloth);
+        CL_CHECK_ERROR( ocl_err, clEnqueueReleaseGLObjects);
+    }
+
+    void SetPositions( Cloth cloth, const vmath::vec4 *p_positions)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        if( !cloth || !p_positions)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        ocl_err = AcquireGLObjects( cloth);
+        CL_CHECK_ERROR( ocl_err, clEnqueueAcquireGLObjects);
+
+            // old position too, the vertices start at rest
+        cl_mem ocl_buffers[] = { cloth->ocl_position_graphic_resource, cloth->ocl_old_position};
+
+        for( int i = 0; i < _ARRAYSIZE( ocl_buffers); ++i)
+        {
+            ocl_err = clEnqueueWriteBuffer( OpenCLUtil::GetCommandQueue(), ocl_buffers[i], CL_TRUE, 0, cloth->vertices_count * sizeof( vmath::vec4), p_positions, 0, nullptr, nullptr);
+            if( ocl_err != CL_SUCCESS)
+            {
+                Log( "clEnqueueWriteBuffer() Failed(%d).", ocl_err);
+                break;
+            }
+        }
+
+        ocl_err = ReleaseGLObjects( cloth);
+        CL_CHECK_ERROR( ocl_err, clEnqueueReleaseGLObjects);
+    }
+
+    void SetProfiling( Cloth cloth, bool b_enable)
+    {
+        // code
+        if( !cloth)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        cloth->b_profiling = b_enable;
+    }
+
+    void GetStageTimes( Cloth cloth, double *p_seconds)
+    {
+        // code
+        if( !cloth || !p_seconds)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+            // events left by an Update() that failed
+        CollectStageEvents( cloth);
+
+        for( int i = 0; i < STAGE_COUNT; ++i)
+        {
+            p_seconds[i] = cloth->stage_seconds[i];
+        }
+    }
+
+    void ResetStageTimes( Cloth cloth)
+    {
+        // variable declaration
+        double stage_seconds[STAGE_COUNT];
+
+        // code
+        if( !cloth)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+            // pending events are collected, then dropped
+        GetStageTimes( cloth, stage_seconds);
+
+        for( int i = 0; i < STAGE_COUNT; ++i)
+        {
+            cloth->stage_seconds[i] = 0.0;
+        }
+    }
+
+    const char* StageName( STAGE stage)
+    {
+        // code
+        switch( stage)
+        {
+            case STAGE_PREDICT:
+                return "predict";
+
+            case STAGE_CONSTRAINTS:
+                return "constraints";
+
+            case STAGE_COLLISIONS:
+                return "collisions";
+
+            case STAGE_NORMALS:
+                return "normals";
+
+            default:
+                return "unknown";
+        }
+    }
+
+    const char* SolverName( SOLVER solver)
+    {
+        // code
+        switch( solver)
+        {
+            case SOLVER_STICK_GROUPS:
+                return "stick groups";
+
+            case SOLVER_COLORED_TILES:
+                return "colored tiles";
+
+            case SOLVER_LOCAL_TILES:
+                return "local memory tiles";
+
+            case SOLVER_XPBD:
+                return "XPBD";
+
+            default:
+                return "unknown";
+        }
+    }
+
+    void DeleteCloth( Cloth cloth)
+    {
+        if( cloth)
+        {
+            cloth->release();
+            delete cloth;
+            cloth = nullptr;
+        }
+    }
+    
+    //////////////////////////////////////////////
+    ///////// BATCHES
+    //////////////////////////////////////////////
+
+    /**
+     * @brief GroupStick() : stick of a group that starts on vertex ( x, y), as group_stick() of cloth.cl
+     * 
+     * @description:
+     *          ( *p_dx, *p_dy) is the offset of p1 from p0 even when the vertex starts no stick of the group.
+     */
+    static bool GroupStick( int group, unsigned int x, unsigned int y, unsigned int *p_dx, unsigned int *p_dy)
+    {
+        // code
+        *p_dx = 0;
+        *p_dy = 0;
+
+        switch( group)
+        {
+            case STICK_GROUP_ID::HORIZONTAL_DISTANCE_1_EVEN:
+            case STICK_GROUP_ID::HORIZONTAL_DISTANCE_1_ODD:
+                *p_dx = 1;
+                return (x % 2) == (group == STICK_GROUP_ID::HORIZONTAL_DISTANCE_1_ODD);
+
+            case STICK_GROUP_ID::VERTICAL_DISTANCE_1_EVEN:
+            case STICK_GROUP_ID::VERTICAL_DISTANCE_1_ODD:
+                *p_dy = 1;
+                return (y % 2) == (group == STICK_GROUP_ID::VERTICAL_DISTANCE_1_ODD);
+
+            case STICK_GROUP_ID::DIAGONAL_DISTANCE_1_EVEN:
+            case STICK_GROUP_ID::DIAGONAL_DISTANCE_1_ODD:
+                *p_dx = *p_dy = 1;
+                return (y % 2) == (group == STICK_GROUP_ID::DIAGONAL_DISTANCE_1_ODD);
+
+            case STICK_GROUP_ID::HORIZONTAL_DISTANCE_2_EVEN:
+            case STICK_GROUP_ID::HORIZONTAL_DISTANCE_2_ODD:
+                *p_dx = 2;
+                return ((x % 4) < 2) == (group == STICK_GROUP_ID::HORIZONTAL_DISTANCE_2_ODD);
+
+            case STICK_GROUP_ID::VERTICAL_DISTANCE_2_EVEN:
+            case STICK_GROUP_ID::VERTICAL_DISTANCE_2_ODD:
+                *p_dy = 2;
+                return ((y % 4) < 2) == (group == STICK_GROUP_ID::VERTICAL_DISTANCE_2_ODD);
+
+            case STICK_GROUP_ID::DIAGONAL_DISTANCE_2_EVEN:
+            case STICK_GROUP_ID::DIAGONAL_DISTANCE_2_ODD:
+                *p_dx = *p_dy = 2;
+                return ((y % 4) < 2) == (group == STICK_GROUP_ID::DIAGONAL_DISTANCE_2_ODD);
+        }
+
+        return false;
+    }
+
+        // transform * point ( vmath's vec * mat multiplies by the transpose)
+    static vmath::vec4 TransformPoint( const vmath::mat4 &transform, const vmath::vec4 &point)
+    {
+        // variable declaration
+        vmath::vec4 result( 0.0f);
+
+        // code
+        for( int column = 0; column < 4; ++column)
+        {
+            for( int row = 0; row < 4; ++row)
+            {
+                result[row] += transform[column][row] * point[column];
+            }
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief CreateClothBatch() : instances_count cloths in shared buffers
+     * 
+     * @description:
+     *          Instance i owns the vertices from first_vertex ( instances in order, rows of x_vertices), its sticks
+     *          index the shared position buffer. Every instance is cut in COLORED_TILE_SIZE tiles colored by the
+     *          parity of tile x and tile y as a single cloth ( CreateTiledSticks()), the tiles of all instances
+     *          are concatenated phase by phase and the sticks counting-sorted on ( tile, group). A launch per phase
+     *          then covers every instance, instances no larger than a tile only have phase 0 tiles.
+     */
+    ClothBatch CreateClothBatch( const ClothInstanceInfo *p_instances, unsigned int instances_count, bool b_headless)
+    {
+        // variable declaration
+        _ClothBatch *batch = nullptr;
+
+        std::vector<vmath::vec4> positions;
+        std::vector<vmath::vec4> normals;
+        std::vector<vmath::vec2> texcoords;
+        std::vector<cl_uchar> fixed_vertices;
+        std::vector<unsigned int> indices;
+
+        std::vector<ClothTile> tiles;
+        std::vector<unsigned int> instance_first_tile( instances_count + 1, 0);
+        std::vector<unsigned int> tile_rank;
+
+        std::vector<Stick> sticks;
+        std::vector<unsigned int> stick_slots;
+
+        cl_int ocl_err;
+
+        // code
+        if( !p_instances || (instances_count == 0))
+        {
+            Log( "Invalid Parameter.");
+            return nullptr;
+        }
+
+        for( unsigned int i = 0; i < instances_count; ++i)
+        {
+            if( (p_instances[i].cloth_width == 0) || (p_instances[i].cloth_height == 0) || (p_instances[i].x_vertices < 2) || (p_instances[i].y_vertices < 2))
+            {
+                Log( "Invalid Parameter ( instance %u).", i);
+                return nullptr;
+            }
+        }
+
+        batch = new _ClothBatch;
+        batch->instances.resize( instances_count);
+
+#pragma region BUFFER_INITIALIZE
+
+        for( unsigned int i = 0; i < instances_count; ++i)
+        {
+            const ClothInstanceInfo &info = p_instances[i];
+            ClothInstance &instance = batch->instances[i];
+            unsigned int first_vertex = positions.size();
+
+            instance.first_vertex = first_vertex;
+            instance.vertices_x = info.x_vertices;
+            instance.vertices_y = info.y_vertices;
+            instance.inverse_mass = ParticleInverseMass( info.mass, info.x_vertices * info.y_vertices);
+            instance.gravity[0] = gravity[0];
+            instance.gravity[1] = gravity[1];
+            instance.gravity[2] = gravity[2];
+
+                // the cloth of CreateCloth(), placed by the transform
+            vmath::vec4 normal = TransformPoint( info.transform, vmath::vec4( 0.0f, 1.0f, 0.0f, 0.0f));
+            normal = vmath::vec4( vmath::normalize( vmath::vec3( normal[0], normal[1], normal[2])), 1.0f);
+
+            for( unsigned int y = 0; y < info.y_vertices; ++y)
+            {
+                for( unsigned int x = 0; x < info.x_vertices; ++x)
+                {
+                    float u = (float) x / (float)(info.x_vertices - 1);
+                    float v = (float) y / (float)(info.y_vertices - 1);
+
+                    vmath::vec4 position = vmath::vec4( info.cloth_width * u - info.cloth_width * 0.5f, 0.0f, info.cloth_height * v - info.cloth_height * 0.5f, 1.0f);
+                    position = TransformPoint( info.transform, position);
+
+                    positions.push_back( vmath::vec4( position[0], position[1], position[2], 1.0f));
+                    normals.push_back( normal);
+                    texcoords.push_back( vmath::vec2( u, v));
+                    fixed_vertices.push_back( y == 0);
+                }
+            }
+
+            for( unsigned int x = 0; x < info.x_vertices - 1; ++x)
+            {
+                for( unsigned int y = 0; y < info.y_vertices - 1; ++y)
+                {
+                    indices.push_back( first_vertex +      y  * info.x_vertices +  x);
+                    indices.push_back( first_vertex + (y + 1) * info.x_vertices +  x);
+                    indices.push_back( first_vertex + (y + 1) * info.x_vertices + (x + 1));
+
+                    indices.push_back( first_vertex +      y  * info.x_vertices +  x);
+                    indices.push_back( first_vertex + (y + 1) * info.x_vertices + (x + 1));
+                    indices.push_back( first_vertex +      y  * info.x_vertices + (x + 1));
+                }
+            }
+
+                // rest length of every group at rest ( transformed), compliance
+            for( int group = 0; group < STICK_GROUP_ID::GROUP_COUNT; ++group)
+            {
+                unsigned int dx, dy;
+                GroupStick( group, 0, 0, &dx, &dy);
+
+                bool b_in_cloth = (dx < info.x_vertices) && (dy < info.y_vertices);
+
+                instance.group_distance[group] = b_in_cloth ? vmath::distance( positions[first_vertex], positions[first_vertex + dy * info.x_vertices + dx]) : 0.0f;
+                instance.group_alpha[group] = GroupAlpha( GroupCompliance( group, stretch_compliance, shear_compliance, bend_compliance), instance.group_distance[group], instance.inverse_mass);
+            }
+
+            unsigned int tiles_x = (info.x_vertices + COLORED_TILE_SIZE - 1) / COLORED_TILE_SIZE;
+            unsigned int tiles_y = (info.y_vertices + COLORED_TILE_SIZE - 1) / COLORED_TILE_SIZE;
+
+            instance_first_tile[i + 1] = instance_first_tile[i] + tiles_x * tiles_y;
+        }
+
+            // tiles, phase by phase and instance by instance
+        tile_rank.resize( instance_first_tile.back());
+
+        for( int phase = 0; phase < TILE_PHASE_COUNT; ++phase)
+        {
+            batch->phase_first_tile[phase] = tiles.size();
+
+            for( unsigned int i = 0; i < instances_count; ++i)
+            {
+                unsigned int tiles_x = (batch->instances[i].vertices_x + COLORED_TILE_SIZE - 1) / COLORED_TILE_SIZE;
+                unsigned int tiles_y = (batch->instances[i].vertices_y + COLORED_TILE_SIZE - 1) / COLORED_TILE_SIZE;
+
+                for( unsigned int ty = (phase / 2); ty < tiles_y; ty += 2)
+                {
+                    for( unsigned int tx = (phase % 2); tx < tiles_x; tx += 2)
+                    {
+                        ClothTile tile = { i, tx * COLORED_TILE_SIZE, ty * COLORED_TILE_SIZE};
+
+                        tile_rank[instance_first_tile[i] + ty * tiles_x + tx] = tiles.size();
+                        tiles.push_back( tile);
+                    }
+                }
+            }
+        }
+
+        batch->phase_first_tile[TILE_PHASE_COUNT] = tiles.size();
+        batch->tiles_count = tiles.size();
+
+            // sticks and their ( tile, group) slot, tiles are cut on the vertex of p0
+        for( unsigned int i = 0; i < instances_count; ++i)
+        {
+            const ClothInstance &instance = batch->instances[i];
+            unsigned int tiles_x = (instance.vertices_x + COLORED_TILE_SIZE - 1) / COLORED_TILE_SIZE;
+
+            for( unsigned int y = 0; y < instance.vertices_y; ++y)
+            {
+                for( unsigned int x = 0; x < instance.vertices_x; ++x)
+                {
+                    unsigned int tile = tile_rank[instance_first_tile[i] + (y / COLORED_TILE_SIZE) * tiles_x + (x / COLORED_TILE_SIZE)];
+
+                    for( int group = 0; group < STICK_GROUP_ID::GROUP_COUNT; ++group)
+                    {
+                        unsigned int dx, dy;
+
+                        if( !GroupStick( group, x, y, &dx, &dy) || ((x + dx) >= instance.vertices_x) || ((y + dy) >= instance.vertices_y))
+                        {
+                            continue;
+                        }
+
+                        Stick s;
+                        s.p0 = instance.first_vertex + y * instance.vertices_x + x;
+                        s.p1 = instance.first_vertex + (y + dy) * instance.vertices_x + (x + dx);
+
+                        sticks.push_back( s);
+                        stick_slots.push_back( tile * STICK_GROUP_ID::GROUP_COUNT + group);
+                    }
+                }
+            }
+        }
+
+            // count, prefix sum, scatter
+        std::vector<unsigned int> offsets( tiles.size() * STICK_GROUP_ID::GROUP_COUNT + 1, 0);
+
+        for( size_t i = 0; i < stick_slots.size(); ++i)
+        {
+            ++offsets[stick_slots[i] + 1];
+        }
+
+        for( size_t i = 1; i < offsets.size(); ++i)
+        {
+            offsets[i] += offsets[i - 1];
+        }
+
+        std::vector<Stick> tiled_sticks( sticks.size());
+        std::vector<unsigned int> cursor( offsets.begin(), offsets.end() - 1);
+
+        for( size_t i = 0; i < sticks.size(); ++i)
+        {
+            tiled_sticks[cursor[stick_slots[i]]++] = sticks[i];
+        }
+
+        batch->vertices_count = positions.size();
+        batch->indices_count = indices.size();
+        batch->b_headless = b_headless;
+
+#pragma endregion
+
+#pragma region OPENGL_BUFFER
+
+        if( b_headless == false)
+        {
+            glGenVertexArrays( 1, &(batch->vao));
+            glBindVertexArray( batch->vao);
+
+                // position
+                glGenBuffers( 1, &(batch->vbo_position));
+                glBindBuffer( GL_ARRAY_BUFFER, batch->vbo_position);
+                    glBufferData( GL_ARRAY_BUFFER, positions.size() * sizeof( vmath::vec4), positions.data(), GL_DYNAMIC_DRAW);
+                    glVertexAttribPointer( ATTRIBUTE_INDEX::POSITION, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+                    glEnableVertexAttribArray( ATTRIBUTE_INDEX::POSITION);
+                glBindBuffer( GL_ARRAY_BUFFER, 0);
+
+                // normal
+                glGenBuffers( 1, &(batch->vbo_normal));
+                glBindBuffer( GL_ARRAY_BUFFER, batch->vbo_normal);
+                    glBufferData( GL_ARRAY_BUFFER, normals.size() * sizeof( vmath::vec4), normals.data(), GL_DYNAMIC_DRAW);
+                    glVertexAttribPointer( ATTRIBUTE_INDEX::NORMAL, 4, GL_FLOAT, GL_FALSE, 0, nullptr);
+                    glEnableVertexAttribArray( ATTRIBUTE_INDEX::NORMAL);
+                glBindBuffer( GL_ARRAY_BUFFER, 0);
+
+                // texcoord
+                glGenBuffers( 1, &(batch->vbo_texcoord));
+                glBindBuffer( GL_ARRAY_BUFFER, batch->vbo_texcoord);
+                    glBufferData( GL_ARRAY_BUFFER, texcoords.size() * sizeof( vmath::vec2), texcoords.data(), GL_STATIC_DRAW);
+                    glVertexAttribPointer( ATTRIBUTE_INDEX::TEXCOORD2D, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
+                    glEnableVertexAttribArray( ATTRIBUTE_INDEX::TEXCOORD2D);
+                glBindBuffer( GL_ARRAY_BUFFER, 0);
+
+                // elements
+                glGenBuffers( 1, &(batch->vbo_elements));
+                glBindBuffer( GL_ELEMENT_ARRAY_BUFFER, batch->vbo_elements);
+                glBufferData( GL_ELEMENT_ARRAY_BUFFER, indices.size() * sizeof( unsigned int), indices.data(), GL_STATIC_DRAW);
+
+            glBindVertexArray( 0);
+        }
+
+#pragma endregion
+
+#pragma region OPENCL_BUFFER
+
+        if( b_headless)
+        {
+            batch->ocl_position_graphic_resource = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, positions.size() * sizeof( vmath::vec4), positions.data(), &ocl_err);
+        }
+        else
+        {
+            batch->ocl_position_graphic_resource = clCreateFromGLBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE, batch->vbo_position, &ocl_err);
+        }
+
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log("%s() Failed(%d).", b_headless ? "clCreateBuffer" : "clCreateFromGLBuffer", ocl_err);
+            DeleteClothBatch( batch);
+            return nullptr;
+        }
+
+        if( b_headless == false)
+        {
+            batch->ocl_normal = clCreateFromGLBuffer( OpenCLUtil::GetContext(), CL_MEM_WRITE_ONLY, batch->vbo_normal, &ocl_err);
+            batch->b_normal_gl_shared = (ocl_err == CL_SUCCESS);
+
+            if( !batch->b_normal_gl_shared)
+            {
+                Log("clCreateFromGLBuffer() Failed(%d), normals go through a buffer.", ocl_err);
+                batch->normal_readback.resize( normals.size());
+            }
+        }
+
+        if( !batch->b_normal_gl_shared)
+        {
+            batch->ocl_normal = clCreateBuffer( OpenCLUtil::GetContext(), CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, normals.size() * sizeof( vmath::vec4), normals.data(), &ocl_err);
+            if( ocl_err != CL_SUCCESS)
+            {
+                Log("clCreateBuffer() Failed(%d).", ocl_err);
+                DeleteClothBatch( batch);
+                return nullptr;
+            }
+        }
+
+            // read-only tables, size and contents
+        struct
+        {
+            cl_mem *p_ocl_buffer;
+            cl_mem_flags flags;
+            size_t size;
+            void *p_data;
+        } buffers[] = {
+            { &(batch->ocl_old_position), CL_MEM_READ_WRITE, positions.size() * sizeof( vmath::vec4), positions.data()},
+            { &(batch->ocl_p_fix_point), CL_MEM_READ_ONLY, fixed_vertices.size() * sizeof( cl_uchar), fixed_vertices.data()},
+            { &(batch->ocl_tiled_sticks), CL_MEM_READ_ONLY, tiled_sticks.size() * sizeof( Stick), tiled_sticks.data()},
+            { &(batch->ocl_tile_stick_offsets), CL_MEM_READ_ONLY, offsets.size() * sizeof( unsigned int), offsets.data()},
+            { &(batch->ocl_tiles), CL_MEM_READ_ONLY, tiles.size() * sizeof( ClothTile), tiles.data()},
+            { &(batch->ocl_instances), CL_MEM_READ_ONLY, batch->instances.size() * sizeof( ClothInstance), batch->instances.data()}
+        };
+
+        for( int i = 0; i < _ARRAYSIZE( buffers); ++i)
+        {
+            *(buffers[i].p_ocl_buffer) = clCreateBuffer( OpenCLUtil::GetContext(), buffers[i].flags | CL_MEM_COPY_HOST_PTR, buffers[i].size, buffers[i].p_data, &ocl_err);
+            if( ocl_err != CL_SUCCESS)
+            {
+                Log("clCreateBuffer() Failed(%d).", ocl_err);
+                DeleteClothBatch( batch);
+                return nullptr;
+            }
+        }
+
+#pragma endregion
+
+        return batch;
+    }
+
+    void RenderClothBatch( ClothBatch batch)
+    {
+        // code
+        if( !batch)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        if( batch->b_headless)
+        {
+            return;
+        }
+
+            // all the instances in one draw
+        glBindVertexArray( batch->vao);
+            glDrawElements( GL_TRIANGLES, batch->indices_count, GL_UNSIGNED_INT, nullptr);
+        glBindVertexArray( 0);
+    }
+
+    static cl_int AcquireGLObjects( ClothBatch batch)
+    {
+        // code
+        if( batch->b_headless)
+        {
+            return CL_SUCCESS;
+        }
+
+        cl_mem ocl_gl_objects[] = { batch->ocl_position_graphic_resource, batch->ocl_normal};
+        cl_uint gl_objects_count = batch->b_normal_gl_shared ? 2 : 1;
+
+        return clEnqueueAcquireGLObjects( OpenCLUtil::GetCommandQueue(), gl_objects_count, ocl_gl_objects, 0, nullptr, nullptr);
+    }
+
+    static cl_int ReleaseGLObjects( ClothBatch batch)
+    {
+        // code
+        if( batch->b_headless)
+        {
+            return CL_SUCCESS;
+        }
+
+        cl_mem ocl_gl_objects[] = { batch->ocl_position_graphic_resource, batch->ocl_normal};
+        cl_uint gl_objects_count = batch->b_normal_gl_shared ? 2 : 1;
+
+        return clEnqueueReleaseGLObjects( OpenCLUtil::GetCommandQueue(), gl_objects_count, ocl_gl_objects, 0, nullptr, nullptr);
+    }
+
+        // update_vertices_batched(), every tile of every instance in one launch
+    static void UpdateBatchPoints( ClothBatch batch, float gravity_scale, float step_friction)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        cl_uint tile_size = COLORED_TILE_SIZE;
+
+        // code
+        ocl_err = clSetKernelArg( ocl_update_vertices_batched, 0, sizeof( cl_mem), &(batch->ocl_position_graphic_resource));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_update_vertices_batched, 1, sizeof( cl_mem), &(batch->ocl_old_position));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_update_vertices_batched, 2, sizeof( cl_mem), &(batch->ocl_p_fix_point));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_update_vertices_batched, 3, sizeof( cl_mem), &(batch->ocl_instances));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_update_vertices_batched, 4, sizeof( cl_mem), &(batch->ocl_tiles));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_update_vertices_batched, 5, sizeof( cl_uint), &tile_size);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_update_vertices_batched, 6, sizeof( cl_float), &gravity_scale);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_update_vertices_batched, 7, sizeof( cl_float), &step_friction);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        size_t global_work_size[] = { batch->tiles_count * batch_local_size};
+        size_t local_work_size[] = { batch_local_size};
+
+        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_update_vertices_batched, 1, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+        CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+    }
+
+        // one constraint iteration of all the instances, ocl_kernel : satisfy_constraints_batched( _xpbd)()
+    static void SatisfyBatchConstraints( ClothBatch batch, cl_kernel ocl_kernel, vmath::vec3 bound_dimension, float step_friction)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        cl_uint tile_size = COLORED_TILE_SIZE;
+
+        // code
+        ocl_err = clSetKernelArg( ocl_kernel, 0, sizeof( cl_mem), &(batch->ocl_position_graphic_resource));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 1, sizeof( cl_mem), &(batch->ocl_old_position));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 2, sizeof( cl_mem), &(batch->ocl_p_fix_point));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 3, sizeof( cl_mem), &(batch->ocl_tiled_sticks));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 4, sizeof( cl_mem), &(batch->ocl_tile_stick_offsets));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 5, sizeof( cl_mem), &(batch->ocl_tiles));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 6, sizeof( cl_mem), &(batch->ocl_instances));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 8, sizeof( cl_uint), &tile_size);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 9, sizeof( cl_float), &step_friction);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 10, sizeof( cl_float), &bounce);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 11, sizeof( cl_float3), &(bound_dimension[0]));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            // one launch per phase for all the instances
+        for( int phase = 0; phase < TILE_PHASE_COUNT; ++phase)
+        {
+            cl_uint first_tile = batch->phase_first_tile[phase];
+            size_t tiles_count = batch->phase_first_tile[phase + 1] - first_tile;
+
+            if( tiles_count == 0)
+            {
+                continue;
+            }
+
+            ocl_err = clSetKernelArg( ocl_kernel, 7, sizeof( cl_uint), &first_tile);
+            CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+            size_t global_work_size[] = { tiles_count * batch_local_size};
+            size_t local_work_size[] = { batch_local_size};
+
+            ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_kernel, 1, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+            CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+        }
+    }
+
+    static void UpdateBatchNormals( ClothBatch batch)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        cl_uint tile_size = COLORED_TILE_SIZE;
+
+        // code
+        ocl_err = clSetKernelArg( ocl_normal_calculation_batched, 0, sizeof( cl_mem), &(batch->ocl_normal));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_normal_calculation_batched, 1, sizeof( cl_mem), &(batch->ocl_position_graphic_resource));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_normal_calculation_batched, 2, sizeof( cl_mem), &(batch->ocl_instances));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_normal_calculation_batched, 3, sizeof( cl_mem), &(batch->ocl_tiles));
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        ocl_err = clSetKernelArg( ocl_normal_calculation_batched, 4, sizeof( cl_uint), &tile_size);
+        CL_CHECK_ERROR( ocl_err, clSetKernelArg);
+
+        size_t global_work_size[] = { batch->tiles_count * batch_local_size};
+        size_t local_work_size[] = { batch_local_size};
+
+        ocl_err = clEnqueueNDRangeKernel( OpenCLUtil::GetCommandQueue(), ocl_normal_calculation_batched, 1, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+        CL_CHECK_ERROR( ocl_err, clEnqueueNDRangeKernel);
+    }
+
+    /**
+     * @brief UpdateClothBatch() : one frame of every instance
+     * 
+     * @description:
+     *          The launches of a single cloth with the same solver, each covering all the instances :
+     *          SOLVER_XPBD 5 x XPBD_SUBSTEPS + 1, SOLVER_COLORED_TILES 4 x CONTRAINT_SATISFY_ITERATION + 2 ( 4 being
+     *          the phases that have tiles, 1 when no instance is larger than a tile).
+     */
+    void UpdateClothBatch( ClothBatch batch, float delta_time, vmath::vec3 bound_dimension)
+    {
+        // variale declaration
+        cl_int ocl_err;
+
+        // code
+        if( !batch)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        if( batch->b_instances_dirty)
+        {
+            ocl_err = clEnqueueWriteBuffer( OpenCLUtil::GetCommandQueue(), batch->ocl_instances, CL_TRUE, 0, batch->instances.size() * sizeof( ClothInstance), batch->instances.data(), 0, nullptr, nullptr);
+            CL_CHECK_ERROR( ocl_err, clEnqueueWriteBuffer);
+
+            batch->b_instances_dirty = false;
+        }
+
+        ocl_err = AcquireGLObjects( batch);
+        CL_CHECK_ERROR( ocl_err, clEnqueueAcquireGLObjects);
+
+        if( batch->solver == SOLVER_XPBD)
+        {
+                // as StepXPBD()
+            float gravity_scale = 1.0f / (XPBD_SUBSTEPS * XPBD_SUBSTEPS);
+            float substep_friction = powf( friction, 1.0f / XPBD_SUBSTEPS);
+
+            for( int i = 0; i < XPBD_SUBSTEPS; ++i)
+            {
+                UpdateBatchPoints( batch, gravity_scale, substep_friction);
+                SatisfyBatchConstraints( batch, ocl_satisfy_constraints_batched_xpbd, bound_dimension, substep_friction);
+            }
+        }
+        else
+        {
+            UpdateBatchPoints( batch, 1.0f, friction);
+
+            for( int i = 0; i < CONTRAINT_SATISFY_ITERATION; ++i)
+            {
+                SatisfyBatchConstraints( batch, ocl_satisfy_constraints_batched, bound_dimension, friction);
+            }
+        }
+
+        UpdateBatchNormals( batch);
+
+        ocl_err = ReleaseGLObjects( batch);
+        CL_CHECK_ERROR( ocl_err, clEnqueueReleaseGLObjects);
+
+        if( !batch->b_normal_gl_shared && !batch->b_headless)
+        {
+            ocl_err = clEnqueueReadBuffer( OpenCLUtil::GetCommandQueue(), batch->ocl_normal, CL_TRUE, 0, batch->vertices_count * sizeof( vmath::vec4), batch->normal_readback.data(), 0, nullptr, nullptr);
+            CL_CHECK_ERROR( ocl_err, clEnqueueReadBuffer);
+
+            glBindBuffer( GL_ARRAY_BUFFER, batch->vbo_normal);
+                glBufferSubData( GL_ARRAY_BUFFER, 0, batch->vertices_count * sizeof( vmath::vec4), batch->normal_readback.data());
+            glBindBuffer( GL_ARRAY_BUFFER, 0);
+        }
+    }
+
+    void SetBatchSolver( ClothBatch batch, SOLVER solver)
+    {
+        // code
+        if( !batch || ((solver != SOLVER_COLORED_TILES) && (solver != SOLVER_XPBD)))
+        {
+            Log( "Invalid Parameter, batches use SOLVER_COLORED_TILES or SOLVER_XPBD.");
+            return;
+        }
+
+        batch->solver = solver;
+    }
+
+    SOLVER GetBatchSolver( ClothBatch batch)
+    {
+        // code
+        return batch ? batch->solver : SOLVER_COUNT;
+    }
+
+    void SetInstanceGravity( ClothBatch batch, unsigned int instance, vmath::vec4 instance_gravity)
+    {
+        // code
+        if( !batch || (instance >= batch->instances.size()))
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        for( int i = 0; i < 3; ++i)
+        {
+            batch->instances[instance].gravity[i] = instance_gravity[i];
+        }
+
+        batch->b_instances_dirty = true;
+    }
+
+    void SetInstanceCompliance( ClothBatch batch, unsigned int instance, float stretch, float shear, float bend)
+    {
+        // code
+        if( !batch || (instance >= batch->instances.size()) || (stretch < 0.0f) || (shear < 0.0f) || (bend < 0.0f))
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        for( int i = 0; i < STICK_GROUP_ID::GROUP_COUNT; ++i)
+        {
+            ClothInstance &cloth_instance = batch->instances[instance];
+
+            cloth_instance.group_alpha[i] = GroupAlpha( GroupCompliance( i, stretch, shear, bend), cloth_instance.group_distance[i], cloth_instance.inverse_mass);
+        }
+
+        batch->b_instances_dirty = true;
+    }
+
+    unsigned int GetBatchInstancesCount( ClothBatch batch)
+    {
+        // code
+        return batch ? (unsigned int) batch->instances.size() : 0;
+    }
+
+    unsigned int GetBatchVerticesCount( ClothBatch batch)
+    {
+        // code
+        return batch ? batch->vertices_count : 0;
+    }
+
+    unsigned int GetInstanceFirstVertex( ClothBatch batch, unsigned int instance)
+    {
+        // code
+        if( !batch || (instance >= batch->instances.size()))
+        {
+            Log( "Invalid Parameter.");
+            return 0;
+        }
+
+        return batch->instances[instance].first_vertex;
+    }
+
+    void ReadBatchPositions( ClothBatch batch, vmath::vec4 *p_positions)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        if( !batch || !p_positions)
+        {
+            Log( "Invalid Parameter.");
+            return;
+        }
+
+        ocl_err = AcquireGLObjects( batch);
+        CL_CHECK_ERROR( ocl_err, clEnqueueAcquireGLObjects);
+
+        ocl_err = clEnqueueReadBuffer( OpenCLUtil::GetCommandQueue(), batch->ocl_position_graphic_resource, CL_TRUE, 0, batch->vertices_count * sizeof( vmath::vec4), p_positions, 0, nullptr, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            Log( "clEnqueueReadBuffer() Failed(%d).", ocl_err);
+        }
+
+        ocl_err = ReleaseGLObjects( batch);
+        CL_CHECK_ERROR( ocl_err, clEnqueueReleaseGLObjects);
+    }
+
+    void DeleteClothBatch( ClothBatch batch)
+    {
+        if( batch)
+        {
+            batch->release();
+            delete batch;
+            batch = nullptr;
+        }
+    }
+
     void Uninitialize()
     {
         CL_OBJECT_RELEASE( ocl_cloth_program, clReleaseProgram);
         CL_OBJECT_RELEASE( ocl_update_vertices, clReleaseKernel);
         CL_OBJECT_RELEASE( ocl_constraint_vertices, clReleaseKernel);
         CL_OBJECT_RELEASE( ocl_update_sticks, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_satisfy_constraints_tiled, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_satisfy_constraints_tiled_xpbd, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_satisfy_constraints_local, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_normal_calculation, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_hash_vertices, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_scan_cells, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_add_block_offsets, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_scatter_vertices, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_collide_vertices, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_update_vertices_batched, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_satisfy_constraints_batched, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_satisfy_constraints_batched_xpbd, clReleaseKernel);
+        CL_OBJECT_RELEASE( ocl_normal_calculation_batched, clReleaseKernel);
         Log("");
     }
 
@@ -4,13 +4,109 @@ namespace ClothSimulation_OpenCL
 {
     typedef struct _Cloth* Cloth;
 
+    enum SOLVER
+    {
+        SOLVER_STICK_GROUPS = 0,    // constraint_vertices + one update_sticks launch per stick group, per iteration
+        SOLVER_COLORED_TILES,       // all stick groups in one buffer, one launch per tile phase, per iteration
+        SOLVER_LOCAL_TILES,         // tiles + halo in local memory, several iterations per launch
+        SOLVER_XPBD,                // compliance based sticks, substeps of one colored tiles iteration each
+
+        SOLVER_COUNT
+    };
+
+        // Update() stages, for the kernel times of SetProfiling()
+    enum STAGE
+    {
+        STAGE_PREDICT = 0,          // update_vertices
+        STAGE_CONSTRAINTS,          // solver launches ( the tiled solvers include their normals)
+        STAGE_COLLISIONS,           // spatial hash and collide_vertices
+        STAGE_NORMALS,
+
+        STAGE_COUNT
+    };
+
     bool Initialize();
 
-    Cloth CreateCloth( unsigned int cloth_width, unsigned int cloth_height, unsigned int x_vertices, unsigned int y_verticecs, float damping, float mass);
+        // b_headless : no OpenGL objects ( no GL context needed), Render() draws nothing
+    Cloth CreateCloth( unsigned int cloth_width, unsigned int cloth_height, unsigned int x_vertices, unsigned int y_verticecs, float damping, float mass, bool b_headless = false);
     void Render( Cloth cloth);
     void RenderVertices( Cloth cloth);
     void Update( Cloth cloth, float delta_time, vmath::vec3 bound_dimension);
+
+        // SOLVER_COLORED_TILES by default ( was SOLVER_STICK_GROUPS) : the same sticks and iterations in 129 instead of
+        // 418 launches per frame, only the order of the sticks differs. A solver the device does not support is
+        // ignored ( GetSolver() is unchanged)
+    void SetSolver( Cloth cloth, SOLVER solver);
+    SOLVER GetSolver( Cloth cloth);
+    const char* SolverName( SOLVER solver);
+
+        // SOLVER_XPBD compliance ( inverse stiffness, 0 = rigid) of the stretch, shear ( diagonal) and bend ( distance 2) sticks,
+        // per unit rest length and per unit inverse vertex mass so it does not depend on the resolution
+        // ( defaults 0, 1e-3, 1e-2)
+    void SetCompliance( Cloth cloth, float stretch, float shear, float bend);
+
+        // colliders, every call replaces the previous set ( count 0 removes it) :
+        //  spheres  : xyz center, w radius
+        //  capsules : 2 vec4 per capsule, xyz end points, w of the first is the radius
+        //  mesh     : static triangles ( 3 indices each), binned once into a uniform grid
+    void SetSphereColliders( Cloth cloth, const vmath::vec4 *p_spheres, unsigned int count);
+    void SetCapsuleColliders( Cloth cloth, const vmath::vec4 *p_capsules, unsigned int count);
+    void SetMeshCollider( Cloth cloth, const vmath::vec3 *p_vertices, unsigned int vertices_count, const unsigned int *p_indices, unsigned int indices_count);
+
+        // distance kept from the colliders and between vertices more than 2 apart in the cloth ( default : vertex spacing)
+    void SetCollisionThickness( Cloth cloth, float thickness);
+    void SetSelfCollision( Cloth cloth, bool b_enable);
+
+        // GetVerticesCount() vec4 ( x_vertices * y_vertices, row major), blocking
+    unsigned int GetVerticesCount( Cloth cloth);
+    void ReadPositions( Cloth cloth, vmath::vec4 *p_positions);
+        // positions and old positions ( the cloth starts at rest)
+    void SetPositions( Cloth cloth, const vmath::vec4 *p_positions);
+
+        // kernel time of every Update() stage, the command-queue needs CL_QUEUE_PROFILING_ENABLE.
+        // The events of an Update() are added up and released at its end, which waits for its commands
+        // ( STAGE_COUNT values, seconds since the last reset)
+    void SetProfiling( Cloth cloth, bool b_enable);
+    void GetStageTimes( Cloth cloth, double *p_seconds);
+    void ResetStageTimes( Cloth cloth);
+    const char* StageName( STAGE stage);
     void DeleteCloth( Cloth cloth);
+
+        // batch : many small cloths packed in shared position, stick and fixed vertex buffers, every launch of
+        // UpdateClothBatch() advances all of them and RenderClothBatch() draws them in one call.
+        // SOLVER_COLORED_TILES and SOLVER_XPBD ( default) only, no collisions
+    typedef struct _ClothBatch* ClothBatch;
+
+        // one cloth of a batch : the cloth of CreateCloth() ( top row fixed) placed by transform
+    struct ClothInstanceInfo
+    {
+        unsigned int cloth_width;
+        unsigned int cloth_height;
+        unsigned int x_vertices;
+        unsigned int y_vertices;
+        float mass;
+        vmath::mat4 transform;
+    };
+
+    ClothBatch CreateClothBatch( const ClothInstanceInfo *p_instances, unsigned int instances_count, bool b_headless = false);
+    void RenderClothBatch( ClothBatch batch);
+    void UpdateClothBatch( ClothBatch batch, float delta_time, vmath::vec3 bound_dimension);
+
+    void SetBatchSolver( ClothBatch batch, SOLVER solver);
+    SOLVER GetBatchSolver( ClothBatch batch);
+
+        // per instance parameters, uploaded by the next UpdateClothBatch() :
+        //  gravity    : displacement per frame ( default that of a single cloth), wind can be added to it
+        //  compliance : as SetCompliance()
+    void SetInstanceGravity( ClothBatch batch, unsigned int instance, vmath::vec4 gravity);
+    void SetInstanceCompliance( ClothBatch batch, unsigned int instance, float stretch, float shear, float bend);
+
+        // the vertices of an instance are x_vertices * y_vertices vec4 from GetInstanceFirstVertex() in the batch positions
+    unsigned int GetBatchInstancesCount( ClothBatch batch);
+    unsigned int GetBatchVerticesCount( ClothBatch batch);
+    unsigned int GetInstanceFirstVertex( ClothBatch batch, unsigned int instance);
+    void ReadBatchPositions( ClothBatch batch, vmath::vec4 *p_positions);
+    void DeleteClothBatch( ClothBatch batch);
     
     void Uninitialize();
 
@@ -39,6 +39,11 @@
 
 #define BOUND_DIMENSION 40.0f
 
+    // flags of the cloth batch : FLAG_ROWS x FLAG_ROWS flags of FLAG_VERTICES x FLAG_VERTICES vertices
+#define FLAG_ROWS 10
+#define FLAG_VERTICES 16
+#define FLAG_SIZE 4
+
 //Global function declaration
 LRESULT CALLBACK WndProc( HWND, UINT, WPARAM, LPARAM);
 
@@ -65,6 +70,7 @@ vmath::mat4 g_projection_matrix;
 double deltaTime = 0.0;
 
 ClothSimulation_OpenCL::Cloth red_cloth = nullptr;
+ClothSimulation_OpenCL::ClothBatch flag_batch = nullptr;
 
 GLuint texture_program;
 GLint texture_u_model_matrix;
@@ -78,6 +84,8 @@ GLuint vao_wireframe_cube;
 GLuint vbo_wireframe_cube;
 
 bool b_toggle_cloth_update = false;
+bool b_cloth_collisions = false;
+bool b_show_flag_batch = false;
 
 //WinMain()
 int WINAPI WinMain( HINSTANCE hInstance, HINSTANCE hPrevInsatnce, LPSTR szCmdLine, int iCmdShow)
@@ -474,6 +482,37 @@ bool Initialize(void)
         return false;
     }
 
+        // flags on a grid, all of them in one batch
+    ClothSimulation_OpenCL::ClothInstanceInfo flags[FLAG_ROWS * FLAG_ROWS];
+
+    for( int i = 0; i < FLAG_ROWS * FLAG_ROWS; ++i)
+    {
+        float x = ((i % FLAG_ROWS) - (FLAG_ROWS - 1) * 0.5f) * (FLAG_SIZE + 2.0f);
+        float z = ((i / FLAG_ROWS) - (FLAG_ROWS - 1) * 0.5f) * (FLAG_SIZE + 2.0f);
+
+        flags[i].cloth_width = FLAG_SIZE;
+        flags[i].cloth_height = FLAG_SIZE;
+        flags[i].x_vertices = FLAG_VERTICES;
+        flags[i].y_vertices = FLAG_VERTICES;
+        flags[i].mass = 1.0f;
+        flags[i].transform = vmath::translate( x, 0.0f, z);
+    }
+
+    flag_batch = ClothSimulation_OpenCL::CreateClothBatch( flags, FLAG_ROWS * FLAG_ROWS);
+    if( flag_batch == nullptr)
+    {
+        Log( "CreateClothBatch() Failed.");
+        return false;
+    }
+
+        // a different wind on every flag
+    for( int i = 0; i < FLAG_ROWS * FLAG_ROWS; ++i)
+    {
+        float wind = 0.0005f * (i % 7);
+
+        ClothSimulation_OpenCL::SetInstanceGravity( flag_batch, i, vmath::vec4( wind, -0.0098f, 0.5f * wind, 0.0f));
+    }
+
     Log("");
 
         /////// texture shader
@@ -789,7 +828,14 @@ void Display( void)
     glBindTexture( GL_TEXTURE_2D, sponza_curtain_blue_texture);
     glUniform1i( texture_u_texture, 0);
 
-    ClothSimulation_OpenCL::Render( red_cloth);
+    if( b_show_flag_batch)
+    {
+        ClothSimulation_OpenCL::RenderClothBatch( flag_batch);
+    }
+    else
+    {
+        ClothSimulation_OpenCL::Render( red_cloth);
+    }
 
     // wire frame cube
     float line_width;
@@ -883,10 +929,64 @@ void Update( double deltaTime)
         glPolygonMode( GL_FRONT_AND_BACK, GL_FILL);
     }
 
+        // cloth solver
+    if( KeyboardInput::IsKeyPressed( 'M'))
+    {
+        ClothSimulation_OpenCL::SOLVER solver = ClothSimulation_OpenCL::GetSolver( red_cloth);
+
+            // next solver the device supports
+        for( int i = 0; i < ClothSimulation_OpenCL::SOLVER_COUNT; ++i)
+        {
+            solver = (ClothSimulation_OpenCL::SOLVER)((solver + 1) % ClothSimulation_OpenCL::SOLVER_COUNT);
+
+            ClothSimulation_OpenCL::SetSolver( red_cloth, solver);
+            if( ClothSimulation_OpenCL::GetSolver( red_cloth) == solver)
+            {
+                break;
+            }
+        }
+
+        Log( "Cloth Solver : %s", ClothSimulation_OpenCL::SolverName( ClothSimulation_OpenCL::GetSolver( red_cloth)));
+    }
+
+        // cloth collisions : a sphere under the cloth and self collision
+    if( KeyboardInput::IsKeyPressed( 'C'))
+    {
+        vmath::vec4 sphere = vmath::vec4( 0.0f, -10.0f, 0.0f, 5.0f);
+
+        b_cloth_collisions = !b_cloth_collisions;
+
+        ClothSimulation_OpenCL::SetSphereColliders( red_cloth, &sphere, b_cloth_collisions ? 1 : 0);
+        ClothSimulation_OpenCL::SetSelfCollision( red_cloth, b_cloth_collisions);
+        Log( "Cloth Collisions : %s", b_cloth_collisions ? "on" : "off");
+    }
+
+        // the red cloth or the flags
+    if( KeyboardInput::IsKeyPressed( 'B'))
+    {
+        b_show_flag_batch = !b_show_flag_batch;
+    }
+
+        // flags solver
+    if( KeyboardInput::IsKeyPressed( 'N'))
+    {
+        ClothSimulation_OpenCL::SOLVER solver = (ClothSimulation_OpenCL::GetBatchSolver( flag_batch) == ClothSimulation_OpenCL::SOLVER_XPBD) ? ClothSimulation_OpenCL::SOLVER_COLORED_TILES : ClothSimulation_OpenCL::SOLVER_XPBD;
+
+        ClothSimulation_OpenCL::SetBatchSolver( flag_batch, solver);
+        Log( "Flags Solver : %s", ClothSimulation_OpenCL::SolverName( solver));
+    }
+
     //update
     if( b_toggle_cloth_update)
     {
-        ClothSimulation_OpenCL::Update( red_cloth, deltaTime, vmath::vec3( BOUND_DIMENSION));
+        if( b_show_flag_batch)
+        {
+            ClothSimulation_OpenCL::UpdateClothBatch( flag_batch, deltaTime, vmath::vec3( BOUND_DIMENSION));
+        }
+        else
+        {
+            ClothSimulation_OpenCL::Update( red_cloth, deltaTime, vmath::vec3( BOUND_DIMENSION));
+        }
     }
     
     UpdateGrid( deltaTime);
@@ -917,6 +1017,9 @@ void UnInitialize( void)
     ClothSimulation_OpenCL::DeleteCloth( red_cloth);
     red_cloth = nullptr;
 
+    ClothSimulation_OpenCL::DeleteClothBatch( flag_batch);
+    flag_batch = nullptr;
+
     ClothSimulation_OpenCL::Uninitialize();
 
     DELETE_TEXTURE(sponza_curtain_blue_texture);
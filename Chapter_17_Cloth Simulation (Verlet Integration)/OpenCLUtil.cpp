@@ -22,8 +22,11 @@ namespace OpenCLUtil
 
     /**
      * @brief CreateContext(): return OpenCL context if succeded.
+     *
+     * @description:
+     *          b_gl_sharing : shares the current OpenGL context ( wglGetCurrentContext()), else the context needs no OpenGL
      */
-    static cl_context CreateContext( cl_device_type device_type)
+    static cl_context CreateContext( cl_device_type device_type, bool b_gl_sharing)
     {
         // variable declaration
         cl_int ocl_err;
@@ -86,6 +89,11 @@ namespace OpenCLUtil
             0
         };
 
+        if( b_gl_sharing == false)
+        {
+            ocl_context_properties[2] = 0;
+        }
+
         ocl_context = clCreateContextFromType( ocl_context_properties, device_type, nullptr, nullptr, &ocl_err);
         if( ocl_err != CL_SUCCESS)
         {
@@ -119,7 +127,7 @@ namespace OpenCLUtil
     /**
      * @brief CreateCommandQueue(): create and return OpenCL command-queue for first device
      */
-    static cl_command_queue CreateCommandQueue( cl_context ocl_context, cl_device_id *out_ocl_device)
+    static cl_command_queue CreateCommandQueue( cl_context ocl_context, cl_device_id *out_ocl_device, cl_command_queue_properties ocl_queue_properties)
     {
         // variable declaration
         cl_int ocl_err;
@@ -159,7 +167,7 @@ namespace OpenCLUtil
         p_ocl_devices = nullptr;
 
             // create command queue
-        ocl_cmd_queue = clCreateCommandQueue( ocl_context, *out_ocl_device, 0, &ocl_err);
+        ocl_cmd_queue = clCreateCommandQueue( ocl_context, *out_ocl_device, ocl_queue_properties, &ocl_err);
         if( (ocl_cmd_queue == nullptr) || (ocl_err != CL_SUCCESS))
         {
             Log( "clCreateCommandQueue() Failed ( %d).", ocl_err);
@@ -176,7 +184,7 @@ namespace OpenCLUtil
     bool Initialize()
     {
         // code
-        g_ocl_context = CreateContext( CL_DEVICE_TYPE_GPU);
+        g_ocl_context = CreateContext( CL_DEVICE_TYPE_GPU, true);
         if( g_ocl_context == nullptr)
         {
             Log("CreateContext() Failed.");
@@ -184,7 +192,32 @@ namespace OpenCLUtil
             return false;
         }
 
-        g_ocl_command_queue = CreateCommandQueue( g_ocl_context, &g_ocl_device_id);
+        g_ocl_command_queue = CreateCommandQueue( g_ocl_context, &g_ocl_device_id, 0);
+        if( g_ocl_command_queue == nullptr)
+        {
+            Log("CreateCommandQueue() Failed.");
+            Unintialize();
+            return false;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief InitializeHeadless() : context without OpenGL sharing, profiling command-queue
+     */
+    bool InitializeHeadless( cl_device_type device_type)
+    {
+        // code
+        g_ocl_context = CreateContext( device_type, false);
+        if( g_ocl_context == nullptr)
+        {
+            Log("CreateContext() Failed.");
+            Unintialize();
+            return false;
+        }
+
+        g_ocl_command_queue = CreateCommandQueue( g_ocl_context, &g_ocl_device_id, CL_QUEUE_PROFILING_ENABLE);
         if( g_ocl_command_queue == nullptr)
         {
             Log("CreateCommandQueue() Failed.");
@@ -283,4 +316,12 @@ namespace OpenCLUtil
         return g_ocl_command_queue;
     }
 
+    /**
+     * @brief GetDevice() : device of the command-queue
+     */
+    cl_device_id GetDevice()
+    {
+        return g_ocl_device_id;
+    }
+
 }
\ No newline at end of file
@@ -12,6 +12,8 @@
 namespace OpenCLUtil
 {
     bool Initialize();
+        // no OpenGL context needed, the command-queue has CL_QUEUE_PROFILING_ENABLE
+    bool InitializeHeadless( cl_device_type device_type);
     void Unintialize();
 
     bool IsInitialized();
@@ -20,4 +22,5 @@ namespace OpenCLUtil
 
     cl_context GetContext();
     cl_command_queue GetCommandQueue();
+    cl_device_id GetDevice();
 }
@@ -16,6 +16,8 @@ enum STICK_GROUP_ID
     VERTICAL_DISTANCE_2_ODD,
     DIAGONAL_DISTANCE_2_EVEN,
     DIAGONAL_DISTANCE_2_ODD,
+
+    GROUP_COUNT
 };
 
 struct Stick
@@ -81,29 +83,17 @@ __kernel void update_vertices(
 }
 
 
-__kernel void constraint_vertices(
-    __global float4 *p_position, __global float4 *p_old_position,
-    __global bool *p_fix_vertices, float friction, float bounce_damping,
-    float3 bound_dimension, uint vertices_count
+void bound_vertex(
+    float4 *p_pos, float4 *p_old_pos,
+    float friction, float bounce_damping, float3 bound_dimension
 )
 {
     // variable declaration
     float4 velocity = (float4)(0.0f);
 
     // code
-    int index = get_global_id(0);
-    if( index > (vertices_count - 1))
-    {
-        return;
-    }
-
-    if( p_fix_vertices[index])
-    {
-        return;
-    }
-
-    float4 pos = p_position[index];
-    float4 old_pos = p_old_position[index];
+    float4 pos = *p_pos;
+    float4 old_pos = *p_old_pos;
 
     velocity = (pos - old_pos) * friction;
 
@@ -142,52 +132,632 @@ __kernel void constraint_vertices(
         old_pos.z = pos.z + velocity.z * bounce_damping;
     }
 
+    *p_pos = pos;
+    *p_old_pos = old_pos;
+}
+
+
+void constraint_vertex(
+    __global float4 *p_position, __global float4 *p_old_position,
+    float friction, float bounce_damping, float3 bound_dimension,
+    uint index
+)
+{
+    // code
+    float4 pos = p_position[index];
+    float4 old_pos = p_old_position[index];
+
+    bound_vertex( &pos, &old_pos, friction, bounce_damping, bound_dimension);
+
     p_position[index] = pos;
     p_old_position[index] = old_pos;
 }
 
 
-__kernel void update_sticks(
-    __global float4 *p_position, __global bool *p_fix_vertices,
-    __global struct Stick *p_sticks, float current_group_distance,
-    unsigned int sticks_count
+__kernel void constraint_vertices(
+    __global float4 *p_position, __global float4 *p_old_position,
+    __global bool *p_fix_vertices, float friction, float bounce_damping,
+    float3 bound_dimension, uint vertices_count
 )
 {
     // code
     int index = get_global_id(0);
+    if( index > (vertices_count - 1))
+    {
+        return;
+    }
 
-    if( index > (sticks_count - 1))
+    if( p_fix_vertices[index])
     {
         return;
     }
 
-    uint p0_index = p_sticks[index].p0;
-    uint p1_index = p_sticks[index].p1;
+    constraint_vertex( p_position, p_old_position, friction, bounce_damping, bound_dimension, index);
+}
+
 
-    float4 p0 = p_position[ p0_index];
-    float4 p1 = p_position[ p1_index];
+void solve_stick(
+    float4 *p_p0, float4 *p_p1,
+    bool b_fixed_p0, bool b_fixed_p1, float group_distance
+)
+{
+    // code
+    float4 p0 = *p_p0;
+    float4 p1 = *p_p1;
 
     float4 dp = p1 - p0;
     float dist = length( dp);
-    float difference = current_group_distance - dist;
+    float difference = group_distance - dist;
     float percent = difference / dist / 2.0f;
 
     float4 offset = dp * percent;
 
-    if( ! p_fix_vertices[p0_index])
+    if( ! b_fixed_p0)
     {
         p0 = p0 - offset;
     }
 
-    if( ! p_fix_vertices[p1_index])
+    if( ! b_fixed_p1)
     {
         p1 = p1 + offset;
     }
 
     p0.w = p1.w = 1.0f;
 
-    p_position[p0_index] = p0;
-    p_position[p1_index] = p1;
+    *p_p0 = p0;
+    *p_p1 = p1;
+}
+
+
+void satisfy_stick(
+    __global float4 *p_position, __global bool *p_fix_vertices,
+    struct Stick stick, float group_distance
+)
+{
+    // code
+    float4 p0 = p_position[ stick.p0];
+    float4 p1 = p_position[ stick.p1];
+
+    solve_stick( &p0, &p1, p_fix_vertices[stick.p0], p_fix_vertices[stick.p1], group_distance);
+
+    p_position[stick.p0] = p0;
+    p_position[stick.p1] = p1;
+}
+
+
+__kernel void update_sticks(
+    __global float4 *p_position, __global bool *p_fix_vertices,
+    __global struct Stick *p_sticks, float current_group_distance,
+    unsigned int sticks_count
+)
+{
+    // code
+    int index = get_global_id(0);
+
+    if( index > (sticks_count - 1))
+    {
+        return;
+    }
+
+    satisfy_stick( p_position, p_fix_vertices, p_sticks[index], current_group_distance);
+}
+
+
+// clamps the w x h vertices from ( x0, y0) of the cloth starting at first_vertex to the bound, work-items of a work-group share the vertices
+void bound_region(
+    __global float4 *p_position, __global float4 *p_old_position,
+    __global bool *p_fix_vertices, uint first_vertex, uint vertices_x,
+    uint x0, uint y0, uint w, uint h,
+    float friction, float bounce_damping, float3 bound_dimension
+)
+{
+    // code
+    uint local_id = get_local_id(0);
+    uint local_size = get_local_size(0);
+
+    for( uint i = local_id; i < w * h; i += local_size)
+    {
+        uint index = first_vertex + (y0 + i / w) * vertices_x + (x0 + i % w);
+
+        if( ! p_fix_vertices[index])
+        {
+            constraint_vertex( p_position, p_old_position, friction, bounce_damping, bound_dimension, index);
+        }
+    }
+}
+
+
+// clamps the vertices of tile p_tile_ids[tile] to the bound
+void bound_tile(
+    __global float4 *p_position, __global float4 *p_old_position,
+    __global bool *p_fix_vertices, __global uint *p_tile_ids, uint tile,
+    uint vertices_x, uint vertices_y, uint tile_size,
+    float friction, float bounce_damping, float3 bound_dimension
+)
+{
+    // code
+    uint tiles_x = (vertices_x + tile_size - 1) / tile_size;
+    uint tile_id = p_tile_ids[tile];
+
+    uint x0 = (tile_id % tiles_x) * tile_size;
+    uint y0 = (tile_id / tiles_x) * tile_size;
+    uint w = min( tile_size, vertices_x - x0);
+    uint h = min( tile_size, vertices_y - y0);
+
+    bound_region( p_position, p_old_position, p_fix_vertices, 0, vertices_x, x0, y0, w, h, friction, bounce_damping, bound_dimension);
+}
+
+
+// normal of a grid vertex from its left, right, down and up neighbours ( b_* : the neighbour exists)
+float3 vertex_normal(
+    float3 position, float3 left, float3 right, float3 down, float3 up,
+    bool b_left, bool b_right, bool b_down, bool b_up
+)
+{
+    // variable declaration
+    float3 normal = (float3)( 0.0f, 0.0f, 0.0f);
+
+    // code
+    if( b_left)
+    {
+        if( b_down)
+        {
+            // normal += normalize( cross( left - position, down - position));
+            normal += normalize( cross( down - position, left - position));
+        }
+
+        if( b_up)
+        {
+            // normal += normalize( cross( up - position, left - position));
+            normal += normalize( cross( left - position, up - position));
+        }
+    }
+
+    if( b_right)
+    {
+        if( b_down)
+        {
+            // normal += normalize( cross( down - position, right - position));
+            normal += normalize( cross( right - position, down - position));
+        }
+
+        if( b_up)
+        {
+            // normal += normalize( cross( right - position, up - position));
+            normal += normalize( cross( up - position, right - position));
+        }
+    }
+
+    return normalize( normal);
+}
+
+
+// normals of the w x h vertices from ( x0, y0) of the cloth starting at first_vertex, from the positions in global memory
+void normal_region(
+    __global float4 *p_normal, __global float4 *p_position,
+    uint first_vertex, uint vertices_x, uint vertices_y,
+    uint x0, uint y0, uint w, uint h
+)
+{
+    // code
+    for( uint i = get_local_id(0); i < w * h; i += get_local_size(0))
+    {
+        uint x = x0 + i % w;
+        uint y = y0 + i / w;
+        uint index = first_vertex + y * vertices_x + x;
+
+        float3 position = p_position[index].xyz;
+        float3 left = (x > 0) ? p_position[index - 1].xyz : position;
+        float3 right = (x < (vertices_x - 1)) ? p_position[index + 1].xyz : position;
+        float3 down = (y > 0) ? p_position[index - vertices_x].xyz : position;
+        float3 up = (y < (vertices_y - 1)) ? p_position[index + vertices_x].xyz : position;
+
+        p_normal[index].xyz = vertex_normal( position, left, right, down, up, x > 0, x < (vertices_x - 1), y > 0, y < (vertices_y - 1));
+    }
+}
+
+
+// normals of the vertices of tile p_tile_ids[tile]
+void normal_tile(
+    __global float4 *p_normal, __global float4 *p_position,
+    __global uint *p_tile_ids, uint tile,
+    uint vertices_x, uint vertices_y, uint tile_size
+)
+{
+    // code
+    uint tiles_x = (vertices_x + tile_size - 1) / tile_size;
+    uint tile_id = p_tile_ids[tile];
+
+    uint x0 = (tile_id % tiles_x) * tile_size;
+    uint y0 = (tile_id / tiles_x) * tile_size;
+    uint w = min( tile_size, vertices_x - x0);
+    uint h = min( tile_size, vertices_y - y0);
+
+    normal_region( p_normal, p_position, 0, vertices_x, vertices_y, x0, y0, w, h);
+}
+
+
+/**
+ * One constraint iteration for the tiles of one phase, one work-group per tile.
+ *
+ * p_sticks holds every stick group sorted by tile ( the tile of p0) and then by STICK_GROUP_ID, the groups
+ * being the colors of the stick graph ( no two sticks of a group share a vertex).
+ * p_tile_stick_offsets[ tile * GROUP_COUNT + group] is the first stick of the group in the tile.
+ *
+ * The work-group clamps the vertices of its tile to the bound and then satisfies the groups one after the
+ * other, with a barrier in between. A stick reaches at most 2 vertices right / down of its tile, so tiles
+ * of a phase ( same parity of tile x and tile y) never share a vertex and run concurrently.
+ *
+ * With b_write_normals ( every phase of the last iteration of a frame) the work-group then writes the normals of
+ * its tile, so no separate normal_calculation pass reads the positions again. The sticks of a later phase can
+ * still move the first 2 rows / columns of the tile and its border, their normals miss that last correction.
+ * A normal reads one vertex around the tile, which no other tile of the phase writes ( tile_size >= 3).
+ */
+__kernel void satisfy_constraints_tiled(
+    __global float4 *p_position, __global float4 *p_old_position,
+    __global bool *p_fix_vertices, __global struct Stick *p_sticks,
+    __global uint *p_tile_stick_offsets, __global uint *p_tile_ids,
+    __constant float *p_group_distance, uint first_tile,
+    uint vertices_x, uint vertices_y, uint tile_size,
+    float friction, float bounce_damping, float3 bound_dimension,
+    __global float4 *p_normal, uint b_write_normals
+)
+{
+    // code
+    uint tile = first_tile + get_group_id(0);
+    uint local_id = get_local_id(0);
+    uint local_size = get_local_size(0);
+
+    bound_tile( p_position, p_old_position, p_fix_vertices, p_tile_ids, tile, vertices_x, vertices_y, tile_size, friction, bounce_damping, bound_dimension);
+
+    barrier( CLK_GLOBAL_MEM_FENCE);
+
+        // sticks, one color at a time
+    __global uint *p_offsets = p_tile_stick_offsets + tile * GROUP_COUNT;
+
+    for( uint group = 0; group < GROUP_COUNT; ++group)
+    {
+        float group_distance = p_group_distance[group];
+
+        for( uint i = p_offsets[group] + local_id; i < p_offsets[group + 1]; i += local_size)
+        {
+            satisfy_stick( p_position, p_fix_vertices, p_sticks[i], group_distance);
+        }
+
+        barrier( CLK_GLOBAL_MEM_FENCE);
+    }
+
+    if( b_write_normals)
+    {
+        normal_tile( p_normal, p_position, p_tile_ids, tile, vertices_x, vertices_y, tile_size);
+    }
+}
+
+
+/**
+ * XPBD distance constraint ( Macklin et al.), a single iteration from lambda = 0 : with one iteration per
+ * substep no multiplier is carried between iterations.
+ *
+ *      delta_lambda = -C / ( w0 + w1 + alpha_tilde),   C = | p1 - p0 | - rest_length
+ *
+ * w0, w1 are inverse masses ( 0 for a fixed vertex), alpha_tilde = compliance / substep_time^2.
+ */
+void solve_stick_xpbd(
+    float4 *p_p0, float4 *p_p1,
+    float w0, float w1, float rest_length, float alpha_tilde
+)
+{
+    // code
+    float4 dp = *p_p1 - *p_p0;
+    float dist = length( dp.xyz);
+    float w = w0 + w1 + alpha_tilde;
+
+    if( (dist <= 0.0f) || (w <= 0.0f))
+    {
+        return;
+    }
+
+    float delta_lambda = -(dist - rest_length) / w;
+    float4 correction = dp * (delta_lambda / dist);
+
+    *p_p0 = *p_p0 - correction * w0;
+    *p_p1 = *p_p1 + correction * w1;
+
+    (*p_p0).w = (*p_p1).w = 1.0f;
+}
+
+
+/**
+ * satisfy_constraints_tiled() with XPBD sticks, for one substep of SOLVER_XPBD.
+ * p_group_alpha[ group] is the compliance of the group divided by substep_time^2, inverse_mass that of a free vertex.
+ * b_write_normals is set for the phases of the last substep of a frame.
+ */
+__kernel void satisfy_constraints_tiled_xpbd(
+    __global float4 *p_position, __global float4 *p_old_position,
+    __global bool *p_fix_vertices, __global struct Stick *p_sticks,
+    __global uint *p_tile_stick_offsets, __global uint *p_tile_ids,
+    __constant float *p_group_distance, __constant float *p_group_alpha,
+    uint first_tile, uint vertices_x, uint vertices_y, uint tile_size,
+    float inverse_mass, float friction, float bounce_damping, float3 bound_dimension,
+    __global float4 *p_normal, uint b_write_normals
+)
+{
+    // code
+    uint tile = first_tile + get_group_id(0);
+    uint local_id = get_local_id(0);
+    uint local_size = get_local_size(0);
+
+    bound_tile( p_position, p_old_position, p_fix_vertices, p_tile_ids, tile, vertices_x, vertices_y, tile_size, friction, bounce_damping, bound_dimension);
+
+    barrier( CLK_GLOBAL_MEM_FENCE);
+
+        // sticks, one color at a time
+    __global uint *p_offsets = p_tile_stick_offsets + tile * GROUP_COUNT;
+
+    for( uint group = 0; group < GROUP_COUNT; ++group)
+    {
+        float group_distance = p_group_distance[group];
+        float alpha_tilde = p_group_alpha[group];
+
+        for( uint i = p_offsets[group] + local_id; i < p_offsets[group + 1]; i += local_size)
+        {
+            struct Stick stick = p_sticks[i];
+
+            float4 p0 = p_position[stick.p0];
+            float4 p1 = p_position[stick.p1];
+
+            float w0 = p_fix_vertices[stick.p0] ? 0.0f : inverse_mass;
+            float w1 = p_fix_vertices[stick.p1] ? 0.0f : inverse_mass;
+
+            solve_stick_xpbd( &p0, &p1, w0, w1, group_distance, alpha_tilde);
+
+            p_position[stick.p0] = p0;
+            p_position[stick.p1] = p1;
+        }
+
+        barrier( CLK_GLOBAL_MEM_FENCE);
+    }
+
+    if( b_write_normals)
+    {
+        normal_tile( p_normal, p_position, p_tile_ids, tile, vertices_x, vertices_y, tile_size);
+    }
+}
+
+
+/**
+ * Stick of a group that starts on vertex ( x, y), the grouping of CreateCloth() ( Cloth_CL.cpp).
+ * Returns false if the vertex starts no stick of the group, else ( *p_dx, *p_dy) is the offset of p1.
+ */
+bool group_stick( int group, int x, int y, int *p_dx, int *p_dy)
+{
+    // code
+    *p_dx = 0;
+    *p_dy = 0;
+
+    switch( group)
+    {
+        case HORIZONTAL_DISTANCE_1_EVEN:
+        case HORIZONTAL_DISTANCE_1_ODD:
+            *p_dx = 1;
+            return (x % 2) == (group == HORIZONTAL_DISTANCE_1_ODD);
+
+        case VERTICAL_DISTANCE_1_EVEN:
+        case VERTICAL_DISTANCE_1_ODD:
+            *p_dy = 1;
+            return (y % 2) == (group == VERTICAL_DISTANCE_1_ODD);
+
+        case DIAGONAL_DISTANCE_1_EVEN:
+        case DIAGONAL_DISTANCE_1_ODD:
+            *p_dx = *p_dy = 1;
+            return (y % 2) == (group == DIAGONAL_DISTANCE_1_ODD);
+
+        case HORIZONTAL_DISTANCE_2_EVEN:
+        case HORIZONTAL_DISTANCE_2_ODD:
+            *p_dx = 2;
+            return ((x % 4) < 2) == (group == HORIZONTAL_DISTANCE_2_ODD);
+
+        case VERTICAL_DISTANCE_2_EVEN:
+        case VERTICAL_DISTANCE_2_ODD:
+            *p_dy = 2;
+            return ((y % 4) < 2) == (group == VERTICAL_DISTANCE_2_ODD);
+
+        case DIAGONAL_DISTANCE_2_EVEN:
+        case DIAGONAL_DISTANCE_2_ODD:
+            *p_dx = *p_dy = 2;
+            return ((y % 4) < 2) == (group == DIAGONAL_DISTANCE_2_ODD);
+    }
+
+    return false;
+}
+
+
+// satisfy_constraints_local : halo around a tile ( the reach of a stick) and vertex state in local memory
+#define LOCAL_TILE_HALO 2
+
+#define VERTEX_PRESENT 0x1
+#define VERTEX_OWNED 0x2
+#define VERTEX_FIXED 0x4
+
+/**
+ * inner_iterations constraint iterations on a tile kept in local memory, one work-group per tile, all tiles
+ * in one launch.
+ *
+ * The tile and a halo of LOCAL_TILE_HALO vertices are read from p_position_in once, the iterations run in
+ * local memory ( sticks are enumerated from the grid, group by group, with a barrier between groups) and the
+ * tile alone is written to p_position_out. The halo is the neighbours' state of the previous launch, so the
+ * tiles are coupled Jacobi-style across launches and Gauss-Seidel inside a tile.
+ * p_position_in and p_position_out must differ, a launch reads halos that other work-groups write.
+ *
+ * With b_write_normals ( last launch of a frame) the normals of the tile are computed from the local positions
+ * and written to p_normal, so no separate normal_calculation pass reads the positions again.
+ *
+ * Local memory : p_tile_position, p_tile_old_position ( float4) and p_tile_state ( uchar), ( tile_size + 2 * LOCAL_TILE_HALO)^2 each.
+ */
+__kernel void satisfy_constraints_local(
+    __global float4 *p_position_in, __global float4 *p_position_out,
+    __global float4 *p_old_position, __global bool *p_fix_vertices,
+    __constant float *p_group_distance, uint vertices_x, uint vertices_y,
+    uint tile_size, uint inner_iterations,
+    float friction, float bounce_damping, float3 bound_dimension,
+    __global float4 *p_normal, uint b_write_normals,
+    __local float4 *p_tile_position, __local float4 *p_tile_old_position,
+    __local uchar *p_tile_state
+)
+{
+    // code
+    int local_id = get_local_id(0);
+    int local_size = get_local_size(0);
+
+        // tile and region ( tile + halo) in cloth coordinates
+    int tiles_x = (vertices_x + tile_size - 1) / tile_size;
+
+    int x0 = (get_group_id(0) % tiles_x) * tile_size;
+    int y0 = (get_group_id(0) / tiles_x) * tile_size;
+    int x1 = min( x0 + (int)tile_size, (int)vertices_x);
+    int y1 = min( y0 + (int)tile_size, (int)vertices_y);
+
+    int region = tile_size + 2 * LOCAL_TILE_HALO;
+    int region_x0 = x0 - LOCAL_TILE_HALO;
+    int region_y0 = y0 - LOCAL_TILE_HALO;
+
+        // load
+    for( int i = local_id; i < region * region; i += local_size)
+    {
+        int x = region_x0 + i % region;
+        int y = region_y0 + i / region;
+
+        uchar state = 0;
+
+        if( (x >= 0) && (x < (int)vertices_x) && (y >= 0) && (y < (int)vertices_y))
+        {
+            uint index = y * vertices_x + x;
+
+            state = VERTEX_PRESENT;
+            p_tile_position[i] = p_position_in[index];
+
+            if( p_fix_vertices[index])
+            {
+                state |= VERTEX_FIXED;
+            }
+
+            if( (x >= x0) && (x < x1) && (y >= y0) && (y < y1))
+            {
+                state |= VERTEX_OWNED;
+                p_tile_old_position[i] = p_old_position[index];
+            }
+        }
+
+        p_tile_state[i] = state;
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    for( uint iteration = 0; iteration < inner_iterations; ++iteration)
+    {
+            // bound, the old position of a halo vertex is not kept ( its owner bounces it)
+        for( int i = local_id; i < region * region; i += local_size)
+        {
+            uchar state = p_tile_state[i];
+
+            if( (state & VERTEX_PRESENT) && !(state & VERTEX_FIXED))
+            {
+                float4 pos = p_tile_position[i];
+                float4 old_pos = (state & VERTEX_OWNED) ? p_tile_old_position[i] : pos;
+
+                bound_vertex( &pos, &old_pos, friction, bounce_damping, bound_dimension);
+
+                p_tile_position[i] = pos;
+
+                if( state & VERTEX_OWNED)
+                {
+                    p_tile_old_position[i] = old_pos;
+                }
+            }
+        }
+
+        barrier( CLK_LOCAL_MEM_FENCE);
+
+            // sticks with both vertices in the region, one group at a time
+        for( int group = 0; group < GROUP_COUNT; ++group)
+        {
+            float group_distance = p_group_distance[group];
+
+            for( int i = local_id; i < region * region; i += local_size)
+            {
+                int local_x = i % region;
+                int local_y = i / region;
+                int dx, dy;
+
+                if( !(p_tile_state[i] & VERTEX_PRESENT))
+                {
+                    continue;
+                }
+
+                if( !group_stick( group, region_x0 + local_x, region_y0 + local_y, &dx, &dy))
+                {
+                    continue;
+                }
+
+                if( ((local_x + dx) >= region) || ((local_y + dy) >= region))
+                {
+                    continue;
+                }
+
+                int j = i + dy * region + dx;
+
+                if( !(p_tile_state[j] & VERTEX_PRESENT))
+                {
+                    continue;
+                }
+
+                float4 p0 = p_tile_position[i];
+                float4 p1 = p_tile_position[j];
+
+                solve_stick( &p0, &p1, p_tile_state[i] & VERTEX_FIXED, p_tile_state[j] & VERTEX_FIXED, group_distance);
+
+                p_tile_position[i] = p0;
+                p_tile_position[j] = p1;
+            }
+
+            barrier( CLK_LOCAL_MEM_FENCE);
+        }
+    }
+
+        // store the tile
+    for( int i = local_id; i < region * region; i += local_size)
+    {
+        if( p_tile_state[i] & VERTEX_OWNED)
+        {
+            uint index = (region_y0 + i / region) * vertices_x + (region_x0 + i % region);
+
+            p_position_out[index] = p_tile_position[i];
+            p_old_position[index] = p_tile_old_position[i];
+
+            if( b_write_normals)
+            {
+                int x = region_x0 + i % region;
+                int y = region_y0 + i / region;
+
+                    // owned vertices are at least LOCAL_TILE_HALO from the region border
+                bool b_left = x > 0;
+                bool b_right = x < (int)(vertices_x - 1);
+                bool b_down = y > 0;
+                bool b_up = y < (int)(vertices_y - 1);
+
+                float3 position = p_tile_position[i].xyz;
+
+                p_normal[index].xyz = vertex_normal(
+                    position,
+                    b_left ? p_tile_position[i - 1].xyz : position,
+                    b_right ? p_tile_position[i + 1].xyz : position,
+                    b_down ? p_tile_position[i - region].xyz : position,
+                    b_up ? p_tile_position[i + region].xyz : position,
+                    b_left, b_right, b_down, b_up
+                );
+            }
+        }
+    }
 }
 
 
@@ -204,46 +774,562 @@ __kernel void normal_calculation(
     uint x = index % width;
     uint y = index / width;
 
+    if( y >= height)
+    {
+        return;
+    }
+
     float3 position = p_position[index].xyz;
-    float3 normal = (float3)( 0.0f, 0.0f, 0.0f);
+    float3 left = (x > 0) ? p_position[index - 1].xyz : position;
+    float3 right = (x < (width - 1)) ? p_position[index + 1].xyz : position;
+    float3 down = (y > 0) ? p_position[index - width].xyz : position;
+    float3 up = (y < (height - 1)) ? p_position[index + width].xyz : position;
+
+    p_normal[index].xyz = vertex_normal( position, left, right, down, up, x > 0, x < (width - 1), y > 0, y < (height - 1));
+}
+
+
+//////////////////////////////////////////////
+///////// COLLISIONS
+//////////////////////////////////////////////
+
+    // slot of a grid cell in the spatial hash table, table_size is a power of 2
+uint cell_hash( int x, int y, int z, uint table_size)
+{
+    // code
+    return (((uint)x * 92837111u) ^ ((uint)y * 689287499u) ^ ((uint)z * 283923481u)) & (table_size - 1);
+}
+
+
+    // counting sort, pass 1 : vertices per slot, and the rank of every vertex in its slot
+__kernel void hash_vertices(
+    __global float4 *p_position, __global uint *p_cell_count,
+    __global uint *p_vertex_cell, __global uint *p_vertex_rank,
+    float cell_size, uint table_size, uint vertices_count
+)
+{
+    // code
+    int index = get_global_id(0);
+    if( index > (vertices_count - 1))
+    {
+        return;
+    }
+
+    float4 pos = p_position[index];
+
+    uint cell = cell_hash( (int)floor( pos.x / cell_size), (int)floor( pos.y / cell_size), (int)floor( pos.z / cell_size), table_size);
+
+    p_vertex_cell[index] = cell;
+    p_vertex_rank[index] = atomic_inc( &p_cell_count[cell]);
+}
+
+
+    // counting sort, pass 2 : in place exclusive scan of one block per work-group, block totals to p_block_sums ( if any)
+__kernel void scan_cells(
+    __global uint *p_data, __global uint *p_block_sums, uint count,
+    __local uint *p_temp
+)
+{
+    // code
+    uint local_id = get_local_id(0);
+    uint local_size = get_local_size(0);
+    uint index = get_global_id(0);
+
+    uint value = (index < count) ? p_data[index] : 0;
+
+    p_temp[local_id] = value;
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    for( uint offset = 1; offset < local_size; offset <<= 1)
+    {
+        uint sum = (local_id >= offset) ? p_temp[local_id - offset] : 0;
+        barrier( CLK_LOCAL_MEM_FENCE);
+
+        p_temp[local_id] += sum;
+        barrier( CLK_LOCAL_MEM_FENCE);
+    }
+
+    if( index < count)
+    {
+        p_data[index] = p_temp[local_id] - value;
+    }
+
+    if( (p_block_sums != 0) && (local_id == (local_size - 1)))
+    {
+        p_block_sums[get_group_id(0)] = p_temp[local_id];
+    }
+}
+
+
+    // counting sort, pass 3 : scanned block totals added back, same work-group size as scan_cells
+__kernel void add_block_offsets(
+    __global uint *p_data, __global uint *p_block_offsets, uint count
+)
+{
+    // code
+    uint index = get_global_id(0);
+    if( index >= count)
+    {
+        return;
+    }
+
+    p_data[index] += p_block_offsets[get_group_id(0)];
+}
+
+
+    // counting sort, pass 4 : vertices ordered by slot
+__kernel void scatter_vertices(
+    __global uint *p_vertex_cell, __global uint *p_vertex_rank,
+    __global uint *p_cell_start, __global uint *p_sorted_vertices,
+    uint vertices_count
+)
+{
+    // code
+    int index = get_global_id(0);
+    if( index > (vertices_count - 1))
+    {
+        return;
+    }
+
+    p_sorted_vertices[p_cell_start[p_vertex_cell[index]] + p_vertex_rank[index]] = index;
+}
+
+
+float3 closest_point_on_segment( float3 p, float3 a, float3 b)
+{
+    // code
+    float3 ab = b - a;
+    float ab_length_squared = dot( ab, ab);
+
+    if( ab_length_squared <= 0.0f)
+    {
+        return a;
+    }
+
+    return a + ab * clamp( dot( p - a, ab) / ab_length_squared, 0.0f, 1.0f);
+}
+
+
+    // Real-Time Collision Detection ( Ericson), 5.1.5
+float3 closest_point_on_triangle( float3 p, float3 a, float3 b, float3 c)
+{
+    // code
+    float3 ab = b - a;
+    float3 ac = c - a;
+    float3 ap = p - a;
+
+    float d1 = dot( ab, ap);
+    float d2 = dot( ac, ap);
+    if( (d1 <= 0.0f) && (d2 <= 0.0f))
+    {
+        return a;
+    }
+
+    float3 bp = p - b;
+    float d3 = dot( ab, bp);
+    float d4 = dot( ac, bp);
+    if( (d3 >= 0.0f) && (d4 <= d3))
+    {
+        return b;
+    }
+
+    float vc = d1 * d4 - d3 * d2;
+    if( (vc <= 0.0f) && (d1 >= 0.0f) && (d3 <= 0.0f))
+    {
+        return a + ab * (d1 / (d1 - d3));
+    }
+
+    float3 cp = p - c;
+    float d5 = dot( ab, cp);
+    float d6 = dot( ac, cp);
+    if( (d6 >= 0.0f) && (d5 <= d6))
+    {
+        return c;
+    }
+
+    float vb = d5 * d2 - d1 * d6;
+    if( (vb <= 0.0f) && (d2 >= 0.0f) && (d6 <= 0.0f))
+    {
+        return a + ac * (d2 / (d2 - d6));
+    }
+
+    float va = d3 * d6 - d5 * d4;
+    if( (va <= 0.0f) && ((d4 - d3) >= 0.0f) && ((d5 - d6) >= 0.0f))
+    {
+        return b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+    }
+
+    float denominator = 1.0f / (va + vb + vc);
+
+    return a + ab * (vb * denominator) + ac * (vc * denominator);
+}
+
+
+    // pushes pos out of the sphere ( center, radius)
+void push_out_of_sphere( float3 *p_pos, float3 center, float radius)
+{
+    // code
+    float3 d = *p_pos - center;
+    float dist = length( d);
+
+    if( (dist < radius) && (dist > 0.0f))
+    {
+        *p_pos = center + d * (radius / dist);
+    }
+}
+
+
+/**
+ * collide_vertices() : one work-item per vertex, p_position_in -> p_position_out
+ *
+ *  - self collision ( p_cell_start != 0) : vertices of the 27 cells around the vertex, found through the spatial hash
+ *    built by hash_vertices() .. scatter_vertices(), closer than thickness are pushed apart. Vertices at most 2
+ *    apart in the cloth are left to the sticks. The corrections are averaged ( Jacobi), so the order of the
+ *    vertices in a slot does not matter
+ *  - spheres ( xyz center, w radius) and capsules ( 2 float4, xyz end points, w of the first is the radius)
+ *  - triangle mesh ( p_mesh_cell_start != 0) : dense grid of cells of mesh_origin.w, every cell lists the
+ *    triangles whose bounds + thickness overlap it. The vertex is kept on the side of the triangle its old position was on
+ */
+__kernel void collide_vertices(
+    __global float4 *p_position_in, __global float4 *p_position_out,
+    __global float4 *p_old_position, __global bool *p_fix_vertices,
+    __global uint *p_cell_start, __global uint *p_sorted_vertices, uint table_size,
+    __global float4 *p_spheres, uint spheres_count,
+    __global float4 *p_capsules, uint capsules_count,
+    __global float4 *p_mesh_vertices, __global uint *p_mesh_indices,
+    __global uint *p_mesh_cell_start, __global uint *p_mesh_cell_triangles,
+    float4 mesh_origin, uint mesh_cells_x, uint mesh_cells_y, uint mesh_cells_z,
+    float thickness, uint vertices_x, uint vertices_count
+)
+{
+    // code
+    int index = get_global_id(0);
+    if( index > (vertices_count - 1))
+    {
+        return;
+    }
 
-    if( x > 0)
+    if( p_fix_vertices[index])
+    {
+        p_position_out[index] = p_position_in[index];
+        return;
+    }
+
+    float3 pos = p_position_in[index].xyz;
+
+        // self collision, the hash cells are thickness wide
+    if( p_cell_start != 0)
     {
-        float3 left = p_position[ index - 1].xyz;
+        int cell_x = (int)floor( pos.x / thickness);
+        int cell_y = (int)floor( pos.y / thickness);
+        int cell_z = (int)floor( pos.z / thickness);
+
+        int vertex_x = index % vertices_x;
+        int vertex_y = index / vertices_x;
+
+        float3 correction = (float3)( 0.0f);
+        int contacts_count = 0;
 
-        if( y > 0)
+        for( int z = cell_z - 1; z <= cell_z + 1; ++z)
         {
-            float3 down = p_position[index - width].xyz;
-            // normal += normalize( cross( left - position, down - position));
-            normal += normalize( cross( down - position, left - position));
+            for( int y = cell_y - 1; y <= cell_y + 1; ++y)
+            {
+                for( int x = cell_x - 1; x <= cell_x + 1; ++x)
+                {
+                    uint cell = cell_hash( x, y, z, table_size);
+                    uint first = p_cell_start[cell];
+                    uint last = (cell < (table_size - 1)) ? p_cell_start[cell + 1] : vertices_count;
+
+                    for( uint i = first; i < last; ++i)
+                    {
+                        uint other = p_sorted_vertices[i];
+
+                        int other_x = other % vertices_x;
+                        int other_y = other / vertices_x;
+                        if( (abs( other_x - vertex_x) <= 2) && (abs( other_y - vertex_y) <= 2))
+                        {
+                            continue;
+                        }
+
+                        float3 other_pos = p_position_in[other].xyz;
+
+                            // another cell in the same slot, it is visited with its own cell
+                        if( ((int)floor( other_pos.x / thickness) != x) ||
+                            ((int)floor( other_pos.y / thickness) != y) ||
+                            ((int)floor( other_pos.z / thickness) != z))
+                        {
+                            continue;
+                        }
+
+                        float3 d = pos - other_pos;
+                        float dist = length( d);
+
+                        if( (dist < thickness) && (dist > 0.0f))
+                        {
+                            correction += d * ((thickness - dist) * 0.5f / dist);
+                            ++contacts_count;
+                        }
+                    }
+                }
+            }
         }
 
-        if( y < (height - 1))
+        if( contacts_count > 0)
         {
-            float3 up = p_position[index + width].xyz;
-            // normal += normalize( cross( up - position, left - position));
-            normal += normalize( cross( left - position, up - position));
+            pos += correction / (float)contacts_count;
         }
     }
 
-    if( x < (width - 1))
+    for( uint i = 0; i < spheres_count; ++i)
+    {
+        float4 sphere = p_spheres[i];
+
+        push_out_of_sphere( &pos, sphere.xyz, sphere.w + thickness);
+    }
+
+    for( uint i = 0; i < capsules_count; ++i)
+    {
+        float4 a = p_capsules[2 * i];
+        float4 b = p_capsules[2 * i + 1];
+
+        push_out_of_sphere( &pos, closest_point_on_segment( pos, a.xyz, b.xyz), a.w + thickness);
+    }
+
+    if( p_mesh_cell_start != 0)
     {
-        float3 right = p_position[ index + 1].xyz;
+        float mesh_cell_size = mesh_origin.w;
 
-        if( y > 0)
+        int x = (int)floor( (pos.x - mesh_origin.x) / mesh_cell_size);
+        int y = (int)floor( (pos.y - mesh_origin.y) / mesh_cell_size);
+        int z = (int)floor( (pos.z - mesh_origin.z) / mesh_cell_size);
+
+        if( (x >= 0) && (x < (int)mesh_cells_x) && (y >= 0) && (y < (int)mesh_cells_y) && (z >= 0) && (z < (int)mesh_cells_z))
         {
-            float3 down = p_position[index - width].xyz;
-            // normal += normalize( cross( down - position, right - position));
-            normal += normalize( cross( right - position, down - position));
+            uint cell = (z * mesh_cells_y + y) * mesh_cells_x + x;
+            float3 old_pos = p_old_position[index].xyz;
+
+            for( uint i = p_mesh_cell_start[cell]; i < p_mesh_cell_start[cell + 1]; ++i)
+            {
+                uint triangle = p_mesh_cell_triangles[i];
+
+                float3 a = p_mesh_vertices[p_mesh_indices[3 * triangle]].xyz;
+                float3 b = p_mesh_vertices[p_mesh_indices[3 * triangle + 1]].xyz;
+                float3 c = p_mesh_vertices[p_mesh_indices[3 * triangle + 2]].xyz;
+
+                float3 closest = closest_point_on_triangle( pos, a, b, c);
+                if( distance( pos, closest) >= thickness)
+                {
+                    continue;
+                }
+
+                float3 normal = normalize( cross( b - a, c - a));
+                if( dot( old_pos - a, normal) < 0.0f)
+                {
+                    normal = -normal;
+                }
+
+                    // still on its side : out of the thickness around the triangle, else back through the plane
+                if( dot( pos - a, normal) >= 0.0f)
+                {
+                    push_out_of_sphere( &pos, closest, thickness);
+                }
+                else
+                {
+                    pos = closest + normal * thickness;
+                }
+            }
+        }
+    }
+
+    p_position_out[index] = (float4)( pos, 1.0f);
+}
+
+
+//////////////////////////////////////////////
+///////// BATCHES
+//////////////////////////////////////////////
+
+    // one cloth of a batch ( ClothInstance of Cloth_CL.cpp), vertices first_vertex .. first_vertex + vertices_x * vertices_y - 1
+struct ClothInstance
+{
+    uint first_vertex;
+    uint vertices_x;
+    uint vertices_y;
+    float inverse_mass;
+    float gravity[3];
+    float group_distance[GROUP_COUNT];
+    float group_alpha[GROUP_COUNT];
+};
+
+    // tile of a batch : its instance and its first vertex ( x0, y0) in the instance
+struct ClothTile
+{
+    uint instance;
+    uint x0;
+    uint y0;
+};
+
+
+/**
+ * update_vertices() for every tile of a batch, one work-group per tile, all the instances in one launch.
+ * The gravity of an instance is scaled by gravity_scale ( 1 / substeps^2 for the substeps of SOLVER_XPBD).
+ */
+__kernel void update_vertices_batched(
+    __global float4 *p_position, __global float4 *p_old_position,
+    __global bool *p_fix_vertices, __global struct ClothInstance *p_instances,
+    __global struct ClothTile *p_tiles, uint tile_size,
+    float gravity_scale, float friction
+)
+{
+    // code
+    struct ClothTile tile = p_tiles[get_group_id(0)];
+    struct ClothInstance instance = p_instances[tile.instance];
+
+    uint w = min( tile_size, instance.vertices_x - tile.x0);
+    uint h = min( tile_size, instance.vertices_y - tile.y0);
+
+    float4 gravity = (float4)( instance.gravity[0], instance.gravity[1], instance.gravity[2], 0.0f) * gravity_scale;
+
+    for( uint i = get_local_id(0); i < w * h; i += get_local_size(0))
+    {
+        uint index = instance.first_vertex + (tile.y0 + i / w) * instance.vertices_x + (tile.x0 + i % w);
+
+        if( p_fix_vertices[index])
+        {
+            continue;
         }
 
-        if( y < (height - 1))
+        float4 pos = p_position[index];
+        float4 old_pos = p_old_position[index];
+
+        float4 velocity = (pos - old_pos) * friction;
+
+        old_pos = pos;
+        pos = pos + velocity + gravity;
+
+        p_position[index] = (float4)(pos.xyz, 1.0f);
+        p_old_position[index] = (float4)(old_pos.xyz, 1.0f);
+    }
+}
+
+
+/**
+ * satisfy_constraints_tiled() for the tiles of one phase of a batch.
+ *
+ * The tiles of every instance are colored by the parity of their tile x and tile y as in a single cloth, and
+ * the batch concatenates them phase by phase, so one launch per phase covers all the instances. Sticks index
+ * the shared position buffer, the rest lengths are those of the tile's instance.
+ */
+__kernel void satisfy_constraints_batched(
+    __global float4 *p_position, __global float4 *p_old_position,
+    __global bool *p_fix_vertices, __global struct Stick *p_sticks,
+    __global uint *p_tile_stick_offsets, __global struct ClothTile *p_tiles,
+    __global struct ClothInstance *p_instances, uint first_tile, uint tile_size,
+    float friction, float bounce_damping, float3 bound_dimension
+)
+{
+    // code
+    uint tile = first_tile + get_group_id(0);
+    uint local_id = get_local_id(0);
+    uint local_size = get_local_size(0);
+
+    struct ClothTile batch_tile = p_tiles[tile];
+    __global struct ClothInstance *p_instance = p_instances + batch_tile.instance;
+
+    uint w = min( tile_size, p_instance->vertices_x - batch_tile.x0);
+    uint h = min( tile_size, p_instance->vertices_y - batch_tile.y0);
+
+    bound_region( p_position, p_old_position, p_fix_vertices, p_instance->first_vertex, p_instance->vertices_x, batch_tile.x0, batch_tile.y0, w, h, friction, bounce_damping, bound_dimension);
+
+    barrier( CLK_GLOBAL_MEM_FENCE);
+
+        // sticks, one color at a time
+    __global uint *p_offsets = p_tile_stick_offsets + tile * GROUP_COUNT;
+
+    for( uint group = 0; group < GROUP_COUNT; ++group)
+    {
+        float group_distance = p_instance->group_distance[group];
+
+        for( uint i = p_offsets[group] + local_id; i < p_offsets[group + 1]; i += local_size)
         {
-            float3 up = p_position[index + width].xyz;
-            // normal += normalize( cross( right - position, up - position));
-            normal += normalize( cross( up - position, right - position));
+            satisfy_stick( p_position, p_fix_vertices, p_sticks[i], group_distance);
         }
+
+        barrier( CLK_GLOBAL_MEM_FENCE);
     }
+}
+
+
+/**
+ * satisfy_constraints_tiled_xpbd() for the tiles of one phase of a batch, the compliance ( group_alpha) and
+ * inverse mass are those of the tile's instance.
+ */
+__kernel void satisfy_constraints_batched_xpbd(
+    __global float4 *p_position, __global float4 *p_old_position,
+    __global bool *p_fix_vertices, __global struct Stick *p_sticks,
+    __global uint *p_tile_stick_offsets, __global struct ClothTile *p_tiles,
+    __global struct ClothInstance *p_instances, uint first_tile, uint tile_size,
+    float friction, float bounce_damping, float3 bound_dimension
+)
+{
+    // code
+    uint tile = first_tile + get_group_id(0);
+    uint local_id = get_local_id(0);
+    uint local_size = get_local_size(0);
+
+    struct ClothTile batch_tile = p_tiles[tile];
+    __global struct ClothInstance *p_instance = p_instances + batch_tile.instance;
+
+    uint w = min( tile_size, p_instance->vertices_x - batch_tile.x0);
+    uint h = min( tile_size, p_instance->vertices_y - batch_tile.y0);
+
+    bound_region( p_position, p_old_position, p_fix_vertices, p_instance->first_vertex, p_instance->vertices_x, batch_tile.x0, batch_tile.y0, w, h, friction, bounce_damping, bound_dimension);
+
+    barrier( CLK_GLOBAL_MEM_FENCE);
+
+        // sticks, one color at a time
+    __global uint *p_offsets = p_tile_stick_offsets + tile * GROUP_COUNT;
+    float inverse_mass = p_instance->inverse_mass;
+
+    for( uint group = 0; group < GROUP_COUNT; ++group)
+    {
+        float group_distance = p_instance->group_distance[group];
+        float alpha_tilde = p_instance->group_alpha[group];
+
+        for( uint i = p_offsets[group] + local_id; i < p_offsets[group + 1]; i += local_size)
+        {
+            struct Stick stick = p_sticks[i];
+
+            float4 p0 = p_position[stick.p0];
+            float4 p1 = p_position[stick.p1];
+
+            float w0 = p_fix_vertices[stick.p0] ? 0.0f : inverse_mass;
+            float w1 = p_fix_vertices[stick.p1] ? 0.0f : inverse_mass;
+
+            solve_stick_xpbd( &p0, &p1, w0, w1, group_distance, alpha_tilde);
+
+            p_position[stick.p0] = p0;
+            p_position[stick.p1] = p1;
+        }
+
+        barrier( CLK_GLOBAL_MEM_FENCE);
+    }
+}
+
+
+    // normal_calculation() for every tile of a batch, one work-group per tile
+__kernel void normal_calculation_batched(
+    __global float4 *p_normal, __global float4 *p_position,
+    __global struct ClothInstance *p_instances,
+    __global struct ClothTile *p_tiles, uint tile_size
+)
+{
+    // code
+    struct ClothTile tile = p_tiles[get_group_id(0)];
+    struct ClothInstance instance = p_instances[tile.instance];
+
+    uint w = min( tile_size, instance.vertices_x - tile.x0);
+    uint h = min( tile_size, instance.vertices_y - tile.y0);
 
-    p_normal[index].xyz = normalize( normal);
+    normal_region( p_normal, p_position, instance.first_vertex, instance.vertices_x, instance.vertices_y, tile.x0, tile.y0, w, h);
 }
@@ -0,0 +1,442 @@
+/************************
+ *
+ * General 2D convolution
+ *
+ *      output( x, y) = sum( mask( c, r) * input( x + c, y + r)),  0 <= c < mask_width, 0 <= r < mask_height
+ *
+ * Same definition as convolve() of "04. Convolution": only the "valid" part is computed, so the output is
+ * ( input_width - mask_width + 1) x ( input_height - mask_height + 1) and no border handling is needed.
+ *
+ *  - the mask is read from __constant memory.
+ *  - every work-group first copies its TILE_WIDTH x TILE_HEIGHT input tile plus the
+ *    ( mask_width - 1) x ( mask_height - 1) halo into local memory, the cache is a __local kernel argument of
+ *    ( TILE_WIDTH + mask_width - 1) * ( TILE_HEIGHT + mask_height - 1) elements.
+ *  - every kernel exists for float and uint ( uint arithmetic wraps, as in convolve()).
+ *
+ * Kernels ( T is float or uint)
+ *      convolve_T()   : any mask size, loop bounds are kernel arguments.
+ *      convolve_T_N() : N x N mask ( N = 3, 5, 7), the mask size is a compile-time constant so both loops are
+ *                       fully unrolled and the cache indices fold into constants.
+ *                       mask_width and mask_height must still be passed and must be N.
+ *
+ * Work-group size must be ( TILE_WIDTH, TILE_HEIGHT).
+ */
+
+#ifndef TILE_WIDTH
+    #define TILE_WIDTH  16
+#endif
+
+#ifndef TILE_HEIGHT
+    #define TILE_HEIGHT 16
+#endif
+
+/**
+ * @brief CONVOLVE_BODY: shared body, MASK_W / MASK_H are either the kernel arguments or literals, UNROLL is
+ *        either empty or _Pragma( "unroll").
+ */
+#define CONVOLVE_BODY( T, MASK_W, MASK_H, UNROLL)                                                   \
+    const int mask_w = MASK_W;                                                                      \
+    const int mask_h = MASK_H;                                                                      \
+                                                                                                    \
+    const int output_width = input_width - mask_w + 1;                                              \
+    const int output_height = input_height - mask_h + 1;                                            \
+                                                                                                    \
+    const int lx = (int)get_local_id(0);                                                            \
+    const int ly = (int)get_local_id(1);                                                            \
+    const int tid = mad24( ly, TILE_WIDTH, lx);                                                     \
+                                                                                                    \
+    const int x = (int)get_global_id(0);                                                            \
+    const int y = (int)get_global_id(1);                                                            \
+                                                                                                    \
+    const int x0 = (int)get_group_id(0) * TILE_WIDTH;                                               \
+    const int y0 = (int)get_group_id(1) * TILE_HEIGHT;                                              \
+                                                                                                    \
+    const int cache_width = TILE_WIDTH + mask_w - 1;                                                \
+    const int cache_height = TILE_HEIGHT + mask_h - 1;                                              \
+                                                                                                    \
+        /* cooperative load of tile + halo, elements past the input are never used by a valid output */ \
+    for( int i = tid; i < cache_width * cache_height; i += TILE_WIDTH * TILE_HEIGHT)                \
+    {                                                                                               \
+        int cy = i / cache_width;                                                                   \
+        int cx = i - cy * cache_width;                                                              \
+                                                                                                    \
+        int gx = x0 + cx;                                                                           \
+        int gy = y0 + cy;                                                                           \
+                                                                                                    \
+        cache[i] = ( (gx < input_width) && (gy < input_height)) ? input[ mad24( gy, input_width, gx)] : (T)0; \
+    }                                                                                               \
+                                                                                                    \
+    barrier( CLK_LOCAL_MEM_FENCE);                                                                  \
+                                                                                                    \
+    if( (x >= output_width) || (y >= output_height))                                                \
+    {                                                                                               \
+        return;                                                                                     \
+    }                                                                                               \
+                                                                                                    \
+    T sum = (T)0;                                                                                   \
+                                                                                                    \
+    UNROLL                                                                                          \
+    for( int r = 0; r < mask_h; ++r)                                                                \
+    {                                                                                               \
+        __local const T *row = cache + mad24( ly + r, cache_width, lx);                             \
+        __constant const T *mask_row = mask + r * mask_w;                                           \
+                                                                                                    \
+        UNROLL                                                                                      \
+        for( int c = 0; c < mask_w; ++c)                                                            \
+        {                                                                                           \
+            sum += mask_row[c] * row[c];                                                            \
+        }                                                                                           \
+    }                                                                                               \
+                                                                                                    \
+    output[ mad24( y, output_width, x)] = sum;
+
+/**
+ * @brief CONVOLVE_KERNEL: declares one convolution kernel, every kernel has the same argument list.
+ */
+#define CONVOLVE_KERNEL( T, NAME, MASK_W, MASK_H, UNROLL)                                           \
+__kernel __attribute__(( reqd_work_group_size( TILE_WIDTH, TILE_HEIGHT, 1)))                        \
+void NAME(                                                                                          \
+    __global const T *input,                                                                        \
+    __constant T *mask,                                                                             \
+    __global T *output,                                                                             \
+    int input_width,                                                                                \
+    int input_height,                                                                               \
+    int mask_width,                                                                                 \
+    int mask_height,                                                                                \
+    __local T *cache                                                                                \
+)                                                                                                   \
+{                                                                                                   \
+    CONVOLVE_BODY( T, MASK_W, MASK_H, UNROLL)                                                       \
+}
+
+#define NO_UNROLL
+#define FULL_UNROLL _Pragma( "unroll")
+
+    // any mask size
+CONVOLVE_KERNEL( float, convolve_float, mask_width, mask_height, NO_UNROLL)
+CONVOLVE_KERNEL( uint, convolve_uint, mask_width, mask_height, NO_UNROLL)
+
+    // fixed N x N masks
+CONVOLVE_KERNEL( float, convolve_float_3, 3, 3, FULL_UNROLL)
+CONVOLVE_KERNEL( float, convolve_float_5, 5, 5, FULL_UNROLL)
+CONVOLVE_KERNEL( float, convolve_float_7, 7, 7, FULL_UNROLL)
+
+CONVOLVE_KERNEL( uint, convolve_uint_3, 3, 3, FULL_UNROLL)
+CONVOLVE_KERNEL( uint, convolve_uint_5, 5, 5, FULL_UNROLL)
+CONVOLVE_KERNEL( uint, convolve_uint_7, 7, 7, FULL_UNROLL)
+
+/************************
+ *
+ * FFT convolution ( float only)
+ *
+ *  For large masks the direct kernels cost mask_width * mask_height per output, the FFT path costs
+ *  O( log( P * Q)) per output. The transforms are real-to-complex plans of the OpenCLFFT library
+ *  ( Common/OpenCLFFT), these kernels only prepare and combine their buffers:
+ *
+ *      1. fft_pad()          : mask and input are zero padded to P x Q real values ( P, Q powers of 2, P >= input_width,
+ *                              Q >= input_height)
+ *      2. R2C FFT of both    : ( P / 2 + 1) x Q complex values each
+ *      3. fft_correlate()    : I * conj( M), the kernels compute a correlation ( the mask is not flipped)
+ *      4. C2R inverse FFT of the product, scaled by 1 / ( P * Q) in the library
+ *      5. fft_extract()      : the valid region
+ *
+ *  The padded size is at least the input size, so the circular correlation does not wrap for any valid output.
+ */
+
+/**
+ * @brief fft_pad(): src ( width x height) -> dst ( fft_width x fft_height), zero padded.
+ */
+__kernel void fft_pad( __global const float *src, int width, int height, __global float *dst, int fft_width, int fft_height)
+{
+    // variable declaration
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    // code
+    if( (x >= fft_width) || (y >= fft_height))
+    {
+        return;
+    }
+
+    dst[ mad24( y, fft_width, x)] = ( (x < width) && (y < height)) ? src[ mad24( y, width, x)] : 0.0f;
+}
+
+/**
+ * @brief fft_correlate(): spectrum = spectrum * conj( mask_spectrum), in place.
+ */
+__kernel void fft_correlate( __global float2 *spectrum, __global const float2 *mask_spectrum, int count)
+{
+    // variable declaration
+    int i = (int)get_global_id(0);
+
+    // code
+    if( i >= count)
+    {
+        return;
+    }
+
+    float2 a = spectrum[i];
+    float2 b = mask_spectrum[i];
+
+    spectrum[i] = (float2)( a.x * b.x + a.y * b.y, a.y * b.x - a.x * b.y);
+}
+
+/**
+ * @brief fft_extract(): top-left output_width x output_height values of src ( rows of fft_width).
+ */
+__kernel void fft_extract( __global const float *src, int fft_width, __global float *output, int output_width, int output_height)
+{
+    // variable declaration
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    // code
+    if( (x >= output_width) || (y >= output_height))
+    {
+        return;
+    }
+
+    output[ mad24( y, output_width, x)] = src[ mad24( y, fft_width, x)];
+}
+
+/************************
+ *
+ * Filter banks ( float only)
+ *
+ *      input   : num_channels planes of input_height x input_width
+ *      filters : num_filters x num_channels masks of mask_height x mask_width
+ *      output  : num_filters planes of output_height x output_width ( "valid" part, as above)
+ *
+ *  As a matrix product, with P = output_width * output_height and L = num_channels * mask_height * mask_width
+ *
+ *      output[ num_filters x P] = filters[ num_filters x L] * columns[ L x P]
+ *
+ *  where column p of "columns" is the receptive field of output pixel p ( im2col). The filters are already
+ *  laid out as the left matrix.
+ *
+ *  1. convolve_bank_direct() : one work-item per output value, reads the receptive field from global memory
+ *                              once per filter.
+ *  2. im2col() + gemm()      : columns is written to a buffer ( a band of output rows at a time) and
+ *                              multiplied by the tiled gemm().
+ *  3. gemm_implicit()        : same tiled product, the tiles of "columns" are gathered from the input
+ *                              while loading them into local memory, nothing is written in between.
+ *
+ *  gemm() / gemm_implicit(): GEMM_TILE x GEMM_TILE output tile per work-group, work-group size
+ *  ( GEMM_TILE, GEMM_TILE / GEMM_WPT), every work-item computes GEMM_WPT values of one column.
+ */
+
+#ifndef GEMM_TILE
+    #define GEMM_TILE   32
+#endif
+
+#ifndef GEMM_WPT
+    #define GEMM_WPT    4
+#endif
+
+#define GEMM_ROWS   ( GEMM_TILE / GEMM_WPT)
+
+/**
+ * @brief convolve_bank_direct(): global size ( output_width, output_height, num_filters) rounded up to the
+ *        work-group size.
+ */
+__kernel void convolve_bank_direct(
+    __global const float *input,
+    int input_width,
+    int input_height,
+    int num_channels,
+    __global const float *filters,
+    int mask_width,
+    int mask_height,
+    int num_filters,
+    __global float *output
+)
+{
+    // variable declaration
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+    int f = (int)get_global_id(2);
+
+    int output_width = input_width - mask_width + 1;
+    int output_height = input_height - mask_height + 1;
+
+    // code
+    if( (x >= output_width) || (y >= output_height) || (f >= num_filters))
+    {
+        return;
+    }
+
+    __global const float *mask = filters + f * num_channels * mask_height * mask_width;
+
+    float sum = 0.0f;
+    for( int c = 0; c < num_channels; ++c)
+    {
+        __global const float *plane = input + c * input_height * input_width;
+
+        for( int r = 0; r < mask_height; ++r)
+        {
+            __global const float *row = plane + mad24( y + r, input_width, x);
+
+            for( int s = 0; s < mask_width; ++s)
+            {
+                sum += *mask++ * row[s];
+            }
+        }
+    }
+
+    output[ mad24( mad24( f, output_height, y), output_width, x)] = sum;
+}
+
+/**
+ * @brief im2col(): columns for output rows [ first_row, first_row + num_rows).
+ *        global size ( num_rows * output_width, L), element ( l, p) is stored at l * num_rows * output_width + p.
+ */
+__kernel void im2col(
+    __global const float *input,
+    int input_width,
+    int input_height,
+    int mask_width,
+    int mask_height,
+    int first_row,
+    int num_rows,
+    __global float *columns
+)
+{
+    // variable declaration
+    int p = (int)get_global_id(0);
+    int l = (int)get_global_id(1);
+
+    int output_width = input_width - mask_width + 1;
+    int band_size = num_rows * output_width;
+
+    // code
+    if( p >= band_size)
+    {
+        return;
+    }
+
+    int y = first_row + p / output_width;
+    int x = p % output_width;
+
+    int mask_size = mask_width * mask_height;
+    int c = l / mask_size;
+    int r = ( l - c * mask_size) / mask_width;
+    int s = l - c * mask_size - r * mask_width;
+
+    columns[ l * band_size + p] = input[ mad24( mad24( c, input_height, y + r), input_width, x + s)];
+}
+
+/**
+ * GEMM_BODY: C[ m * ldc + c_offset + n] = sum( A[ m * L + l] * B( l, n)), B( l, n) is given by LOAD_B.
+ */
+#define GEMM_BODY( LOAD_B)                                                                          \
+    __local float a_tile[GEMM_TILE][GEMM_TILE];                                                     \
+    __local float b_tile[GEMM_TILE][GEMM_TILE];                                                     \
+                                                                                                    \
+    const int tx = (int)get_local_id(0);                                                            \
+    const int ty = (int)get_local_id(1);                                                            \
+                                                                                                    \
+    const int m0 = (int)get_group_id(1) * GEMM_TILE;                                                \
+    const int n0 = (int)get_group_id(0) * GEMM_TILE;                                                \
+    const int n = n0 + tx;                                                                          \
+                                                                                                    \
+    float acc[GEMM_WPT];                                                                            \
+    for( int w = 0; w < GEMM_WPT; ++w)                                                              \
+    {                                                                                               \
+        acc[w] = 0.0f;                                                                              \
+    }                                                                                               \
+                                                                                                    \
+    for( int l0 = 0; l0 < L; l0 += GEMM_TILE)                                                       \
+    {                                                                                               \
+            /* a_tile[ m][ l] from A, b_tile[ l][ n] from B, zero outside the matrices */           \
+        for( int w = 0; w < GEMM_WPT; ++w)                                                          \
+        {                                                                                           \
+            int row = ty + w * GEMM_ROWS;                                                           \
+            int am = m0 + row;                                                                      \
+            int al = l0 + tx;                                                                       \
+            int bl = l0 + row;                                                                      \
+                                                                                                    \
+            a_tile[row][tx] = ( (am < M) && (al < L)) ? A[ am * L + al] : 0.0f;                     \
+            b_tile[row][tx] = ( (bl < L) && (n < N)) ? LOAD_B( bl) : 0.0f;                          \
+        }                                                                                           \
+                                                                                                    \
+        barrier( CLK_LOCAL_MEM_FENCE);                                                              \
+                                                                                                    \
+        for( int l = 0; l < GEMM_TILE; ++l)                                                         \
+        {                                                                                           \
+            float b = b_tile[l][tx];                                                                \
+            for( int w = 0; w < GEMM_WPT; ++w)                                                      \
+            {                                                                                       \
+                acc[w] += a_tile[ ty + w * GEMM_ROWS][l] * b;                                       \
+            }                                                                                       \
+        }                                                                                           \
+                                                                                                    \
+        barrier( CLK_LOCAL_MEM_FENCE);                                                              \
+    }                                                                                               \
+                                                                                                    \
+    for( int w = 0; w < GEMM_WPT; ++w)                                                              \
+    {                                                                                               \
+        int m = m0 + ty + w * GEMM_ROWS;                                                            \
+        if( (m < M) && (n < N))                                                                     \
+        {                                                                                           \
+            C[ m * ldc + c_offset + n] = acc[w];                                                    \
+        }                                                                                           \
+    }
+
+/**
+ * @brief gemm(): C = A ( M x L) * B ( L x N), B has N values per row.
+ *        global size ( N, M / GEMM_WPT) rounded up to the tile.
+ */
+#define LOAD_B_BUFFER( l) B[ (l) * N + n]
+
+__kernel __attribute__(( reqd_work_group_size( GEMM_TILE, GEMM_ROWS, 1)))
+void gemm(
+    int M,
+    int N,
+    int L,
+    __global const float *A,
+    __global const float *B,
+    __global float *C,
+    int ldc,
+    int c_offset
+)
+{
+    // code
+    GEMM_BODY( LOAD_B_BUFFER)
+}
+
+/**
+ * @brief gemm_implicit(): output = filters * im2col( input), the columns are never stored.
+ *        M = num_filters, N = output_width * output_height, L = num_channels * mask_height * mask_width.
+ */
+__kernel __attribute__(( reqd_work_group_size( GEMM_TILE, GEMM_ROWS, 1)))
+void gemm_implicit(
+    int M,
+    int N,
+    int L,
+    __global const float *A,
+    __global const float *input,
+    int input_width,
+    int input_height,
+    int mask_width,
+    int mask_height,
+    __global float *C
+)
+{
+    // variable declaration
+    const int ldc = N;
+    const int c_offset = 0;
+
+    const int output_width = input_width - mask_width + 1;
+    const int mask_size = mask_width * mask_height;
+
+        // top-left input pixel of the receptive field of output n, the column of this work-item
+    const int column = (int)get_group_id(0) * GEMM_TILE + (int)get_local_id(0);
+    const int origin = mad24( column / output_width, input_width, column % output_width);
+
+    // code
+#define LOAD_B_IMPLICIT( l) input[ origin + mad24( mad24( (l) / mask_size, input_height, ( (l) % mask_size) / mask_width), input_width, ( (l) % mask_size) % mask_width)]
+
+    GEMM_BODY( LOAD_B_IMPLICIT)
+
+#undef LOAD_B_IMPLICIT
+}
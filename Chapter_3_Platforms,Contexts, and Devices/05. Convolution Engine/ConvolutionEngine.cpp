@@ -0,0 +1,810 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+#include <iostream>
+
+#include "OpenCLUtil.h"
+#include "ConvolutionEngine.h"
+#include "../../Common/OpenCLFFT/OpenCLFFT.h"
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+namespace ConvolutionEngine
+{
+        // must match the defaults in ConvolutionEngine.cl
+    const int TILE_WIDTH = 16;
+    const int TILE_HEIGHT = 16;
+
+        // cost of one FFT launch over one complex value, in multiply-adds of the direct kernels.
+        // every launch streams the whole spectrum through global memory, the direct kernels read local memory,
+        // and a radix-8 pass does the butterflies of three radix-2 passes
+    const double FFT_COST_PER_POINT_PASS = 16.0;
+
+        // must match GEMM_TILE / GEMM_WPT in ConvolutionEngine.cl
+    const int GEMM_TILE = 32;
+    const int GEMM_WPT = 4;
+
+        // upper bound of the im2col buffer, larger outputs are lowered a band of rows at a time
+    const size_t IM2COL_BUFFER_LIMIT = 64 * 1024 * 1024;
+
+    //////////////////////////////////////////////
+    ///////// TYPE DEFINITION
+    //////////////////////////////////////////////
+    enum KERNEL_ID
+    {
+        KERNEL_GENERIC = 0,
+        KERNEL_MASK_3,
+        KERNEL_MASK_5,
+        KERNEL_MASK_7,
+
+        KERNEL_COUNT
+    };
+
+    const char *kernel_names[DATA_TYPE_COUNT][KERNEL_COUNT] =
+    {
+        { "convolve_float", "convolve_float_3", "convolve_float_5", "convolve_float_7"},
+        { "convolve_uint", "convolve_uint_3", "convolve_uint_5", "convolve_uint_7"}
+    };
+
+    const size_t element_size[DATA_TYPE_COUNT] = { sizeof( cl_float), sizeof( cl_uint)};
+
+    enum FFT_KERNEL_ID
+    {
+        FFT_PAD = 0,
+        FFT_CORRELATE,
+        FFT_EXTRACT,
+
+        FFT_KERNEL_COUNT
+    };
+
+    const char *fft_kernel_names[FFT_KERNEL_COUNT] = { "fft_pad", "fft_correlate", "fft_extract"};
+
+    enum BANK_KERNEL_ID
+    {
+        BANK_KERNEL_DIRECT = 0,
+        BANK_KERNEL_IM2COL,
+        BANK_KERNEL_GEMM,
+        BANK_KERNEL_GEMM_IMPLICIT,
+
+        BANK_KERNEL_COUNT
+    };
+
+    const char *bank_kernel_names[BANK_KERNEL_COUNT] = { "convolve_bank_direct", "im2col", "gemm", "gemm_implicit"};
+
+    struct _Engine
+    {
+        cl_program ocl_program = nullptr;
+        cl_kernel ocl_kernels[DATA_TYPE_COUNT][KERNEL_COUNT] = { { nullptr } };
+        cl_kernel ocl_fft_kernels[FFT_KERNEL_COUNT] = { nullptr };
+        cl_kernel ocl_bank_kernels[BANK_KERNEL_COUNT] = { nullptr };
+
+        cl_ulong device_local_mem_size = 0;
+        cl_ulong device_constant_buffer_size = 0;
+        cl_ulong device_max_mem_alloc_size = 0;
+
+            // R2C plan of the padded size, padded real values and spectra of the mask ( 0) and the input ( 1),
+            // recreated when the padded size changes
+        cl_context ocl_context = nullptr;
+        OpenCLFFT::Library fft_library = nullptr;
+        OpenCLFFT::Plan fft_plan = nullptr;
+        cl_mem ocl_fft_real[2] = { nullptr };
+        cl_mem ocl_fft_spectra[2] = { nullptr };
+        int fft_width = 0;
+        int fft_height = 0;
+
+            // im2col buffer, grows to the largest band
+        cl_mem ocl_column_buffer = nullptr;
+        size_t column_buffer_size = 0;
+
+        ~_Engine()
+        {
+            RELEASE_CL_OBJECT( ocl_column_buffer, clReleaseMemObject);
+
+            for( int k = 0; k < BANK_KERNEL_COUNT; ++k)
+            {
+                RELEASE_CL_OBJECT( ocl_bank_kernels[k], clReleaseKernel);
+            }
+
+            for( int i = 0; i < 2; ++i)
+            {
+                RELEASE_CL_OBJECT( ocl_fft_real[i], clReleaseMemObject);
+                RELEASE_CL_OBJECT( ocl_fft_spectra[i], clReleaseMemObject);
+            }
+
+            RELEASE_CL_OBJECT( fft_plan, OpenCLFFT::DeletePlan);
+            RELEASE_CL_OBJECT( fft_library, OpenCLFFT::DeleteLibrary);
+
+            for( int k = 0; k < FFT_KERNEL_COUNT; ++k)
+            {
+                RELEASE_CL_OBJECT( ocl_fft_kernels[k], clReleaseKernel);
+            }
+
+            for( int t = 0; t < DATA_TYPE_COUNT; ++t)
+            {
+                for( int k = 0; k < KERNEL_COUNT; ++k)
+                {
+                    RELEASE_CL_OBJECT( ocl_kernels[t][k], clReleaseKernel);
+                }
+            }
+
+            RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+        }
+    };
+
+    //////////////////////////////////////////////
+    ////// FUNCTION DEFINITION
+    //////////////////////////////////////////////
+
+    /**
+     * @brief SelectKernel(): specialized kernel for square 3x3, 5x5 and 7x7 masks, the generic one otherwise.
+     */
+    static KERNEL_ID SelectKernel( int mask_width, int mask_height, bool use_specialized)
+    {
+        // code
+        if( !use_specialized || (mask_width != mask_height))
+        {
+            return KERNEL_GENERIC;
+        }
+
+        switch( mask_width)
+        {
+            case 3: return KERNEL_MASK_3;
+            case 5: return KERNEL_MASK_5;
+            case 7: return KERNEL_MASK_7;
+        }
+
+        return KERNEL_GENERIC;
+    }
+
+    /**
+     * @brief CacheSize(): bytes of local memory for one tile plus its halo.
+     */
+    static size_t CacheSize( DATA_TYPE type, int mask_width, int mask_height)
+    {
+        // code
+        return (size_t)( TILE_WIDTH + mask_width - 1) * ( TILE_HEIGHT + mask_height - 1) * element_size[type];
+    }
+
+    /**
+     * @brief NextPowerOfTwo()
+     */
+    static int NextPowerOfTwo( int value)
+    {
+        // variable declaration
+        int result = 1;
+
+        // code
+        while( result < value)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief FFTWidth(): padded row length, R2C plans need at least 2 values per row.
+     */
+    static int FFTWidth( int value)
+    {
+        // code
+        return ( value < 2) ? 2 : NextPowerOfTwo( value);
+    }
+
+    /**
+     * @brief Log2(): value is a power of 2.
+     */
+    static int Log2( int value)
+    {
+        // variable declaration
+        int result = 0;
+
+        // code
+        while( (1 << result) < value)
+        {
+            ++result;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief CreateEngine(): build ConvolutionEngine.cl and create all kernels, and the FFT library.
+     */
+    Engine CreateEngine( cl_context ocl_context, cl_device_id ocl_device, const char *kernel_file_name, const char *fft_kernel_file_name)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        Engine engine = new _Engine();
+
+        // code
+        engine->ocl_program = CreateProgram( ocl_context, ocl_device, kernel_file_name);
+        if( engine->ocl_program == nullptr)
+        {
+            std::cerr << "CreateProgram() Failed.\n";
+            delete engine;
+            return nullptr;
+        }
+
+        for( int t = 0; t < DATA_TYPE_COUNT; ++t)
+        {
+            for( int k = 0; k < KERNEL_COUNT; ++k)
+            {
+                engine->ocl_kernels[t][k] = clCreateKernel( engine->ocl_program, kernel_names[t][k], &ocl_err);
+                if( !engine->ocl_kernels[t][k] || ocl_err)
+                {
+                    std::cerr << "clCreateKernel( " << kernel_names[t][k] << ") Failed." << ocl_err << "\n";
+                    delete engine;
+                    return nullptr;
+                }
+            }
+        }
+
+        for( int k = 0; k < FFT_KERNEL_COUNT; ++k)
+        {
+            engine->ocl_fft_kernels[k] = clCreateKernel( engine->ocl_program, fft_kernel_names[k], &ocl_err);
+            if( !engine->ocl_fft_kernels[k] || ocl_err)
+            {
+                std::cerr << "clCreateKernel( " << fft_kernel_names[k] << ") Failed." << ocl_err << "\n";
+                delete engine;
+                return nullptr;
+            }
+        }
+
+        for( int k = 0; k < BANK_KERNEL_COUNT; ++k)
+        {
+            engine->ocl_bank_kernels[k] = clCreateKernel( engine->ocl_program, bank_kernel_names[k], &ocl_err);
+            if( !engine->ocl_bank_kernels[k] || ocl_err)
+            {
+                std::cerr << "clCreateKernel( " << bank_kernel_names[k] << ") Failed." << ocl_err << "\n";
+                delete engine;
+                return nullptr;
+            }
+        }
+
+        engine->fft_library = OpenCLFFT::CreateLibrary( ocl_context, ocl_device, fft_kernel_file_name);
+        if( engine->fft_library == nullptr)
+        {
+            std::cerr << "OpenCLFFT::CreateLibrary() Failed.\n";
+            delete engine;
+            return nullptr;
+        }
+
+        engine->ocl_context = ocl_context;
+
+        clGetDeviceInfo( ocl_device, CL_DEVICE_LOCAL_MEM_SIZE, sizeof( cl_ulong), &engine->device_local_mem_size, nullptr);
+        clGetDeviceInfo( ocl_device, CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE, sizeof( cl_ulong), &engine->device_constant_buffer_size, nullptr);
+        clGetDeviceInfo( ocl_device, CL_DEVICE_MAX_MEM_ALLOC_SIZE, sizeof( cl_ulong), &engine->device_max_mem_alloc_size, nullptr);
+
+        return engine;
+    }
+
+    /**
+     * @brief CanConvolveDirect()
+     */
+    bool CanConvolveDirect( Engine engine, DATA_TYPE type, int mask_width, int mask_height)
+    {
+        // code
+        if( (mask_width < 1) || (mask_height < 1))
+        {
+            return false;
+        }
+
+        size_t mask_size = (size_t)mask_width * mask_height * element_size[type];
+
+        return ( CacheSize( type, mask_width, mask_height) <= engine->device_local_mem_size) && ( mask_size <= engine->device_constant_buffer_size);
+    }
+
+    /**
+     * @brief ChooseMethod(): compare the multiply-adds of the direct kernels with the FFT passes.
+     *
+     *      direct : output_width * output_height * mask_width * mask_height
+     *      FFT    : every launch of ConvolveFFT() over P * Q real ( P * Q / 2 complex) values,
+     *               - 3 transforms ( mask, input, inverse), the mask is transformed again on every call,
+     *                 each log8( P / 2) + log8( Q) passes ( radix-8, rounded up) plus the R2C / C2R step
+     *               - 2 pads, the correlate and the extract
+     *
+     *  with a 2048 x 2048 input the FFT wins from about 16 x 16 masks on.
+     */
+    METHOD ChooseMethod( Engine engine, DATA_TYPE type, int input_width, int input_height, int mask_width, int mask_height)
+    {
+        // code
+        if( type != CONVOLVE_FLOAT)
+        {
+            return METHOD_DIRECT;
+        }
+
+        if( !CanConvolveDirect( engine, type, mask_width, mask_height))
+        {
+            return METHOD_FFT;
+        }
+
+        int fft_width = FFTWidth( input_width);
+        int fft_height = NextPowerOfTwo( input_height);
+
+        int num_passes = ( Log2( fft_width / 2) + 2) / 3 + ( Log2( fft_height) + 2) / 3;
+        int num_launches = 3 * ( num_passes + 1) + 4;
+
+        double direct_cost = (double)( input_width - mask_width + 1) * ( input_height - mask_height + 1) * mask_width * mask_height;
+        double fft_cost = (double)( fft_width / 2) * fft_height * num_launches * FFT_COST_PER_POINT_PASS;
+
+        return ( fft_cost < direct_cost) ? METHOD_FFT : METHOD_DIRECT;
+    }
+
+    /**
+     * @brief KernelName()
+     */
+    const char* KernelName( Engine engine, DATA_TYPE type, int mask_width, int mask_height, bool use_specialized)
+    {
+        // code
+        return kernel_names[type][ SelectKernel( mask_width, mask_height, use_specialized)];
+    }
+
+    /**
+     * @brief PrepareFFT(): plan and work buffers of a fft_width x fft_height transform, kept until the size changes.
+     */
+    static cl_int PrepareFFT( Engine engine, int fft_width, int fft_height)
+    {
+        // variable declaration
+        cl_int ocl_err = CL_SUCCESS;
+
+        // code
+        if( (fft_width == engine->fft_width) && (fft_height == engine->fft_height))
+        {
+            return CL_SUCCESS;
+        }
+
+        for( int i = 0; i < 2; ++i)
+        {
+            RELEASE_CL_OBJECT( engine->ocl_fft_real[i], clReleaseMemObject);
+            RELEASE_CL_OBJECT( engine->ocl_fft_spectra[i], clReleaseMemObject);
+        }
+
+        RELEASE_CL_OBJECT( engine->fft_plan, OpenCLFFT::DeletePlan);
+
+        engine->fft_width = 0;
+        engine->fft_height = 0;
+
+        engine->fft_plan = OpenCLFFT::CreatePlan( engine->fft_library, OpenCLFFT::FFT_R2C, fft_width, fft_height, 1);
+        if( engine->fft_plan == nullptr)
+        {
+            return CL_OUT_OF_RESOURCES;
+        }
+
+        for( int i = 0; i < 2; ++i)
+        {
+            engine->ocl_fft_real[i] = clCreateBuffer( engine->ocl_context, CL_MEM_READ_WRITE, OpenCLFFT::InputSize( engine->fft_plan, OpenCLFFT::FFT_FORWARD), nullptr, &ocl_err);
+            if( !engine->ocl_fft_real[i] || ocl_err)
+            {
+                return ocl_err;
+            }
+
+            engine->ocl_fft_spectra[i] = clCreateBuffer( engine->ocl_context, CL_MEM_READ_WRITE, OpenCLFFT::OutputSize( engine->fft_plan, OpenCLFFT::FFT_FORWARD), nullptr, &ocl_err);
+            if( !engine->ocl_fft_spectra[i] || ocl_err)
+            {
+                return ocl_err;
+            }
+        }
+
+        engine->fft_width = fft_width;
+        engine->fft_height = fft_height;
+
+        return CL_SUCCESS;
+    }
+
+    /**
+     * @brief ConvolveFFT(): FFT path of Convolve(), cl_float only.
+     */
+    static cl_int ConvolveFFT(
+        Engine engine,
+        cl_command_queue ocl_command_queue,
+        cl_mem input, int input_width, int input_height,
+        cl_mem mask, int mask_width, int mask_height,
+        cl_mem output,
+        cl_event *event
+    )
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        int fft_width = FFTWidth( input_width);
+        int fft_height = NextPowerOfTwo( input_height);
+        int spectrum_count = ( fft_width / 2 + 1) * fft_height;
+
+        int output_width = input_width - mask_width + 1;
+        int output_height = input_height - mask_height + 1;
+
+        cl_mem sources[2] = { mask, input};
+        int source_widths[2] = { mask_width, input_width};
+        int source_heights[2] = { mask_height, input_height};
+
+        // code
+        ocl_err = PrepareFFT( engine, fft_width, fft_height);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+        size_t pad_global_work_size[2] = { (size_t)fft_width, (size_t)fft_height};
+
+            // spectra of the mask and the input
+        cl_kernel ocl_pad = engine->ocl_fft_kernels[FFT_PAD];
+
+        for( int i = 0; i < 2; ++i)
+        {
+            ocl_err = clSetKernelArg( ocl_pad, 0, sizeof( cl_mem), &sources[i]);
+            ocl_err |= clSetKernelArg( ocl_pad, 1, sizeof( int), &source_widths[i]);
+            ocl_err |= clSetKernelArg( ocl_pad, 2, sizeof( int), &source_heights[i]);
+            ocl_err |= clSetKernelArg( ocl_pad, 3, sizeof( cl_mem), &engine->ocl_fft_real[i]);
+            ocl_err |= clSetKernelArg( ocl_pad, 4, sizeof( int), &fft_width);
+            ocl_err |= clSetKernelArg( ocl_pad, 5, sizeof( int), &fft_height);
+            ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, ocl_pad, 2, nullptr, pad_global_work_size, nullptr, 0, nullptr, nullptr);
+            if( ocl_err != CL_SUCCESS)
+            {
+                return ocl_err;
+            }
+
+            ocl_err = OpenCLFFT::Execute( engine->fft_plan, ocl_command_queue, OpenCLFFT::FFT_FORWARD, engine->ocl_fft_real[i], engine->ocl_fft_spectra[i]);
+            if( ocl_err != CL_SUCCESS)
+            {
+                return ocl_err;
+            }
+        }
+
+            // product, in the input spectrum
+        cl_kernel ocl_correlate = engine->ocl_fft_kernels[FFT_CORRELATE];
+
+        ocl_err = clSetKernelArg( ocl_correlate, 0, sizeof( cl_mem), &engine->ocl_fft_spectra[1]);
+        ocl_err |= clSetKernelArg( ocl_correlate, 1, sizeof( cl_mem), &engine->ocl_fft_spectra[0]);
+        ocl_err |= clSetKernelArg( ocl_correlate, 2, sizeof( int), &spectrum_count);
+
+        size_t correlate_global_work_size[1] = { (size_t)spectrum_count};
+        ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, ocl_correlate, 1, nullptr, correlate_global_work_size, nullptr, 0, nullptr, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+            // inverse transform ( scaled by 1 / ( P * Q)), the padded mask is no longer needed
+        ocl_err = OpenCLFFT::Execute( engine->fft_plan, ocl_command_queue, OpenCLFFT::FFT_INVERSE, engine->ocl_fft_spectra[1], engine->ocl_fft_real[0]);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+        cl_kernel ocl_extract = engine->ocl_fft_kernels[FFT_EXTRACT];
+
+        ocl_err = clSetKernelArg( ocl_extract, 0, sizeof( cl_mem), &engine->ocl_fft_real[0]);
+        ocl_err |= clSetKernelArg( ocl_extract, 1, sizeof( int), &fft_width);
+        ocl_err |= clSetKernelArg( ocl_extract, 2, sizeof( cl_mem), &output);
+        ocl_err |= clSetKernelArg( ocl_extract, 3, sizeof( int), &output_width);
+        ocl_err |= clSetKernelArg( ocl_extract, 4, sizeof( int), &output_height);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+        size_t extract_global_work_size[2] = { (size_t)output_width, (size_t)output_height};
+
+        return clEnqueueNDRangeKernel( ocl_command_queue, ocl_extract, 2, nullptr, extract_global_work_size, nullptr, 0, nullptr, event);
+    }
+
+    /**
+     * @brief Convolve(): enqueue one convolution, does not wait for it.
+     */
+    cl_int Convolve(
+        Engine engine,
+        cl_command_queue ocl_command_queue,
+        DATA_TYPE type,
+        cl_mem input, int input_width, int input_height,
+        cl_mem mask, int mask_width, int mask_height,
+        cl_mem output,
+        METHOD method,
+        bool use_specialized,
+        cl_event *event
+    )
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        int output_width = input_width - mask_width + 1;
+        int output_height = input_height - mask_height + 1;
+
+        // code
+        if( (output_width < 1) || (output_height < 1))
+        {
+            return CL_INVALID_VALUE;
+        }
+
+        if( method == METHOD_AUTO)
+        {
+            method = ChooseMethod( engine, type, input_width, input_height, mask_width, mask_height);
+        }
+
+        if( method == METHOD_FFT)
+        {
+            if( type != CONVOLVE_FLOAT)
+            {
+                return CL_INVALID_VALUE;
+            }
+
+            return ConvolveFFT( engine, ocl_command_queue, input, input_width, input_height, mask, mask_width, mask_height, output, event);
+        }
+
+        if( !CanConvolveDirect( engine, type, mask_width, mask_height))
+        {
+            return CL_OUT_OF_RESOURCES;
+        }
+
+        cl_kernel ocl_kernel = engine->ocl_kernels[type][ SelectKernel( mask_width, mask_height, use_specialized)];
+
+        ocl_err = clSetKernelArg( ocl_kernel, 0, sizeof( cl_mem), &input);
+        ocl_err |= clSetKernelArg( ocl_kernel, 1, sizeof( cl_mem), &mask);
+        ocl_err |= clSetKernelArg( ocl_kernel, 2, sizeof( cl_mem), &output);
+        ocl_err |= clSetKernelArg( ocl_kernel, 3, sizeof( int), &input_width);
+        ocl_err |= clSetKernelArg( ocl_kernel, 4, sizeof( int), &input_height);
+        ocl_err |= clSetKernelArg( ocl_kernel, 5, sizeof( int), &mask_width);
+        ocl_err |= clSetKernelArg( ocl_kernel, 6, sizeof( int), &mask_height);
+        ocl_err |= clSetKernelArg( ocl_kernel, 7, CacheSize( type, mask_width, mask_height), nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+        size_t local_work_size[2] = { TILE_WIDTH, TILE_HEIGHT};
+        size_t global_work_size[2] =
+        {
+            (size_t)( ( output_width + TILE_WIDTH - 1) / TILE_WIDTH) * TILE_WIDTH,
+            (size_t)( ( output_height + TILE_HEIGHT - 1) / TILE_HEIGHT) * TILE_HEIGHT
+        };
+
+        return clEnqueueNDRangeKernel( ocl_command_queue, ocl_kernel, 2, nullptr, global_work_size, local_work_size, 0, nullptr, event);
+    }
+
+    /**
+     * @brief EnqueueGEMM(): C[ m * ldc + c_offset + n] = ( A * B)[ m][ n], A is M x L, B is L x N.
+     */
+    static cl_int EnqueueGEMM( Engine engine, cl_command_queue ocl_command_queue, int M, int N, int L, cl_mem A, cl_mem B, cl_mem C, int ldc, int c_offset, cl_event *event)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        cl_kernel ocl_kernel = engine->ocl_bank_kernels[BANK_KERNEL_GEMM];
+
+        // code
+        ocl_err = clSetKernelArg( ocl_kernel, 0, sizeof( int), &M);
+        ocl_err |= clSetKernelArg( ocl_kernel, 1, sizeof( int), &N);
+        ocl_err |= clSetKernelArg( ocl_kernel, 2, sizeof( int), &L);
+        ocl_err |= clSetKernelArg( ocl_kernel, 3, sizeof( cl_mem), &A);
+        ocl_err |= clSetKernelArg( ocl_kernel, 4, sizeof( cl_mem), &B);
+        ocl_err |= clSetKernelArg( ocl_kernel, 5, sizeof( cl_mem), &C);
+        ocl_err |= clSetKernelArg( ocl_kernel, 6, sizeof( int), &ldc);
+        ocl_err |= clSetKernelArg( ocl_kernel, 7, sizeof( int), &c_offset);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+        size_t local_work_size[2] = { GEMM_TILE, GEMM_TILE / GEMM_WPT};
+        size_t global_work_size[2] =
+        {
+            (size_t)( ( N + GEMM_TILE - 1) / GEMM_TILE) * GEMM_TILE,
+            (size_t)( ( M + GEMM_TILE - 1) / GEMM_TILE) * ( GEMM_TILE / GEMM_WPT)
+        };
+
+        return clEnqueueNDRangeKernel( ocl_command_queue, ocl_kernel, 2, nullptr, global_work_size, local_work_size, 0, nullptr, event);
+    }
+
+    /**
+     * @brief ConvolveBankIm2col(): im2col of a band of output rows into ocl_column_buffer, then gemm() of the
+     *        filters with it into the same rows of every output plane.
+     */
+    static cl_int ConvolveBankIm2col(
+        Engine engine,
+        cl_command_queue ocl_command_queue,
+        cl_mem input, int input_width, int input_height, int num_channels,
+        cl_mem filters, int mask_width, int mask_height, int num_filters,
+        cl_mem output,
+        cl_event *event
+    )
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        int output_width = input_width - mask_width + 1;
+        int output_height = input_height - mask_height + 1;
+        int L = num_channels * mask_width * mask_height;
+
+        size_t row_size = (size_t)L * output_width * sizeof( cl_float);
+
+        // code
+            // rows per band
+        size_t buffer_limit = IM2COL_BUFFER_LIMIT;
+        if( (engine->device_max_mem_alloc_size != 0) && (engine->device_max_mem_alloc_size < buffer_limit))
+        {
+            buffer_limit = (size_t)engine->device_max_mem_alloc_size;
+        }
+
+        int band_height = (int)( buffer_limit / row_size);
+        if( band_height < 1)
+        {
+            return CL_OUT_OF_RESOURCES;
+        }
+
+        if( band_height > output_height)
+        {
+            band_height = output_height;
+        }
+
+        size_t buffer_size = row_size * band_height;
+        if( buffer_size > engine->column_buffer_size)
+        {
+            RELEASE_CL_OBJECT( engine->ocl_column_buffer, clReleaseMemObject);
+            engine->column_buffer_size = 0;
+
+            engine->ocl_column_buffer = clCreateBuffer( engine->ocl_context, CL_MEM_READ_WRITE, buffer_size, nullptr, &ocl_err);
+            if( !engine->ocl_column_buffer || ocl_err)
+            {
+                return ocl_err;
+            }
+
+            engine->column_buffer_size = buffer_size;
+        }
+
+        cl_kernel ocl_im2col = engine->ocl_bank_kernels[BANK_KERNEL_IM2COL];
+
+        ocl_err = clSetKernelArg( ocl_im2col, 0, sizeof( cl_mem), &input);
+        ocl_err |= clSetKernelArg( ocl_im2col, 1, sizeof( int), &input_width);
+        ocl_err |= clSetKernelArg( ocl_im2col, 2, sizeof( int), &input_height);
+        ocl_err |= clSetKernelArg( ocl_im2col, 3, sizeof( int), &mask_width);
+        ocl_err |= clSetKernelArg( ocl_im2col, 4, sizeof( int), &mask_height);
+        ocl_err |= clSetKernelArg( ocl_im2col, 7, sizeof( cl_mem), &engine->ocl_column_buffer);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+        for( int first_row = 0; first_row < output_height; first_row += band_height)
+        {
+            int num_rows = ( output_height - first_row < band_height) ? ( output_height - first_row) : band_height;
+            int band_size = num_rows * output_width;
+
+            ocl_err = clSetKernelArg( ocl_im2col, 5, sizeof( int), &first_row);
+            ocl_err |= clSetKernelArg( ocl_im2col, 6, sizeof( int), &num_rows);
+            if( ocl_err != CL_SUCCESS)
+            {
+                return ocl_err;
+            }
+
+            size_t global_work_size[2] = { (size_t)band_size, (size_t)L};
+
+            ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, ocl_im2col, 2, nullptr, global_work_size, nullptr, 0, nullptr, nullptr);
+            if( ocl_err != CL_SUCCESS)
+            {
+                return ocl_err;
+            }
+
+                // the event of the last band's product marks the end of the whole convolution
+            bool last_band = ( first_row + num_rows >= output_height);
+
+            ocl_err = EnqueueGEMM(
+                engine, ocl_command_queue,
+                num_filters, band_size, L,
+                filters, engine->ocl_column_buffer, output,
+                output_width * output_height, first_row * output_width,
+                last_band ? event : nullptr
+            );
+            if( ocl_err != CL_SUCCESS)
+            {
+                return ocl_err;
+            }
+        }
+
+        return CL_SUCCESS;
+    }
+
+    /**
+     * @brief ConvolveBank(): enqueue one filter bank convolution, does not wait for it.
+     */
+    cl_int ConvolveBank(
+        Engine engine,
+        cl_command_queue ocl_command_queue,
+        BANK_METHOD method,
+        cl_mem input, int input_width, int input_height, int num_channels,
+        cl_mem filters, int mask_width, int mask_height, int num_filters,
+        cl_mem output,
+        cl_event *event
+    )
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        int output_width = input_width - mask_width + 1;
+        int output_height = input_height - mask_height + 1;
+
+        // code
+        if( (output_width < 1) || (output_height < 1) || (mask_width < 1) || (mask_height < 1) || (num_channels < 1) || (num_filters < 1))
+        {
+            return CL_INVALID_VALUE;
+        }
+
+        if( method == BANK_IM2COL)
+        {
+            return ConvolveBankIm2col( engine, ocl_command_queue, input, input_width, input_height, num_channels, filters, mask_width, mask_height, num_filters, output, event);
+        }
+
+        if( method == BANK_IMPLICIT_GEMM)
+        {
+            cl_kernel ocl_kernel = engine->ocl_bank_kernels[BANK_KERNEL_GEMM_IMPLICIT];
+
+            int N = output_width * output_height;
+            int L = num_channels * mask_width * mask_height;
+
+            ocl_err = clSetKernelArg( ocl_kernel, 0, sizeof( int), &num_filters);
+            ocl_err |= clSetKernelArg( ocl_kernel, 1, sizeof( int), &N);
+            ocl_err |= clSetKernelArg( ocl_kernel, 2, sizeof( int), &L);
+            ocl_err |= clSetKernelArg( ocl_kernel, 3, sizeof( cl_mem), &filters);
+            ocl_err |= clSetKernelArg( ocl_kernel, 4, sizeof( cl_mem), &input);
+            ocl_err |= clSetKernelArg( ocl_kernel, 5, sizeof( int), &input_width);
+            ocl_err |= clSetKernelArg( ocl_kernel, 6, sizeof( int), &input_height);
+            ocl_err |= clSetKernelArg( ocl_kernel, 7, sizeof( int), &mask_width);
+            ocl_err |= clSetKernelArg( ocl_kernel, 8, sizeof( int), &mask_height);
+            ocl_err |= clSetKernelArg( ocl_kernel, 9, sizeof( cl_mem), &output);
+            if( ocl_err != CL_SUCCESS)
+            {
+                return ocl_err;
+            }
+
+            size_t local_work_size[2] = { GEMM_TILE, GEMM_TILE / GEMM_WPT};
+            size_t global_work_size[2] =
+            {
+                (size_t)( ( N + GEMM_TILE - 1) / GEMM_TILE) * GEMM_TILE,
+                (size_t)( ( num_filters + GEMM_TILE - 1) / GEMM_TILE) * ( GEMM_TILE / GEMM_WPT)
+            };
+
+            return clEnqueueNDRangeKernel( ocl_command_queue, ocl_kernel, 2, nullptr, global_work_size, local_work_size, 0, nullptr, event);
+        }
+
+        cl_kernel ocl_kernel = engine->ocl_bank_kernels[BANK_KERNEL_DIRECT];
+
+        ocl_err = clSetKernelArg( ocl_kernel, 0, sizeof( cl_mem), &input);
+        ocl_err |= clSetKernelArg( ocl_kernel, 1, sizeof( int), &input_width);
+        ocl_err |= clSetKernelArg( ocl_kernel, 2, sizeof( int), &input_height);
+        ocl_err |= clSetKernelArg( ocl_kernel, 3, sizeof( int), &num_channels);
+        ocl_err |= clSetKernelArg( ocl_kernel, 4, sizeof( cl_mem), &filters);
+        ocl_err |= clSetKernelArg( ocl_kernel, 5, sizeof( int), &mask_width);
+        ocl_err |= clSetKernelArg( ocl_kernel, 6, sizeof( int), &mask_height);
+        ocl_err |= clSetKernelArg( ocl_kernel, 7, sizeof( int), &num_filters);
+        ocl_err |= clSetKernelArg( ocl_kernel, 8, sizeof( cl_mem), &output);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+        size_t local_work_size[3] = { TILE_WIDTH, TILE_HEIGHT, 1};
+        size_t global_work_size[3] =
+        {
+            (size_t)( ( output_width + TILE_WIDTH - 1) / TILE_WIDTH) * TILE_WIDTH,
+            (size_t)( ( output_height + TILE_HEIGHT - 1) / TILE_HEIGHT) * TILE_HEIGHT,
+            (size_t)num_filters
+        };
+
+        return clEnqueueNDRangeKernel( ocl_command_queue, ocl_kernel, 3, nullptr, global_work_size, local_work_size, 0, nullptr, event);
+    }
+
+    /**
+     * @brief DeleteEngine()
+     */
+    void DeleteEngine( Engine engine)
+    {
+        // code
+        delete engine;
+    }
+
+} // namespace ConvolutionEngine
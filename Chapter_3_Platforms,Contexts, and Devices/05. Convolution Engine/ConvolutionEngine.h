@@ -0,0 +1,92 @@
+#include <cl/cl.h>
+
+/**
+ * Reusable 2D convolution on OpenCL buffers, see ConvolutionEngine.cl.
+ *
+ *  - input  : input_height rows of input_width elements
+ *  - mask   : mask_height rows of mask_width elements, must fit in constant memory for METHOD_DIRECT
+ *  - output : ( input_height - mask_height + 1) rows of ( input_width - mask_width + 1) elements
+ *
+ * All three buffers hold the same element type ( cl_float or cl_uint).
+ *
+ * Two methods:
+ *  - METHOD_DIRECT : tiled kernels, cost grows with mask_width * mask_height
+ *  - METHOD_FFT    : zero pad to powers of 2, R2C FFT of input and mask ( Common/OpenCLFFT), pointwise product,
+ *                    inverse FFT. cl_float only, cost grows with log( padded size), no limit on the mask size
+ * METHOD_AUTO picks the cheaper one with a simple operation-count model, see ChooseMethod().
+ *
+ * ConvolveBank() applies num_filters multi-channel masks to one multi-channel input ( cl_float only):
+ *  - input   : num_channels planes of input_height x input_width
+ *  - filters : num_filters x num_channels masks of mask_height x mask_width
+ *  - output  : num_filters planes of ( input_height - mask_height + 1) x ( input_width - mask_width + 1)
+ *
+ *  - BANK_DIRECT          : one work-item per output value
+ *  - BANK_IM2COL          : input lowered to a ( num_channels * mask_height * mask_width) x pixels matrix
+ *                           by an im2col kernel ( a band of rows at a time), then a tiled matrix multiply
+ *  - BANK_IMPLICIT_GEMM   : the same matrix multiply, gathering the lowered tiles straight from the input
+ */
+namespace ConvolutionEngine
+{
+    enum DATA_TYPE
+    {
+        CONVOLVE_FLOAT = 0,
+        CONVOLVE_UINT,
+
+        DATA_TYPE_COUNT
+    };
+
+    enum METHOD
+    {
+        METHOD_AUTO = 0,
+        METHOD_DIRECT,
+        METHOD_FFT
+    };
+
+    enum BANK_METHOD
+    {
+        BANK_DIRECT = 0,
+        BANK_IM2COL,
+        BANK_IMPLICIT_GEMM,
+
+        BANK_METHOD_COUNT
+    };
+
+    typedef struct _Engine* Engine;
+
+        // fft_kernel_file_name is OpenCLFFT.cl, built for the METHOD_FFT transforms
+    Engine CreateEngine( cl_context ocl_context, cl_device_id ocl_device, const char *kernel_file_name, const char *fft_kernel_file_name);
+
+        // false if the local cache or the mask of the direct kernels does not fit on the device
+    bool CanConvolveDirect( Engine engine, DATA_TYPE type, int mask_width, int mask_height);
+
+        // method METHOD_AUTO resolves to, METHOD_DIRECT for cl_uint
+    METHOD ChooseMethod( Engine engine, DATA_TYPE type, int input_width, int input_height, int mask_width, int mask_height);
+
+        // name of the kernel a direct Convolve() would launch
+    const char* KernelName( Engine engine, DATA_TYPE type, int mask_width, int mask_height, bool use_specialized = true);
+
+    cl_int Convolve(
+        Engine engine,
+        cl_command_queue ocl_command_queue,
+        DATA_TYPE type,
+        cl_mem input, int input_width, int input_height,
+        cl_mem mask, int mask_width, int mask_height,
+        cl_mem output,
+        METHOD method = METHOD_AUTO,
+        bool use_specialized = true,
+        cl_event *event = nullptr
+    );
+
+    cl_int ConvolveBank(
+        Engine engine,
+        cl_command_queue ocl_command_queue,
+        BANK_METHOD method,
+        cl_mem input, int input_width, int input_height, int num_channels,
+        cl_mem filters, int mask_width, int mask_height, int num_filters,
+        cl_mem output,
+        cl_event *event = nullptr
+    );
+
+    void DeleteEngine( Engine engine);
+
+} // namespace ConvolutionEngine
@@ -0,0 +1,701 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * Convolution engine sample.
+ *
+ *  Convolves a random width x height signal with a random mask on the device, checks the result against a
+ *  CPU reference and times the kernel.
+ *  The engine launches convolve_T_N() for 3x3, 5x5 and 7x7 masks and convolve_T() for every other size,
+ *  --generic forces convolve_T() so both can be compared.
+ *  For large float masks the engine switches to FFT convolution, --method direct|fft overrides the choice,
+ *  e.g. --mask 64 --method direct vs --mask 64 --method fft.
+ *
+ *  --bank runs a filter bank instead: --channels input planes convolved with 8, 16, 32, 64 and 128 filters
+ *  ( or --filters n), timed for the direct, im2col + GEMM and implicit GEMM methods and spot-checked against the CPU.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <random>
+
+#include <cmath>
+
+#include "OpenCLUtil.h"
+#include "ConvolutionEngine.h"
+
+#define DEFAULT_PLATFORM 0
+#define DEFAULT_WIDTH 2048
+#define DEFAULT_HEIGHT 2048
+#define DEFAULT_MASK_WIDTH 5
+
+#define DEFAULT_BANK_WIDTH 256
+#define DEFAULT_BANK_HEIGHT 256
+#define DEFAULT_BANK_MASK_WIDTH 3
+#define DEFAULT_BANK_CHANNELS 16
+
+    // outputs compared with the CPU per filter count and method
+#define BANK_VERIFY_COUNT 65536
+
+#define To_String(x) #x
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_command_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+
+ConvolutionEngine::Engine convolution_engine = nullptr;
+
+cl_mem ocl_input = nullptr;
+cl_mem ocl_mask = nullptr;
+cl_mem ocl_output = nullptr;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    void ConvolveReferenceFloat( const float *input, int input_width, int input_height, const float *mask, int mask_width, int mask_height, float *output);
+    void ConvolveReferenceUint( const cl_uint *input, int input_width, int input_height, const cl_uint *mask, int mask_width, int mask_height, cl_uint *output);
+    int RunFilterBank( int input_width, int input_height, int num_channels, int mask_width, int mask_height, const std::vector<int> &filter_counts, int num_iterations);
+    void  cleanup();
+
+    // variable declaration
+    int input_width = 0;
+    int input_height = 0;
+    int mask_width = 0;
+    int mask_height = 0;
+
+    bool run_bank = false;
+    int num_channels = DEFAULT_BANK_CHANNELS;
+    int num_filters = 0;
+
+    int platform_used = DEFAULT_PLATFORM;
+    int num_iterations = 1;
+    bool use_specialized = true;
+
+    std::string type_name = "float";
+    ConvolutionEngine::DATA_TYPE type = ConvolutionEngine::CONVOLVE_FLOAT;
+
+    std::string method_name = "auto";
+    ConvolutionEngine::METHOD method = ConvolutionEngine::METHOD_AUTO;
+
+    cl_int ocl_err;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--platform") && (i + 1 < argc))
+        {
+            platform_used = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--width") && (i + 1 < argc))
+        {
+            input_width = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--height") && (i + 1 < argc))
+        {
+            input_height = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--mask") && (i + 1 < argc))
+        {
+            mask_width = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--mask_height") && (i + 1 < argc))
+        {
+            mask_height = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--type") && (i + 1 < argc))
+        {
+            type_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--method") && (i + 1 < argc))
+        {
+            method_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--iterations") && (i + 1 < argc))
+        {
+            num_iterations = std::max( 1, atoi( argv[++i]));
+        }
+        else if( !input.compare( "--generic"))
+        {
+            use_specialized = false;
+        }
+        else if( !input.compare( "--bank"))
+        {
+            run_bank = true;
+        }
+        else if( !input.compare( "--channels") && (i + 1 < argc))
+        {
+            num_channels = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--filters") && (i + 1 < argc))
+        {
+            num_filters = atoi( argv[++i]);
+        }
+    }
+
+    if( input_width <= 0)
+    {
+        input_width = run_bank ? DEFAULT_BANK_WIDTH : DEFAULT_WIDTH;
+    }
+
+    if( input_height <= 0)
+    {
+        input_height = run_bank ? DEFAULT_BANK_HEIGHT : DEFAULT_HEIGHT;
+    }
+
+    if( mask_width <= 0)
+    {
+        mask_width = run_bank ? DEFAULT_BANK_MASK_WIDTH : DEFAULT_MASK_WIDTH;
+    }
+
+    if( mask_height <= 0)
+    {
+        mask_height = mask_width;
+    }
+
+    if( !type_name.compare( "uint"))
+    {
+        type = ConvolutionEngine::CONVOLVE_UINT;
+    }
+
+    if( !method_name.compare( "direct"))
+    {
+        method = ConvolutionEngine::METHOD_DIRECT;
+    }
+    else if( !method_name.compare( "fft"))
+    {
+        method = ConvolutionEngine::METHOD_FFT;
+    }
+
+    if( (mask_width < 1) || (mask_width > input_width) || (mask_height > input_height) ||
+        (type_name.compare( "float") && type_name.compare( "uint")) ||
+        (method_name.compare( "auto") && method_name.compare( "direct") && method_name.compare( "fft")) ||
+        ((method == ConvolutionEngine::METHOD_FFT) && (type != ConvolutionEngine::CONVOLVE_FLOAT)) ||
+        (run_bank && ((num_channels < 1) || (num_filters < 0))))
+    {
+        std::cerr << "usage: " << argv[0] << "\n";
+        std::cerr << "options: " << "\n"
+                  << "   --platform n\n"
+                  << "   --width w, --height h: input size (default " << DEFAULT_WIDTH << " x " << DEFAULT_HEIGHT << ")\n"
+                  << "   --mask w: mask width (default " << DEFAULT_MASK_WIDTH << ")\n"
+                  << "   --mask_height h: mask height (default: mask width)\n"
+                  << "   --type float|uint (default float)\n"
+                  << "   --method auto|direct|fft: fft is float only (default auto)\n"
+                  << "   --generic: do not use the unrolled 3x3 / 5x5 / 7x7 kernels\n"
+                  << "   --iterations n: number of timed runs (default 1)\n"
+                  << "   --bank: filter bank benchmark (default " << DEFAULT_BANK_WIDTH << " x " << DEFAULT_BANK_HEIGHT << " input, "
+                  << DEFAULT_BANK_MASK_WIDTH << " x " << DEFAULT_BANK_MASK_WIDTH << " masks)\n"
+                  << "   --channels n: input planes of --bank (default " << DEFAULT_BANK_CHANNELS << ")\n"
+                  << "   --filters n: filters of --bank (default 8, 16, 32, 64 and 128)"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( platform_used);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_command_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_command_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    convolution_engine = ConvolutionEngine::CreateEngine( ocl_context, ocl_device, "ConvolutionEngine.cl", "../../Common/OpenCLFFT/OpenCLFFT.cl");
+    if( convolution_engine == nullptr)
+    {
+        std::cerr << "ConvolutionEngine::CreateEngine() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    if( run_bank)
+    {
+        std::vector<int> filter_counts = { 8, 16, 32, 64, 128};
+        if( num_filters > 0)
+        {
+            filter_counts.assign( 1, num_filters);
+        }
+
+        int result = RunFilterBank( input_width, input_height, num_channels, mask_width, mask_height, filter_counts, num_iterations);
+
+        cleanup();
+        return result;
+    }
+
+    if( method == ConvolutionEngine::METHOD_AUTO)
+    {
+        method = ConvolutionEngine::ChooseMethod( convolution_engine, type, input_width, input_height, mask_width, mask_height);
+    }
+
+    if( (method == ConvolutionEngine::METHOD_DIRECT) && !ConvolutionEngine::CanConvolveDirect( convolution_engine, type, mask_width, mask_height))
+    {
+        std::cerr << "mask " << mask_width << " x " << mask_height << " is too large for direct convolution on this device.\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** Input Data ***********/
+    int output_width = input_width - mask_width + 1;
+    int output_height = input_height - mask_height + 1;
+
+    size_t input_count = (size_t)input_width * input_height;
+    size_t mask_count = (size_t)mask_width * mask_height;
+    size_t output_count = (size_t)output_width * output_height;
+
+        // float and uint share the same element size
+    std::vector<cl_uint> input_data( input_count);
+    std::vector<cl_uint> mask_data( mask_count);
+    std::vector<cl_uint> output_data( output_count);
+    std::vector<cl_uint> reference_data( output_count);
+
+    std::mt19937 generator( 1234);
+
+    if( type == ConvolutionEngine::CONVOLVE_FLOAT)
+    {
+        std::uniform_real_distribution<float> distribution( 0.0f, 1.0f);
+
+        float *input_f = reinterpret_cast<float *>( input_data.data());
+        float *mask_f = reinterpret_cast<float *>( mask_data.data());
+
+        for( size_t i = 0; i < input_count; ++i)
+        {
+            input_f[i] = distribution( generator);
+        }
+
+            // normalized so the output stays in [0, 1]
+        float mask_sum = 0.0f;
+        for( size_t i = 0; i < mask_count; ++i)
+        {
+            mask_f[i] = distribution( generator);
+            mask_sum += mask_f[i];
+        }
+
+        for( size_t i = 0; i < mask_count; ++i)
+        {
+            mask_f[i] /= mask_sum;
+        }
+    }
+    else
+    {
+        std::uniform_int_distribution<cl_uint> distribution( 0, 255);
+
+        for( size_t i = 0; i < input_count; ++i)
+        {
+            input_data[i] = distribution( generator);
+        }
+
+        for( size_t i = 0; i < mask_count; ++i)
+        {
+            mask_data[i] = distribution( generator) & 3;
+        }
+    }
+
+    ocl_input = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, input_count * sizeof( cl_uint), input_data.data(), &ocl_err);
+    if( !ocl_input || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_mask = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, mask_count * sizeof( cl_uint), mask_data.data(), &ocl_err);
+    if( !ocl_mask || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_output = clCreateBuffer( ocl_context, CL_MEM_WRITE_ONLY, output_count * sizeof( cl_uint), nullptr, &ocl_err);
+    if( !ocl_output || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    std::cout << To_String( input_width) << " : " << input_width << "\n";
+    std::cout << To_String( input_height) << " : " << input_height << "\n";
+    std::cout << To_String( mask_width) << " : " << mask_width << "\n";
+    std::cout << To_String( mask_height) << " : " << mask_height << "\n";
+    if( method == ConvolutionEngine::METHOD_FFT)
+    {
+        std::cout << "method : fft\n\n";
+    }
+    else
+    {
+        std::cout << "method : direct ( " << ConvolutionEngine::KernelName( convolution_engine, type, mask_width, mask_height, use_specialized) << ")\n\n";
+    }
+
+        /******** Convolution ***********/
+        // warm-up run, also the one that is verified
+    ocl_err = ConvolutionEngine::Convolve( convolution_engine, ocl_command_queue, type, ocl_input, input_width, input_height, ocl_mask, mask_width, mask_height, ocl_output, method, use_specialized);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "ConvolutionEngine::Convolve() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+    clFinish( ocl_command_queue);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < num_iterations; ++i)
+    {
+        ocl_err = ConvolutionEngine::Convolve( convolution_engine, ocl_command_queue, type, ocl_input, input_width, input_height, ocl_mask, mask_width, mask_height, ocl_output, method, use_specialized);
+        if( ocl_err != CL_SUCCESS)
+        {
+            std::cerr << "ConvolutionEngine::Convolve() Failed." << ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    }
+    clFinish( ocl_command_queue);
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  elapsed_seconds = ( end - start) / num_iterations;
+
+    double mpixels_per_second = (double)output_count / elapsed_seconds.count() * 1.0e-6;
+
+    std::cout << "Time Required for Convolution by OpenCL is: " << elapsed_seconds.count() * 1000.0 << "ms ( " << mpixels_per_second << " MPixel/s)" << std::endl;
+
+    ocl_err = clEnqueueReadBuffer( ocl_command_queue, ocl_output, CL_TRUE, 0, output_count * sizeof( cl_uint), output_data.data(), 0, nullptr, nullptr);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clEnqueueReadBuffer() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** Verification ***********/
+    start = std::chrono::steady_clock::now();
+
+    size_t num_mismatches = 0;
+
+    if( type == ConvolutionEngine::CONVOLVE_FLOAT)
+    {
+        const float *output_f = reinterpret_cast<const float *>( output_data.data());
+        float *reference_f = reinterpret_cast<float *>( reference_data.data());
+
+        ConvolveReferenceFloat( reinterpret_cast<const float *>( input_data.data()), input_width, input_height, reinterpret_cast<const float *>( mask_data.data()), mask_width, mask_height, reference_f);
+
+        for( size_t i = 0; i < output_count; ++i)
+        {
+                // the FFT rounds differently from the direct sum
+            if( fabsf( output_f[i] - reference_f[i]) > 1.0e-4f * std::max( 1.0f, fabsf( reference_f[i])))
+            {
+                ++num_mismatches;
+            }
+        }
+    }
+    else
+    {
+        ConvolveReferenceUint( input_data.data(), input_width, input_height, mask_data.data(), mask_width, mask_height, reference_data.data());
+
+        for( size_t i = 0; i < output_count; ++i)
+        {
+            if( output_data[i] != reference_data[i])
+            {
+                ++num_mismatches;
+            }
+        }
+    }
+
+    end = std::chrono::steady_clock::now();
+    elapsed_seconds = end - start;
+
+    std::cout << "Time Required for Convolution by CPU is: " << elapsed_seconds.count() * 1000.0 << "ms" << std::endl;
+    std::cout << "mismatches : " << num_mismatches << " / " << output_count << std::endl;
+
+    cleanup();
+
+    return ( num_mismatches == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief RunFilterBank(): time every ConvolveBank() method for each filter count, verify a sample of the outputs.
+ */
+int RunFilterBank( int input_width, int input_height, int num_channels, int mask_width, int mask_height, const std::vector<int> &filter_counts, int num_iterations)
+{
+    // function declaration
+    float ConvolveBankReference( const float *input, int input_width, int input_height, int num_channels, const float *filters, int mask_width, int mask_height, int filter, int x, int y);
+
+    // variable declaration
+    const char *method_names[ConvolutionEngine::BANK_METHOD_COUNT] = { "direct", "im2col + gemm", "implicit gemm"};
+
+    int output_width = input_width - mask_width + 1;
+    int output_height = input_height - mask_height + 1;
+    int max_filters = *std::max_element( filter_counts.begin(), filter_counts.end());
+
+    size_t input_count = (size_t)input_width * input_height * num_channels;
+    size_t filter_size = (size_t)mask_width * mask_height * num_channels;
+    size_t output_plane = (size_t)output_width * output_height;
+
+    size_t num_mismatches = 0;
+
+    cl_int ocl_err;
+
+    // code
+        /******** Input Data ***********/
+    std::vector<float> input_data( input_count);
+    std::vector<float> filter_data( filter_size * max_filters);
+    std::vector<float> output_data( output_plane * max_filters);
+
+    std::mt19937 generator( 1234);
+    std::uniform_real_distribution<float> distribution( 0.0f, 1.0f);
+
+    for( size_t i = 0; i < input_count; ++i)
+    {
+        input_data[i] = distribution( generator);
+    }
+
+        // every filter normalized so the output stays in [0, 1]
+    for( int f = 0; f < max_filters; ++f)
+    {
+        float *filter = filter_data.data() + f * filter_size;
+
+        float filter_sum = 0.0f;
+        for( size_t i = 0; i < filter_size; ++i)
+        {
+            filter[i] = distribution( generator);
+            filter_sum += filter[i];
+        }
+
+        for( size_t i = 0; i < filter_size; ++i)
+        {
+            filter[i] /= filter_sum;
+        }
+    }
+
+    ocl_input = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, input_data.size() * sizeof( cl_float), input_data.data(), &ocl_err);
+    if( !ocl_input || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        return EXIT_FAILURE;
+    }
+
+    ocl_mask = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, filter_data.size() * sizeof( cl_float), filter_data.data(), &ocl_err);
+    if( !ocl_mask || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        return EXIT_FAILURE;
+    }
+
+    ocl_output = clCreateBuffer( ocl_context, CL_MEM_WRITE_ONLY, output_data.size() * sizeof( cl_float), nullptr, &ocl_err);
+    if( !ocl_output || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        return EXIT_FAILURE;
+    }
+
+    std::cout << To_String( input_width) << " : " << input_width << "\n";
+    std::cout << To_String( input_height) << " : " << input_height << "\n";
+    std::cout << To_String( num_channels) << " : " << num_channels << "\n";
+    std::cout << To_String( mask_width) << " : " << mask_width << "\n";
+    std::cout << To_String( mask_height) << " : " << mask_height << "\n\n";
+
+    std::cout << "filters";
+    for( int m = 0; m < ConvolutionEngine::BANK_METHOD_COUNT; ++m)
+    {
+        std::cout << " | " << method_names[m] << " ms ( GFLOP/s)";
+    }
+    std::cout << std::endl;
+
+        /******** Convolution ***********/
+    for( int num_filters : filter_counts)
+    {
+        size_t output_count = output_plane * num_filters;
+        size_t verify_step = std::max( (size_t)1, output_count / BANK_VERIFY_COUNT);
+
+        double flop = 2.0 * (double)output_count * filter_size;
+
+        std::cout << num_filters;
+
+        for( int m = 0; m < ConvolutionEngine::BANK_METHOD_COUNT; ++m)
+        {
+            ConvolutionEngine::BANK_METHOD method = (ConvolutionEngine::BANK_METHOD)m;
+
+                // warm-up run, also the one that is verified
+            ocl_err = ConvolutionEngine::ConvolveBank( convolution_engine, ocl_command_queue, method, ocl_input, input_width, input_height, num_channels, ocl_mask, mask_width, mask_height, num_filters, ocl_output);
+            if( ocl_err != CL_SUCCESS)
+            {
+                std::cerr << "\nConvolutionEngine::ConvolveBank() Failed." << ocl_err << "\n";
+                return EXIT_FAILURE;
+            }
+            clFinish( ocl_command_queue);
+
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            for( int i = 0; i < num_iterations; ++i)
+            {
+                ocl_err = ConvolutionEngine::ConvolveBank( convolution_engine, ocl_command_queue, method, ocl_input, input_width, input_height, num_channels, ocl_mask, mask_width, mask_height, num_filters, ocl_output);
+                if( ocl_err != CL_SUCCESS)
+                {
+                    std::cerr << "\nConvolutionEngine::ConvolveBank() Failed." << ocl_err << "\n";
+                    return EXIT_FAILURE;
+                }
+            }
+            clFinish( ocl_command_queue);
+
+            std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+            std::chrono::duration<double>  elapsed_seconds = ( end - start) / num_iterations;
+
+            std::cout << " | " << elapsed_seconds.count() * 1000.0 << " ( " << flop / elapsed_seconds.count() * 1.0e-9 << ")" << std::flush;
+
+            ocl_err = clEnqueueReadBuffer( ocl_command_queue, ocl_output, CL_TRUE, 0, output_count * sizeof( cl_float), output_data.data(), 0, nullptr, nullptr);
+            if( ocl_err != CL_SUCCESS)
+            {
+                std::cerr << "\nclEnqueueReadBuffer() Failed." << ocl_err << "\n";
+                return EXIT_FAILURE;
+            }
+
+                /******** Verification ***********/
+            for( size_t i = 0; i < output_count; i += verify_step)
+            {
+                int f = (int)( i / output_plane);
+                int y = (int)( ( i % output_plane) / output_width);
+                int x = (int)( i % output_width);
+
+                float reference = ConvolveBankReference( input_data.data(), input_width, input_height, num_channels, filter_data.data(), mask_width, mask_height, f, x, y);
+                if( fabsf( output_data[i] - reference) > 1.0e-4f * std::max( 1.0f, fabsf( reference)))
+                {
+                    ++num_mismatches;
+                }
+            }
+        }
+
+        std::cout << std::endl;
+    }
+
+    std::cout << "mismatches : " << num_mismatches << std::endl;
+
+    return ( num_mismatches == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief ConvolveBankReference(): output ( x, y) of one filter.
+ */
+float ConvolveBankReference( const float *input, int input_width, int input_height, int num_channels, const float *filters, int mask_width, int mask_height, int filter, int x, int y)
+{
+    // variable declaration
+    const float *mask = filters + (size_t)filter * num_channels * mask_height * mask_width;
+    float sum = 0.0f;
+
+    // code
+    for( int c = 0; c < num_channels; ++c)
+    {
+        for( int r = 0; r < mask_height; ++r)
+        {
+            const float *row = input + ( (size_t)c * input_height + y + r) * input_width + x;
+            for( int s = 0; s < mask_width; ++s)
+            {
+                sum += *mask++ * row[s];
+            }
+        }
+    }
+
+    return sum;
+}
+
+/**
+ * @brief ConvolveReferenceFloat(): same loop order as the kernel.
+ */
+void ConvolveReferenceFloat( const float *input, int input_width, int input_height, const float *mask, int mask_width, int mask_height, float *output)
+{
+    // variable declaration
+    int output_width = input_width - mask_width + 1;
+    int output_height = input_height - mask_height + 1;
+
+    // code
+    for( int y = 0; y < output_height; ++y)
+    {
+        for( int x = 0; x < output_width; ++x)
+        {
+            float sum = 0.0f;
+            for( int r = 0; r < mask_height; ++r)
+            {
+                const float *row = input + (size_t)( y + r) * input_width + x;
+                for( int c = 0; c < mask_width; ++c)
+                {
+                    sum += mask[ r * mask_width + c] * row[c];
+                }
+            }
+
+            output[ (size_t)y * output_width + x] = sum;
+        }
+    }
+}
+
+/**
+ * @brief ConvolveReferenceUint(): wraps modulo 2^32 like the kernel.
+ */
+void ConvolveReferenceUint( const cl_uint *input, int input_width, int input_height, const cl_uint *mask, int mask_width, int mask_height, cl_uint *output)
+{
+    // variable declaration
+    int output_width = input_width - mask_width + 1;
+    int output_height = input_height - mask_height + 1;
+
+    // code
+    for( int y = 0; y < output_height; ++y)
+    {
+        for( int x = 0; x < output_width; ++x)
+        {
+            cl_uint sum = 0;
+            for( int r = 0; r < mask_height; ++r)
+            {
+                const cl_uint *row = input + (size_t)( y + r) * input_width + x;
+                for( int c = 0; c < mask_width; ++c)
+                {
+                    sum += mask[ r * mask_width + c] * row[c];
+                }
+            }
+
+            output[ (size_t)y * output_width + x] = sum;
+        }
+    }
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // code
+    if( convolution_engine)
+    {
+        ConvolutionEngine::DeleteEngine( convolution_engine);
+        convolution_engine = nullptr;
+    }
+
+    RELEASE_CL_OBJECT( ocl_input, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_mask, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_output, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_command_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+}
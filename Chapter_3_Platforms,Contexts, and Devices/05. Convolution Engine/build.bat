@@ -0,0 +1,5 @@
+CL.exe /EHsc /c /I"%CUDA_PATH%\include" /I"." Source.cpp ConvolutionEngine.cpp OpenCLUtil.cpp "../../Common/OpenCLFFT/OpenCLFFT.cpp"
+
+LINK.exe /OUT:Source.exe /LIBPATH:"%CUDA_PATH%\lib\x64" opencl.lib Source.obj ConvolutionEngine.obj OpenCLUtil.obj OpenCLFFT.obj
+
+DEL Source.obj ConvolutionEngine.obj OpenCLUtil.obj OpenCLFFT.obj
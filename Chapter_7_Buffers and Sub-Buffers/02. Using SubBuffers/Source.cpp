@@ -3,18 +3,45 @@
  * @date   : 1-August-2023
  */
 
+/************************
+ *
+ * Squares one buffer on every device of the context.
+ *
+ *  The buffer is split into sub-buffers ( chunks) by WorkPartition. Each device is first timed with a short probe
+ *  run, then gets a share of the chunks proportional to its throughput, and a device that runs out of work steals
+ *  chunks from the device with the most left, so a slow device no longer sets the pace.
+ *  --policy equal gives every device the same share without stealing, like a plain split into sub-buffers.
+ *
+ *  --fission splits every CPU device into one sub-device per NUMA node ( clCreateSubDevices(), by affinity domain),
+ *  each with its own queue. The input is written share by share through the queue of the sub-device that owns
+ *  the share, so its pages are first touched by, and stay local to, the node that squares them. This needs the
+ *  copy transfer, --fission always uses it.
+ *
+ *  --transfer picks how the data gets to and from the devices ( see Transfer.h). auto, the default, times copy, map,
+ *  CL_MEM_ALLOC_HOST_PTR and CL_MEM_USE_HOST_PTR once for every device model and keeps the fastest in Transfer.cache.
+ *  All devices share one buffer, so when they disagree ( e.g. a GPU and a CPU with --allDevices) copy is used.
+ */
+
 #include <iostream>
 #include <fstream>
 #include <sstream>
 #include <vector>
+#include <chrono>
 
 #include <CL/cl.h>
 
 #include "Info.hpp"
+#include "WorkPartition.h"
+#include "Transfer.h"
 
 #define DEFAULT_PLATFORM 0
-#define DEFAULT_USE_MAP 0
-#define NUM_BUFFER_ELEMENTS 100
+#define DEFAULT_TRANSFER "auto"
+#define TRANSFER_CACHE_FILE "Transfer.cache"
+#define NUM_BUFFER_ELEMENTS ( 1 << 22)
+#define PROBE_ELEMENTS ( 1 << 18)
+
+    // the result is printed only for small buffers
+#define MAX_PRINT_ELEMENTS 1000
 
 #define RELEASE_ELEMENT_AND_CLEAR_VECTOR( vec, release_func)  \
     for( int x = 0; x < vec.size(); ++x)    \
@@ -27,7 +54,15 @@
     }   \
     vec.clear();
 
+cl_context ocl_context = nullptr;
+cl_program ocl_program = nullptr;
+cl_device_id *ocl_devices = nullptr;
+
+std::vector<cl_device_id> sub_devices;
+std::vector<cl_command_queue> queue;
 
+Transfer::Buffer transfer_buffer = nullptr;
+WorkPartition::Scheduler scheduler = nullptr;
 
 /**
  * @brief main() : Entry-Point function
@@ -35,29 +70,35 @@
 int main( int argc, char **argv)
 {
     // function declaration
-    cl_context CreateContext( int platform_used);
+    cl_context CreateContext( int platform_used, cl_device_type device_type);
+    cl_context CreateContextWithSubDevices( int platform_used, cl_device_type device_type, std::vector<cl_device_id> &sub_devices);
     cl_command_queue CreateCommandQueue( cl_context, cl_device_id* );
     cl_program CreateProgram( cl_context, cl_device_id, const char* );
     cl_program CreateProgramFromBinary( cl_context, cl_device_id, const char* );
     bool SaveProgramBinary( cl_program, cl_device_id, const char *);
     void Cleanup( cl_context, cl_command_queue, cl_program, cl_kernel);
+    void ReleaseAll();
 
     // variable declaration
-    cl_context ocl_context = nullptr;
-    cl_program ocl_program = nullptr;
     cl_device_id ocl_device = nullptr;
     cl_int ocl_err = 0;
-    cl_uint num_platforms = 0;
 
     int platform_used = DEFAULT_PLATFORM;
-    bool b_use_map_buffer = DEFAULT_USE_MAP;
+    std::string transfer_name = DEFAULT_TRANSFER;
+    Transfer::STRATEGY transfer_strategy = Transfer::STRATEGY_COPY;
+    bool b_use_fission = false;
+    cl_device_type device_type = CL_DEVICE_TYPE_GPU;
+    size_t elements_per_device = NUM_BUFFER_ELEMENTS;
+
+    std::string policy_name = "adaptive";
+    WorkPartition::POLICY policy = WorkPartition::POLICY_ADAPTIVE;
 
     // code
     for( int i = 1; i < argc; ++i)
     {
         std::string input( argv[i]);
 
-        if( !input.compare( "--platform"))
+        if( !input.compare( "--platform") && (i + 1 < argc))
         {
             input = std::string( argv[++i]);
             std::istringstream buffer(input);
@@ -65,22 +106,85 @@ int main( int argc, char **argv)
         }
         else if( !input.compare("--useMapBuffer"))
         {
-            b_use_map_buffer = true;
+            transfer_name = Transfer::StrategyName( Transfer::STRATEGY_MAP);
+        }
+        else if( !input.compare( "--transfer") && (i + 1 < argc))
+        {
+            transfer_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--allDevices"))
+        {
+            device_type = CL_DEVICE_TYPE_ALL;
+        }
+        else if( !input.compare( "--fission"))
+        {
+            b_use_fission = true;
+        }
+        else if( !input.compare( "--elements") && (i + 1 < argc))
+        {
+            input = std::string( argv[++i]);
+            std::istringstream buffer(input);
+            buffer >> elements_per_device;
+        }
+        else if( !input.compare( "--policy") && (i + 1 < argc))
+        {
+            policy_name = std::string( argv[++i]);
         }
         else
         {
-            std::cout << "usage: %s --platform n --useMapBuffer" << std::endl;
+            std::cout << "usage: " << argv[0] << " --platform n --useMapBuffer --transfer auto|copy|map|alloc_host_ptr|use_host_ptr --allDevices --fission --elements n --policy equal|proportional|adaptive" << std::endl;
             return 0;
         }
     }
 
+    if( !policy_name.compare( "equal"))
+    {
+        policy = WorkPartition::POLICY_EQUAL;
+    }
+    else if( !policy_name.compare( "proportional"))
+    {
+        policy = WorkPartition::POLICY_PROPORTIONAL;
+    }
+    else if( policy_name.compare( "adaptive"))
+    {
+        std::cerr << "Unknown policy " << policy_name << std::endl;
+        return 1;
+    }
+
+    if( transfer_name.compare( "auto") && !Transfer::StrategyFromName( transfer_name.c_str(), &transfer_strategy))
+    {
+        std::cerr << "Unknown transfer " << transfer_name << std::endl;
+        return 1;
+    }
+
+    if( elements_per_device == 0)
+    {
+        elements_per_device = NUM_BUFFER_ELEMENTS;
+    }
+
+        // fission splits CPU devices, without --allDevices use only those
+    if( b_use_fission && (device_type == CL_DEVICE_TYPE_GPU))
+    {
+        device_type = CL_DEVICE_TYPE_CPU;
+    }
+
 
 
         // Create an OpenCL context on first available platform
-    ocl_context = CreateContext( platform_used);
+    if( b_use_fission)
+    {
+        ocl_context = CreateContextWithSubDevices( platform_used, device_type, sub_devices);
+    }
+    else
+    {
+        ocl_context = CreateContext( platform_used, device_type);
+    }
+
     if( ocl_context == nullptr)
     {
         std::cerr << "Failed to create OpenCL Context." << std::endl;
+
+        ReleaseAll();
         return 1;
     }
 
@@ -91,7 +195,7 @@ int main( int argc, char **argv)
     {
         std::cerr << "CreateProgram() Failed." << __LINE__ << std::endl;
 
-        Cleanup( ocl_context, nullptr, ocl_program, nullptr);
+        ReleaseAll();
         return 1;
     }
 
@@ -104,278 +208,280 @@ int main( int argc, char **argv)
     {
         std::cerr << "clGetProgramInfo() Failed." << __LINE__ << std::endl;
 
-        Cleanup( ocl_context, nullptr, ocl_program, nullptr);
+        ReleaseAll();
         return 1;
     }
 
-    cl_device_id *ocl_devices = new cl_device_id[ num_devices];
+    ocl_devices = new cl_device_id[ num_devices];
     ocl_err = clGetProgramInfo( ocl_program, CL_PROGRAM_DEVICES, sizeof( cl_device_id) * num_devices, ocl_devices, nullptr);
     if( ocl_err != CL_SUCCESS)
     {
         std::cerr << "clGetProgramInfo() Failed." << __LINE__ << std::endl;
 
-        Cleanup( ocl_context, nullptr, ocl_program, nullptr);
+        ReleaseAll();
         return 1;
     }
 
     std::cout << "Num Device : " << num_devices << std::endl;
 
-
-        // Create memory objects that will be used as arguments to kernel.
-        // First create host memory arrays that will be used to store the arguments to the kernel.
-    int *inputOutput = new int[ NUM_BUFFER_ELEMENTS * num_devices];
-
-    for( int i = 0; i < NUM_BUFFER_ELEMENTS * num_devices; ++i)
-    {
-        inputOutput[ i] = i;
-    }
-
+    size_t num_elements = elements_per_device * num_devices;
 
 
-    std::vector<cl_command_queue> queue;
-    std::vector<cl_event> events;
-    std::vector<cl_mem> buffers;
-    std::vector<cl_kernel> kernels;
 
-
-
-
-        // create memory object
-    cl_mem buffer = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, sizeof( cl_int) * NUM_BUFFER_ELEMENTS * num_devices, nullptr, nullptr);
-    if( buffer == nullptr)
+        // Create a command-queue for each devices
+    for( cl_uint i = 0; i < num_devices; ++i)
     {
-        delete inputOutput;
-        delete ocl_devices;
-
-        Cleanup( ocl_context, nullptr, ocl_program, nullptr);
-        std::cerr << "Error creating memory objects." << std::endl;
-        return 1;
-    }
-    buffers.push_back( buffer);
+        InfoDevice<cl_device_type>::display( ocl_devices[i], CL_DEVICE_TYPE, __To_String(CL_DEVICE_TYPE));
 
-        // now for all devices other than the first create a sub-buffer
-    for( int i = 1; i < num_devices; ++i)
-    {
-        cl_buffer_region region = 
-        {
-            NUM_BUFFER_ELEMENTS * i * sizeof(int),
-            NUM_BUFFER_ELEMENTS * sizeof(int)
-        };
-
-        cl_mem buffer = clCreateSubBuffer(
-                buffers[0],
-                CL_MEM_READ_WRITE,
-                CL_BUFFER_CREATE_TYPE_REGION,
-                &region,
-                &ocl_err
-        );
-
-        if( buffer == nullptr)
+        cl_command_queue ocl_command_queue = clCreateCommandQueue( ocl_context, ocl_devices[i], 0, &ocl_err);
+        if( ocl_command_queue == nullptr)
         {
-            delete inputOutput;
-            delete ocl_devices;
-
-            Cleanup( ocl_context, nullptr, ocl_program, nullptr);
-
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( buffers, clReleaseMemObject);
+            std::cerr << "clCreateCommandQueue() Failed." << __LINE__ << std::endl;
 
-            std::cerr << "Error creating memory objects." << std::endl;
+            ReleaseAll();
             return 1;
         }
+
+        queue.push_back( ocl_command_queue);
     }
 
-    
 
-        // Create a command-queue for each devices and kernel object
-    for( int i = 0; i < num_devices; ++i)
+        // Zero-copy strategies write the whole buffer from queue[0] into the host array the main thread filled,
+        // the sub-device shares would no longer be first touched on their own node.
+    if( b_use_fission && (transfer_strategy != Transfer::STRATEGY_COPY || !transfer_name.compare( "auto")))
     {
-        InfoDevice<cl_device_type>::display( ocl_devices[i], CL_DEVICE_TYPE, __To_String(CL_DEVICE_TYPE));
-
-        cl_command_queue ocl_command_queue = clCreateCommandQueue( ocl_context, ocl_devices[i], 0, &ocl_err);
-        if( ocl_command_queue == nullptr)
+        if( transfer_name.compare( "auto"))
         {
-            std::cerr << "clCreateCommandQueue() Failed." << __LINE__ << std::endl;
+            std::cerr << "--fission writes every share from its own sub-device, using transfer copy instead of " << transfer_name << std::endl;
+        }
 
-            delete inputOutput;
-            delete ocl_devices;
+        transfer_name = Transfer::StrategyName( Transfer::STRATEGY_COPY);
+        transfer_strategy = Transfer::STRATEGY_COPY;
+    }
 
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( buffers, clReleaseMemObject);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( queue, clReleaseCommandQueue);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( kernels, clReleaseKernel);
+        // one strategy per device ( cached per device model), the buffer takes it only if every device agrees
+    if( !transfer_name.compare( "auto"))
+    {
+        double probe_seconds[Transfer::STRATEGY_COUNT];
 
-            Cleanup( ocl_context, ocl_command_queue, ocl_program, nullptr);
+        cl_kernel ocl_probe_kernel = clCreateKernel( ocl_program, "square", &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            std::cerr << "clCreateKernel() Failed." << __LINE__ << std::endl;
 
+            ReleaseAll();
             return 1;
         }
 
-        queue.push_back( ocl_command_queue);
-
-        
-            // Create OpenCL Kernel
-        cl_kernel kernel = clCreateKernel( ocl_program, "square", &ocl_err);
-        if( ocl_err != CL_SUCCESS)
+        for( cl_uint i = 0; i < num_devices; ++i)
         {
-            std::cerr << "clCreateKernel() Failed." << __LINE__ << std::endl;
+            Transfer::STRATEGY device_strategy = Transfer::Select( ocl_context, queue[i], ocl_probe_kernel, elements_per_device, sizeof( cl_int), TRANSFER_CACHE_FILE, probe_seconds);
+
+            for( int s = 0; s < Transfer::STRATEGY_COUNT; ++s)
+            {
+                if( probe_seconds[s] > 0.0)
+                {
+                    std::cout << "device " << i << " transfer probe " << Transfer::StrategyName( (Transfer::STRATEGY)s) << " : " << probe_seconds[s] * 1000.0 << " ms" << std::endl;
+                }
+            }
+
+            std::cout << "device " << i << " transfer : " << Transfer::StrategyName( device_strategy) << std::endl;
+
+            if( i == 0)
+            {
+                transfer_strategy = device_strategy;
+            }
+            else if( device_strategy != transfer_strategy)
+            {
+                    // all shares are sub-buffers of one buffer with one set of flags, copy lets every device write its own share
+                transfer_strategy = Transfer::STRATEGY_COPY;
+            }
+        }
 
-            delete inputOutput;
-            delete ocl_devices;
+        clReleaseKernel( ocl_probe_kernel);
+    }
 
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( buffers, clReleaseMemObject);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( queue, clReleaseCommandQueue);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( kernels, clReleaseKernel);
+    std::cout << "transfer : " << Transfer::StrategyName( transfer_strategy) << std::endl;
 
-            Cleanup( ocl_context, ocl_command_queue, ocl_program, nullptr);
 
-            return 1;
-        }
+        // Create memory objects that will be used as arguments to kernel.
+        // The host array comes with the buffer ( page aligned, so CL_MEM_USE_HOST_PTR does not copy),
+        // WorkPartition cuts the buffer into sub-buffers.
+    transfer_buffer = Transfer::CreateBuffer( ocl_context, transfer_strategy, sizeof( cl_int) * num_elements, &ocl_err);
+    if( transfer_buffer == nullptr)
+    {
+        std::cerr << "Error creating memory objects." << ocl_err << std::endl;
 
-        
-            // Set the kernel arguments ( result, a, b)
-        ocl_err = clSetKernelArg( kernel, 0 /* argument index */, sizeof( cl_mem), &buffers[i]);
-        if( ocl_err != CL_SUCCESS)
-        {
-            std::cerr << "clSetKernelArg() Failed." << __LINE__ << std::endl;
+        ReleaseAll();
+        return 1;
+    }
 
-            delete inputOutput;
-            delete ocl_devices;
+        // Values stay below 46341 so the squares fit in an int.
+    int *inputOutput = static_cast<int *>( Transfer::HostPointer( transfer_buffer));
 
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( buffers, clReleaseMemObject);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( queue, clReleaseCommandQueue);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( kernels, clReleaseKernel);
+    for( size_t i = 0; i < num_elements; ++i)
+    {
+        inputOutput[ i] = (int)( i % 46341);
+    }
 
-            Cleanup( ocl_context, ocl_command_queue, ocl_program, nullptr);
+    scheduler = WorkPartition::CreateScheduler( ocl_context, ocl_program, "square", queue, Transfer::Memory( transfer_buffer), num_elements, sizeof( cl_int));
+    if( scheduler == nullptr)
+    {
+        std::cerr << "WorkPartition::CreateScheduler() Failed." << __LINE__ << std::endl;
 
-            return 1;
-        }
-    
-        kernels.push_back( kernel);
-        
+        ReleaseAll();
+        return 1;
     }
 
 
-    if( b_use_map_buffer)
+        // probe run on every device
+    if( policy != WorkPartition::POLICY_EQUAL)
     {
-        cl_int *map_ptr = (cl_int *) clEnqueueMapBuffer( queue[0], buffers[0], CL_TRUE, CL_MAP_WRITE, 0, sizeof( cl_int) * NUM_BUFFER_ELEMENTS * num_devices, 0, nullptr, nullptr, &ocl_err);
+        ocl_err = WorkPartition::Calibrate( scheduler, std::min( (size_t)PROBE_ELEMENTS, num_elements));
         if( ocl_err != CL_SUCCESS)
         {
-            std::cerr << "clEnqueueMapBuffer() Failed." << __LINE__ << std::endl;
-
-            delete inputOutput;
-            delete ocl_devices;
-
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( buffers, clReleaseMemObject);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( queue, clReleaseCommandQueue);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( kernels, clReleaseKernel);
-
-            Cleanup( ocl_context, nullptr, ocl_program, nullptr);
+            std::cerr << "WorkPartition::Calibrate() Failed." << ocl_err << std::endl;
 
+            ReleaseAll();
             return 1;
         }
+    }
 
-        for( int i = 0; i < NUM_BUFFER_ELEMENTS * num_devices; ++i)
-        {
-            map_ptr[i] = inputOutput[i];
-        }
 
-        ocl_err = clEnqueueUnmapMemObject( queue[0], buffers[0], map_ptr, 0, nullptr, nullptr);
+    if( transfer_strategy == Transfer::STRATEGY_COPY)
+    {
+            // every share through the queue that will square it ( first touch on its own NUMA node)
+        ocl_err = WorkPartition::Upload( scheduler, policy, inputOutput);
     }
     else
     {
-        ocl_err = clEnqueueWriteBuffer( queue[0], buffers[0], CL_TRUE, 0, sizeof( int) * NUM_BUFFER_ELEMENTS * num_devices, (void *)inputOutput, 0, nullptr, nullptr);
+        ocl_err = Transfer::Upload( transfer_buffer, queue[0]);
+    }
+
+        // the other queues must not start before the data is in place
+    clFinish( queue[0]);
+
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "Writing the input Failed." << ocl_err << std::endl;
+
+        ReleaseAll();
+        return 1;
     }
 
 
 
+        // run the chunks on all devices
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
 
-        //submit kernel enqueue to each queue
-    for( int i = 0; i < queue.size(); ++i)
+    ocl_err = WorkPartition::Run( scheduler, policy);
+    if( ocl_err != CL_SUCCESS)
     {
-        cl_event event;
-
-        size_t gWI = NUM_BUFFER_ELEMENTS;
+        std::cerr << "WorkPartition::Run() Failed." << ocl_err << std::endl;
 
-            // Queue the kernel up for execution across the array
-        ocl_err = clEnqueueNDRangeKernel( queue[i], kernels[i], 1, nullptr, (const size_t*) &gWI, nullptr, 0, nullptr, &event);
-        if( ocl_err != CL_SUCCESS)
-        {
-            std::cerr << "Error queuing kernel for execution." << std::endl;
+        ReleaseAll();
+        return 1;
+    }
 
-            delete inputOutput;
-            delete ocl_devices;
+    std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
 
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( buffers, clReleaseMemObject);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( queue, clReleaseCommandQueue);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( kernels, clReleaseKernel);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( events, clReleaseEvent);
+    std::cout << "policy : " << policy_name << ", " << WorkPartition::NumChunks( scheduler) << " chunks" << std::endl;
 
-            Cleanup( ocl_context, nullptr, ocl_program, nullptr);
-            return 1;
-        }
+    for( int i = 0; i < WorkPartition::NumDevices( scheduler); ++i)
+    {
+        const WorkPartition::DeviceStats &stats = WorkPartition::Stats( scheduler, i);
 
-        events.push_back( event);
+        std::cout << "device " << i
+                  << " : probe " << stats.probe_throughput * 1.0e-6 << " M elements/s"
+                  << ", share " << stats.share_chunks
+                  << ", executed " << stats.executed_chunks
+                  << " ( stolen " << stats.stolen_chunks << ")"
+                  << ", busy " << stats.busy_seconds * 1000.0 << " ms" << std::endl;
     }
 
-    // wait for commands to complete
-    clWaitForEvents( events.size(), events.data()); // Technically, don't need this as we are doing a blocking read with in-order queue.
-    RELEASE_ELEMENT_AND_CLEAR_VECTOR( events, clReleaseEvent);
+    std::cout << "Time Required : " << elapsed_seconds.count() * 1000.0 << " ms" << std::endl;
 
     /***************************************************************************************************/
 
-    if( b_use_map_buffer)
+    ocl_err = Transfer::Download( transfer_buffer, queue[0]);
+    if( ocl_err != CL_SUCCESS)
     {
-        cl_int *map_ptr = (cl_int*) clEnqueueMapBuffer( queue[0], buffers[0], CL_TRUE, CL_MAP_READ, 0, sizeof( cl_int) * NUM_BUFFER_ELEMENTS * num_devices, 0, nullptr, nullptr, &ocl_err);
-        if( ocl_err != CL_SUCCESS)
-        {
-            std::cerr << "clEnqueueMapBuffer()." << std::endl;
-
-            delete inputOutput;
-            delete ocl_devices;
+        std::cerr << "Transfer::Download() Failed." << ocl_err << std::endl;
 
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( buffers, clReleaseMemObject);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( queue, clReleaseCommandQueue);
-            RELEASE_ELEMENT_AND_CLEAR_VECTOR( kernels, clReleaseKernel);
+        ReleaseAll();
+        return 1;
+    }
 
-            Cleanup( ocl_context, nullptr, ocl_program, nullptr);
-            return 1;
+        // Output the result buffer
+    size_t num_mismatches = 0;
+    for( size_t i = 0; i < num_elements; ++i)
+    {
+        int value = (int)( i % 46341);
+        if( inputOutput[i] != value * value)
+        {
+            ++num_mismatches;
         }
 
-        for( int i = 0; i < NUM_BUFFER_ELEMENTS * num_devices; ++i)
+        if( num_elements <= MAX_PRINT_ELEMENTS)
         {
-            inputOutput[i] = map_ptr[i];
+            std::cout << inputOutput[i] << "\n";
         }
-
-        ocl_err = clEnqueueUnmapMemObject( queue[0], buffers[0], map_ptr, 0, nullptr, nullptr);
     }
-    else
+
+    std::cout << "mismatches : " << num_mismatches << " / " << num_elements << std::endl;
+
+    if( num_mismatches == 0)
     {
-        clEnqueueReadBuffer( queue[0], buffers[0], CL_TRUE, 0, sizeof( int) * NUM_BUFFER_ELEMENTS * num_devices, (void *)inputOutput, 0, nullptr, nullptr);
+        std::cout << "Executed program Successfully." << std::endl;
     }
 
-        // Output the result buffer
-    for( int i = 0; i < NUM_BUFFER_ELEMENTS * num_devices; ++i)
+    ReleaseAll();
+
+    return ( num_mismatches == 0) ? 0 : 1;
+}
+
+/**
+ * @brief ReleaseAll() : release everything main() created.
+ */
+void ReleaseAll()
+{
+    // function declaration
+    void Cleanup( cl_context, cl_command_queue, cl_program, cl_kernel);
+
+    // code
+    if( scheduler)
     {
-        std::cout << inputOutput[i] << "\n";
+        WorkPartition::DeleteScheduler( scheduler);
+        scheduler = nullptr;
     }
 
-    std::cout << "Executed program Successfully." << std::endl;
+        // after the scheduler, its chunks are sub-buffers of this buffer
+    if( transfer_buffer)
+    {
+        Transfer::DeleteBuffer( transfer_buffer);
+        transfer_buffer = nullptr;
+    }
 
-    delete inputOutput;
-    delete ocl_devices;
+    delete [] ocl_devices;
+    ocl_devices = nullptr;
 
-    RELEASE_ELEMENT_AND_CLEAR_VECTOR( buffers, clReleaseMemObject);
     RELEASE_ELEMENT_AND_CLEAR_VECTOR( queue, clReleaseCommandQueue);
-    RELEASE_ELEMENT_AND_CLEAR_VECTOR( kernels, clReleaseKernel);
 
     Cleanup( ocl_context, nullptr, ocl_program, nullptr);
 
-    return 0;
-}
+    ocl_context = nullptr;
+    ocl_program = nullptr;
 
+    RELEASE_ELEMENT_AND_CLEAR_VECTOR( sub_devices, clReleaseDevice);
+}
 
 /**
  * @brief CreateContext() : returns OpenCL context.
+ *
+ * @param device_type CL_DEVICE_TYPE_ALL puts every device of the platform in the context ( e.g. CPU and GPU),
+ *                    otherwise GPUs with a fallback to CPUs.
  */
-cl_context CreateContext( int platform_used)
+cl_context CreateContext( int platform_used, cl_device_type device_type)
 {
     // variable declaration
     cl_int ocl_err;
@@ -423,8 +529,8 @@ cl_context CreateContext( int platform_used)
         0
     };
 
-    ocl_context = clCreateContextFromType( ocl_context_properties, CL_DEVICE_TYPE_GPU, nullptr, nullptr, &ocl_err);
-    if( ocl_err != CL_SUCCESS)
+    ocl_context = clCreateContextFromType( ocl_context_properties, device_type, nullptr, nullptr, &ocl_err);
+    if( (ocl_err != CL_SUCCESS) && (device_type == CL_DEVICE_TYPE_GPU))
     {
         std::cout << "Could not create GPU context, trying CPU..." << std::endl;
 
@@ -436,6 +542,12 @@ cl_context CreateContext( int platform_used)
             return nullptr;
         }
     }
+    else if( ocl_err != CL_SUCCESS)
+    {
+        delete ocl_platform_ids;
+        std::cerr << "Failed to create an OpenCL context." << std::endl;
+        return nullptr;
+    }
 
     delete ocl_platform_ids;
 
@@ -443,6 +555,132 @@ cl_context CreateContext( int platform_used)
 }
 
 
+/**
+ * @brief CreateContextWithSubDevices() : context on the devices of a platform, CPU devices split by affinity domain.
+ *
+ * @description:
+ *          A CPU device normally spans every socket, so its work-items and the pages they touch can land on any
+ *          NUMA node. clCreateSubDevices() with CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN gives one sub-device per
+ *          node ( or per next partitionable level if the device does not report NUMA). Devices that cannot be
+ *          partitioned are used as they are. The sub-devices created are returned in sub_devices, to be released
+ *          after the context.
+ */
+cl_context CreateContextWithSubDevices( int platform_used, cl_device_type device_type, std::vector<cl_device_id> &sub_devices)
+{
+    // variable declaration
+    cl_int ocl_err;
+    cl_uint ocl_num_platforms;
+    cl_uint ocl_num_devices = 0;
+    cl_platform_id ocl_platform_id;
+    cl_context ocl_context = nullptr;
+
+    std::vector<cl_device_id> context_devices;
+
+    // code
+    ocl_err = clGetPlatformIDs( 0, nullptr, &ocl_num_platforms);
+    if( (ocl_err != CL_SUCCESS) || ( ocl_num_platforms <= 0))
+    {
+        std::cerr << "Failed to find any OpenCL platforms." << std::endl;
+        return nullptr;
+    }
+
+    std::vector<cl_platform_id> ocl_platform_ids( ocl_num_platforms);
+    clGetPlatformIDs( ocl_num_platforms, ocl_platform_ids.data(), nullptr);
+
+    if( (platform_used < 0) || ( platform_used >= ocl_num_platforms))
+    {
+        platform_used = DEFAULT_PLATFORM;
+    }
+
+    ocl_platform_id = ocl_platform_ids[platform_used];
+
+    DisplayPlatformInfo( ocl_platform_id, CL_PLATFORM_VENDOR, "CL_PLATFORM_VENDOR");
+
+    ocl_err = clGetDeviceIDs( ocl_platform_id, device_type, 0, nullptr, &ocl_num_devices);
+    if( (ocl_err != CL_SUCCESS) || (ocl_num_devices == 0))
+    {
+        std::cerr << "Failed to find any OpenCL devices." << std::endl;
+        return nullptr;
+    }
+
+    std::vector<cl_device_id> ocl_devices( ocl_num_devices);
+    clGetDeviceIDs( ocl_platform_id, device_type, ocl_num_devices, ocl_devices.data(), nullptr);
+
+    for( cl_uint i = 0; i < ocl_num_devices; ++i)
+    {
+        cl_device_type type = 0;
+        cl_device_affinity_domain domains = 0;
+
+        clGetDeviceInfo( ocl_devices[i], CL_DEVICE_TYPE, sizeof( cl_device_type), &type, nullptr);
+        clGetDeviceInfo( ocl_devices[i], CL_DEVICE_PARTITION_AFFINITY_DOMAIN, sizeof( cl_device_affinity_domain), &domains, nullptr);
+
+        cl_device_affinity_domain domain = 0;
+        if( domains & CL_DEVICE_AFFINITY_DOMAIN_NUMA)
+        {
+            domain = CL_DEVICE_AFFINITY_DOMAIN_NUMA;
+        }
+        else if( domains & CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE)
+        {
+            domain = CL_DEVICE_AFFINITY_DOMAIN_NEXT_PARTITIONABLE;
+        }
+
+        cl_uint num_sub_devices = 0;
+
+        if( (type & CL_DEVICE_TYPE_CPU) && domain)
+        {
+            cl_device_partition_property properties[] =
+            {
+                CL_DEVICE_PARTITION_BY_AFFINITY_DOMAIN, (cl_device_partition_property)domain,
+                0
+            };
+
+            ocl_err = clCreateSubDevices( ocl_devices[i], properties, 0, nullptr, &num_sub_devices);
+            if( (ocl_err == CL_SUCCESS) && (num_sub_devices > 1))
+            {
+                std::vector<cl_device_id> ids( num_sub_devices);
+
+                ocl_err = clCreateSubDevices( ocl_devices[i], properties, num_sub_devices, ids.data(), nullptr);
+                if( ocl_err == CL_SUCCESS)
+                {
+                    sub_devices.insert( sub_devices.end(), ids.begin(), ids.end());
+                    context_devices.insert( context_devices.end(), ids.begin(), ids.end());
+                }
+                else
+                {
+                    num_sub_devices = 0;
+                }
+            }
+            else
+            {
+                    // a single domain: nothing to split
+                num_sub_devices = 0;
+            }
+        }
+
+        if( num_sub_devices == 0)
+        {
+            context_devices.push_back( ocl_devices[i]);
+        }
+
+        std::cout << "device " << i << " : " << ( num_sub_devices ? num_sub_devices : 1) << ( num_sub_devices ? " sub-devices" : " device ( not partitioned)") << std::endl;
+    }
+
+    cl_context_properties ocl_context_properties[] =
+    {
+        CL_CONTEXT_PLATFORM, (cl_context_properties) ocl_platform_id,
+        0
+    };
+
+    ocl_context = clCreateContext( ocl_context_properties, (cl_uint)context_devices.size(), context_devices.data(), nullptr, nullptr, &ocl_err);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "Failed to create an OpenCL context." << std::endl;
+        return nullptr;
+    }
+
+    return ocl_context;
+}
+
 /**
  * @brief CreateCommandQueue() : create and return OpenCL command-queue
  */
@@ -0,0 +1,452 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <map>
+#include <chrono>
+
+#include <cstring>
+#include <cstdlib>
+
+#ifdef _WIN32
+    #include <malloc.h>
+#endif
+
+#include "Transfer.h"
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+namespace Transfer
+{
+        // zero-copy needs a page aligned host array ( CL_DEVICE_MEM_BASE_ADDR_ALIGN is at most this)
+    const size_t HOST_ALIGNMENT = 4096;
+
+        // timed probe runs per strategy after the warm-up, the fastest one is kept
+    const int PROBE_RUNS = 3;
+
+    const char *strategy_names[STRATEGY_COUNT] = { "copy", "map", "alloc_host_ptr", "use_host_ptr"};
+
+    //////////////////////////////////////////////
+    ///////// TYPE DEFINITION
+    //////////////////////////////////////////////
+    struct _Buffer
+    {
+        STRATEGY strategy = STRATEGY_COPY;
+        size_t size = 0;
+
+        void *host = nullptr;
+        cl_mem ocl_buffer = nullptr;
+
+        ~_Buffer()
+        {
+                // the buffer may use the host array, release it first
+            RELEASE_CL_OBJECT( ocl_buffer, clReleaseMemObject);
+
+            if( host)
+            {
+#ifdef _WIN32
+                _aligned_free( host);
+#else
+                free( host);
+#endif
+                host = nullptr;
+            }
+        }
+    };
+
+        // Select() results of this process, key from CacheKey()
+    std::map<std::string, STRATEGY> strategy_cache;
+
+    //////////////////////////////////////////////
+    ////// FUNCTION DEFINITION
+    //////////////////////////////////////////////
+
+    /**
+     * @brief StrategyName()
+     */
+    const char* StrategyName( STRATEGY strategy)
+    {
+        // code
+        return strategy_names[strategy];
+    }
+
+    /**
+     * @brief StrategyFromName()
+     */
+    bool StrategyFromName( const char *name, STRATEGY *strategy)
+    {
+        // code
+        for( int s = 0; s < STRATEGY_COUNT; ++s)
+        {
+            if( !strcmp( name, strategy_names[s]))
+            {
+                *strategy = (STRATEGY)s;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /**
+     * @brief AllocateHost(): page aligned, nullptr on failure.
+     */
+    static void* AllocateHost( size_t size)
+    {
+        // variable declaration
+        void *host = nullptr;
+
+        // code
+            // round up so the last page is whole, the runtime may map it completely
+        size = ( size + HOST_ALIGNMENT - 1) / HOST_ALIGNMENT * HOST_ALIGNMENT;
+
+#ifdef _WIN32
+        host = _aligned_malloc( size, HOST_ALIGNMENT);
+#else
+        if( posix_memalign( &host, HOST_ALIGNMENT, size) != 0)
+        {
+            host = nullptr;
+        }
+#endif
+
+        return host;
+    }
+
+    /**
+     * @brief CreateBuffer()
+     */
+    Buffer CreateBuffer( cl_context ocl_context, STRATEGY strategy, size_t size, cl_int *ocl_err)
+    {
+        // variable declaration
+        cl_mem_flags flags = CL_MEM_READ_WRITE;
+        void *host_ptr = nullptr;
+
+        Buffer buffer = new _Buffer();
+
+        // code
+        buffer->strategy = strategy;
+        buffer->size = size;
+
+        buffer->host = AllocateHost( size);
+        if( buffer->host == nullptr)
+        {
+            *ocl_err = CL_OUT_OF_HOST_MEMORY;
+            delete buffer;
+            return nullptr;
+        }
+
+        if( strategy == STRATEGY_ALLOC_HOST_PTR)
+        {
+            flags |= CL_MEM_ALLOC_HOST_PTR;
+        }
+        else if( strategy == STRATEGY_USE_HOST_PTR)
+        {
+            flags |= CL_MEM_USE_HOST_PTR;
+            host_ptr = buffer->host;
+        }
+
+        buffer->ocl_buffer = clCreateBuffer( ocl_context, flags, size, host_ptr, ocl_err);
+        if( !buffer->ocl_buffer || *ocl_err)
+        {
+            delete buffer;
+            return nullptr;
+        }
+
+        return buffer;
+    }
+
+    /**
+     * @brief HostPointer()
+     */
+    void* HostPointer( Buffer buffer)
+    {
+        // code
+        return buffer->host;
+    }
+
+    /**
+     * @brief Memory()
+     */
+    cl_mem Memory( Buffer buffer)
+    {
+        // code
+        return buffer->ocl_buffer;
+    }
+
+    /**
+     * @brief Strategy()
+     */
+    STRATEGY Strategy( Buffer buffer)
+    {
+        // code
+        return buffer->strategy;
+    }
+
+    /**
+     * @brief Upload()
+     */
+    cl_int Upload( Buffer buffer, cl_command_queue ocl_command_queue)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        if( buffer->strategy == STRATEGY_COPY)
+        {
+            return clEnqueueWriteBuffer( ocl_command_queue, buffer->ocl_buffer, CL_TRUE, 0, buffer->size, buffer->host, 0, nullptr, nullptr);
+        }
+
+            // the old content is overwritten, so the runtime does not have to fetch it
+        void *map_ptr = clEnqueueMapBuffer( ocl_command_queue, buffer->ocl_buffer, CL_TRUE, CL_MAP_WRITE_INVALIDATE_REGION, 0, buffer->size, 0, nullptr, nullptr, &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+            // CL_MEM_USE_HOST_PTR maps the host array itself
+        if( map_ptr != buffer->host)
+        {
+            memcpy( map_ptr, buffer->host, buffer->size);
+        }
+
+        return clEnqueueUnmapMemObject( ocl_command_queue, buffer->ocl_buffer, map_ptr, 0, nullptr, nullptr);
+    }
+
+    /**
+     * @brief Download()
+     */
+    cl_int Download( Buffer buffer, cl_command_queue ocl_command_queue)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        if( buffer->strategy == STRATEGY_COPY)
+        {
+            return clEnqueueReadBuffer( ocl_command_queue, buffer->ocl_buffer, CL_TRUE, 0, buffer->size, buffer->host, 0, nullptr, nullptr);
+        }
+
+        void *map_ptr = clEnqueueMapBuffer( ocl_command_queue, buffer->ocl_buffer, CL_TRUE, CL_MAP_READ, 0, buffer->size, 0, nullptr, nullptr, &ocl_err);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+        if( map_ptr != buffer->host)
+        {
+            memcpy( buffer->host, map_ptr, buffer->size);
+        }
+
+        ocl_err = clEnqueueUnmapMemObject( ocl_command_queue, buffer->ocl_buffer, map_ptr, 0, nullptr, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            return ocl_err;
+        }
+
+        return clFinish( ocl_command_queue);
+    }
+
+    /**
+     * @brief DeleteBuffer()
+     */
+    void DeleteBuffer( Buffer buffer)
+    {
+        // code
+        delete buffer;
+    }
+
+    /**
+     * @brief CacheKey(): device name, driver version and size class ( log2 of the bytes).
+     */
+    static std::string CacheKey( cl_command_queue ocl_command_queue, size_t size)
+    {
+        // variable declaration
+        cl_device_id ocl_device = nullptr;
+        char device_name[256] = { 0 };
+        char driver_version[256] = { 0 };
+
+        int size_class = 0;
+
+        // code
+        clGetCommandQueueInfo( ocl_command_queue, CL_QUEUE_DEVICE, sizeof( cl_device_id), &ocl_device, nullptr);
+        clGetDeviceInfo( ocl_device, CL_DEVICE_NAME, sizeof( device_name) - 1, device_name, nullptr);
+        clGetDeviceInfo( ocl_device, CL_DRIVER_VERSION, sizeof( driver_version) - 1, driver_version, nullptr);
+
+        while( ( (size_t)1 << ( size_class + 1)) <= size)
+        {
+            ++size_class;
+        }
+
+        std::ostringstream key;
+        key << device_name << ";" << driver_version << ";" << size_class;
+
+        return key.str();
+    }
+
+    /**
+     * @brief LoadCache(): lines of "key <tab> strategy name".
+     */
+    static void LoadCache( const char *cache_file_name)
+    {
+        // code
+        std::ifstream cache_file( cache_file_name, std::ios::in);
+        if( !cache_file.is_open())
+        {
+            return;
+        }
+
+        std::string line;
+        while( std::getline( cache_file, line))
+        {
+            size_t tab = line.rfind( '\t');
+            if( tab == std::string::npos)
+            {
+                continue;
+            }
+
+            STRATEGY strategy;
+            if( StrategyFromName( line.substr( tab + 1).c_str(), &strategy))
+            {
+                strategy_cache[ line.substr( 0, tab)] = strategy;
+            }
+        }
+    }
+
+    /**
+     * @brief SaveCache()
+     */
+    static void SaveCache( const char *cache_file_name)
+    {
+        // code
+        std::ofstream cache_file( cache_file_name, std::ios::out | std::ios::trunc);
+        if( !cache_file.is_open())
+        {
+            std::cerr << "Failed to open file for writing: " << cache_file_name << std::endl;
+            return;
+        }
+
+        for( const std::pair<const std::string, STRATEGY> &entry : strategy_cache)
+        {
+            cache_file << entry.first << "\t" << strategy_names[entry.second] << "\n";
+        }
+    }
+
+    /**
+     * @brief ProbeStrategy(): best of PROBE_RUNS upload + kernel + download, 0 if the strategy is not available.
+     */
+    static double ProbeStrategy( cl_context ocl_context, cl_command_queue ocl_command_queue, cl_kernel ocl_kernel, size_t num_elements, size_t element_size, STRATEGY strategy)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        double best_seconds = 0.0;
+
+        // code
+        Buffer buffer = CreateBuffer( ocl_context, strategy, num_elements * element_size, &ocl_err);
+        if( buffer == nullptr)
+        {
+            return 0.0;
+        }
+
+        memset( buffer->host, 0, buffer->size);
+
+        ocl_err = clSetKernelArg( ocl_kernel, 0, sizeof( cl_mem), &buffer->ocl_buffer);
+
+            // run 0 is the warm-up
+        for( int run = 0; (run <= PROBE_RUNS) && (ocl_err == CL_SUCCESS); ++run)
+        {
+            std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+            ocl_err = Upload( buffer, ocl_command_queue);
+            ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, ocl_kernel, 1, nullptr, &num_elements, nullptr, 0, nullptr, nullptr);
+            ocl_err |= Download( buffer, ocl_command_queue);
+
+            std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+
+            if( (run > 0) && ((best_seconds == 0.0) || (elapsed_seconds.count() < best_seconds)))
+            {
+                best_seconds = elapsed_seconds.count();
+            }
+        }
+
+        clFinish( ocl_command_queue);
+        DeleteBuffer( buffer);
+
+        return ( ocl_err == CL_SUCCESS) ? best_seconds : 0.0;
+    }
+
+    /**
+     * @brief Select()
+     */
+    STRATEGY Select(
+        cl_context ocl_context,
+        cl_command_queue ocl_command_queue,
+        cl_kernel ocl_kernel,
+        size_t num_elements,
+        size_t element_size,
+        const char *cache_file_name,
+        double *probe_seconds
+    )
+    {
+        // variable declaration
+        std::string key = CacheKey( ocl_command_queue, num_elements * element_size);
+
+        STRATEGY best_strategy = STRATEGY_COPY;
+        double best_seconds = 0.0;
+
+        // code
+        if( probe_seconds)
+        {
+            for( int s = 0; s < STRATEGY_COUNT; ++s)
+            {
+                probe_seconds[s] = 0.0;
+            }
+        }
+
+        if( cache_file_name && (strategy_cache.find( key) == strategy_cache.end()))
+        {
+            LoadCache( cache_file_name);
+        }
+
+        std::map<std::string, STRATEGY>::const_iterator cached = strategy_cache.find( key);
+        if( cached != strategy_cache.end())
+        {
+            return cached->second;
+        }
+
+        for( int s = 0; s < STRATEGY_COUNT; ++s)
+        {
+            double seconds = ProbeStrategy( ocl_context, ocl_command_queue, ocl_kernel, num_elements, element_size, (STRATEGY)s);
+
+            if( probe_seconds)
+            {
+                probe_seconds[s] = seconds;
+            }
+
+            if( (seconds > 0.0) && ((best_seconds == 0.0) || (seconds < best_seconds)))
+            {
+                best_strategy = (STRATEGY)s;
+                best_seconds = seconds;
+            }
+        }
+
+        strategy_cache[key] = best_strategy;
+
+        if( cache_file_name)
+        {
+            SaveCache( cache_file_name);
+        }
+
+        return best_strategy;
+    }
+
+} // namespace Transfer
@@ -0,0 +1,63 @@
+#include <CL/cl.h>
+
+/**
+ * Host <-> device transfers of one buffer, with the strategy picked per device by timing them.
+ *
+ * Every Buffer owns a page aligned host array ( HostPointer()), the application fills it before Upload() and
+ * reads it after Download(). How the data gets to the device depends on the strategy:
+ *
+ *  - STRATEGY_COPY           : device buffer, clEnqueueWriteBuffer() / clEnqueueReadBuffer()
+ *  - STRATEGY_MAP            : device buffer, clEnqueueMapBuffer() and memcpy() from / to the host array
+ *  - STRATEGY_ALLOC_HOST_PTR : CL_MEM_ALLOC_HOST_PTR buffer ( pinned host memory on most GPUs), map and memcpy()
+ *  - STRATEGY_USE_HOST_PTR   : CL_MEM_USE_HOST_PTR buffer on the host array itself, map / unmap only.
+ *                              On a CPU or unified-memory device the kernel works on the host array, nothing is copied
+ *
+ * Select() times upload + kernel + download for every strategy on the device of a queue, and caches the fastest
+ * one per device, driver version and size class, in memory and optionally in a file so the next run skips the probe.
+ */
+namespace Transfer
+{
+    enum STRATEGY
+    {
+        STRATEGY_COPY = 0,
+        STRATEGY_MAP,
+        STRATEGY_ALLOC_HOST_PTR,
+        STRATEGY_USE_HOST_PTR,
+
+        STRATEGY_COUNT
+    };
+
+    typedef struct _Buffer* Buffer;
+
+    const char* StrategyName( STRATEGY strategy);
+
+        // false if name is not one of the StrategyName()s
+    bool StrategyFromName( const char *name, STRATEGY *strategy);
+
+        // ocl_kernel( buffer, ...) is the workload, argument 0 is set to the probe buffer, the others must be set.
+        // probe_seconds ( STRATEGY_COUNT values) receives the best time of every strategy, 0 for cached or failed ones
+    STRATEGY Select(
+        cl_context ocl_context,
+        cl_command_queue ocl_command_queue,
+        cl_kernel ocl_kernel,
+        size_t num_elements,
+        size_t element_size,
+        const char *cache_file_name = nullptr,
+        double *probe_seconds = nullptr
+    );
+
+    Buffer CreateBuffer( cl_context ocl_context, STRATEGY strategy, size_t size, cl_int *ocl_err);
+
+    void* HostPointer( Buffer buffer);
+    cl_mem Memory( Buffer buffer);
+    STRATEGY Strategy( Buffer buffer);
+
+        // host array -> device, enqueued on ocl_command_queue ( the host array may be reused once it returns)
+    cl_int Upload( Buffer buffer, cl_command_queue ocl_command_queue);
+
+        // device -> host array, blocking
+    cl_int Download( Buffer buffer, cl_command_queue ocl_command_queue);
+
+    void DeleteBuffer( Buffer buffer);
+
+} // namespace Transfer
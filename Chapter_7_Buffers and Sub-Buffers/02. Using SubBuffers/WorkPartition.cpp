@@ -0,0 +1,543 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <algorithm>
+
+#include "WorkPartition.h"
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+namespace WorkPartition
+{
+        // chunks per device of an equal share, more chunks balance better but cost more launches
+    const size_t CHUNKS_PER_DEVICE = 16;
+
+        // timed probe runs per device, the fastest one is kept
+    const int PROBE_RUNS = 3;
+
+    //////////////////////////////////////////////
+    ///////// TYPE DEFINITION
+    //////////////////////////////////////////////
+    struct _Scheduler
+    {
+        cl_context ocl_context = nullptr;
+
+        std::vector<cl_device_id> ocl_devices;
+        std::vector<cl_command_queue> ocl_queues;
+        std::vector<cl_kernel> ocl_kernels;        // one per device, kernel arguments are not thread safe
+
+        std::vector<cl_mem> ocl_chunks;             // sub-buffers of the buffer
+        std::vector<size_t> chunk_first;            // first element of every chunk
+        std::vector<size_t> chunk_elements;
+        size_t element_size = 0;
+
+        std::vector<DeviceStats> stats;
+
+            // shares of the current Run(), device d executes chunks [ next[d], end[d])
+        std::mutex share_mutex;
+        std::vector<size_t> next;
+        std::vector<size_t> end;
+        bool allow_stealing = false;
+
+        ~_Scheduler()
+        {
+            for( size_t i = 0; i < ocl_chunks.size(); ++i)
+            {
+                RELEASE_CL_OBJECT( ocl_chunks[i], clReleaseMemObject);
+            }
+
+            for( size_t i = 0; i < ocl_kernels.size(); ++i)
+            {
+                RELEASE_CL_OBJECT( ocl_kernels[i], clReleaseKernel);
+            }
+        }
+    };
+
+    //////////////////////////////////////////////
+    ////// FUNCTION DEFINITION
+    //////////////////////////////////////////////
+
+    /**
+     * @brief CreateScheduler(): kernels and chunk sub-buffers.
+     */
+    Scheduler CreateScheduler(
+        cl_context ocl_context,
+        cl_program ocl_program,
+        const char *kernel_name,
+        const std::vector<cl_command_queue> &ocl_queues,
+        cl_mem buffer,
+        size_t num_elements,
+        size_t element_size
+    )
+    {
+        // variable declaration
+        cl_int ocl_err;
+        Scheduler scheduler = nullptr;
+
+        cl_uint max_align_bits = 8;
+
+        // code
+        if( ocl_queues.empty() || (num_elements == 0))
+        {
+            return nullptr;
+        }
+
+        scheduler = new _Scheduler();
+        scheduler->ocl_context = ocl_context;
+        scheduler->ocl_queues = ocl_queues;
+        scheduler->element_size = element_size;
+        scheduler->stats.resize( ocl_queues.size());
+
+        for( size_t i = 0; i < ocl_queues.size(); ++i)
+        {
+            cl_device_id ocl_device = nullptr;
+            clGetCommandQueueInfo( ocl_queues[i], CL_QUEUE_DEVICE, sizeof( cl_device_id), &ocl_device, nullptr);
+            scheduler->ocl_devices.push_back( ocl_device);
+
+                // sub-buffer origins must be aligned for every device that may use them
+            cl_uint align_bits = 0;
+            clGetDeviceInfo( ocl_device, CL_DEVICE_MEM_BASE_ADDR_ALIGN, sizeof( cl_uint), &align_bits, nullptr);
+            max_align_bits = std::max( max_align_bits, align_bits);
+
+            cl_kernel ocl_kernel = clCreateKernel( ocl_program, kernel_name, &ocl_err);
+            if( !ocl_kernel || ocl_err)
+            {
+                std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+                delete scheduler;
+                return nullptr;
+            }
+
+            scheduler->ocl_kernels.push_back( ocl_kernel);
+        }
+
+            // chunk size, a multiple of the alignment
+        size_t align_elements = std::max( (size_t)1, ( max_align_bits / 8) / element_size);
+
+        size_t chunk_size = num_elements / ( ocl_queues.size() * CHUNKS_PER_DEVICE);
+        chunk_size = std::max( align_elements, ( chunk_size + align_elements - 1) / align_elements * align_elements);
+
+        for( size_t first = 0; first < num_elements; first += chunk_size)
+        {
+            size_t count = std::min( chunk_size, num_elements - first);
+
+            cl_buffer_region region =
+            {
+                first * element_size,
+                count * element_size
+            };
+
+            cl_mem ocl_chunk = clCreateSubBuffer( buffer, CL_MEM_READ_WRITE, CL_BUFFER_CREATE_TYPE_REGION, &region, &ocl_err);
+            if( !ocl_chunk || ocl_err)
+            {
+                std::cerr << "clCreateSubBuffer() Failed." << ocl_err << "\n";
+                delete scheduler;
+                return nullptr;
+            }
+
+            scheduler->ocl_chunks.push_back( ocl_chunk);
+            scheduler->chunk_first.push_back( first);
+            scheduler->chunk_elements.push_back( count);
+        }
+
+        return scheduler;
+    }
+
+    /**
+     * @brief Calibrate(): best of PROBE_RUNS timed runs on every device, one device at a time so they do
+     *        not compete for the host or the bus.
+     *        Every device gets its own scratch buffer, first touched by its warm-up run, so a sub-device of a
+     *        NUMA node is not timed on memory of another node.
+     */
+    cl_int Calibrate( Scheduler scheduler, size_t probe_elements)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        if( probe_elements == 0)
+        {
+            return CL_INVALID_VALUE;
+        }
+
+        for( size_t d = 0; d < scheduler->ocl_queues.size(); ++d)
+        {
+            cl_command_queue ocl_queue = scheduler->ocl_queues[d];
+            cl_kernel ocl_kernel = scheduler->ocl_kernels[d];
+
+                // scratch buffer, the kernel only needs something of the right size
+            cl_mem ocl_probe = clCreateBuffer( scheduler->ocl_context, CL_MEM_READ_WRITE, probe_elements * scheduler->element_size, nullptr, &ocl_err);
+            if( !ocl_probe || ocl_err)
+            {
+                return ocl_err;
+            }
+
+            ocl_err = clSetKernelArg( ocl_kernel, 0, sizeof( cl_mem), &ocl_probe);
+            if( ocl_err != CL_SUCCESS)
+            {
+                clReleaseMemObject( ocl_probe);
+                return ocl_err;
+            }
+
+            double best_seconds = 0.0;
+
+                // run 0 is the warm-up ( buffer migration, first launch)
+            for( int run = 0; run <= PROBE_RUNS; ++run)
+            {
+                std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+                ocl_err = clEnqueueNDRangeKernel( ocl_queue, ocl_kernel, 1, nullptr, &probe_elements, nullptr, 0, nullptr, nullptr);
+                ocl_err |= clFinish( ocl_queue);
+                if( ocl_err != CL_SUCCESS)
+                {
+                    clReleaseMemObject( ocl_probe);
+                    return ocl_err;
+                }
+
+                std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+
+                if( (run > 0) && ((best_seconds == 0.0) || (elapsed_seconds.count() < best_seconds)))
+                {
+                    best_seconds = elapsed_seconds.count();
+                }
+            }
+
+                // a probe too short for the clock counts as very fast
+            scheduler->stats[d].probe_throughput = (double)probe_elements / std::max( best_seconds, 1.0e-9);
+
+            clReleaseMemObject( ocl_probe);
+        }
+
+        return CL_SUCCESS;
+    }
+
+    /**
+     * @brief AssignShares(): contiguous runs of chunks, sized by largest remainder so they add up exactly.
+     */
+    static void AssignShares( Scheduler scheduler, POLICY policy)
+    {
+        // variable declaration
+        size_t num_devices = scheduler->ocl_queues.size();
+        size_t num_chunks = scheduler->ocl_chunks.size();
+
+        std::vector<double> weights( num_devices, 1.0);
+        std::vector<size_t> shares( num_devices, 0);
+        std::vector<double> remainders( num_devices, 0.0);
+
+        // code
+        if( policy != POLICY_EQUAL)
+        {
+            for( size_t d = 0; d < num_devices; ++d)
+            {
+                    // not calibrated: equal weights
+                if( scheduler->stats[d].probe_throughput > 0.0)
+                {
+                    weights[d] = scheduler->stats[d].probe_throughput;
+                }
+            }
+        }
+
+        double total_weight = 0.0;
+        for( size_t d = 0; d < num_devices; ++d)
+        {
+            total_weight += weights[d];
+        }
+
+        size_t assigned = 0;
+        for( size_t d = 0; d < num_devices; ++d)
+        {
+            double exact = (double)num_chunks * weights[d] / total_weight;
+
+            shares[d] = (size_t)exact;
+            remainders[d] = exact - (double)shares[d];
+            assigned += shares[d];
+        }
+
+        while( assigned < num_chunks)
+        {
+            size_t d = std::max_element( remainders.begin(), remainders.end()) - remainders.begin();
+
+            ++shares[d];
+            remainders[d] = -1.0;
+            ++assigned;
+        }
+
+        scheduler->next.assign( num_devices, 0);
+        scheduler->end.assign( num_devices, 0);
+
+        size_t first = 0;
+        for( size_t d = 0; d < num_devices; ++d)
+        {
+            scheduler->next[d] = first;
+            scheduler->end[d] = first + shares[d];
+            first += shares[d];
+
+            scheduler->stats[d].share_chunks = shares[d];
+        }
+    }
+
+    /**
+     * @brief Upload(): write every share through the queue of its device.
+     *        The writes of all devices are enqueued first and run concurrently, then all queues are finished.
+     */
+    cl_int Upload( Scheduler scheduler, POLICY policy, const void *host_data)
+    {
+        // variable declaration
+        cl_int ocl_err = CL_SUCCESS;
+        size_t num_devices = scheduler->ocl_queues.size();
+
+        const char *host_bytes = static_cast<const char *>( host_data);
+
+        // code
+        AssignShares( scheduler, policy);
+
+        for( size_t d = 0; (d < num_devices) && (ocl_err == CL_SUCCESS); ++d)
+        {
+            for( size_t c = scheduler->next[d]; c < scheduler->end[d]; ++c)
+            {
+                ocl_err = clEnqueueWriteBuffer(
+                    scheduler->ocl_queues[d],
+                    scheduler->ocl_chunks[c],
+                    CL_FALSE,
+                    0,
+                    scheduler->chunk_elements[c] * scheduler->element_size,
+                    host_bytes + scheduler->chunk_first[c] * scheduler->element_size,
+                    0, nullptr, nullptr
+                );
+                if( ocl_err != CL_SUCCESS)
+                {
+                    break;
+                }
+            }
+
+            clFlush( scheduler->ocl_queues[d]);
+        }
+
+            // the host data must stay valid until every write has finished, even after an error
+        for( size_t d = 0; d < num_devices; ++d)
+        {
+            cl_int finish_err = clFinish( scheduler->ocl_queues[d]);
+            if( ocl_err == CL_SUCCESS)
+            {
+                ocl_err = finish_err;
+            }
+        }
+
+        return ocl_err;
+    }
+
+    /**
+     * @brief TakeChunk(): next chunk of the device's own share, or the last chunk of the largest remaining share.
+     *
+     * @return false when there is nothing left for this device
+     */
+    static bool TakeChunk( Scheduler scheduler, size_t device, size_t *chunk, bool *stolen)
+    {
+        // code
+        std::lock_guard<std::mutex> lock( scheduler->share_mutex);
+
+        if( scheduler->next[device] < scheduler->end[device])
+        {
+            *chunk = scheduler->next[device]++;
+            *stolen = false;
+            return true;
+        }
+
+        if( !scheduler->allow_stealing)
+        {
+            return false;
+        }
+
+        size_t victim = device;
+        size_t victim_remaining = 0;
+
+        for( size_t d = 0; d < scheduler->next.size(); ++d)
+        {
+            size_t remaining = scheduler->end[d] - scheduler->next[d];
+            if( remaining > victim_remaining)
+            {
+                victim = d;
+                victim_remaining = remaining;
+            }
+        }
+
+        if( victim_remaining == 0)
+        {
+            return false;
+        }
+
+            // the victim works from the front, so taking from the back never races with it
+        *chunk = --scheduler->end[victim];
+        *stolen = true;
+        return true;
+    }
+
+    /**
+     * @brief RunDevice(): host thread of one device, keeps up to two chunks in flight.
+     */
+    static void RunDevice( Scheduler scheduler, size_t device, cl_int *result)
+    {
+        // variable declaration
+        cl_int ocl_err = CL_SUCCESS;
+
+        cl_command_queue ocl_queue = scheduler->ocl_queues[device];
+        cl_kernel ocl_kernel = scheduler->ocl_kernels[device];
+        DeviceStats &stats = scheduler->stats[device];
+
+        cl_event ocl_in_flight[2] = { nullptr, nullptr};
+        int slot = 0;
+
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        // code
+        while( ocl_err == CL_SUCCESS)
+        {
+                // wait for the older of the two launches before taking more work
+            if( ocl_in_flight[slot])
+            {
+                ocl_err = clWaitForEvents( 1, &ocl_in_flight[slot]);
+                RELEASE_CL_OBJECT( ocl_in_flight[slot], clReleaseEvent);
+                if( ocl_err != CL_SUCCESS)
+                {
+                    break;
+                }
+            }
+
+            size_t chunk;
+            bool stolen;
+            if( !TakeChunk( scheduler, device, &chunk, &stolen))
+            {
+                break;
+            }
+
+            size_t global_work_size = scheduler->chunk_elements[chunk];
+
+            ocl_err = clSetKernelArg( ocl_kernel, 0, sizeof( cl_mem), &scheduler->ocl_chunks[chunk]);
+            ocl_err |= clEnqueueNDRangeKernel( ocl_queue, ocl_kernel, 1, nullptr, &global_work_size, nullptr, 0, nullptr, &ocl_in_flight[slot]);
+            if( ocl_err != CL_SUCCESS)
+            {
+                break;
+            }
+
+            clFlush( ocl_queue);
+
+            ++stats.executed_chunks;
+            if( stolen)
+            {
+                ++stats.stolen_chunks;
+            }
+
+            slot ^= 1;
+        }
+
+        cl_int finish_err = clFinish( ocl_queue);
+
+        RELEASE_CL_OBJECT( ocl_in_flight[0], clReleaseEvent);
+        RELEASE_CL_OBJECT( ocl_in_flight[1], clReleaseEvent);
+
+        std::chrono::duration<double> elapsed_seconds = std::chrono::steady_clock::now() - start;
+        stats.busy_seconds = elapsed_seconds.count();
+
+        *result = ( ocl_err != CL_SUCCESS) ? ocl_err : finish_err;
+    }
+
+    /**
+     * @brief Run()
+     */
+    cl_int Run( Scheduler scheduler, POLICY policy)
+    {
+        // variable declaration
+        size_t num_devices = scheduler->ocl_queues.size();
+
+        std::vector<std::thread> threads;
+        std::vector<cl_int> results( num_devices, CL_SUCCESS);
+
+        // code
+        AssignShares( scheduler, policy);
+        scheduler->allow_stealing = ( policy == POLICY_ADAPTIVE);
+
+        for( size_t d = 0; d < num_devices; ++d)
+        {
+            scheduler->stats[d].executed_chunks = 0;
+            scheduler->stats[d].stolen_chunks = 0;
+            scheduler->stats[d].busy_seconds = 0.0;
+        }
+
+        for( size_t d = 0; d < num_devices; ++d)
+        {
+            threads.emplace_back( RunDevice, scheduler, d, &results[d]);
+        }
+
+        for( std::thread &thread : threads)
+        {
+            thread.join();
+        }
+
+        for( size_t d = 0; d < num_devices; ++d)
+        {
+            if( results[d] != CL_SUCCESS)
+            {
+                return results[d];
+            }
+        }
+
+        return CL_SUCCESS;
+    }
+
+    /**
+     * @brief NumDevices()
+     */
+    int NumDevices( Scheduler scheduler)
+    {
+        // code
+        return (int)scheduler->ocl_queues.size();
+    }
+
+    /**
+     * @brief NumChunks()
+     */
+    size_t NumChunks( Scheduler scheduler)
+    {
+        // code
+        return scheduler->ocl_chunks.size();
+    }
+
+    /**
+     * @brief Device()
+     */
+    cl_device_id Device( Scheduler scheduler, int index)
+    {
+        // code
+        return scheduler->ocl_devices[index];
+    }
+
+    /**
+     * @brief Stats()
+     */
+    const DeviceStats& Stats( Scheduler scheduler, int index)
+    {
+        // code
+        return scheduler->stats[index];
+    }
+
+    /**
+     * @brief DeleteScheduler()
+     */
+    void DeleteScheduler( Scheduler scheduler)
+    {
+        // code
+        delete scheduler;
+    }
+
+} // namespace WorkPartition
@@ -0,0 +1,67 @@
+#include <vector>
+
+#include <CL/cl.h>
+
+/**
+ * Splits one buffer over several devices of a context and runs a one-argument kernel ( kernel( __global T *buffer),
+ * one work-item per element) over all of it.
+ *
+ *  - The buffer is cut into chunks, every chunk is a sub-buffer aligned to CL_DEVICE_MEM_BASE_ADDR_ALIGN.
+ *  - Calibrate() times a short probe run of the kernel on every device.
+ *  - Run() gives every device a contiguous share of the chunks ( equal, or proportional to the probe throughput).
+ *    With POLICY_ADAPTIVE a device that has finished its share steals chunks from the end of the largest
+ *    remaining share, so a device that falls behind is helped by the others.
+ *
+ * Every device is driven by its own host thread, with up to two chunks in flight on its queue.
+ *
+ * Upload() writes each share through the queue of the device that will run it, so on a CPU split into NUMA
+ * sub-devices the pages of a share are first touched ( and placed) by the node that works on them.
+ */
+namespace WorkPartition
+{
+    enum POLICY
+    {
+        POLICY_EQUAL = 0,       // same share for every device, no stealing
+        POLICY_PROPORTIONAL,    // share proportional to the probe throughput, no stealing
+        POLICY_ADAPTIVE         // proportional share plus work stealing
+    };
+
+    struct DeviceStats
+    {
+        double probe_throughput = 0.0;      // elements per second, 0 before Calibrate()
+        size_t share_chunks = 0;            // chunks assigned by the last Run()
+        size_t executed_chunks = 0;         // chunks executed by the last Run(), stolen ones included
+        size_t stolen_chunks = 0;
+        double busy_seconds = 0.0;          // until the device ran out of chunks
+    };
+
+    typedef struct _Scheduler* Scheduler;
+
+        // one entry per device, queues must belong to ocl_context and ocl_program must be built for their devices
+    Scheduler CreateScheduler(
+        cl_context ocl_context,
+        cl_program ocl_program,
+        const char *kernel_name,
+        const std::vector<cl_command_queue> &ocl_queues,
+        cl_mem buffer,
+        size_t num_elements,
+        size_t element_size
+    );
+
+        // probe_elements work-items per device on a scratch buffer, the data of buffer is not touched
+    cl_int Calibrate( Scheduler scheduler, size_t probe_elements);
+
+        // host_data holds num_elements elements, shares are assigned as by Run( scheduler, policy)
+    cl_int Upload( Scheduler scheduler, POLICY policy, const void *host_data);
+
+        // blocks until every chunk has been executed and all queues are finished
+    cl_int Run( Scheduler scheduler, POLICY policy);
+
+    int NumDevices( Scheduler scheduler);
+    size_t NumChunks( Scheduler scheduler);
+    cl_device_id Device( Scheduler scheduler, int index);
+    const DeviceStats& Stats( Scheduler scheduler, int index);
+
+    void DeleteScheduler( Scheduler scheduler);
+
+} // namespace WorkPartition
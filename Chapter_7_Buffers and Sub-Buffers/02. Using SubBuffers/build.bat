@@ -1,5 +1,5 @@
-CL.exe /EHsc /c /I"%CUDA_PATH%\include" Source.cpp
+CL.exe /EHsc /c /I"%CUDA_PATH%\include" Source.cpp WorkPartition.cpp Transfer.cpp
 
-LINK.exe /OUT:Source.exe /LIBPATH:"%CUDA_PATH%\lib\x64" opencl.lib Source.obj
+LINK.exe /OUT:Source.exe /LIBPATH:"%CUDA_PATH%\lib\x64" opencl.lib Source.obj WorkPartition.obj Transfer.obj
 
-DEL Source.obj
+DEL Source.obj WorkPartition.obj Transfer.obj
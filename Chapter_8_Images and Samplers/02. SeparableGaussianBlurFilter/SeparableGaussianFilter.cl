@@ -0,0 +1,128 @@
+/************************
+ *
+ * Separable Gaussian blur
+ *
+ *      G( x, y) = G( x) * G( y), so the 2D blur of radius r is done as a horizontal pass followed by
+ * a vertical pass, 2 * ( 2r + 1) taps per pixel instead of ( 2r + 1)^2.
+ *
+ *      The 2r + 1 normalized weights are computed once on the host from sigma and passed in __constant memory.
+ *
+ *      Every work-group caches the pixels it needs ( its own pixels plus r pixels of apron on each side along
+ * the filter direction) in local memory. The cache is a __local kernel argument sized by the host:
+ *      ( FILTER_GROUP_SIZE + 2 * radius) * CROSS_GROUP_SIZE * sizeof( float4)
+ *
+ *      gaussian_blur_horizontal() work-group size: ( FILTER_GROUP_SIZE, CROSS_GROUP_SIZE)
+ *      gaussian_blur_vertical()   work-group size: ( CROSS_GROUP_SIZE, FILTER_GROUP_SIZE)
+ */
+
+#ifndef FILTER_GROUP_SIZE
+    #define FILTER_GROUP_SIZE   64
+#endif
+
+#ifndef CROSS_GROUP_SIZE
+    #define CROSS_GROUP_SIZE    4
+#endif
+
+const sampler_t sampler_ = CLK_NORMALIZED_COORDS_FALSE | CLK_ADDRESS_CLAMP_TO_EDGE | CLK_FILTER_NEAREST;
+
+/**
+ * @brief gaussian_blur_horizontal(): horizontal pass, each row of the work-group is cached in local memory.
+ */
+__kernel void gaussian_blur_horizontal(
+    __read_only image2d_t src_img,
+    __write_only image2d_t dst_img,
+    __constant float *weights,
+    int radius,
+    __local float4 *cache
+)
+{
+    // variable declaration
+    int width = get_image_width( src_img);
+    int height = get_image_height( src_img);
+
+    int lx = (int)get_local_id(0);
+    int ly = (int)get_local_id(1);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    int x0 = (int)get_group_id(0) * FILTER_GROUP_SIZE - radius;
+    int cache_width = FILTER_GROUP_SIZE + 2 * radius;
+
+    __local float4 *row = cache + ly * cache_width;
+
+    // code
+        // the sampler clamps the apron at the image border
+    for( int i = lx; i < cache_width; i += FILTER_GROUP_SIZE)
+    {
+        row[i] = read_imagef( src_img, sampler_, (int2)( x0 + i, y));
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    if( (x >= width) || (y >= height))
+    {
+        return;
+    }
+
+    float4 sum = (float4)( 0.0f);
+    row += lx;
+
+    for( int k = 0; k <= 2 * radius; ++k)
+    {
+        sum += weights[k] * row[k];
+    }
+
+    write_imagef( dst_img, (int2)( x, y), sum);
+}
+
+/**
+ * @brief gaussian_blur_vertical(): vertical pass, each column of the work-group is cached in local memory.
+ */
+__kernel void gaussian_blur_vertical(
+    __read_only image2d_t src_img,
+    __write_only image2d_t dst_img,
+    __constant float *weights,
+    int radius,
+    __local float4 *cache
+)
+{
+    // variable declaration
+    int width = get_image_width( src_img);
+    int height = get_image_height( src_img);
+
+    int lx = (int)get_local_id(0);
+    int ly = (int)get_local_id(1);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    int y0 = (int)get_group_id(1) * FILTER_GROUP_SIZE - radius;
+    int cache_height = FILTER_GROUP_SIZE + 2 * radius;
+
+    __local float4 *column = cache + lx * cache_height;
+
+    // code
+        // the sampler clamps the apron at the image border
+    for( int i = ly; i < cache_height; i += FILTER_GROUP_SIZE)
+    {
+        column[i] = read_imagef( src_img, sampler_, (int2)( x, y0 + i));
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    if( (x >= width) || (y >= height))
+    {
+        return;
+    }
+
+    float4 sum = (float4)( 0.0f);
+    column += ly;
+
+    for( int k = 0; k <= 2 * radius; ++k)
+    {
+        sum += weights[k] * column[k];
+    }
+
+    write_imagef( dst_img, (int2)( x, y), sum);
+}
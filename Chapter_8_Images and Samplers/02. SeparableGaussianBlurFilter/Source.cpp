@@ -0,0 +1,428 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * Separable Gaussian blur of arbitrary radius.
+ *
+ *  - radius = ceil( 3 * sigma), the 2 * radius + 1 weights
+ *          w[k] = exp( -( k - radius)^2 / ( 2 * sigma^2))
+ *    are normalized on the host and uploaded once into a constant buffer.
+ *  - pass 1 blurs rows ( src -> tmp), pass 2 blurs columns ( tmp -> dst).
+ *    tmp is a float image so the intermediate result is not quantized to 8-bit.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include <cmath>
+
+#include "OpenCLUtil.h"
+
+#include "../../Common/FreeImage/x64/FreeImage.h"
+
+#define DEFAULT_PLATFORM 0
+#define DEFAULT_SIGMA 5.0f
+
+#define To_String(x) #x
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+    // must match the defaults in SeparableGaussianFilter.cl
+const int FILTER_GROUP_SIZE = 64;
+const int CROSS_GROUP_SIZE = 4;
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_command_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+cl_program ocl_program = nullptr;
+
+cl_kernel gaussian_blur_horizontal = nullptr;
+cl_kernel gaussian_blur_vertical = nullptr;
+
+cl_mem ocl_weights = nullptr;
+cl_mem ocl_image_src = nullptr;
+cl_mem ocl_image_tmp = nullptr;
+cl_mem ocl_image_dst = nullptr;
+
+uint8_t *image_bits = nullptr;
+uint8_t *output_image_bits = nullptr;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool SaveImage( const char *out_file_name, uint8_t *image_data, int image_width, int image_height);
+    uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height);
+    std::vector<float> GaussianWeights( float sigma);
+    size_t RoundUp( int group_size, int global_size);
+    void  cleanup();
+
+    // variable declaration
+    int image_width = 0;
+    int image_height = 0;
+
+    int platform_used = DEFAULT_PLATFORM;
+    float sigma = DEFAULT_SIGMA;
+    int num_iterations = 1;
+
+    std::string input_file_name;
+    std::string output_file_name = "out.png";
+
+    cl_int ocl_err;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--i") && (i + 1 < argc))
+        {
+            input_file_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--o") && (i + 1 < argc))
+        {
+            output_file_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--platform") && (i + 1 < argc))
+        {
+            platform_used = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--sigma") && (i + 1 < argc))
+        {
+            sigma = (float)atof( argv[++i]);
+        }
+        else if( !input.compare( "--iterations") && (i + 1 < argc))
+        {
+            num_iterations = std::max( 1, atoi( argv[++i]));
+        }
+    }
+
+    if( input_file_name.empty() || !(sigma > 0.0f))
+    {
+        std::cerr << "usage: " << argv[0] << " --i input_file_name\n";
+        std::cerr << "options: " << "\n"
+                  << "   --o output_file_name (default out.png)\n"
+                  << "   --platform n\n"
+                  << "   --sigma s: standard deviation in pixels, radius is ceil( 3 * s) (default " << DEFAULT_SIGMA << ")\n"
+                  << "   --iterations n: number of timed runs (default 1)"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( platform_used);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_command_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_command_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_program = CreateProgram( ocl_context, ocl_device, "SeparableGaussianFilter.cl");
+    if( ocl_program == nullptr)
+    {
+        std::cerr << "CreateProgram() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    gaussian_blur_horizontal = clCreateKernel( ocl_program, "gaussian_blur_horizontal", &ocl_err);
+    if( !gaussian_blur_horizontal || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    gaussian_blur_vertical = clCreateKernel( ocl_program, "gaussian_blur_vertical", &ocl_err);
+    if( !gaussian_blur_vertical || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** Filter Weights ***********/
+    std::vector<float> weights = GaussianWeights( sigma);
+    int radius = (int)weights.size() / 2;
+
+    size_t local_cache_size = (size_t)( FILTER_GROUP_SIZE + 2 * radius) * CROSS_GROUP_SIZE * sizeof( cl_float4);
+
+    cl_ulong device_local_mem_size = 0;
+    cl_ulong device_constant_buffer_size = 0;
+    clGetDeviceInfo( ocl_device, CL_DEVICE_LOCAL_MEM_SIZE, sizeof( cl_ulong), &device_local_mem_size, nullptr);
+    clGetDeviceInfo( ocl_device, CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE, sizeof( cl_ulong), &device_constant_buffer_size, nullptr);
+
+    if( (local_cache_size > device_local_mem_size) || (weights.size() * sizeof( float) > device_constant_buffer_size))
+    {
+        std::cerr << "sigma " << sigma << " ( radius " << radius << ") is too large for this device.\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_weights = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, weights.size() * sizeof( float), weights.data(), &ocl_err);
+    if( !ocl_weights || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** IMAGE LOADING ***********/
+    image_bits = LoadImage( input_file_name.c_str(), &image_width, &image_height);
+    if( image_bits == nullptr)
+    {
+        std::cerr << "Cannot open image \"" << input_file_name << "\"" << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cl_image_format ocl_image_format = { };
+    ocl_image_format.image_channel_order = CL_RGBA;
+    ocl_image_format.image_channel_data_type = CL_UNORM_INT8;
+
+    cl_image_desc ocl_image_desc = { };
+    ocl_image_desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    ocl_image_desc.image_width = image_width;
+    ocl_image_desc.image_height = image_height;
+    ocl_image_desc.image_row_pitch = image_width * 4;
+    ocl_image_desc.mem_object = nullptr;
+
+    ocl_image_src = clCreateImage( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, &ocl_image_format, &ocl_image_desc, image_bits, &ocl_err);
+    if( !ocl_image_src || ocl_err)
+    {
+        std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_image_desc.image_row_pitch = 0;
+    ocl_image_dst = clCreateImage( ocl_context, CL_MEM_WRITE_ONLY, &ocl_image_format, &ocl_image_desc, nullptr, &ocl_err);
+    if( !ocl_image_dst || ocl_err)
+    {
+        std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        // intermediate result of the horizontal pass
+    ocl_image_format.image_channel_data_type = CL_FLOAT;
+    ocl_image_tmp = clCreateImage( ocl_context, CL_MEM_READ_WRITE, &ocl_image_format, &ocl_image_desc, nullptr, &ocl_err);
+    if( !ocl_image_tmp || ocl_err)
+    {
+        std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_err = clSetKernelArg( gaussian_blur_horizontal, 0, sizeof( cl_mem), &ocl_image_src);
+    ocl_err |= clSetKernelArg( gaussian_blur_horizontal, 1, sizeof( cl_mem), &ocl_image_tmp);
+    ocl_err |= clSetKernelArg( gaussian_blur_horizontal, 2, sizeof( cl_mem), &ocl_weights);
+    ocl_err |= clSetKernelArg( gaussian_blur_horizontal, 3, sizeof( int), &radius);
+    ocl_err |= clSetKernelArg( gaussian_blur_horizontal, 4, local_cache_size, nullptr);
+
+    ocl_err |= clSetKernelArg( gaussian_blur_vertical, 0, sizeof( cl_mem), &ocl_image_tmp);
+    ocl_err |= clSetKernelArg( gaussian_blur_vertical, 1, sizeof( cl_mem), &ocl_image_dst);
+    ocl_err |= clSetKernelArg( gaussian_blur_vertical, 2, sizeof( cl_mem), &ocl_weights);
+    ocl_err |= clSetKernelArg( gaussian_blur_vertical, 3, sizeof( int), &radius);
+    ocl_err |= clSetKernelArg( gaussian_blur_vertical, 4, local_cache_size, nullptr);
+
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clSetKernelArg() Failed.\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    size_t horizontal_local_work_size[2] = { FILTER_GROUP_SIZE, CROSS_GROUP_SIZE};
+    size_t horizontal_global_work_size[2] = { RoundUp( FILTER_GROUP_SIZE, image_width), RoundUp( CROSS_GROUP_SIZE, image_height)};
+
+    size_t vertical_local_work_size[2] = { CROSS_GROUP_SIZE, FILTER_GROUP_SIZE};
+    size_t vertical_global_work_size[2] = { RoundUp( CROSS_GROUP_SIZE, image_width), RoundUp( FILTER_GROUP_SIZE, image_height)};
+
+    std::cout << To_String( image_width) << " : " << image_width << "\n";
+    std::cout << To_String( image_height) << " : " << image_height << "\n";
+    std::cout << To_String( sigma) << " : " << sigma << "\n";
+    std::cout << To_String( radius) << " : " << radius << "\n\n";
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < num_iterations; ++i)
+    {
+        ocl_err = clEnqueueNDRangeKernel( ocl_command_queue, gaussian_blur_horizontal, 2, nullptr, horizontal_global_work_size, horizontal_local_work_size, 0, nullptr, nullptr);
+        ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, gaussian_blur_vertical, 2, nullptr, vertical_global_work_size, vertical_local_work_size, 0, nullptr, nullptr);
+        if( ocl_err != CL_SUCCESS)
+        {
+            std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    }
+    clFinish( ocl_command_queue);
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  elapsed_seconds = ( end - start) / num_iterations;
+    std::cout << "Time Required for Separable Gaussian Blur by OpenCL is: " << elapsed_seconds.count() << "s" << std::endl;
+
+        // read result
+    output_image_bits = new uint8_t[ (size_t)image_width * image_height * 4];
+
+    size_t origin[3] = { 0, 0, 0};
+    size_t region[3] = { (size_t)image_width, (size_t)image_height, 1};
+    size_t row_pitch = image_width * 4;
+
+    ocl_err = clEnqueueReadImage( ocl_command_queue, ocl_image_dst, CL_TRUE, origin, region, row_pitch, 0, output_image_bits, 0, nullptr, nullptr);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clEnqueueReadImage() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    if( !SaveImage( output_file_name.c_str(), output_image_bits, image_width, image_height))
+    {
+        std::cerr << "Error writing output image: " << output_file_name << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cleanup();
+
+    return 0;
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // code
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+    RELEASE_CL_OBJECT( ocl_command_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+    RELEASE_CL_OBJECT( gaussian_blur_horizontal, clReleaseKernel);
+    RELEASE_CL_OBJECT( gaussian_blur_vertical, clReleaseKernel);
+    RELEASE_CL_OBJECT( ocl_weights, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_src, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_tmp, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_dst, clReleaseMemObject);
+    RELEASE_CL_OBJECT( image_bits, delete[]);
+    RELEASE_CL_OBJECT( output_image_bits, delete[]);
+}
+
+/**
+ * @brief GaussianWeights() : normalized 1D Gaussian of radius ceil( 3 * sigma), 2 * radius + 1 weights.
+ */
+std::vector<float> GaussianWeights( float sigma)
+{
+    // variable declaration
+    int radius = (int)ceilf( 3.0f * sigma);
+    std::vector<float> weights( 2 * radius + 1);
+    float sum = 0.0f;
+
+    // code
+    for( int k = -radius; k <= radius; ++k)
+    {
+        weights[ k + radius] = expf( -(float)( k * k) / ( 2.0f * sigma * sigma));
+        sum += weights[ k + radius];
+    }
+
+    for( float &w : weights)
+    {
+        w /= sum;
+    }
+
+    return weights;
+}
+
+/**
+ * @brief RoundUp()
+ */
+size_t RoundUp( int group_size, int global_size)
+{
+    // code
+    int r = global_size % group_size;
+    if( r == 0)
+    {
+        return global_size;
+    }
+    else
+    {
+        return global_size + group_size - r;
+    }
+}
+
+/**
+ * @brief LoadImage() : Load Image and returns image width, image height and image data in 32-bit format. Delete image data when work is done.
+ */
+uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height)
+{
+    // code
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( file_name, 0);
+    FIBITMAP *image = FreeImage_Load( format, file_name);
+    if( image == nullptr)
+    {
+        *image_width = 0;
+        *image_height = 0;
+        return nullptr;
+    }
+
+        // convert to 32-bit image
+    FIBITMAP *temp = image;
+    image = FreeImage_ConvertTo32Bits( image);
+    FreeImage_Unload( temp);
+
+    *image_width = FreeImage_GetWidth( image);
+    *image_height = FreeImage_GetHeight( image);
+
+    uint8_t *image_bits = FreeImage_GetBits( image);
+
+    uint8_t *ret_image_bits = new uint8_t[ (*image_width) * (*image_height) * 4];
+    memcpy( ret_image_bits, image_bits, (*image_width) * (*image_height) * 4 * sizeof( uint8_t));
+
+    FreeImage_Unload( image);
+
+    return ret_image_bits;
+}
+
+/**
+ * @brief SaveImage()
+ */
+bool SaveImage( const char *out_file_name, uint8_t *image_bits, int image_width, int image_height)
+{
+    // save image
+    FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_file_name);
+    if( format == FREE_IMAGE_FORMAT::FIF_UNKNOWN)
+    {
+        return false;
+    }
+
+    int row_pitch = 4 * image_width;
+    FIBITMAP *image = FreeImage_ConvertFromRawBits( image_bits, image_width, image_height, row_pitch, 32, 0xFF000000, 0x00FF0000, 0x0000FF00);
+    bool b_saved = FreeImage_Save( format, image, out_file_name);
+    FreeImage_Unload( image);
+
+    return b_saved;
+}
@@ -0,0 +1,211 @@
+/************************
+ *
+ * Large-radius blur with a constant cost per pixel
+ *
+ * 1. Recursive Gaussian ( Young - van Vliet, 1995)
+ *
+ *      The Gaussian is approximated by a causal and an anti-causal 3rd order IIR filter,
+ *          forward  : w[n] = B * x[n] + b1 * w[n - 1] + b2 * w[n - 2] + b3 * w[n - 3]
+ *          backward : y[n] = B * w[n] + b1 * y[n + 1] + b2 * y[n + 2] + b3 * y[n + 3]
+ *      where B, b1, b2, b3 ( already divided by b0) are computed from sigma on the host and passed as
+ *      coefficients = ( B, b1, b2, b3).
+ *
+ *      One work-item filters one whole line, the forward result is kept in a scratch buffer laid out so that
+ *      neighbouring work-items touch neighbouring addresses. The line is extended by replicating its edge pixels,
+ *      the filter state is started at its steady state for that value.
+ *
+ * 2. Iterated box filter
+ *
+ *      A box of width 2r + 1 applied n times approaches a Gaussian ( central limit theorem).
+ *      Each pass keeps a running sum along the line: add the pixel entering the window, subtract the one leaving it.
+ *
+ * Rows are filtered first, then columns. The sampler clamps coordinates, so the edge pixels are replicated.
+ */
+
+const sampler_t sampler_ = CLK_NORMALIZED_COORDS_FALSE | CLK_ADDRESS_CLAMP_TO_EDGE | CLK_FILTER_NEAREST;
+
+/**
+ * @brief recursive_gaussian_rows(): one work-item per row.
+ *
+ * @param scratch width * height float4, element ( x, y) is stored at x * height + y
+ */
+__kernel void recursive_gaussian_rows(
+    __read_only image2d_t src_img,
+    __write_only image2d_t dst_img,
+    __global float4 *scratch,
+    float4 coefficients
+)
+{
+    // variable declaration
+    int width = get_image_width( src_img);
+    int height = get_image_height( src_img);
+
+    int y = (int)get_global_id(0);
+
+    float B = coefficients.x;
+    float b1 = coefficients.y;
+    float b2 = coefficients.z;
+    float b3 = coefficients.w;
+
+    // code
+    if( y >= height)
+    {
+        return;
+    }
+
+        // forward ( causal) pass
+    float4 w1 = read_imagef( src_img, sampler_, (int2)( 0, y));
+    float4 w2 = w1;
+    float4 w3 = w1;
+
+    for( int x = 0; x < width; ++x)
+    {
+        float4 w0 = B * read_imagef( src_img, sampler_, (int2)( x, y)) + b1 * w1 + b2 * w2 + b3 * w3;
+        scratch[ mad24( x, height, y)] = w0;
+
+        w3 = w2; w2 = w1; w1 = w0;
+    }
+
+        // backward ( anti-causal) pass
+    float4 y1 = w1;
+    float4 y2 = w1;
+    float4 y3 = w1;
+
+    for( int x = width - 1; x >= 0; --x)
+    {
+        float4 y0 = B * scratch[ mad24( x, height, y)] + b1 * y1 + b2 * y2 + b3 * y3;
+        write_imagef( dst_img, (int2)( x, y), y0);
+
+        y3 = y2; y2 = y1; y1 = y0;
+    }
+}
+
+/**
+ * @brief recursive_gaussian_columns(): one work-item per column.
+ *
+ * @param scratch width * height float4, element ( x, y) is stored at y * width + x
+ */
+__kernel void recursive_gaussian_columns(
+    __read_only image2d_t src_img,
+    __write_only image2d_t dst_img,
+    __global float4 *scratch,
+    float4 coefficients
+)
+{
+    // variable declaration
+    int width = get_image_width( src_img);
+    int height = get_image_height( src_img);
+
+    int x = (int)get_global_id(0);
+
+    float B = coefficients.x;
+    float b1 = coefficients.y;
+    float b2 = coefficients.z;
+    float b3 = coefficients.w;
+
+    // code
+    if( x >= width)
+    {
+        return;
+    }
+
+        // forward ( causal) pass
+    float4 w1 = read_imagef( src_img, sampler_, (int2)( x, 0));
+    float4 w2 = w1;
+    float4 w3 = w1;
+
+    for( int y = 0; y < height; ++y)
+    {
+        float4 w0 = B * read_imagef( src_img, sampler_, (int2)( x, y)) + b1 * w1 + b2 * w2 + b3 * w3;
+        scratch[ mad24( y, width, x)] = w0;
+
+        w3 = w2; w2 = w1; w1 = w0;
+    }
+
+        // backward ( anti-causal) pass
+    float4 y1 = w1;
+    float4 y2 = w1;
+    float4 y3 = w1;
+
+    for( int y = height - 1; y >= 0; --y)
+    {
+        float4 y0 = B * scratch[ mad24( y, width, x)] + b1 * y1 + b2 * y2 + b3 * y3;
+        write_imagef( dst_img, (int2)( x, y), y0);
+
+        y3 = y2; y2 = y1; y1 = y0;
+    }
+}
+
+/**
+ * @brief box_filter_rows(): one box pass of width 2 * radius + 1, one work-item per row.
+ */
+__kernel void box_filter_rows(
+    __read_only image2d_t src_img,
+    __write_only image2d_t dst_img,
+    int radius
+)
+{
+    // variable declaration
+    int width = get_image_width( src_img);
+    int height = get_image_height( src_img);
+
+    int y = (int)get_global_id(0);
+
+    float scale = 1.0f / (float)( 2 * radius + 1);
+
+    // code
+    if( y >= height)
+    {
+        return;
+    }
+
+    float4 sum = (float4)( 0.0f);
+    for( int i = -radius; i <= radius; ++i)
+    {
+        sum += read_imagef( src_img, sampler_, (int2)( i, y));
+    }
+
+    for( int x = 0; x < width; ++x)
+    {
+        write_imagef( dst_img, (int2)( x, y), sum * scale);
+
+        sum += read_imagef( src_img, sampler_, (int2)( x + radius + 1, y)) - read_imagef( src_img, sampler_, (int2)( x - radius, y));
+    }
+}
+
+/**
+ * @brief box_filter_columns(): one box pass of width 2 * radius + 1, one work-item per column.
+ */
+__kernel void box_filter_columns(
+    __read_only image2d_t src_img,
+    __write_only image2d_t dst_img,
+    int radius
+)
+{
+    // variable declaration
+    int width = get_image_width( src_img);
+    int height = get_image_height( src_img);
+
+    int x = (int)get_global_id(0);
+
+    float scale = 1.0f / (float)( 2 * radius + 1);
+
+    // code
+    if( x >= width)
+    {
+        return;
+    }
+
+    float4 sum = (float4)( 0.0f);
+    for( int i = -radius; i <= radius; ++i)
+    {
+        sum += read_imagef( src_img, sampler_, (int2)( x, i));
+    }
+
+    for( int y = 0; y < height; ++y)
+    {
+        write_imagef( dst_img, (int2)( x, y), sum * scale);
+
+        sum += read_imagef( src_img, sampler_, (int2)( x, y + radius + 1)) - read_imagef( src_img, sampler_, (int2)( x, y - radius));
+    }
+}
@@ -0,0 +1,522 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * Large-radius Gaussian blur whose cost per pixel does not depend on sigma.
+ *
+ *  --method iir : recursive Gaussian ( Young - van Vliet), rows then columns, one work-item per line.
+ *  --method box : n passes ( --passes, default 3) of a running-sum box filter per direction,
+ *                 the box width is chosen so that n passes have the variance of the requested Gaussian.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include <cmath>
+
+#include "OpenCLUtil.h"
+
+#include "../../Common/FreeImage/x64/FreeImage.h"
+
+#define DEFAULT_PLATFORM 0
+#define DEFAULT_SIGMA 20.0f
+#define DEFAULT_BOX_PASSES 3
+
+#define To_String(x) #x
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+    // one work-item per line, lines are grouped 64 per work-group
+const int LINE_GROUP_SIZE = 64;
+
+enum BlurMethod
+{
+    BLUR_METHOD_IIR,
+    BLUR_METHOD_BOX
+};
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_command_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+cl_program ocl_program = nullptr;
+
+cl_kernel recursive_gaussian_rows = nullptr;
+cl_kernel recursive_gaussian_columns = nullptr;
+cl_kernel box_filter_rows = nullptr;
+cl_kernel box_filter_columns = nullptr;
+
+cl_mem ocl_scratch = nullptr;
+cl_mem ocl_image_src = nullptr;
+cl_mem ocl_image_tmp[2] = { nullptr, nullptr};
+cl_mem ocl_image_dst = nullptr;
+
+uint8_t *image_bits = nullptr;
+uint8_t *output_image_bits = nullptr;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool SaveImage( const char *out_file_name, uint8_t *image_data, int image_width, int image_height);
+    uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height);
+    cl_float4 RecursiveGaussianCoefficients( float sigma);
+    int BoxRadius( float sigma, int num_passes);
+    cl_int EnqueueLinePass( cl_kernel kernel, cl_mem src, cl_mem dst, size_t num_lines);
+    size_t RoundUp( int group_size, int global_size);
+    void  cleanup();
+
+    // variable declaration
+    int image_width = 0;
+    int image_height = 0;
+
+    int platform_used = DEFAULT_PLATFORM;
+    float sigma = DEFAULT_SIGMA;
+    BlurMethod method = BLUR_METHOD_IIR;
+    int num_box_passes = DEFAULT_BOX_PASSES;
+    int num_iterations = 1;
+
+    std::string input_file_name;
+    std::string output_file_name = "out.png";
+
+    cl_int ocl_err;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--i") && (i + 1 < argc))
+        {
+            input_file_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--o") && (i + 1 < argc))
+        {
+            output_file_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--platform") && (i + 1 < argc))
+        {
+            platform_used = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--sigma") && (i + 1 < argc))
+        {
+            sigma = (float)atof( argv[++i]);
+        }
+        else if( !input.compare( "--method") && (i + 1 < argc))
+        {
+            std::string name( argv[++i]);
+            method = !name.compare( "box") ? BLUR_METHOD_BOX : BLUR_METHOD_IIR;
+        }
+        else if( !input.compare( "--passes") && (i + 1 < argc))
+        {
+            num_box_passes = std::max( 1, atoi( argv[++i]));
+        }
+        else if( !input.compare( "--iterations") && (i + 1 < argc))
+        {
+            num_iterations = std::max( 1, atoi( argv[++i]));
+        }
+    }
+
+    if( input_file_name.empty() || !(sigma >= 0.5f))
+    {
+        std::cerr << "usage: " << argv[0] << " --i input_file_name\n";
+        std::cerr << "options: " << "\n"
+                  << "   --o output_file_name (default out.png)\n"
+                  << "   --platform n\n"
+                  << "   --sigma s: standard deviation in pixels, s >= 0.5 (default " << DEFAULT_SIGMA << ")\n"
+                  << "   --method iir|box: recursive Gaussian or iterated box filter (default iir)\n"
+                  << "   --passes n: box filter passes per direction (default " << DEFAULT_BOX_PASSES << ")\n"
+                  << "   --iterations n: number of timed runs (default 1)"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( platform_used);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_command_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_command_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_program = CreateProgram( ocl_context, ocl_device, "RecursiveGaussianFilter.cl");
+    if( ocl_program == nullptr)
+    {
+        std::cerr << "CreateProgram() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    recursive_gaussian_rows = clCreateKernel( ocl_program, "recursive_gaussian_rows", &ocl_err);
+    if( !recursive_gaussian_rows || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    recursive_gaussian_columns = clCreateKernel( ocl_program, "recursive_gaussian_columns", &ocl_err);
+    if( !recursive_gaussian_columns || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    box_filter_rows = clCreateKernel( ocl_program, "box_filter_rows", &ocl_err);
+    if( !box_filter_rows || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    box_filter_columns = clCreateKernel( ocl_program, "box_filter_columns", &ocl_err);
+    if( !box_filter_columns || ocl_err)
+    {
+        std::cerr << "clCreateKernel() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** IMAGE LOADING ***********/
+    image_bits = LoadImage( input_file_name.c_str(), &image_width, &image_height);
+    if( image_bits == nullptr)
+    {
+        std::cerr << "Cannot open image \"" << input_file_name << "\"" << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cl_image_format ocl_image_format = { };
+    ocl_image_format.image_channel_order = CL_RGBA;
+    ocl_image_format.image_channel_data_type = CL_UNORM_INT8;
+
+    cl_image_desc ocl_image_desc = { };
+    ocl_image_desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    ocl_image_desc.image_width = image_width;
+    ocl_image_desc.image_height = image_height;
+    ocl_image_desc.image_row_pitch = image_width * 4;
+    ocl_image_desc.mem_object = nullptr;
+
+    ocl_image_src = clCreateImage( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, &ocl_image_format, &ocl_image_desc, image_bits, &ocl_err);
+    if( !ocl_image_src || ocl_err)
+    {
+        std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_image_desc.image_row_pitch = 0;
+    ocl_image_dst = clCreateImage( ocl_context, CL_MEM_WRITE_ONLY, &ocl_image_format, &ocl_image_desc, nullptr, &ocl_err);
+    if( !ocl_image_dst || ocl_err)
+    {
+        std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        // float ping-pong images for the intermediate passes
+    ocl_image_format.image_channel_data_type = CL_FLOAT;
+    for( int i = 0; i < 2; ++i)
+    {
+        ocl_image_tmp[i] = clCreateImage( ocl_context, CL_MEM_READ_WRITE, &ocl_image_format, &ocl_image_desc, nullptr, &ocl_err);
+        if( !ocl_image_tmp[i] || ocl_err)
+        {
+            std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    }
+
+        // forward pass result of the recursive filter
+    ocl_scratch = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, (size_t)image_width * image_height * sizeof( cl_float4), nullptr, &ocl_err);
+    if( !ocl_scratch || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cl_float4 coefficients = RecursiveGaussianCoefficients( sigma);
+    int box_radius = BoxRadius( sigma, num_box_passes);
+
+    ocl_err = clSetKernelArg( recursive_gaussian_rows, 2, sizeof( cl_mem), &ocl_scratch);
+    ocl_err |= clSetKernelArg( recursive_gaussian_rows, 3, sizeof( cl_float4), &coefficients);
+    ocl_err |= clSetKernelArg( recursive_gaussian_columns, 2, sizeof( cl_mem), &ocl_scratch);
+    ocl_err |= clSetKernelArg( recursive_gaussian_columns, 3, sizeof( cl_float4), &coefficients);
+    ocl_err |= clSetKernelArg( box_filter_rows, 2, sizeof( int), &box_radius);
+    ocl_err |= clSetKernelArg( box_filter_columns, 2, sizeof( int), &box_radius);
+
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clSetKernelArg() Failed.\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    std::cout << To_String( image_width) << " : " << image_width << "\n";
+    std::cout << To_String( image_height) << " : " << image_height << "\n";
+    std::cout << To_String( sigma) << " : " << sigma << "\n";
+    if( method == BLUR_METHOD_BOX)
+    {
+        std::cout << To_String( box_radius) << " : " << box_radius << " x " << num_box_passes << " passes\n";
+    }
+    std::cout << "\n";
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int i = 0; i < num_iterations; ++i)
+    {
+        if( method == BLUR_METHOD_IIR)
+        {
+            ocl_err = EnqueueLinePass( recursive_gaussian_rows, ocl_image_src, ocl_image_tmp[0], image_height);
+            ocl_err |= EnqueueLinePass( recursive_gaussian_columns, ocl_image_tmp[0], ocl_image_dst, image_width);
+        }
+        else
+        {
+                // src -> tmp[0] -> tmp[1] -> tmp[0] ... -> dst
+            cl_mem src = ocl_image_src;
+            int target = 0;
+
+            ocl_err = CL_SUCCESS;
+            for( int pass = 0; pass < 2 * num_box_passes; ++pass)
+            {
+                bool b_rows = pass < num_box_passes;
+                bool b_last = pass == 2 * num_box_passes - 1;
+
+                cl_mem dst = b_last ? ocl_image_dst : ocl_image_tmp[target];
+
+                ocl_err |= EnqueueLinePass( b_rows ? box_filter_rows : box_filter_columns, src, dst, b_rows ? image_height : image_width);
+
+                src = dst;
+                target = 1 - target;
+            }
+        }
+
+        if( ocl_err != CL_SUCCESS)
+        {
+            std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    }
+    clFinish( ocl_command_queue);
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  elapsed_seconds = ( end - start) / num_iterations;
+    std::cout << "Time Required for " << ( method == BLUR_METHOD_IIR ? "Recursive Gaussian" : "Iterated Box") << " Blur by OpenCL is: " << elapsed_seconds.count() << "s" << std::endl;
+
+        // read result
+    output_image_bits = new uint8_t[ (size_t)image_width * image_height * 4];
+
+    size_t origin[3] = { 0, 0, 0};
+    size_t region[3] = { (size_t)image_width, (size_t)image_height, 1};
+    size_t row_pitch = image_width * 4;
+
+    ocl_err = clEnqueueReadImage( ocl_command_queue, ocl_image_dst, CL_TRUE, origin, region, row_pitch, 0, output_image_bits, 0, nullptr, nullptr);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clEnqueueReadImage() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    if( !SaveImage( output_file_name.c_str(), output_image_bits, image_width, image_height))
+    {
+        std::cerr << "Error writing output image: " << output_file_name << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cleanup();
+
+    return 0;
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // code
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+    RELEASE_CL_OBJECT( ocl_command_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+    RELEASE_CL_OBJECT( recursive_gaussian_rows, clReleaseKernel);
+    RELEASE_CL_OBJECT( recursive_gaussian_columns, clReleaseKernel);
+    RELEASE_CL_OBJECT( box_filter_rows, clReleaseKernel);
+    RELEASE_CL_OBJECT( box_filter_columns, clReleaseKernel);
+    RELEASE_CL_OBJECT( ocl_scratch, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_src, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_tmp[0], clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_tmp[1], clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_dst, clReleaseMemObject);
+    RELEASE_CL_OBJECT( image_bits, delete[]);
+    RELEASE_CL_OBJECT( output_image_bits, delete[]);
+}
+
+/**
+ * @brief EnqueueLinePass() : set source and destination image and launch one work-item per line.
+ */
+cl_int EnqueueLinePass( cl_kernel kernel, cl_mem src, cl_mem dst, size_t num_lines)
+{
+    // function declaration
+    size_t RoundUp( int group_size, int global_size);
+
+    // variable declaration
+    cl_int ocl_err;
+
+    // code
+    ocl_err = clSetKernelArg( kernel, 0, sizeof( cl_mem), &src);
+    ocl_err |= clSetKernelArg( kernel, 1, sizeof( cl_mem), &dst);
+    if( ocl_err != CL_SUCCESS)
+    {
+        return ocl_err;
+    }
+
+    size_t local_work_size = LINE_GROUP_SIZE;
+    size_t global_work_size = RoundUp( LINE_GROUP_SIZE, (int)num_lines);
+
+    return clEnqueueNDRangeKernel( ocl_command_queue, kernel, 1, nullptr, &global_work_size, &local_work_size, 0, nullptr, nullptr);
+}
+
+/**
+ * @brief RecursiveGaussianCoefficients() : Young - van Vliet coefficients ( B, b1, b2, b3), b1..b3 divided by b0.
+ */
+cl_float4 RecursiveGaussianCoefficients( float sigma)
+{
+    // variable declaration
+    cl_float4 coefficients;
+    double q;
+
+    // code
+    if( sigma >= 2.5f)
+    {
+        q = 0.98711 * sigma - 0.96330;
+    }
+    else
+    {
+        q = 3.97156 - 4.14554 * sqrt( 1.0 - 0.26891 * sigma);
+    }
+
+    double q2 = q * q;
+    double q3 = q2 * q;
+
+    double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    double b1 = ( 2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+    double b2 = -( 1.4281 * q2 + 1.26661 * q3) / b0;
+    double b3 = ( 0.422205 * q3) / b0;
+
+    coefficients.s[0] = (float)( 1.0 - ( b1 + b2 + b3));
+    coefficients.s[1] = (float)b1;
+    coefficients.s[2] = (float)b2;
+    coefficients.s[3] = (float)b3;
+
+    return coefficients;
+}
+
+/**
+ * @brief BoxRadius() : radius of a box filter whose num_passes passes have the variance sigma^2.
+ *
+ *  one box of width w has variance ( w^2 - 1) / 12, so w = sqrt( 12 * sigma^2 / n + 1).
+ */
+int BoxRadius( float sigma, int num_passes)
+{
+    // code
+    double ideal_width = sqrt( 12.0 * sigma * sigma / num_passes + 1.0);
+
+    return std::max( 1, (int)floor( ( ideal_width - 1.0) / 2.0 + 0.5));
+}
+
+/**
+ * @brief RoundUp()
+ */
+size_t RoundUp( int group_size, int global_size)
+{
+    // code
+    int r = global_size % group_size;
+    if( r == 0)
+    {
+        return global_size;
+    }
+    else
+    {
+        return global_size + group_size - r;
+    }
+}
+
+/**
+ * @brief LoadImage() : Load Image and returns image width, image height and image data in 32-bit format. Delete image data when work is done.
+ */
+uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height)
+{
+    // code
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( file_name, 0);
+    FIBITMAP *image = FreeImage_Load( format, file_name);
+    if( image == nullptr)
+    {
+        *image_width = 0;
+        *image_height = 0;
+        return nullptr;
+    }
+
+        // convert to 32-bit image
+    FIBITMAP *temp = image;
+    image = FreeImage_ConvertTo32Bits( image);
+    FreeImage_Unload( temp);
+
+    *image_width = FreeImage_GetWidth( image);
+    *image_height = FreeImage_GetHeight( image);
+
+    uint8_t *image_bits = FreeImage_GetBits( image);
+
+    uint8_t *ret_image_bits = new uint8_t[ (*image_width) * (*image_height) * 4];
+    memcpy( ret_image_bits, image_bits, (*image_width) * (*image_height) * 4 * sizeof( uint8_t));
+
+    FreeImage_Unload( image);
+
+    return ret_image_bits;
+}
+
+/**
+ * @brief SaveImage()
+ */
+bool SaveImage( const char *out_file_name, uint8_t *image_bits, int image_width, int image_height)
+{
+    // save image
+    FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_file_name);
+    if( format == FREE_IMAGE_FORMAT::FIF_UNKNOWN)
+    {
+        return false;
+    }
+
+    int row_pitch = 4 * image_width;
+    FIBITMAP *image = FreeImage_ConvertFromRawBits( image_bits, image_width, image_height, row_pitch, 32, 0xFF000000, 0x00FF0000, 0x0000FF00);
+    bool b_saved = FreeImage_Save( format, image, out_file_name);
+    FreeImage_Unload( image);
+
+    return b_saved;
+}
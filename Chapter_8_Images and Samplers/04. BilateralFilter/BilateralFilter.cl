@@ -0,0 +1,257 @@
+/************************
+ *
+ * Edge-preserving bilateral filter
+ *
+ *      out( p) = sum( Gs( |p - q|) * Gr( |I(p) - I(q)|) * I(q)) / sum( Gs( |p - q|) * Gr( |I(p) - I(q)|))
+ *
+ * 1. bilateral_filter()
+ *      - Gs for the ( 2r + 1)^2 window is computed once on the host and read from __constant memory.
+ *      - Gr is a lookup table indexed by the sum of absolute channel differences ( 0 .. 3 * 255),
+ *        so the inner loop has no exp().
+ *      - the work-group tile plus an r pixel apron is cached in local memory as uchar4, the cache is a
+ *        __local kernel argument of ( TILE_SIZE + 2r)^2 * sizeof( uchar4) bytes.
+ *      Work-group size must be ( TILE_SIZE, TILE_SIZE).
+ *
+ * 2. Bilateral grid ( Chen, Paris, Durand 2007), cost independent of the spatial sigma
+ *      - bilateral_grid_splat()   : every pixel adds ( color, 1) to the cell ( x / ss, y / ss, luminance / sr)
+ *      - bilateral_grid_convert() : integer sums -> float4
+ *      - bilateral_grid_blur()    : [ 1 2 1] / 4 along one axis of the grid, launched for x, y and z
+ *      - bilateral_grid_slice()   : trilinear lookup at ( x / ss, y / ss, luminance / sr), color = sum / weight
+ *      The grid has one cell of padding on each side, cell ( gx, gy, gz) is stored at ( gz * gh + gy) * gw + gx.
+ *
+ * Images are loaded from 32-bit FreeImage data, so channel x is blue and z is red.
+ */
+
+#ifndef TILE_SIZE
+    #define TILE_SIZE   16
+#endif
+
+const sampler_t sampler_ = CLK_NORMALIZED_COORDS_FALSE | CLK_ADDRESS_CLAMP_TO_EDGE | CLK_FILTER_NEAREST;
+
+/**
+ * @brief luminance(): BGR -> luminance
+ */
+inline float luminance( float4 clr)
+{
+    // code
+    return 0.114f * clr.x + 0.587f * clr.y + 0.299f * clr.z;
+}
+
+/**
+ * @brief bilateral_filter(): direct bilateral filter of radius r over a local memory tile.
+ */
+__kernel void bilateral_filter(
+    __read_only image2d_t src_img,
+    __write_only image2d_t dst_img,
+    __constant float *spatial_weights,
+    __constant float *range_lut,
+    int radius,
+    __local uchar4 *cache
+)
+{
+    // variable declaration
+    int width = get_image_width( src_img);
+    int height = get_image_height( src_img);
+
+    int lx = (int)get_local_id(0);
+    int ly = (int)get_local_id(1);
+    int tid = mad24( ly, TILE_SIZE, lx);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    int x0 = (int)get_group_id(0) * TILE_SIZE - radius;
+    int y0 = (int)get_group_id(1) * TILE_SIZE - radius;
+
+    int cache_size = TILE_SIZE + 2 * radius;
+    int window_size = 2 * radius + 1;
+
+    // code
+        // cooperative load of tile + apron, the sampler clamps at the image border
+    for( int i = tid; i < cache_size * cache_size; i += TILE_SIZE * TILE_SIZE)
+    {
+        int cy = i / cache_size;
+        int cx = i - cy * cache_size;
+
+        cache[i] = convert_uchar4_sat_rte( read_imagef( src_img, sampler_, (int2)( x0 + cx, y0 + cy)) * 255.0f);
+    }
+
+    barrier( CLK_LOCAL_MEM_FENCE);
+
+    if( (x >= width) || (y >= height))
+    {
+        return;
+    }
+
+    int4 center = convert_int4( cache[ mad24( ly + radius, cache_size, lx + radius)]);
+
+    float4 sum = (float4)( 0.0f);
+    float weight_sum = 0.0f;
+
+    for( int dy = 0; dy < window_size; ++dy)
+    {
+        __local const uchar4 *row = cache + mad24( ly + dy, cache_size, lx);
+        __constant const float *spatial_row = spatial_weights + dy * window_size;
+
+        for( int dx = 0; dx < window_size; ++dx)
+        {
+            int4 clr = convert_int4( row[dx]);
+            uint4 diff = abs( clr - center);
+
+            float w = spatial_row[dx] * range_lut[ diff.x + diff.y + diff.z];
+
+            sum += w * convert_float4( clr);
+            weight_sum += w;
+        }
+    }
+
+        // the center pixel has weight 1 in both terms, weight_sum > 0
+    write_imagef( dst_img, (int2)( x, y), sum / ( weight_sum * 255.0f));
+}
+
+/**
+ * @brief bilateral_grid_splat(): accumulate pixels into the grid, 4 uint per cell ( B, G, R, count).
+ *
+ * @param grid_size  ( gw, gh, gd, 0)
+ * @param inv_sampling ( 1 / ss, 1 / sr)
+ */
+__kernel void bilateral_grid_splat(
+    __read_only image2d_t src_img,
+    __global uint *grid,
+    int4 grid_size,
+    float2 inv_sampling
+)
+{
+    // variable declaration
+    int width = get_image_width( src_img);
+    int height = get_image_height( src_img);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    // code
+    if( (x >= width) || (y >= height))
+    {
+        return;
+    }
+
+    float4 clr = read_imagef( src_img, sampler_, (int2)( x, y));
+
+    int gx = (int)( x * inv_sampling.x + 0.5f) + 1;
+    int gy = (int)( y * inv_sampling.x + 0.5f) + 1;
+    int gz = (int)( luminance( clr) * inv_sampling.y + 0.5f) + 1;
+
+    uint4 value = convert_uint4_sat_rte( clr * 255.0f);
+
+    __global uint *cell = grid + 4 * mad24( mad24( gz, grid_size.y, gy), grid_size.x, gx);
+
+    atomic_add( cell + 0, value.x);
+    atomic_add( cell + 1, value.y);
+    atomic_add( cell + 2, value.z);
+    atomic_add( cell + 3, 1u);
+}
+
+/**
+ * @brief bilateral_grid_convert(): integer cell sums to float4.
+ */
+__kernel void bilateral_grid_convert( __global const uint4 *grid_sums, __global float4 *grid, int num_cells)
+{
+    // variable declaration
+    int i = (int)get_global_id(0);
+
+    // code
+    if( i < num_cells)
+    {
+        grid[i] = convert_float4( grid_sums[i]);
+    }
+}
+
+/**
+ * @brief bilateral_grid_blur(): [ 1 2 1] / 4 along axis ( 0: x, 1: y, 2: z), cells outside the grid are zero.
+ */
+__kernel void bilateral_grid_blur( __global const float4 *src, __global float4 *dst, int4 grid_size, int axis)
+{
+    // variable declaration
+    int i = (int)get_global_id(0);
+    int num_cells = grid_size.x * grid_size.y * grid_size.z;
+
+    // code
+    if( i >= num_cells)
+    {
+        return;
+    }
+
+    int gx = i % grid_size.x;
+    int gy = ( i / grid_size.x) % grid_size.y;
+    int gz = i / ( grid_size.x * grid_size.y);
+
+    int coord = ( axis == 0) ? gx : ( ( axis == 1) ? gy : gz);
+    int extent = ( axis == 0) ? grid_size.x : ( ( axis == 1) ? grid_size.y : grid_size.z);
+    int stride = ( axis == 0) ? 1 : ( ( axis == 1) ? grid_size.x : grid_size.x * grid_size.y);
+
+    float4 sum = 2.0f * src[i];
+    if( coord > 0)
+    {
+        sum += src[ i - stride];
+    }
+    if( coord < extent - 1)
+    {
+        sum += src[ i + stride];
+    }
+
+    dst[i] = 0.25f * sum;
+}
+
+/**
+ * @brief bilateral_grid_slice(): trilinear interpolation of the blurred grid.
+ */
+__kernel void bilateral_grid_slice(
+    __read_only image2d_t src_img,
+    __global const float4 *grid,
+    int4 grid_size,
+    float2 inv_sampling,
+    __write_only image2d_t dst_img
+)
+{
+    // variable declaration
+    int width = get_image_width( src_img);
+    int height = get_image_height( src_img);
+
+    int x = (int)get_global_id(0);
+    int y = (int)get_global_id(1);
+
+    int slice = grid_size.x * grid_size.y;
+
+    // code
+    if( (x >= width) || (y >= height))
+    {
+        return;
+    }
+
+    float4 clr = read_imagef( src_img, sampler_, (int2)( x, y));
+
+    float fx = x * inv_sampling.x + 1.0f;
+    float fy = y * inv_sampling.x + 1.0f;
+    float fz = luminance( clr) * inv_sampling.y + 1.0f;
+
+    int ix = (int)fx;
+    int iy = (int)fy;
+    int iz = (int)fz;
+
+    float tx = fx - ix;
+    float ty = fy - iy;
+    float tz = fz - iz;
+
+    __global const float4 *c = grid + mad24( iz, slice, mad24( iy, grid_size.x, ix));
+
+    float4 c00 = mix( c[0], c[1], tx);
+    float4 c10 = mix( c[ grid_size.x], c[ grid_size.x + 1], tx);
+    float4 c01 = mix( c[ slice], c[ slice + 1], tx);
+    float4 c11 = mix( c[ slice + grid_size.x], c[ slice + grid_size.x + 1], tx);
+
+    float4 value = mix( mix( c00, c10, ty), mix( c01, c11, ty), tz);
+
+    float4 result = ( value.w > 1.0e-4f) ? (float4)( value.xyz / ( value.w * 255.0f), 1.0f) : clr;
+
+    write_imagef( dst_img, (int2)( x, y), result);
+}
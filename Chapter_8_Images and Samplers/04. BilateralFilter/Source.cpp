@@ -0,0 +1,633 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * Bilateral filter
+ *
+ *  - bilateral_filter    : direct filter, radius = ceil( 2 * sigma_s), spatial weights in __constant memory,
+ *                          range weights from a lookup table, local memory tiles.
+ *  - bilateral grid      : splat / blur / slice on a coarse ( x / sigma_s, y / sigma_s, luminance / sigma_r) grid,
+ *                          for large spatial sigmas.
+ *
+ * Both are timed against gaussian_filter() of "01. GaussianBlurFilter", the program is built from
+ * "../01. GaussianBlurFilter/GaussianFilter.cl", so run the sample from its own directory.
+ *
+ * Output: out_bilateral.png and out_bilateral_grid.png
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include <cmath>
+
+#include "OpenCLUtil.h"
+
+#include "../../Common/FreeImage/x64/FreeImage.h"
+
+#define DEFAULT_PLATFORM 0
+#define DEFAULT_SIGMA_S 3.0f
+#define DEFAULT_SIGMA_R 0.1f
+
+#define To_String(x) #x
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+    // must match the defaults in BilateralFilter.cl
+const int TILE_SIZE = 16;
+
+    // range LUT is indexed by |dB| + |dG| + |dR|
+const int RANGE_LUT_SIZE = 3 * 255 + 1;
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_command_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+cl_program ocl_program = nullptr;
+cl_program ocl_gaussian_program = nullptr;
+
+cl_kernel gaussian_filter = nullptr;
+cl_kernel bilateral_filter = nullptr;
+cl_kernel bilateral_grid_splat = nullptr;
+cl_kernel bilateral_grid_convert = nullptr;
+cl_kernel bilateral_grid_blur = nullptr;
+cl_kernel bilateral_grid_slice = nullptr;
+
+cl_sampler ocl_sampler = nullptr;
+
+cl_mem ocl_spatial_weights = nullptr;
+cl_mem ocl_range_lut = nullptr;
+cl_mem ocl_grid_sums = nullptr;
+cl_mem ocl_grid[2] = { nullptr, nullptr};
+cl_mem ocl_image_src = nullptr;
+cl_mem ocl_image_dst = nullptr;
+
+uint8_t *image_bits = nullptr;
+uint8_t *output_image_bits = nullptr;
+
+int image_width = 0;
+int image_height = 0;
+
+cl_int4 grid_size;
+int num_grid_cells = 0;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool SaveImage( const char *out_file_name, uint8_t *image_data, int image_width, int image_height);
+    uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height);
+    cl_int EnqueueGaussian();
+    cl_int EnqueueBilateral();
+    cl_int EnqueueBilateralGrid();
+    bool Benchmark( const char *name, cl_int (*enqueue_func)(), int num_iterations, const char *out_file_name);
+    size_t RoundUp( int group_size, int global_size);
+    void  cleanup();
+
+    // variable declaration
+    int platform_used = DEFAULT_PLATFORM;
+    float sigma_s = DEFAULT_SIGMA_S;
+    float sigma_r = DEFAULT_SIGMA_R;
+    int num_iterations = 10;
+
+    std::string input_file_name;
+
+    cl_int ocl_err;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--i") && (i + 1 < argc))
+        {
+            input_file_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--platform") && (i + 1 < argc))
+        {
+            platform_used = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--sigma_s") && (i + 1 < argc))
+        {
+            sigma_s = (float)atof( argv[++i]);
+        }
+        else if( !input.compare( "--sigma_r") && (i + 1 < argc))
+        {
+            sigma_r = (float)atof( argv[++i]);
+        }
+        else if( !input.compare( "--iterations") && (i + 1 < argc))
+        {
+            num_iterations = std::max( 1, atoi( argv[++i]));
+        }
+    }
+
+    if( input_file_name.empty() || !(sigma_s >= 1.0f) || !(sigma_r > 0.0f))
+    {
+        std::cerr << "usage: " << argv[0] << " --i input_file_name\n";
+        std::cerr << "options: " << "\n"
+                  << "   --platform n\n"
+                  << "   --sigma_s s: spatial sigma in pixels, s >= 1 (default " << DEFAULT_SIGMA_S << ")\n"
+                  << "   --sigma_r r: range sigma, intensities are in [0, 1] (default " << DEFAULT_SIGMA_R << ")\n"
+                  << "   --iterations n: number of timed runs (default 10)"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( platform_used);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_command_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_command_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_program = CreateProgram( ocl_context, ocl_device, "BilateralFilter.cl");
+    if( ocl_program == nullptr)
+    {
+        std::cerr << "CreateProgram() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_gaussian_program = CreateProgram( ocl_context, ocl_device, "../01. GaussianBlurFilter/GaussianFilter.cl");
+    if( ocl_gaussian_program == nullptr)
+    {
+        std::cerr << "CreateProgram() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    struct
+    {
+        cl_kernel *kernel;
+        cl_program program;
+        const char *name;
+    } kernels[] = {
+        { &gaussian_filter, ocl_gaussian_program, "gaussian_filter"},
+        { &bilateral_filter, ocl_program, "bilateral_filter"},
+        { &bilateral_grid_splat, ocl_program, "bilateral_grid_splat"},
+        { &bilateral_grid_convert, ocl_program, "bilateral_grid_convert"},
+        { &bilateral_grid_blur, ocl_program, "bilateral_grid_blur"},
+        { &bilateral_grid_slice, ocl_program, "bilateral_grid_slice"}
+    };
+
+    for( auto &k : kernels)
+    {
+        *k.kernel = clCreateKernel( k.program, k.name, &ocl_err);
+        if( !(*k.kernel) || ocl_err)
+        {
+            std::cerr << "clCreateKernel() Failed for " << k.name << ". " << ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    }
+
+    ocl_sampler = clCreateSampler( ocl_context, CL_FALSE, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST, &ocl_err);
+    if( !ocl_sampler || ocl_err)
+    {
+        std::cerr << "clCreateSampler() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** Filter Weights ***********/
+    int radius = (int)ceilf( 2.0f * sigma_s);
+    int window_size = 2 * radius + 1;
+
+    std::vector<float> spatial_weights( window_size * window_size);
+    for( int dy = -radius; dy <= radius; ++dy)
+    {
+        for( int dx = -radius; dx <= radius; ++dx)
+        {
+            spatial_weights[ ( dy + radius) * window_size + ( dx + radius)] = expf( -(float)( dx * dx + dy * dy) / ( 2.0f * sigma_s * sigma_s));
+        }
+    }
+
+        // difference d = |dB| + |dG| + |dR| in 0..765, mean channel difference d / ( 3 * 255) in [0, 1]
+    std::vector<float> range_lut( RANGE_LUT_SIZE);
+    for( int d = 0; d < RANGE_LUT_SIZE; ++d)
+    {
+        float delta = (float)d / ( 3.0f * 255.0f);
+        range_lut[d] = expf( -( delta * delta) / ( 2.0f * sigma_r * sigma_r));
+    }
+
+    size_t local_cache_size = (size_t)( TILE_SIZE + 2 * radius) * ( TILE_SIZE + 2 * radius) * sizeof( cl_uchar4);
+
+    cl_ulong device_local_mem_size = 0;
+    cl_ulong device_constant_buffer_size = 0;
+    clGetDeviceInfo( ocl_device, CL_DEVICE_LOCAL_MEM_SIZE, sizeof( cl_ulong), &device_local_mem_size, nullptr);
+    clGetDeviceInfo( ocl_device, CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE, sizeof( cl_ulong), &device_constant_buffer_size, nullptr);
+
+    bool b_direct_supported = ( local_cache_size <= device_local_mem_size) &&
+                              ( ( spatial_weights.size() + range_lut.size()) * sizeof( float) <= device_constant_buffer_size);
+    if( !b_direct_supported)
+    {
+        std::cout << "sigma_s " << sigma_s << " ( radius " << radius << ") is too large for the direct filter on this device, only the grid is run.\n";
+    }
+
+    ocl_spatial_weights = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, spatial_weights.size() * sizeof( float), spatial_weights.data(), &ocl_err);
+    if( !ocl_spatial_weights || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_range_lut = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, range_lut.size() * sizeof( float), range_lut.data(), &ocl_err);
+    if( !ocl_range_lut || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** IMAGE LOADING ***********/
+    image_bits = LoadImage( input_file_name.c_str(), &image_width, &image_height);
+    if( image_bits == nullptr)
+    {
+        std::cerr << "Cannot open image \"" << input_file_name << "\"" << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cl_image_format ocl_image_format = { };
+    ocl_image_format.image_channel_order = CL_RGBA;
+    ocl_image_format.image_channel_data_type = CL_UNORM_INT8;
+
+    cl_image_desc ocl_image_desc = { };
+    ocl_image_desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    ocl_image_desc.image_width = image_width;
+    ocl_image_desc.image_height = image_height;
+    ocl_image_desc.image_row_pitch = image_width * 4;
+    ocl_image_desc.mem_object = nullptr;
+
+    ocl_image_src = clCreateImage( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, &ocl_image_format, &ocl_image_desc, image_bits, &ocl_err);
+    if( !ocl_image_src || ocl_err)
+    {
+        std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_image_desc.image_row_pitch = 0;
+    ocl_image_dst = clCreateImage( ocl_context, CL_MEM_WRITE_ONLY, &ocl_image_format, &ocl_image_desc, nullptr, &ocl_err);
+    if( !ocl_image_dst || ocl_err)
+    {
+        std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** Bilateral Grid ***********/
+        // sampling rate ss = sigma_s, sr = sigma_r, one cell of padding on each side plus one for the trilinear lookup
+    cl_float2 inv_sampling;
+    inv_sampling.s[0] = 1.0f / sigma_s;
+    inv_sampling.s[1] = 1.0f / sigma_r;
+
+    grid_size.s[0] = (int)( ( image_width - 1) * inv_sampling.s[0]) + 4;
+    grid_size.s[1] = (int)( ( image_height - 1) * inv_sampling.s[0]) + 4;
+    grid_size.s[2] = (int)( inv_sampling.s[1]) + 4;
+    grid_size.s[3] = 0;
+
+    num_grid_cells = grid_size.s[0] * grid_size.s[1] * grid_size.s[2];
+
+    ocl_grid_sums = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, num_grid_cells * sizeof( cl_uint4), nullptr, &ocl_err);
+    if( !ocl_grid_sums || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    for( int i = 0; i < 2; ++i)
+    {
+        ocl_grid[i] = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, num_grid_cells * sizeof( cl_float4), nullptr, &ocl_err);
+        if( !ocl_grid[i] || ocl_err)
+        {
+            std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+            cleanup();
+            return EXIT_FAILURE;
+        }
+    }
+
+        /******** Kernel Arguments ***********/
+    ocl_err = clSetKernelArg( gaussian_filter, 0, sizeof( cl_mem), &ocl_image_src);
+    ocl_err |= clSetKernelArg( gaussian_filter, 1, sizeof( cl_mem), &ocl_image_dst);
+    ocl_err |= clSetKernelArg( gaussian_filter, 2, sizeof( cl_sampler), &ocl_sampler);
+    ocl_err |= clSetKernelArg( gaussian_filter, 3, sizeof( cl_int), &image_width);
+    ocl_err |= clSetKernelArg( gaussian_filter, 4, sizeof( cl_int), &image_height);
+
+    ocl_err |= clSetKernelArg( bilateral_filter, 0, sizeof( cl_mem), &ocl_image_src);
+    ocl_err |= clSetKernelArg( bilateral_filter, 1, sizeof( cl_mem), &ocl_image_dst);
+    ocl_err |= clSetKernelArg( bilateral_filter, 2, sizeof( cl_mem), &ocl_spatial_weights);
+    ocl_err |= clSetKernelArg( bilateral_filter, 3, sizeof( cl_mem), &ocl_range_lut);
+    ocl_err |= clSetKernelArg( bilateral_filter, 4, sizeof( int), &radius);
+    ocl_err |= clSetKernelArg( bilateral_filter, 5, b_direct_supported ? local_cache_size : sizeof( cl_uchar4), nullptr);
+
+    ocl_err |= clSetKernelArg( bilateral_grid_splat, 0, sizeof( cl_mem), &ocl_image_src);
+    ocl_err |= clSetKernelArg( bilateral_grid_splat, 1, sizeof( cl_mem), &ocl_grid_sums);
+    ocl_err |= clSetKernelArg( bilateral_grid_splat, 2, sizeof( cl_int4), &grid_size);
+    ocl_err |= clSetKernelArg( bilateral_grid_splat, 3, sizeof( cl_float2), &inv_sampling);
+
+    ocl_err |= clSetKernelArg( bilateral_grid_convert, 0, sizeof( cl_mem), &ocl_grid_sums);
+    ocl_err |= clSetKernelArg( bilateral_grid_convert, 1, sizeof( cl_mem), &ocl_grid[0]);
+    ocl_err |= clSetKernelArg( bilateral_grid_convert, 2, sizeof( int), &num_grid_cells);
+
+    ocl_err |= clSetKernelArg( bilateral_grid_blur, 2, sizeof( cl_int4), &grid_size);
+
+        // after the x, y and z blur the result is in grid[1]
+    ocl_err |= clSetKernelArg( bilateral_grid_slice, 0, sizeof( cl_mem), &ocl_image_src);
+    ocl_err |= clSetKernelArg( bilateral_grid_slice, 1, sizeof( cl_mem), &ocl_grid[1]);
+    ocl_err |= clSetKernelArg( bilateral_grid_slice, 2, sizeof( cl_int4), &grid_size);
+    ocl_err |= clSetKernelArg( bilateral_grid_slice, 3, sizeof( cl_float2), &inv_sampling);
+    ocl_err |= clSetKernelArg( bilateral_grid_slice, 4, sizeof( cl_mem), &ocl_image_dst);
+
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clSetKernelArg() Failed.\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    std::cout << To_String( image_width) << " : " << image_width << "\n";
+    std::cout << To_String( image_height) << " : " << image_height << "\n";
+    std::cout << To_String( sigma_s) << " : " << sigma_s << " ( radius " << radius << ")\n";
+    std::cout << To_String( sigma_r) << " : " << sigma_r << "\n";
+    std::cout << "grid : " << grid_size.s[0] << " x " << grid_size.s[1] << " x " << grid_size.s[2] << "\n\n";
+
+        /******** Benchmark ***********/
+    if( !Benchmark( "gaussian_filter ( 3x3)", EnqueueGaussian, num_iterations, nullptr))
+    {
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    if( b_direct_supported && !Benchmark( "bilateral_filter", EnqueueBilateral, num_iterations, "out_bilateral.png"))
+    {
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    if( !Benchmark( "bilateral grid", EnqueueBilateralGrid, num_iterations, "out_bilateral_grid.png"))
+    {
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cleanup();
+
+    return 0;
+}
+
+/**
+ * @brief Benchmark() : time num_iterations runs of enqueue_func, print throughput and optionally save the result.
+ */
+bool Benchmark( const char *name, cl_int (*enqueue_func)(), int num_iterations, const char *out_file_name)
+{
+    // function declaration
+    bool SaveImage( const char *out_file_name, uint8_t *image_data, int image_width, int image_height);
+
+    // variable declaration
+    cl_int ocl_err;
+
+    // code
+        // warm up
+    ocl_err = enqueue_func();
+    clFinish( ocl_command_queue);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int i = 0; (i < num_iterations) && (ocl_err == CL_SUCCESS); ++i)
+    {
+        ocl_err = enqueue_func();
+    }
+    clFinish( ocl_command_queue);
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << name << ": clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    std::chrono::duration<double>  elapsed_seconds = ( end - start) / num_iterations;
+    double mega_pixels_per_second = (double)image_width * image_height / elapsed_seconds.count() / 1.0e6;
+
+    std::cout << name << " : " << elapsed_seconds.count() * 1000.0 << " ms, " << mega_pixels_per_second << " MPixel/s" << std::endl;
+
+    if( out_file_name == nullptr)
+    {
+        return true;
+    }
+
+    if( output_image_bits == nullptr)
+    {
+        output_image_bits = new uint8_t[ (size_t)image_width * image_height * 4];
+    }
+
+    size_t origin[3] = { 0, 0, 0};
+    size_t region[3] = { (size_t)image_width, (size_t)image_height, 1};
+    size_t row_pitch = image_width * 4;
+
+    ocl_err = clEnqueueReadImage( ocl_command_queue, ocl_image_dst, CL_TRUE, origin, region, row_pitch, 0, output_image_bits, 0, nullptr, nullptr);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "clEnqueueReadImage() Failed." << ocl_err << "\n";
+        return false;
+    }
+
+    if( !SaveImage( out_file_name, output_image_bits, image_width, image_height))
+    {
+        std::cerr << "Error writing output image: " << out_file_name << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+/**
+ * @brief EnqueueGaussian() : 3x3 gaussian_filter() of "01. GaussianBlurFilter".
+ */
+cl_int EnqueueGaussian()
+{
+    // function declaration
+    size_t RoundUp( int group_size, int global_size);
+
+    // code
+    size_t local_work_size[2] = { 16, 16};
+    size_t global_work_size[2] = { RoundUp( 16, image_width), RoundUp( 16, image_height)};
+
+    return clEnqueueNDRangeKernel( ocl_command_queue, gaussian_filter, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+}
+
+/**
+ * @brief EnqueueBilateral() : direct bilateral filter.
+ */
+cl_int EnqueueBilateral()
+{
+    // function declaration
+    size_t RoundUp( int group_size, int global_size);
+
+    // code
+    size_t local_work_size[2] = { TILE_SIZE, TILE_SIZE};
+    size_t global_work_size[2] = { RoundUp( TILE_SIZE, image_width), RoundUp( TILE_SIZE, image_height)};
+
+    return clEnqueueNDRangeKernel( ocl_command_queue, bilateral_filter, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+}
+
+/**
+ * @brief EnqueueBilateralGrid() : clear, splat, blur x / y / z and slice.
+ */
+cl_int EnqueueBilateralGrid()
+{
+    // function declaration
+    size_t RoundUp( int group_size, int global_size);
+
+    // variable declaration
+    cl_int ocl_err;
+    cl_uint zero = 0;
+
+    // code
+    size_t local_work_size[2] = { 16, 16};
+    size_t global_work_size[2] = { RoundUp( 16, image_width), RoundUp( 16, image_height)};
+
+    size_t grid_local_work_size = 256;
+    size_t grid_global_work_size = RoundUp( 256, num_grid_cells);
+
+    ocl_err = clEnqueueFillBuffer( ocl_command_queue, ocl_grid_sums, &zero, sizeof( cl_uint), 0, num_grid_cells * sizeof( cl_uint4), 0, nullptr, nullptr);
+    ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, bilateral_grid_splat, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+    ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, bilateral_grid_convert, 1, nullptr, &grid_global_work_size, &grid_local_work_size, 0, nullptr, nullptr);
+
+    for( int axis = 0; axis < 3; ++axis)
+    {
+            // grid[0] -> grid[1] -> grid[0] -> grid[1]
+        ocl_err |= clSetKernelArg( bilateral_grid_blur, 0, sizeof( cl_mem), &ocl_grid[ axis & 1]);
+        ocl_err |= clSetKernelArg( bilateral_grid_blur, 1, sizeof( cl_mem), &ocl_grid[ 1 - ( axis & 1)]);
+        ocl_err |= clSetKernelArg( bilateral_grid_blur, 3, sizeof( int), &axis);
+        ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, bilateral_grid_blur, 1, nullptr, &grid_global_work_size, &grid_local_work_size, 0, nullptr, nullptr);
+    }
+
+    ocl_err |= clEnqueueNDRangeKernel( ocl_command_queue, bilateral_grid_slice, 2, nullptr, global_work_size, local_work_size, 0, nullptr, nullptr);
+
+    return ocl_err;
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // code
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+    RELEASE_CL_OBJECT( ocl_command_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+    RELEASE_CL_OBJECT( ocl_gaussian_program, clReleaseProgram);
+    RELEASE_CL_OBJECT( gaussian_filter, clReleaseKernel);
+    RELEASE_CL_OBJECT( bilateral_filter, clReleaseKernel);
+    RELEASE_CL_OBJECT( bilateral_grid_splat, clReleaseKernel);
+    RELEASE_CL_OBJECT( bilateral_grid_convert, clReleaseKernel);
+    RELEASE_CL_OBJECT( bilateral_grid_blur, clReleaseKernel);
+    RELEASE_CL_OBJECT( bilateral_grid_slice, clReleaseKernel);
+    RELEASE_CL_OBJECT( ocl_sampler, clReleaseSampler);
+    RELEASE_CL_OBJECT( ocl_spatial_weights, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_range_lut, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_grid_sums, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_grid[0], clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_grid[1], clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_src, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_image_dst, clReleaseMemObject);
+    RELEASE_CL_OBJECT( image_bits, delete[]);
+    RELEASE_CL_OBJECT( output_image_bits, delete[]);
+}
+
+/**
+ * @brief RoundUp()
+ */
+size_t RoundUp( int group_size, int global_size)
+{
+    // code
+    int r = global_size % group_size;
+    if( r == 0)
+    {
+        return global_size;
+    }
+    else
+    {
+        return global_size + group_size - r;
+    }
+}
+
+/**
+ * @brief LoadImage() : Load Image and returns image width, image height and image data in 32-bit format. Delete image data when work is done.
+ */
+uint8_t* LoadImage( const char *file_name, int *image_width, int *image_height)
+{
+    // code
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( file_name, 0);
+    FIBITMAP *image = FreeImage_Load( format, file_name);
+    if( image == nullptr)
+    {
+        *image_width = 0;
+        *image_height = 0;
+        return nullptr;
+    }
+
+        // convert to 32-bit image
+    FIBITMAP *temp = image;
+    image = FreeImage_ConvertTo32Bits( image);
+    FreeImage_Unload( temp);
+
+    *image_width = FreeImage_GetWidth( image);
+    *image_height = FreeImage_GetHeight( image);
+
+    uint8_t *image_bits = FreeImage_GetBits( image);
+
+    uint8_t *ret_image_bits = new uint8_t[ (*image_width) * (*image_height) * 4];
+    memcpy( ret_image_bits, image_bits, (*image_width) * (*image_height) * 4 * sizeof( uint8_t));
+
+    FreeImage_Unload( image);
+
+    return ret_image_bits;
+}
+
+/**
+ * @brief SaveImage()
+ */
+bool SaveImage( const char *out_file_name, uint8_t *image_bits, int image_width, int image_height)
+{
+    // save image
+    FREE_IMAGE_FORMAT format = FreeImage_GetFIFFromFilename( out_file_name);
+    if( format == FREE_IMAGE_FORMAT::FIF_UNKNOWN)
+    {
+        return false;
+    }
+
+    int row_pitch = 4 * image_width;
+    FIBITMAP *image = FreeImage_ConvertFromRawBits( image_bits, image_width, image_height, row_pitch, 32, 0xFF000000, 0x00FF0000, 0x0000FF00);
+    bool b_saved = FreeImage_Save( format, image, out_file_name);
+    FreeImage_Unload( image);
+
+    return b_saved;
+}
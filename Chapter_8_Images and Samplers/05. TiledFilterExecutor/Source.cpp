@@ -0,0 +1,874 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * Tiled filter executor for images larger than CL_DEVICE_IMAGE2D_MAX_WIDTH / HEIGHT or device memory.
+ *
+ *  - the output is split into tiles of --tile x --tile pixels, every tile is processed with a
+ *    filter-specific halo, so the input tile is ( tile + 2 * halo)^2 pixels.
+ *  - NUM_SLOTS device slots ( source image, destination image and filter scratch) are allocated once
+ *    and reused for all tiles.
+ *  - the host gathers the input tile into the slot's staging buffer, replicating edge pixels where the
+ *    halo leaves the image, so every filter sees the same border handling as on the whole image.
+ *  - uploads and downloads go on the transfer queue, kernels on the compute queue. Tile t is uploaded
+ *    before tile t - 1 is downloaded, so upload, compute and download of consecutive tiles overlap.
+ *  - only the inner tile ( without halo) is read back, straight into its place in the output image.
+ *
+ * Filters ( kernels are built from the other samples, run from this directory):
+ *      gaussian           : gaussian_filter()                           01. GaussianBlurFilter, halo 1
+ *      separable          : gaussian_blur_horizontal / vertical()       02. SeparableGaussianBlurFilter, halo ceil( 3 * sigma)
+ *      recursive          : recursive_gaussian_rows / columns()         03. RecursiveGaussianBlurFilter, halo ceil( 4 * sigma)
+ *      bilateral          : bilateral_filter()                          04. BilateralFilter, halo ceil( 2 * sigma)
+ *      sobel              : sobel_edge_detection_tiled_image()          Chapter 15, halo 1
+ *      sobel_grayscale    : sobel_grayscale_tiled_image()               Chapter 15, halo 1
+ *
+ *  The recursive filter has an infinite impulse response, with a 4 sigma halo the difference to the
+ *  untiled result is below 8-bit precision.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+
+#include <cmath>
+
+#include "OpenCLUtil.h"
+
+#include "../../Common/FreeImage/x64/FreeImage.h"
+
+#define DEFAULT_PLATFORM 0
+#define DEFAULT_TILE_SIZE 2048
+#define DEFAULT_SIGMA 5.0f
+#define DEFAULT_SIGMA_R 0.1f
+
+#define To_String(x) #x
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+    // number of tiles in flight
+#define NUM_SLOTS 3
+
+    // must match the kernel defaults of the samples the programs are built from
+const int FILTER_GROUP_SIZE = 64;
+const int CROSS_GROUP_SIZE = 4;
+const int LINE_GROUP_SIZE = 64;
+const int BILATERAL_TILE_SIZE = 16;
+const int SOBEL_TILE_WIDTH = 16;
+const int SOBEL_TILE_HEIGHT = 16;
+const int SOBEL_ROWS_PER_ITEM = 4;
+
+const int RANGE_LUT_SIZE = 3 * 255 + 1;
+
+enum FilterType
+{
+    FILTER_GAUSSIAN,
+    FILTER_SEPARABLE,
+    FILTER_RECURSIVE,
+    FILTER_BILATERAL,
+    FILTER_SOBEL,
+    FILTER_SOBEL_GRAYSCALE
+};
+
+struct Tile
+{
+    int x0, y0;                 // top-left output pixel
+    int width, height;          // output pixels
+};
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_transfer_queue = nullptr;
+cl_command_queue ocl_compute_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+cl_program ocl_program = nullptr;
+
+    // filter state
+FilterType filter_type = FILTER_GAUSSIAN;
+int filter_halo = 1;
+cl_kernel filter_kernels[2] = { nullptr, nullptr};
+cl_sampler ocl_sampler = nullptr;
+cl_mem ocl_weights = nullptr;
+cl_mem ocl_range_lut = nullptr;
+size_t filter_local_cache_size = 0;
+int filter_radius = 0;
+cl_float4 recursive_coefficients;
+
+    // device slots
+int slot_width = 0;
+int slot_height = 0;
+cl_mem slot_src[ NUM_SLOTS] = { };
+cl_mem slot_dst[ NUM_SLOTS] = { };
+cl_mem slot_tmp[ NUM_SLOTS] = { };
+cl_mem slot_scratch[ NUM_SLOTS] = { };
+std::vector<uint8_t> slot_staging[ NUM_SLOTS];
+
+cl_event write_done[ NUM_SLOTS] = { };
+cl_event kernel_done[ NUM_SLOTS] = { };
+cl_event read_done[ NUM_SLOTS] = { };
+
+FIBITMAP *input_image = nullptr;
+FIBITMAP *output_image = nullptr;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool CreateFilter( float sigma, float sigma_r);
+    bool CreateSlots();
+    void GatherTile( const uint8_t *image_bits, size_t image_pitch, int image_width, int image_height, const Tile &tile, uint8_t *staging);
+    cl_int EnqueueFilter( int slot, cl_uint num_wait_events, const cl_event *wait_events, cl_event *done_event);
+    void  cleanup();
+
+    // variable declaration
+    int image_width = 0;
+    int image_height = 0;
+
+    int platform_used = DEFAULT_PLATFORM;
+    int tile_size = DEFAULT_TILE_SIZE;
+    float sigma = DEFAULT_SIGMA;
+    float sigma_r = DEFAULT_SIGMA_R;
+
+    std::string input_file_name;
+    std::string output_file_name = "out.png";
+    std::string filter_name = "gaussian";
+
+    cl_int ocl_err;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--i") && (i + 1 < argc))
+        {
+            input_file_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--o") && (i + 1 < argc))
+        {
+            output_file_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--platform") && (i + 1 < argc))
+        {
+            platform_used = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--filter") && (i + 1 < argc))
+        {
+            filter_name = std::string( argv[++i]);
+        }
+        else if( !input.compare( "--tile") && (i + 1 < argc))
+        {
+            tile_size = std::max( 64, atoi( argv[++i]));
+        }
+        else if( !input.compare( "--sigma") && (i + 1 < argc))
+        {
+            sigma = (float)atof( argv[++i]);
+        }
+        else if( !input.compare( "--sigma_r") && (i + 1 < argc))
+        {
+            sigma_r = (float)atof( argv[++i]);
+        }
+    }
+
+    if( !filter_name.compare( "gaussian"))                  filter_type = FILTER_GAUSSIAN;
+    else if( !filter_name.compare( "separable"))            filter_type = FILTER_SEPARABLE;
+    else if( !filter_name.compare( "recursive"))            filter_type = FILTER_RECURSIVE;
+    else if( !filter_name.compare( "bilateral"))            filter_type = FILTER_BILATERAL;
+    else if( !filter_name.compare( "sobel"))                filter_type = FILTER_SOBEL;
+    else if( !filter_name.compare( "sobel_grayscale"))      filter_type = FILTER_SOBEL_GRAYSCALE;
+    else
+    {
+        input_file_name.clear();
+    }
+
+    if( input_file_name.empty() || !(sigma >= 1.0f) || !(sigma_r > 0.0f))
+    {
+        std::cerr << "usage: " << argv[0] << " --i input_file_name\n";
+        std::cerr << "options: " << "\n"
+                  << "   --o output_file_name (default out.png)\n"
+                  << "   --platform n\n"
+                  << "   --filter gaussian|separable|recursive|bilateral|sobel|sobel_grayscale (default gaussian)\n"
+                  << "   --tile n: output tile size in pixels (default " << DEFAULT_TILE_SIZE << ")\n"
+                  << "   --sigma s: sigma of separable, recursive and bilateral, s >= 1 (default " << DEFAULT_SIGMA << ")\n"
+                  << "   --sigma_r r: range sigma of bilateral (default " << DEFAULT_SIGMA_R << ")"
+                  << std::endl;
+
+        return EXIT_SUCCESS;
+    }
+
+        /******** IMAGE LOADING ***********/
+        // the image stays in the FreeImage bitmap, no extra host copy of the whole picture
+    FREE_IMAGE_FORMAT format = FreeImage_GetFileType( input_file_name.c_str(), 0);
+    input_image = FreeImage_Load( format, input_file_name.c_str());
+    if( input_image == nullptr)
+    {
+        std::cerr << "Cannot open image \"" << input_file_name << "\"" << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    if( FreeImage_GetBPP( input_image) != 32)
+    {
+        FIBITMAP *temp = input_image;
+        input_image = FreeImage_ConvertTo32Bits( temp);
+        FreeImage_Unload( temp);
+    }
+
+    image_width = FreeImage_GetWidth( input_image);
+    image_height = FreeImage_GetHeight( input_image);
+
+    output_image = FreeImage_Allocate( image_width, image_height, 32, 0x00FF0000, 0x0000FF00, 0x000000FF);
+    if( output_image == nullptr)
+    {
+        std::cerr << "FreeImage_Allocate() Failed." << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( platform_used);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_compute_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_compute_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_transfer_queue = clCreateCommandQueue( ocl_context, ocl_device, 0, &ocl_err);
+    if( !ocl_transfer_queue || ocl_err)
+    {
+        std::cerr << "clCreateCommandQueue() Failed." << ocl_err << "\n";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    if( !CreateFilter( sigma, sigma_r))
+    {
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** Tiles ***********/
+    tile_size = std::min( tile_size, std::max( image_width, image_height));
+
+    slot_width = std::min( tile_size, image_width) + 2 * filter_halo;
+    slot_height = std::min( tile_size, image_height) + 2 * filter_halo;
+
+    if( !CreateSlots())
+    {
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    std::vector<Tile> tiles;
+    for( int y = 0; y < image_height; y += tile_size)
+    {
+        for( int x = 0; x < image_width; x += tile_size)
+        {
+            Tile tile = { x, y, std::min( tile_size, image_width - x), std::min( tile_size, image_height - y)};
+            tiles.push_back( tile);
+        }
+    }
+
+    std::cout << To_String( image_width) << " : " << image_width << "\n";
+    std::cout << To_String( image_height) << " : " << image_height << "\n";
+    std::cout << "filter : " << filter_name << " ( halo " << filter_halo << ")\n";
+    std::cout << "tiles : " << tiles.size() << " of " << tile_size << " x " << tile_size << ", device slot " << slot_width << " x " << slot_height << "\n\n";
+
+    const uint8_t *input_bits = FreeImage_GetBits( input_image);
+    size_t input_pitch = FreeImage_GetPitch( input_image);
+
+    uint8_t *output_bits = FreeImage_GetBits( output_image);
+    size_t output_pitch = FreeImage_GetPitch( output_image);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+        // step t: upload and filter tile t, then download tile t - 1
+    for( size_t t = 0; t <= tiles.size(); ++t)
+    {
+        if( t < tiles.size())
+        {
+            int s = (int)( t % NUM_SLOTS);
+
+                // staging buffer is free again when its previous upload finished
+            if( write_done[s])
+            {
+                clWaitForEvents( 1, &write_done[s]);
+                RELEASE_CL_OBJECT( write_done[s], clReleaseEvent);
+            }
+
+            GatherTile( input_bits, input_pitch, image_width, image_height, tiles[t], slot_staging[s].data());
+
+                // source image is free when the previous kernel on this slot finished
+            size_t origin[3] = { 0, 0, 0};
+            size_t region[3] = { (size_t)slot_width, (size_t)slot_height, 1};
+
+            ocl_err = clEnqueueWriteImage( ocl_transfer_queue, slot_src[s], CL_FALSE, origin, region, (size_t)slot_width * 4, 0, slot_staging[s].data(),
+                                           kernel_done[s] ? 1 : 0, kernel_done[s] ? &kernel_done[s] : nullptr, &write_done[s]);
+            if( ocl_err != CL_SUCCESS)
+            {
+                std::cerr << "clEnqueueWriteImage() Failed." << ocl_err << "\n";
+                cleanup();
+                return EXIT_FAILURE;
+            }
+            RELEASE_CL_OBJECT( kernel_done[s], clReleaseEvent);
+
+                // destination image is free when the previous download from this slot finished
+            cl_event wait_events[2] = { write_done[s], read_done[s]};
+
+            ocl_err = EnqueueFilter( s, read_done[s] ? 2 : 1, wait_events, &kernel_done[s]);
+            if( ocl_err != CL_SUCCESS)
+            {
+                std::cerr << "clEnqueueNDRangeKernel() Failed." << ocl_err << "\n";
+                cleanup();
+                return EXIT_FAILURE;
+            }
+            RELEASE_CL_OBJECT( read_done[s], clReleaseEvent);
+
+            clFlush( ocl_compute_queue);
+        }
+
+        if( t > 0)
+        {
+            int p = (int)( ( t - 1) % NUM_SLOTS);
+            const Tile &tile = tiles[ t - 1];
+
+            size_t origin[3] = { (size_t)filter_halo, (size_t)filter_halo, 0};
+            size_t region[3] = { (size_t)tile.width, (size_t)tile.height, 1};
+
+            uint8_t *dst = output_bits + tile.y0 * output_pitch + (size_t)tile.x0 * 4;
+
+            ocl_err = clEnqueueReadImage( ocl_transfer_queue, slot_dst[p], CL_FALSE, origin, region, output_pitch, 0, dst, 1, &kernel_done[p], &read_done[p]);
+            if( ocl_err != CL_SUCCESS)
+            {
+                std::cerr << "clEnqueueReadImage() Failed." << ocl_err << "\n";
+                cleanup();
+                return EXIT_FAILURE;
+            }
+        }
+
+        clFlush( ocl_transfer_queue);
+    }
+
+    clFinish( ocl_compute_queue);
+    clFinish( ocl_transfer_queue);
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+    std::chrono::duration<double>  elapsed_seconds = end - start;
+
+    std::cout << "Time Required for tiled " << filter_name << " by OpenCL is: " << elapsed_seconds.count() << "s ("
+              << (double)image_width * image_height / elapsed_seconds.count() / 1.0e6 << " MPixel/s)" << std::endl;
+
+    FREE_IMAGE_FORMAT out_format = FreeImage_GetFIFFromFilename( output_file_name.c_str());
+    if( (out_format == FIF_UNKNOWN) || !FreeImage_Save( out_format, output_image, output_file_name.c_str()))
+    {
+        std::cerr << "Error writing output image: " << output_file_name << std::endl;
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cleanup();
+
+    return 0;
+}
+
+/**
+ * @brief GaussianWeights() : normalized 1D Gaussian of radius ceil( 3 * sigma).
+ */
+std::vector<float> GaussianWeights( float sigma)
+{
+    // variable declaration
+    int radius = (int)ceilf( 3.0f * sigma);
+    std::vector<float> weights( 2 * radius + 1);
+    float sum = 0.0f;
+
+    // code
+    for( int k = -radius; k <= radius; ++k)
+    {
+        weights[ k + radius] = expf( -(float)( k * k) / ( 2.0f * sigma * sigma));
+        sum += weights[ k + radius];
+    }
+
+    for( float &w : weights)
+    {
+        w /= sum;
+    }
+
+    return weights;
+}
+
+/**
+ * @brief RecursiveGaussianCoefficients() : Young - van Vliet coefficients ( B, b1, b2, b3), b1..b3 divided by b0.
+ */
+cl_float4 RecursiveGaussianCoefficients( float sigma)
+{
+    // variable declaration
+    cl_float4 coefficients;
+    double q;
+
+    // code
+    if( sigma >= 2.5f)
+    {
+        q = 0.98711 * sigma - 0.96330;
+    }
+    else
+    {
+        q = 3.97156 - 4.14554 * sqrt( 1.0 - 0.26891 * sigma);
+    }
+
+    double q2 = q * q;
+    double q3 = q2 * q;
+
+    double b0 = 1.57825 + 2.44413 * q + 1.4281 * q2 + 0.422205 * q3;
+    double b1 = ( 2.44413 * q + 2.85619 * q2 + 1.26661 * q3) / b0;
+    double b2 = -( 1.4281 * q2 + 1.26661 * q3) / b0;
+    double b3 = ( 0.422205 * q3) / b0;
+
+    coefficients.s[0] = (float)( 1.0 - ( b1 + b2 + b3));
+    coefficients.s[1] = (float)b1;
+    coefficients.s[2] = (float)b2;
+    coefficients.s[3] = (float)b3;
+
+    return coefficients;
+}
+
+/**
+ * @brief CreateFilter() : build the filter's program and kernels, upload its constant data and set its halo.
+ */
+bool CreateFilter( float sigma, float sigma_r)
+{
+    // variable declaration
+    const char *program_file = nullptr;
+    const char *kernel_names[2] = { nullptr, nullptr};
+    std::vector<float> weights;
+    std::vector<float> range_lut;
+
+    cl_int ocl_err;
+
+    // code
+    switch( filter_type)
+    {
+        case FILTER_GAUSSIAN:
+            program_file = "../01. GaussianBlurFilter/GaussianFilter.cl";
+            kernel_names[0] = "gaussian_filter";
+            filter_halo = 1;
+            break;
+
+        case FILTER_SEPARABLE:
+            program_file = "../02. SeparableGaussianBlurFilter/SeparableGaussianFilter.cl";
+            kernel_names[0] = "gaussian_blur_horizontal";
+            kernel_names[1] = "gaussian_blur_vertical";
+            weights = GaussianWeights( sigma);
+            filter_radius = (int)weights.size() / 2;
+            filter_halo = filter_radius;
+            filter_local_cache_size = (size_t)( FILTER_GROUP_SIZE + 2 * filter_radius) * CROSS_GROUP_SIZE * sizeof( cl_float4);
+            break;
+
+        case FILTER_RECURSIVE:
+            program_file = "../03. RecursiveGaussianBlurFilter/RecursiveGaussianFilter.cl";
+            kernel_names[0] = "recursive_gaussian_rows";
+            kernel_names[1] = "recursive_gaussian_columns";
+            recursive_coefficients = RecursiveGaussianCoefficients( sigma);
+            filter_halo = (int)ceilf( 4.0f * sigma);
+            break;
+
+        case FILTER_BILATERAL:
+        {
+            program_file = "../04. BilateralFilter/BilateralFilter.cl";
+            kernel_names[0] = "bilateral_filter";
+            filter_radius = (int)ceilf( 2.0f * sigma);
+            filter_halo = filter_radius;
+            filter_local_cache_size = (size_t)( BILATERAL_TILE_SIZE + 2 * filter_radius) * ( BILATERAL_TILE_SIZE + 2 * filter_radius) * sizeof( cl_uchar4);
+
+            int window_size = 2 * filter_radius + 1;
+            weights.resize( window_size * window_size);
+            for( int dy = -filter_radius; dy <= filter_radius; ++dy)
+            {
+                for( int dx = -filter_radius; dx <= filter_radius; ++dx)
+                {
+                    weights[ ( dy + filter_radius) * window_size + ( dx + filter_radius)] = expf( -(float)( dx * dx + dy * dy) / ( 2.0f * sigma * sigma));
+                }
+            }
+
+            range_lut.resize( RANGE_LUT_SIZE);
+            for( int d = 0; d < RANGE_LUT_SIZE; ++d)
+            {
+                float delta = (float)d / ( 3.0f * 255.0f);
+                range_lut[d] = expf( -( delta * delta) / ( 2.0f * sigma_r * sigma_r));
+            }
+            break;
+        }
+
+        case FILTER_SOBEL:
+            program_file = "../../Chapter_15_Sobel Edge Detection Filter and Grayscale/01. Edge Detection/03. Using OpenCL (local memory)/sobel_edge_detection.cl";
+            kernel_names[0] = "sobel_edge_detection_tiled_image";
+            filter_halo = 1;
+            break;
+
+        case FILTER_SOBEL_GRAYSCALE:
+            program_file = "../../Chapter_15_Sobel Edge Detection Filter and Grayscale/02. Grayscale/03. Using OpenCL (local memory)/sobel_grayscale.cl";
+            kernel_names[0] = "sobel_grayscale_tiled_image";
+            filter_halo = 1;
+            break;
+    }
+
+    ocl_program = CreateProgram( ocl_context, ocl_device, program_file);
+    if( ocl_program == nullptr)
+    {
+        std::cerr << "CreateProgram() Failed.";
+        return false;
+    }
+
+    for( int i = 0; i < 2; ++i)
+    {
+        if( kernel_names[i] == nullptr)
+        {
+            continue;
+        }
+
+        filter_kernels[i] = clCreateKernel( ocl_program, kernel_names[i], &ocl_err);
+        if( !filter_kernels[i] || ocl_err)
+        {
+            std::cerr << "clCreateKernel() Failed for " << kernel_names[i] << ". " << ocl_err << "\n";
+            return false;
+        }
+    }
+
+    cl_ulong device_local_mem_size = 0;
+    clGetDeviceInfo( ocl_device, CL_DEVICE_LOCAL_MEM_SIZE, sizeof( cl_ulong), &device_local_mem_size, nullptr);
+    if( filter_local_cache_size > device_local_mem_size)
+    {
+        std::cerr << "sigma " << sigma << " is too large for this device.\n";
+        return false;
+    }
+
+        // spatial / separable weights and the range LUT are __constant kernel arguments
+    cl_ulong device_max_constant_size = 0;
+    clGetDeviceInfo( ocl_device, CL_DEVICE_MAX_CONSTANT_BUFFER_SIZE, sizeof( cl_ulong), &device_max_constant_size, nullptr);
+
+    size_t filter_constant_size = ( weights.size() + range_lut.size()) * sizeof( float);
+    if( filter_constant_size > device_max_constant_size)
+    {
+        std::cerr << "sigma " << sigma << " is too large for this device: " << filter_constant_size
+                  << " bytes of filter weights, the device allows " << device_max_constant_size << " bytes of constant memory.\n";
+        return false;
+    }
+
+    if( filter_type == FILTER_GAUSSIAN)
+    {
+        ocl_sampler = clCreateSampler( ocl_context, CL_FALSE, CL_ADDRESS_CLAMP_TO_EDGE, CL_FILTER_NEAREST, &ocl_err);
+        if( !ocl_sampler || ocl_err)
+        {
+            std::cerr << "clCreateSampler() Failed." << ocl_err << "\n";
+            return false;
+        }
+    }
+
+    if( !weights.empty())
+    {
+        ocl_weights = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, weights.size() * sizeof( float), weights.data(), &ocl_err);
+        if( !ocl_weights || ocl_err)
+        {
+            std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+            return false;
+        }
+    }
+
+    if( !range_lut.empty())
+    {
+        ocl_range_lut = clCreateBuffer( ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, range_lut.size() * sizeof( float), range_lut.data(), &ocl_err);
+        if( !ocl_range_lut || ocl_err)
+        {
+            std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief CreateSlots() : device images ( and filter scratch) of slot_width x slot_height for every slot.
+ */
+bool CreateSlots()
+{
+    // variable declaration
+    size_t max_image_width = 0;
+    size_t max_image_height = 0;
+
+    cl_int ocl_err;
+
+    // code
+    clGetDeviceInfo( ocl_device, CL_DEVICE_IMAGE2D_MAX_WIDTH, sizeof( size_t), &max_image_width, nullptr);
+    clGetDeviceInfo( ocl_device, CL_DEVICE_IMAGE2D_MAX_HEIGHT, sizeof( size_t), &max_image_height, nullptr);
+
+    if( ( (size_t)slot_width > max_image_width) || ( (size_t)slot_height > max_image_height))
+    {
+        std::cerr << "Tile with halo ( " << slot_width << " x " << slot_height << ") exceeds the device image size ( "
+                  << max_image_width << " x " << max_image_height << "), use a smaller --tile.\n";
+        return false;
+    }
+
+    cl_image_format ocl_image_format = { };
+    ocl_image_format.image_channel_order = CL_RGBA;
+    ocl_image_format.image_channel_data_type = CL_UNORM_INT8;
+
+    cl_image_desc ocl_image_desc = { };
+    ocl_image_desc.image_type = CL_MEM_OBJECT_IMAGE2D;
+    ocl_image_desc.image_width = slot_width;
+    ocl_image_desc.image_height = slot_height;
+    ocl_image_desc.mem_object = nullptr;
+
+    cl_image_format ocl_float_format = ocl_image_format;
+    ocl_float_format.image_channel_data_type = CL_FLOAT;
+
+    for( int s = 0; s < NUM_SLOTS; ++s)
+    {
+        slot_staging[s].resize( (size_t)slot_width * slot_height * 4);
+
+        slot_src[s] = clCreateImage( ocl_context, CL_MEM_READ_ONLY, &ocl_image_format, &ocl_image_desc, nullptr, &ocl_err);
+        if( !slot_src[s] || ocl_err)
+        {
+            std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+            return false;
+        }
+
+        slot_dst[s] = clCreateImage( ocl_context, CL_MEM_WRITE_ONLY, &ocl_image_format, &ocl_image_desc, nullptr, &ocl_err);
+        if( !slot_dst[s] || ocl_err)
+        {
+            std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+            return false;
+        }
+
+            // intermediate result of two-pass filters
+        if( (filter_type == FILTER_SEPARABLE) || (filter_type == FILTER_RECURSIVE))
+        {
+            slot_tmp[s] = clCreateImage( ocl_context, CL_MEM_READ_WRITE, &ocl_float_format, &ocl_image_desc, nullptr, &ocl_err);
+            if( !slot_tmp[s] || ocl_err)
+            {
+                std::cerr << "clCreateImage() Failed." <<  ocl_err << "\n";
+                return false;
+            }
+        }
+
+        if( filter_type == FILTER_RECURSIVE)
+        {
+            slot_scratch[s] = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, (size_t)slot_width * slot_height * sizeof( cl_float4), nullptr, &ocl_err);
+            if( !slot_scratch[s] || ocl_err)
+            {
+                std::cerr << "clCreateBuffer() Failed." <<  ocl_err << "\n";
+                return false;
+            }
+        }
+    }
+
+    return true;
+}
+
+/**
+ * @brief GatherTile() : copy the tile plus halo into staging, coordinates outside the image are clamped.
+ */
+void GatherTile( const uint8_t *image_bits, size_t image_pitch, int image_width, int image_height, const Tile &tile, uint8_t *staging)
+{
+    // variable declaration
+    int sx0 = tile.x0 - filter_halo;
+    int sy0 = tile.y0 - filter_halo;
+
+    int valid_begin = std::max( sx0, 0);
+    int valid_end = std::min( sx0 + slot_width, image_width);
+
+    // code
+    for( int r = 0; r < slot_height; ++r)
+    {
+        int sy = std::min( std::max( sy0 + r, 0), image_height - 1);
+
+        const uint8_t *src_row = image_bits + sy * image_pitch;
+        uint8_t *dst_row = staging + (size_t)r * slot_width * 4;
+
+            // left halo outside the image
+        for( int c = 0; c < valid_begin - sx0; ++c)
+        {
+            memcpy( dst_row + c * 4, src_row, 4);
+        }
+
+        memcpy( dst_row + ( valid_begin - sx0) * 4, src_row + (size_t)valid_begin * 4, (size_t)( valid_end - valid_begin) * 4);
+
+            // right halo outside the image
+        for( int c = valid_end - sx0; c < slot_width; ++c)
+        {
+            memcpy( dst_row + c * 4, src_row + (size_t)( image_width - 1) * 4, 4);
+        }
+    }
+}
+
+/**
+ * @brief EnqueueFilter() : run the filter on a slot, src -> dst, on the compute queue.
+ */
+cl_int EnqueueFilter( int slot, cl_uint num_wait_events, const cl_event *wait_events, cl_event *done_event)
+{
+    // function declaration
+    size_t RoundUp( int group_size, int global_size);
+
+    // variable declaration
+    cl_int ocl_err = CL_SUCCESS;
+
+    // code
+    switch( filter_type)
+    {
+        case FILTER_GAUSSIAN:
+        {
+            size_t local_work_size[2] = { 16, 16};
+            size_t global_work_size[2] = { RoundUp( 16, slot_width), RoundUp( 16, slot_height)};
+
+            ocl_err = clSetKernelArg( filter_kernels[0], 0, sizeof( cl_mem), &slot_src[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 1, sizeof( cl_mem), &slot_dst[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 2, sizeof( cl_sampler), &ocl_sampler);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 3, sizeof( cl_int), &slot_width);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 4, sizeof( cl_int), &slot_height);
+            ocl_err |= clEnqueueNDRangeKernel( ocl_compute_queue, filter_kernels[0], 2, nullptr, global_work_size, local_work_size, num_wait_events, wait_events, done_event);
+            break;
+        }
+
+        case FILTER_SEPARABLE:
+        {
+            size_t horizontal_local_work_size[2] = { FILTER_GROUP_SIZE, CROSS_GROUP_SIZE};
+            size_t horizontal_global_work_size[2] = { RoundUp( FILTER_GROUP_SIZE, slot_width), RoundUp( CROSS_GROUP_SIZE, slot_height)};
+
+            size_t vertical_local_work_size[2] = { CROSS_GROUP_SIZE, FILTER_GROUP_SIZE};
+            size_t vertical_global_work_size[2] = { RoundUp( CROSS_GROUP_SIZE, slot_width), RoundUp( FILTER_GROUP_SIZE, slot_height)};
+
+            ocl_err = clSetKernelArg( filter_kernels[0], 0, sizeof( cl_mem), &slot_src[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 1, sizeof( cl_mem), &slot_tmp[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 2, sizeof( cl_mem), &ocl_weights);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 3, sizeof( int), &filter_radius);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 4, filter_local_cache_size, nullptr);
+
+            ocl_err |= clSetKernelArg( filter_kernels[1], 0, sizeof( cl_mem), &slot_tmp[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[1], 1, sizeof( cl_mem), &slot_dst[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[1], 2, sizeof( cl_mem), &ocl_weights);
+            ocl_err |= clSetKernelArg( filter_kernels[1], 3, sizeof( int), &filter_radius);
+            ocl_err |= clSetKernelArg( filter_kernels[1], 4, filter_local_cache_size, nullptr);
+
+            ocl_err |= clEnqueueNDRangeKernel( ocl_compute_queue, filter_kernels[0], 2, nullptr, horizontal_global_work_size, horizontal_local_work_size, num_wait_events, wait_events, nullptr);
+            ocl_err |= clEnqueueNDRangeKernel( ocl_compute_queue, filter_kernels[1], 2, nullptr, vertical_global_work_size, vertical_local_work_size, 0, nullptr, done_event);
+            break;
+        }
+
+        case FILTER_RECURSIVE:
+        {
+            size_t local_work_size = LINE_GROUP_SIZE;
+            size_t rows_global_work_size = RoundUp( LINE_GROUP_SIZE, slot_height);
+            size_t columns_global_work_size = RoundUp( LINE_GROUP_SIZE, slot_width);
+
+            ocl_err = clSetKernelArg( filter_kernels[0], 0, sizeof( cl_mem), &slot_src[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 1, sizeof( cl_mem), &slot_tmp[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 2, sizeof( cl_mem), &slot_scratch[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 3, sizeof( cl_float4), &recursive_coefficients);
+
+            ocl_err |= clSetKernelArg( filter_kernels[1], 0, sizeof( cl_mem), &slot_tmp[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[1], 1, sizeof( cl_mem), &slot_dst[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[1], 2, sizeof( cl_mem), &slot_scratch[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[1], 3, sizeof( cl_float4), &recursive_coefficients);
+
+            ocl_err |= clEnqueueNDRangeKernel( ocl_compute_queue, filter_kernels[0], 1, nullptr, &rows_global_work_size, &local_work_size, num_wait_events, wait_events, nullptr);
+            ocl_err |= clEnqueueNDRangeKernel( ocl_compute_queue, filter_kernels[1], 1, nullptr, &columns_global_work_size, &local_work_size, 0, nullptr, done_event);
+            break;
+        }
+
+        case FILTER_BILATERAL:
+        {
+            size_t local_work_size[2] = { BILATERAL_TILE_SIZE, BILATERAL_TILE_SIZE};
+            size_t global_work_size[2] = { RoundUp( BILATERAL_TILE_SIZE, slot_width), RoundUp( BILATERAL_TILE_SIZE, slot_height)};
+
+            ocl_err = clSetKernelArg( filter_kernels[0], 0, sizeof( cl_mem), &slot_src[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 1, sizeof( cl_mem), &slot_dst[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 2, sizeof( cl_mem), &ocl_weights);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 3, sizeof( cl_mem), &ocl_range_lut);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 4, sizeof( int), &filter_radius);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 5, filter_local_cache_size, nullptr);
+            ocl_err |= clEnqueueNDRangeKernel( ocl_compute_queue, filter_kernels[0], 2, nullptr, global_work_size, local_work_size, num_wait_events, wait_events, done_event);
+            break;
+        }
+
+        case FILTER_SOBEL:
+        case FILTER_SOBEL_GRAYSCALE:
+        {
+                // each work-group covers SOBEL_TILE_WIDTH x ( SOBEL_TILE_HEIGHT * SOBEL_ROWS_PER_ITEM) pixels
+            size_t local_work_size[2] = { SOBEL_TILE_WIDTH, SOBEL_TILE_HEIGHT};
+            size_t global_work_size[2] = { RoundUp( SOBEL_TILE_WIDTH, slot_width),
+                                           (size_t)( ( slot_height + SOBEL_TILE_HEIGHT * SOBEL_ROWS_PER_ITEM - 1) / ( SOBEL_TILE_HEIGHT * SOBEL_ROWS_PER_ITEM)) * SOBEL_TILE_HEIGHT};
+
+            ocl_err = clSetKernelArg( filter_kernels[0], 0, sizeof( cl_mem), &slot_src[slot]);
+            ocl_err |= clSetKernelArg( filter_kernels[0], 1, sizeof( cl_mem), &slot_dst[slot]);
+            ocl_err |= clEnqueueNDRangeKernel( ocl_compute_queue, filter_kernels[0], 2, nullptr, global_work_size, local_work_size, num_wait_events, wait_events, done_event);
+            break;
+        }
+    }
+
+    return ocl_err;
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // code
+    for( int s = 0; s < NUM_SLOTS; ++s)
+    {
+        RELEASE_CL_OBJECT( write_done[s], clReleaseEvent);
+        RELEASE_CL_OBJECT( kernel_done[s], clReleaseEvent);
+        RELEASE_CL_OBJECT( read_done[s], clReleaseEvent);
+        RELEASE_CL_OBJECT( slot_src[s], clReleaseMemObject);
+        RELEASE_CL_OBJECT( slot_dst[s], clReleaseMemObject);
+        RELEASE_CL_OBJECT( slot_tmp[s], clReleaseMemObject);
+        RELEASE_CL_OBJECT( slot_scratch[s], clReleaseMemObject);
+    }
+
+    RELEASE_CL_OBJECT( ocl_weights, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_range_lut, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_sampler, clReleaseSampler);
+    RELEASE_CL_OBJECT( filter_kernels[0], clReleaseKernel);
+    RELEASE_CL_OBJECT( filter_kernels[1], clReleaseKernel);
+    RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+    RELEASE_CL_OBJECT( ocl_transfer_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_compute_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+    RELEASE_CL_OBJECT( input_image, FreeImage_Unload);
+    RELEASE_CL_OBJECT( output_image, FreeImage_Unload);
+}
+
+/**
+ * @brief RoundUp()
+ */
+size_t RoundUp( int group_size, int global_size)
+{
+    // code
+    int r = global_size % group_size;
+    if( r == 0)
+    {
+        return global_size;
+    }
+    else
+    {
+        return global_size + group_size - r;
+    }
+}
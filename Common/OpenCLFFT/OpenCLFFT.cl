@@ -0,0 +1,246 @@
+/************************
+ *
+ * Batched FFT kernels, see OpenCLFFT.h.
+ *
+ * 1. fft_radix2 / fft_radix4 / fft_radix8()
+ *      One Stockham pass of radix R over many lines of length n ( Govindaraju et al., 2008).
+ *      Work-item j < n / R of a line reads R values n / R apart, multiplies them by the twiddles of its
+ *      sub-transform, does an R point DFT and writes them span apart into the next ordering:
+ *
+ *          k   = j % span
+ *          v_r = src[ j + r * n / R] * w_n^( r * k * n / ( span * R))
+ *          V   = DFT_R( v)
+ *          dst[ ( j - k) * R + k + r * span] = V_r
+ *
+ *      span runs 1, R1, R1 * R2, ... up to n, so log_R( n) passes give the transform in natural order.
+ *      w_n^t = exp( -2 pi i t / n) is read from a twiddle table of n entries built on the host,
+ *      the inverse uses its conjugate.
+ *
+ *      Element i of line l is at ( l / lines_per_block) * block_stride + ( l % lines_per_block) * line_stride
+ *      + i * element_stride, so the same kernels transform rows ( element_stride 1) and columns
+ *      ( element_stride = row length) of a batch of 2D arrays.
+ *
+ * 2. fft_r2c_postprocess() / fft_c2r_preprocess()
+ *      A real line x of even length n is read as n / 2 complex values z[m] = x[2m] + i x[2m + 1].
+ *      After the n / 2 point FFT Z of z, the n / 2 + 1 non-redundant values of X = FFT( x) are
+ *
+ *          Fe = ( Z[k] + conj( Z[n / 2 - k])) / 2
+ *          Fo = ( Z[k] - conj( Z[n / 2 - k])) / 2i
+ *          X[k] = Fe + w_n^k * Fo
+ *
+ *      and the inverse recovers Z from X the other way round.
+ *
+ * Complex values are float2 ( re, im).
+ */
+
+/**
+ * @brief cmul(): complex product.
+ */
+inline float2 cmul( float2 a, float2 b)
+{
+    // code
+    return (float2)( a.x * b.x - a.y * b.y, a.x * b.y + a.y * b.x);
+}
+
+/**
+ * @brief mul_i(): a * ( direction * i), direction is -1 ( forward) or +1 ( inverse).
+ */
+inline float2 mul_i( float2 a, float direction)
+{
+    // code
+    return (float2)( -direction * a.y, direction * a.x);
+}
+
+/**
+ * @brief twiddle(): w_n^t for the forward, its conjugate for the inverse transform.
+ */
+inline float2 twiddle( __global const float2 *twiddles, int t, float direction)
+{
+    // variable declaration
+    float2 w = twiddles[t];
+
+    // code
+    return (float2)( w.x, -direction * w.y);
+}
+
+/**
+ * @brief line_offset(): offset of element 0 of line l.
+ */
+inline int line_offset( int line, int line_stride, int lines_per_block, int block_stride)
+{
+    // variable declaration
+    int block = line / lines_per_block;
+
+    // code
+    return block * block_stride + ( line - block * lines_per_block) * line_stride;
+}
+
+/**
+ * @brief dft4(): in-place 4 point DFT.
+ */
+inline void dft4( float2 *v0, float2 *v1, float2 *v2, float2 *v3, float direction)
+{
+    // variable declaration
+    float2 t0 = *v0 + *v2;
+    float2 t1 = *v0 - *v2;
+    float2 t2 = *v1 + *v3;
+    float2 t3 = mul_i( *v1 - *v3, direction);
+
+    // code
+    *v0 = t0 + t2;
+    *v1 = t1 + t3;
+    *v2 = t0 - t2;
+    *v3 = t1 - t3;
+}
+
+/**
+ * FFT_PASS_BEGIN / FFT_PASS_END: shared load ( with twiddles) and store of the radix-R pass kernels.
+ */
+#define FFT_PASS_ARGUMENTS                  \
+    __global const float2 *src,             \
+    __global float2 *dst,                   \
+    __global const float2 *twiddles,        \
+    int n,                                  \
+    int span,                               \
+    int element_stride,                     \
+    int line_stride,                        \
+    int lines_per_block,                    \
+    int block_stride,                       \
+    float direction,                        \
+    float scale
+
+#define FFT_PASS_BEGIN( R)                                                                      \
+    int j = (int)get_global_id(0);                                                              \
+    int line = (int)get_global_id(1);                                                           \
+                                                                                                \
+    int offset = line_offset( line, line_stride, lines_per_block, block_stride);                \
+    int k = j % span;                                                                           \
+    int part = n / R;                                                                           \
+    int twiddle_step = k * ( n / ( span * R));                                                  \
+                                                                                                \
+    float2 v[R];                                                                                \
+    for( int r = 0; r < R; ++r)                                                                 \
+    {                                                                                           \
+        v[r] = src[ offset + ( j + r * part) * element_stride];                                 \
+    }                                                                                           \
+    for( int r = 1; r < R; ++r)                                                                 \
+    {                                                                                           \
+        v[r] = cmul( v[r], twiddle( twiddles, r * twiddle_step, direction));                    \
+    }
+
+#define FFT_PASS_END( R)                                                                        \
+    int out = ( j - k) * R + k;                                                                 \
+    for( int r = 0; r < R; ++r)                                                                 \
+    {                                                                                           \
+        dst[ offset + ( out + r * span) * element_stride] = scale * v[r];                       \
+    }
+
+/**
+ * @brief fft_radix2(): global size ( n / 2, number of lines).
+ */
+__kernel void fft_radix2( FFT_PASS_ARGUMENTS)
+{
+    // code
+    FFT_PASS_BEGIN( 2)
+
+    float2 a = v[0];
+    v[0] = a + v[1];
+    v[1] = a - v[1];
+
+    FFT_PASS_END( 2)
+}
+
+/**
+ * @brief fft_radix4(): global size ( n / 4, number of lines).
+ */
+__kernel void fft_radix4( FFT_PASS_ARGUMENTS)
+{
+    // code
+    FFT_PASS_BEGIN( 4)
+
+    dft4( &v[0], &v[1], &v[2], &v[3], direction);
+
+    FFT_PASS_END( 4)
+}
+
+/**
+ * @brief fft_radix8(): global size ( n / 8, number of lines).
+ *        8 point DFT = 4 point DFTs of the even and odd values, combined with w_8^q.
+ */
+__kernel void fft_radix8( FFT_PASS_ARGUMENTS)
+{
+    // code
+    FFT_PASS_BEGIN( 8)
+
+    float2 e0 = v[0], e1 = v[2], e2 = v[4], e3 = v[6];
+    float2 o0 = v[1], o1 = v[3], o2 = v[5], o3 = v[7];
+
+    dft4( &e0, &e1, &e2, &e3, direction);
+    dft4( &o0, &o1, &o2, &o3, direction);
+
+        // w_8 = ( 1 + direction * i) / sqrt( 2)
+    const float h = 0.70710678118654752f;
+
+    o1 = h * ( o1 + mul_i( o1, direction));
+    o2 = mul_i( o2, direction);
+    o3 = h * ( mul_i( o3, direction) - o3);
+
+    v[0] = e0 + o0;  v[4] = e0 - o0;
+    v[1] = e1 + o1;  v[5] = e1 - o1;
+    v[2] = e2 + o2;  v[6] = e2 - o2;
+    v[3] = e3 + o3;  v[7] = e3 - o3;
+
+    FFT_PASS_END( 8)
+}
+
+/**
+ * @brief fft_r2c_postprocess(): Z ( n / 2 values per line) -> X ( n / 2 + 1 values per line).
+ *        global size ( n / 2 + 1, number of lines), lines are contiguous.
+ *
+ * @param twiddles table of n entries
+ */
+__kernel void fft_r2c_postprocess( __global const float2 *src, __global float2 *dst, __global const float2 *twiddles, int n)
+{
+    // variable declaration
+    int k = (int)get_global_id(0);
+    int line = (int)get_global_id(1);
+
+    int half_n = n >> 1;
+
+    // code
+    __global const float2 *z = src + line * half_n;
+
+    float2 a = z[ k % half_n];
+    float2 b = z[ ( half_n - k) % half_n];
+    b.y = -b.y;
+
+    float2 fe = 0.5f * ( a + b);
+    float2 fo = mul_i( 0.5f * ( a - b), -1.0f);
+
+    dst[ line * ( half_n + 1) + k] = fe + cmul( twiddle( twiddles, k, -1.0f), fo);
+}
+
+/**
+ * @brief fft_c2r_preprocess(): X ( n / 2 + 1 values per line) -> Z ( n / 2 values per line).
+ *        global size ( n / 2, number of lines), lines are contiguous.
+ */
+__kernel void fft_c2r_preprocess( __global const float2 *src, __global float2 *dst, __global const float2 *twiddles, int n)
+{
+    // variable declaration
+    int k = (int)get_global_id(0);
+    int line = (int)get_global_id(1);
+
+    int half_n = n >> 1;
+
+    // code
+    __global const float2 *x = src + line * ( half_n + 1);
+
+    float2 a = x[k];
+    float2 b = x[ half_n - k];
+    b.y = -b.y;
+
+    float2 fe = 0.5f * ( a + b);
+    float2 fo = cmul( 0.5f * ( a - b), twiddle( twiddles, k, 1.0f));
+
+    dst[ line * half_n + k] = fe + mul_i( fo, 1.0f);
+}
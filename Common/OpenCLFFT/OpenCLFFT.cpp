@@ -0,0 +1,492 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+#ifndef _USE_MATH_DEFINES
+#define _USE_MATH_DEFINES
+#endif
+
+#include <iostream>
+#include <vector>
+#include <map>
+
+#include <cmath>
+
+#include "OpenCLUtil.h"
+#include "OpenCLFFT.h"
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+namespace OpenCLFFT
+{
+    //////////////////////////////////////////////
+    ///////// TYPE DEFINITION
+    //////////////////////////////////////////////
+    enum KERNEL_ID
+    {
+        KERNEL_RADIX2 = 0,
+        KERNEL_RADIX4,
+        KERNEL_RADIX8,
+        KERNEL_R2C_POSTPROCESS,
+        KERNEL_C2R_PREPROCESS,
+
+        KERNEL_COUNT
+    };
+
+    const char *kernel_names[KERNEL_COUNT] = { "fft_radix2", "fft_radix4", "fft_radix8", "fft_r2c_postprocess", "fft_c2r_preprocess"};
+
+    struct _Library
+    {
+        cl_context ocl_context = nullptr;
+        cl_program ocl_program = nullptr;
+        cl_kernel ocl_kernels[KERNEL_COUNT] = { nullptr };
+
+            // w_n^t = exp( -2 pi i t / n), t < n, keyed by n
+        std::map<int, cl_mem> twiddles;
+
+        ~_Library()
+        {
+            for( auto &entry : twiddles)
+            {
+                RELEASE_CL_OBJECT( entry.second, clReleaseMemObject);
+            }
+
+            for( int k = 0; k < KERNEL_COUNT; ++k)
+            {
+                RELEASE_CL_OBJECT( ocl_kernels[k], clReleaseKernel);
+            }
+
+            RELEASE_CL_OBJECT( ocl_program, clReleaseProgram);
+        }
+    };
+
+        // one kernel launch of a plan
+    struct Step
+    {
+        KERNEL_ID kernel;
+        cl_mem twiddles;
+
+        int n;
+        int span;
+        int element_stride;
+        int line_stride;
+        int lines_per_block;
+        int block_stride;
+
+        size_t global_work_size[2];
+
+        float scale;
+    };
+
+    struct _Plan
+    {
+        Library library = nullptr;
+
+        FFT_TYPE type = FFT_C2C;
+        int width = 0;
+        int height = 0;
+        int batch = 0;
+
+        std::vector<Step> steps[2];
+
+        cl_mem ocl_scratch[2] = { nullptr };
+
+        ~_Plan()
+        {
+            RELEASE_CL_OBJECT( ocl_scratch[0], clReleaseMemObject);
+            RELEASE_CL_OBJECT( ocl_scratch[1], clReleaseMemObject);
+        }
+    };
+
+    //////////////////////////////////////////////
+    ////// FUNCTION DEFINITION
+    //////////////////////////////////////////////
+
+    /**
+     * @brief Log2(): -1 if value is not a power of 2.
+     */
+    static int Log2( int value)
+    {
+        // variable declaration
+        int result = 0;
+
+        // code
+        if( (value < 1) || (value & ( value - 1)))
+        {
+            return -1;
+        }
+
+        while( (1 << result) < value)
+        {
+            ++result;
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief GetTwiddles(): twiddle table of n values, created on first use.
+     */
+    static cl_mem GetTwiddles( Library library, int n)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        auto found = library->twiddles.find( n);
+        if( found != library->twiddles.end())
+        {
+            return found->second;
+        }
+
+            // in double, so large tables are as accurate as small ones
+        std::vector<cl_float2> table( n);
+        for( int t = 0; t < n; ++t)
+        {
+            double angle = -2.0 * M_PI * (double)t / (double)n;
+
+            table[t].s[0] = (float)cos( angle);
+            table[t].s[1] = (float)sin( angle);
+        }
+
+        cl_mem ocl_table = clCreateBuffer( library->ocl_context, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, n * sizeof( cl_float2), table.data(), &ocl_err);
+        if( !ocl_table || ocl_err)
+        {
+            std::cerr << "clCreateBuffer() Failed." << ocl_err << "\n";
+            return nullptr;
+        }
+
+        library->twiddles[n] = ocl_table;
+
+        return ocl_table;
+    }
+
+    /**
+     * @brief AddPasses(): Stockham passes of one axis, radix 8 first, the last pass applies scale.
+     *
+     *  log2( n) = 3 * a + b, b = 1 is done as 4 * 4 instead of 8 * 2 when possible.
+     */
+    static bool AddPasses( Library library, std::vector<Step> &steps, int n, int element_stride, int line_stride, int lines_per_block, int block_stride, int num_lines, float scale)
+    {
+        // variable declaration
+        int log2_n = Log2( n);
+
+        int num_radix8 = log2_n / 3;
+        int remainder = log2_n % 3;
+
+        std::vector<KERNEL_ID> radices;
+
+        // code
+        if( (remainder == 1) && (num_radix8 > 0))
+        {
+            --num_radix8;
+            radices.push_back( KERNEL_RADIX4);
+            radices.push_back( KERNEL_RADIX4);
+        }
+        else if( remainder == 2)
+        {
+            radices.push_back( KERNEL_RADIX4);
+        }
+        else if( remainder == 1)
+        {
+            radices.push_back( KERNEL_RADIX2);
+        }
+
+        radices.insert( radices.begin(), num_radix8, KERNEL_RADIX8);
+
+        if( radices.empty())
+        {
+            return true;
+        }
+
+        cl_mem ocl_twiddles = GetTwiddles( library, n);
+        if( ocl_twiddles == nullptr)
+        {
+            return false;
+        }
+
+        int span = 1;
+        for( size_t i = 0; i < radices.size(); ++i)
+        {
+                // KERNEL_RADIX2 / 4 / 8 are 0 / 1 / 2
+            int radix = 2 << radices[i];
+
+            Step step = { };
+            step.kernel = radices[i];
+            step.twiddles = ocl_twiddles;
+            step.n = n;
+            step.span = span;
+            step.element_stride = element_stride;
+            step.line_stride = line_stride;
+            step.lines_per_block = lines_per_block;
+            step.block_stride = block_stride;
+            step.global_work_size[0] = (size_t)( n / radix);
+            step.global_work_size[1] = (size_t)num_lines;
+            step.scale = ( i + 1 == radices.size()) ? scale : 1.0f;
+
+            steps.push_back( step);
+
+            span *= radix;
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief AddRealStep(): R2C post-process or C2R pre-process of lines of n real values.
+     */
+    static bool AddRealStep( Library library, std::vector<Step> &steps, KERNEL_ID kernel, int n, int num_lines)
+    {
+        // code
+        Step step = { };
+        step.kernel = kernel;
+        step.twiddles = GetTwiddles( library, n);
+        step.n = n;
+        step.global_work_size[0] = (size_t)( ( kernel == KERNEL_R2C_POSTPROCESS) ? n / 2 + 1 : n / 2);
+        step.global_work_size[1] = (size_t)num_lines;
+        step.scale = 1.0f;
+
+        steps.push_back( step);
+
+        return ( step.twiddles != nullptr);
+    }
+
+    /**
+     * @brief CreateLibrary(): build OpenCLFFT.cl and create all kernels.
+     */
+    Library CreateLibrary( cl_context ocl_context, cl_device_id ocl_device, const char *kernel_file_name)
+    {
+        // variable declaration
+        cl_int ocl_err;
+        Library library = new _Library();
+
+        // code
+        library->ocl_context = ocl_context;
+
+        library->ocl_program = CreateProgram( ocl_context, ocl_device, kernel_file_name);
+        if( library->ocl_program == nullptr)
+        {
+            std::cerr << "CreateProgram() Failed.\n";
+            delete library;
+            return nullptr;
+        }
+
+        for( int k = 0; k < KERNEL_COUNT; ++k)
+        {
+            library->ocl_kernels[k] = clCreateKernel( library->ocl_program, kernel_names[k], &ocl_err);
+            if( !library->ocl_kernels[k] || ocl_err)
+            {
+                std::cerr << "clCreateKernel( " << kernel_names[k] << ") Failed." << ocl_err << "\n";
+                delete library;
+                return nullptr;
+            }
+        }
+
+        return library;
+    }
+
+    /**
+     * @brief DeleteLibrary(): all plans of the library must be deleted first.
+     */
+    void DeleteLibrary( Library library)
+    {
+        // code
+        delete library;
+    }
+
+    /**
+     * @brief CreatePlan()
+     */
+    Plan CreatePlan( Library library, FFT_TYPE type, int width, int height, int batch)
+    {
+        // variable declaration
+        cl_int ocl_err;
+
+        // code
+        if( (Log2( width) < 1) || (Log2( height) < 0) || (batch < 1))
+        {
+            return nullptr;
+        }
+
+        Plan plan = new _Plan();
+        plan->library = library;
+        plan->type = type;
+        plan->width = width;
+        plan->height = height;
+        plan->batch = batch;
+
+        std::vector<Step> &forward = plan->steps[FFT_FORWARD];
+        std::vector<Step> &inverse = plan->steps[FFT_INVERSE];
+
+        bool result = true;
+        size_t scratch_size = 0;
+
+        if( type == FFT_C2C)
+        {
+                // rows, then columns
+            int num_rows = height * batch;
+
+            result &= AddPasses( library, forward, width, 1, width, num_rows, 0, num_rows, 1.0f);
+            result &= AddPasses( library, forward, height, width, 1, width, width * height, width * batch, 1.0f);
+
+            result &= AddPasses( library, inverse, width, 1, width, num_rows, 0, num_rows, 1.0f / width);
+            result &= AddPasses( library, inverse, height, width, 1, width, width * height, width * batch, 1.0f / height);
+
+            scratch_size = (size_t)width * height * batch * sizeof( cl_float2);
+        }
+        else
+        {
+                // rows of width real values are width / 2 complex values
+            int half_width = width / 2;
+            int spectrum_width = half_width + 1;
+            int num_rows = height * batch;
+
+            result &= AddPasses( library, forward, half_width, 1, half_width, num_rows, 0, num_rows, 1.0f);
+            result &= AddRealStep( library, forward, KERNEL_R2C_POSTPROCESS, width, num_rows);
+            result &= AddPasses( library, forward, height, spectrum_width, 1, spectrum_width, spectrum_width * height, spectrum_width * batch, 1.0f);
+
+            result &= AddPasses( library, inverse, height, spectrum_width, 1, spectrum_width, spectrum_width * height, spectrum_width * batch, 1.0f / height);
+            result &= AddRealStep( library, inverse, KERNEL_C2R_PREPROCESS, width, num_rows);
+            result &= AddPasses( library, inverse, half_width, 1, half_width, num_rows, 0, num_rows, 1.0f / half_width);
+
+            scratch_size = (size_t)spectrum_width * height * batch * sizeof( cl_float2);
+        }
+
+        if( !result)
+        {
+            delete plan;
+            return nullptr;
+        }
+
+        for( int i = 0; i < 2; ++i)
+        {
+            plan->ocl_scratch[i] = clCreateBuffer( library->ocl_context, CL_MEM_READ_WRITE, scratch_size, nullptr, &ocl_err);
+            if( !plan->ocl_scratch[i] || ocl_err)
+            {
+                std::cerr << "clCreateBuffer() Failed." << ocl_err << "\n";
+                delete plan;
+                return nullptr;
+            }
+        }
+
+        return plan;
+    }
+
+    /**
+     * @brief InputSize()
+     */
+    size_t InputSize( Plan plan, FFT_DIRECTION direction)
+    {
+        // variable declaration
+        size_t count = (size_t)plan->height * plan->batch;
+
+        // code
+        if( plan->type == FFT_C2C)
+        {
+            return count * plan->width * sizeof( cl_float2);
+        }
+
+        return ( direction == FFT_FORWARD) ? count * plan->width * sizeof( cl_float) : count * ( plan->width / 2 + 1) * sizeof( cl_float2);
+    }
+
+    /**
+     * @brief OutputSize()
+     */
+    size_t OutputSize( Plan plan, FFT_DIRECTION direction)
+    {
+        // code
+        return InputSize( plan, ( direction == FFT_FORWARD) ? FFT_INVERSE : FFT_FORWARD);
+    }
+
+    /**
+     * @brief Execute(): step i reads the output of step i - 1, the steps in between ping-pong between the
+     *        two scratch buffers.
+     */
+    cl_int Execute(
+        Plan plan,
+        cl_command_queue ocl_command_queue,
+        FFT_DIRECTION direction,
+        cl_mem input,
+        cl_mem output,
+        cl_uint num_events_in_wait_list,
+        const cl_event *event_wait_list,
+        cl_event *event
+    )
+    {
+        // variable declaration
+        cl_int ocl_err = CL_SUCCESS;
+
+        const std::vector<Step> &steps = plan->steps[direction];
+        size_t num_steps = steps.size();
+
+            // a single step cannot run in place
+        bool copy_back = ( num_steps == 1) && ( input == output);
+
+        float direction_sign = ( direction == FFT_FORWARD) ? -1.0f : 1.0f;
+
+        // code
+        for( size_t i = 0; i < num_steps; ++i)
+        {
+            const Step &step = steps[i];
+            cl_kernel ocl_kernel = plan->library->ocl_kernels[step.kernel];
+
+            cl_mem src = ( i == 0) ? input : plan->ocl_scratch[ ( i - 1) & 1];
+            cl_mem dst = ( (i + 1 == num_steps) && !copy_back) ? output : plan->ocl_scratch[ i & 1];
+
+            ocl_err = clSetKernelArg( ocl_kernel, 0, sizeof( cl_mem), &src);
+            ocl_err |= clSetKernelArg( ocl_kernel, 1, sizeof( cl_mem), &dst);
+            ocl_err |= clSetKernelArg( ocl_kernel, 2, sizeof( cl_mem), &step.twiddles);
+            ocl_err |= clSetKernelArg( ocl_kernel, 3, sizeof( int), &step.n);
+
+            if( (step.kernel != KERNEL_R2C_POSTPROCESS) && (step.kernel != KERNEL_C2R_PREPROCESS))
+            {
+                ocl_err |= clSetKernelArg( ocl_kernel, 4, sizeof( int), &step.span);
+                ocl_err |= clSetKernelArg( ocl_kernel, 5, sizeof( int), &step.element_stride);
+                ocl_err |= clSetKernelArg( ocl_kernel, 6, sizeof( int), &step.line_stride);
+                ocl_err |= clSetKernelArg( ocl_kernel, 7, sizeof( int), &step.lines_per_block);
+                ocl_err |= clSetKernelArg( ocl_kernel, 8, sizeof( int), &step.block_stride);
+                ocl_err |= clSetKernelArg( ocl_kernel, 9, sizeof( float), &direction_sign);
+                ocl_err |= clSetKernelArg( ocl_kernel, 10, sizeof( float), &step.scale);
+            }
+
+            if( ocl_err != CL_SUCCESS)
+            {
+                return ocl_err;
+            }
+
+            ocl_err = clEnqueueNDRangeKernel(
+                        ocl_command_queue, ocl_kernel, 2, nullptr, step.global_work_size, nullptr,
+                        ( i == 0) ? num_events_in_wait_list : 0,
+                        ( i == 0) ? event_wait_list : nullptr,
+                        ( (i + 1 == num_steps) && !copy_back) ? event : nullptr
+                    );
+            if( ocl_err != CL_SUCCESS)
+            {
+                return ocl_err;
+            }
+        }
+
+        if( copy_back)
+        {
+            ocl_err = clEnqueueCopyBuffer( ocl_command_queue, plan->ocl_scratch[0], output, 0, 0, OutputSize( plan, direction), 0, nullptr, event);
+        }
+
+        return ocl_err;
+    }
+
+    /**
+     * @brief DeletePlan()
+     */
+    void DeletePlan( Plan plan)
+    {
+        // code
+        delete plan;
+    }
+
+} // namespace OpenCLFFT
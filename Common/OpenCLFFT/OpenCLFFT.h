@@ -0,0 +1,62 @@
+#include <cl/cl.h>
+
+/**
+ * Batched 1D / 2D FFT on OpenCL buffers, kernels in OpenCLFFT.cl.
+ *
+ *  - Library : program, kernels and twiddle tables ( one table of n values per transform length n,
+ *              shared by every plan of the library). Create it once per context.
+ *  - Plan    : the pass schedule and scratch buffers of one transform size, reused by every Execute().
+ *
+ * Sizes are powers of 2, every pass is a radix-8, radix-4 or radix-2 Stockham pass.
+ * A 1D plan has height 1. Batches are stored one after another.
+ *
+ * Buffer layout ( complex values are cl_float2 ( re, im), rows of width values):
+ *      FFT_C2C forward / inverse : width x height complex   -> width x height complex
+ *      FFT_R2C forward           : width x height cl_float  -> ( width / 2 + 1) x height complex
+ *      FFT_R2C inverse ( C2R)    : ( width / 2 + 1) x height complex -> width x height cl_float
+ *
+ * The forward transform is X[k] = sum( x[n] * exp( -2 pi i k n / N)), the inverse is scaled by 1 / N so a
+ * forward and inverse transform give back the input. input may be the same buffer as output.
+ */
+namespace OpenCLFFT
+{
+    enum FFT_TYPE
+    {
+        FFT_C2C = 0,
+        FFT_R2C
+    };
+
+    enum FFT_DIRECTION
+    {
+        FFT_FORWARD = 0,
+        FFT_INVERSE
+    };
+
+    typedef struct _Library* Library;
+    typedef struct _Plan* Plan;
+
+    Library CreateLibrary( cl_context ocl_context, cl_device_id ocl_device, const char *kernel_file_name);
+    void DeleteLibrary( Library library);
+
+        // nullptr if width / height is not a power of 2 or width < 2
+    Plan CreatePlan( Library library, FFT_TYPE type, int width, int height, int batch);
+
+        // bytes of the input / output buffer of one Execute()
+    size_t InputSize( Plan plan, FFT_DIRECTION direction);
+    size_t OutputSize( Plan plan, FFT_DIRECTION direction);
+
+        // enqueue one transform, does not wait for it
+    cl_int Execute(
+        Plan plan,
+        cl_command_queue ocl_command_queue,
+        FFT_DIRECTION direction,
+        cl_mem input,
+        cl_mem output,
+        cl_uint num_events_in_wait_list = 0,
+        const cl_event *event_wait_list = nullptr,
+        cl_event *event = nullptr
+    );
+
+    void DeletePlan( Plan plan);
+
+} // namespace OpenCLFFT
@@ -0,0 +1,465 @@
+/**
+ * @author : Vijaykumar Dangi
+ * @date   : 19-Oct-2026
+ */
+
+/************************
+ *
+ * OpenCLFFT validation and benchmark.
+ *
+ *  - every plan in the test list transforms random data forward, the result is compared with a direct
+ *    DFT computed in double on the CPU, then the inverse transform is compared with the input.
+ *    The error is || gpu - reference || / || reference ||.
+ *  - the benchmark times a --size x --size complex 2D transform.
+ *
+ *  Run from this directory, the kernels are read from ../OpenCLFFT.cl.
+ */
+
+#ifndef _USE_MATH_DEFINES
+#define _USE_MATH_DEFINES
+#endif
+
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <vector>
+#include <complex>
+#include <random>
+#include <algorithm>
+
+#include <cmath>
+
+#include "OpenCLUtil.h"
+#include "../OpenCLFFT.h"
+
+#define DEFAULT_PLATFORM 0
+#define DEFAULT_BENCHMARK_SIZE 1024
+
+    // float FFTs of these sizes stay well below this
+#define MAX_RELATIVE_ERROR 1.0e-5
+
+#define RELEASE_CL_OBJECT( obj, release_func) \
+    if(obj) \
+    {   \
+        release_func(obj);    \
+        obj = nullptr;  \
+    }
+
+struct FFTTest
+{
+    OpenCLFFT::FFT_TYPE type;
+    int width;
+    int height;
+    int batch;
+};
+
+const FFTTest fft_tests[] =
+{
+        // 1D, every radix schedule up to 8 * 8 * 8 * 8
+    { OpenCLFFT::FFT_C2C,    2, 1, 3}, { OpenCLFFT::FFT_C2C,    4, 1, 3}, { OpenCLFFT::FFT_C2C,    8, 1, 3},
+    { OpenCLFFT::FFT_C2C,   16, 1, 3}, { OpenCLFFT::FFT_C2C,   32, 1, 3}, { OpenCLFFT::FFT_C2C,   64, 1, 3},
+    { OpenCLFFT::FFT_C2C,  128, 1, 3}, { OpenCLFFT::FFT_C2C,  256, 1, 3}, { OpenCLFFT::FFT_C2C,  512, 1, 3},
+    { OpenCLFFT::FFT_C2C, 1024, 1, 3}, { OpenCLFFT::FFT_C2C, 2048, 1, 3}, { OpenCLFFT::FFT_C2C, 4096, 1, 3},
+
+        // 2D
+    { OpenCLFFT::FFT_C2C,    8,    4, 2}, { OpenCLFFT::FFT_C2C,   64,   32, 3},
+    { OpenCLFFT::FFT_C2C,  256,  128, 1}, { OpenCLFFT::FFT_C2C,    2, 1024, 1},
+
+        // real to complex
+    { OpenCLFFT::FFT_R2C,    2, 1, 2}, { OpenCLFFT::FFT_R2C,    4, 1, 2}, { OpenCLFFT::FFT_R2C,   16, 1, 2},
+    { OpenCLFFT::FFT_R2C,  256, 1, 2}, { OpenCLFFT::FFT_R2C, 4096, 1, 2},
+    { OpenCLFFT::FFT_R2C,   64,   32, 2}, { OpenCLFFT::FFT_R2C,  128,  256, 1}
+};
+
+cl_context ocl_context = nullptr;
+cl_command_queue ocl_command_queue = nullptr;
+cl_device_id ocl_device = nullptr;
+
+OpenCLFFT::Library fft_library = nullptr;
+OpenCLFFT::Plan fft_plan = nullptr;
+
+cl_mem ocl_input = nullptr;
+cl_mem ocl_output = nullptr;
+
+/**
+ * @brief main() : Entry-Point function
+ */
+int main( int argc, char **argv)
+{
+    // function declaration
+    bool RunTest( const FFTTest &test);
+    bool RunBenchmark( int size, int num_iterations);
+    void  cleanup();
+
+    // variable declaration
+    int platform_used = DEFAULT_PLATFORM;
+    int benchmark_size = DEFAULT_BENCHMARK_SIZE;
+    int num_iterations = 10;
+
+    int num_failed = 0;
+
+    // code
+    for( int i = 1; i < argc; ++i)
+    {
+        std::string input( argv[i]);
+        if( !input.compare( "--platform") && (i + 1 < argc))
+        {
+            platform_used = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--size") && (i + 1 < argc))
+        {
+            benchmark_size = atoi( argv[++i]);
+        }
+        else if( !input.compare( "--iterations") && (i + 1 < argc))
+        {
+            num_iterations = std::max( 1, atoi( argv[++i]));
+        }
+        else
+        {
+            std::cerr << "usage: " << argv[0] << "\n";
+            std::cerr << "options: " << "\n"
+                      << "   --platform n\n"
+                      << "   --size n: benchmark n x n complex 2D FFT, power of 2 (default " << DEFAULT_BENCHMARK_SIZE << ")\n"
+                      << "   --iterations n: number of timed runs (default 10)"
+                      << std::endl;
+
+            return EXIT_SUCCESS;
+        }
+    }
+
+        /******** Initialize OpenCL ***********/
+    ocl_context = CreateContext( platform_used);
+    if( ocl_context == nullptr)
+    {
+        std::cerr << "CreateContext() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    ocl_command_queue = CreateCommandQueue( ocl_context, &ocl_device);
+    if( ocl_command_queue == nullptr)
+    {
+        std::cerr << "CreateCommandQueue() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    fft_library = OpenCLFFT::CreateLibrary( ocl_context, ocl_device, "../OpenCLFFT.cl");
+    if( fft_library == nullptr)
+    {
+        std::cerr << "OpenCLFFT::CreateLibrary() Failed.";
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+        /******** Validation ***********/
+    for( const FFTTest &test : fft_tests)
+    {
+        if( !RunTest( test))
+        {
+            ++num_failed;
+        }
+    }
+
+    std::cout << "\n" << num_failed << " of " << sizeof( fft_tests) / sizeof( fft_tests[0]) << " tests failed.\n\n";
+
+        /******** Benchmark ***********/
+    if( !RunBenchmark( benchmark_size, num_iterations))
+    {
+        cleanup();
+        return EXIT_FAILURE;
+    }
+
+    cleanup();
+
+    return ( num_failed == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+/**
+ * @brief ReferenceDFT(): direct 2D DFT of batch width x height arrays, rows then columns.
+ */
+void ReferenceDFT( std::vector< std::complex<double> > &data, int width, int height, int batch)
+{
+    // variable declaration
+    std::vector< std::complex<double> > line;
+    std::vector< std::complex<double> > result;
+
+    // code
+    for( int b = 0; b < batch; ++b)
+    {
+        std::complex<double> *array = data.data() + (size_t)b * width * height;
+
+        for( int axis = 0; axis < 2; ++axis)
+        {
+            int n = ( axis == 0) ? width : height;
+            int num_lines = ( axis == 0) ? height : width;
+            int element_stride = ( axis == 0) ? 1 : width;
+            int line_stride = ( axis == 0) ? width : 1;
+
+            line.resize( n);
+            result.resize( n);
+
+            for( int l = 0; l < num_lines; ++l)
+            {
+                for( int i = 0; i < n; ++i)
+                {
+                    line[i] = array[ l * line_stride + i * element_stride];
+                }
+
+                for( int k = 0; k < n; ++k)
+                {
+                    std::complex<double> sum = 0.0;
+                    for( int i = 0; i < n; ++i)
+                    {
+                        sum += line[i] * std::polar( 1.0, -2.0 * M_PI * (double)( ( (long long)k * i) % n) / (double)n);
+                    }
+                    result[k] = sum;
+                }
+
+                for( int k = 0; k < n; ++k)
+                {
+                    array[ l * line_stride + k * element_stride] = result[k];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @brief RelativeError(): || a - b || / || b || over count values.
+ */
+double RelativeError( const float *a, const double *b, size_t count)
+{
+    // variable declaration
+    double error = 0.0;
+    double norm = 0.0;
+
+    // code
+    for( size_t i = 0; i < count; ++i)
+    {
+        error += ( a[i] - b[i]) * ( a[i] - b[i]);
+        norm += b[i] * b[i];
+    }
+
+    return sqrt( error / std::max( norm, 1.0e-30));
+}
+
+/**
+ * @brief ReleaseTestObjects(): plan and buffers of one test.
+ */
+void ReleaseTestObjects()
+{
+    // code
+    RELEASE_CL_OBJECT( ocl_input, clReleaseMemObject);
+    RELEASE_CL_OBJECT( ocl_output, clReleaseMemObject);
+
+    if( fft_plan)
+    {
+        OpenCLFFT::DeletePlan( fft_plan);
+        fft_plan = nullptr;
+    }
+}
+
+/**
+ * @brief RunTest(): forward transform against ReferenceDFT(), inverse against the input.
+ */
+bool RunTest( const FFTTest &test)
+{
+    // function declaration
+    void ReferenceDFT( std::vector< std::complex<double> > &data, int width, int height, int batch);
+    double RelativeError( const float *a, const double *b, size_t count);
+    void ReleaseTestObjects();
+
+    // variable declaration
+    cl_int ocl_err;
+
+    bool is_real = ( test.type == OpenCLFFT::FFT_R2C);
+
+    size_t count = (size_t)test.width * test.height * test.batch;
+    int spectrum_width = is_real ? test.width / 2 + 1 : test.width;
+
+    std::mt19937 generator( test.width * 131 + test.height);
+    std::uniform_real_distribution<float> distribution( -1.0f, 1.0f);
+
+    // code
+    fft_plan = OpenCLFFT::CreatePlan( fft_library, test.type, test.width, test.height, test.batch);
+    if( fft_plan == nullptr)
+    {
+        std::cerr << "OpenCLFFT::CreatePlan() Failed.\n";
+        return false;
+    }
+
+    size_t input_size = OpenCLFFT::InputSize( fft_plan, OpenCLFFT::FFT_FORWARD);
+    size_t output_size = OpenCLFFT::OutputSize( fft_plan, OpenCLFFT::FFT_FORWARD);
+
+        // input, real or ( re, im) pairs
+    std::vector<float> input( input_size / sizeof( float));
+    for( float &value : input)
+    {
+        value = distribution( generator);
+    }
+
+    std::vector<float> output( output_size / sizeof( float));
+    std::vector<float> round_trip( input.size());
+
+        // reference spectrum, only the first spectrum_width columns for R2C
+    std::vector< std::complex<double> > reference( count);
+    for( size_t i = 0; i < count; ++i)
+    {
+        reference[i] = is_real ? std::complex<double>( input[i], 0.0) : std::complex<double>( input[ 2 * i], input[ 2 * i + 1]);
+    }
+
+    ReferenceDFT( reference, test.width, test.height, test.batch);
+
+    std::vector<double> expected( output.size());
+    for( size_t row = 0; row < (size_t)test.height * test.batch; ++row)
+    {
+        for( int x = 0; x < spectrum_width; ++x)
+        {
+            size_t i = row * spectrum_width + x;
+
+            expected[ 2 * i] = reference[ row * test.width + x].real();
+            expected[ 2 * i + 1] = reference[ row * test.width + x].imag();
+        }
+    }
+
+    std::vector<double> expected_round_trip( input.begin(), input.end());
+
+        // device
+    ocl_input = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE | CL_MEM_COPY_HOST_PTR, input_size, input.data(), &ocl_err);
+    if( !ocl_input || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." << ocl_err << "\n";
+        ReleaseTestObjects();
+        return false;
+    }
+
+    ocl_output = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, output_size, nullptr, &ocl_err);
+    if( !ocl_output || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." << ocl_err << "\n";
+        ReleaseTestObjects();
+        return false;
+    }
+
+    ocl_err = OpenCLFFT::Execute( fft_plan, ocl_command_queue, OpenCLFFT::FFT_FORWARD, ocl_input, ocl_output);
+    ocl_err |= clEnqueueReadBuffer( ocl_command_queue, ocl_output, CL_TRUE, 0, output_size, output.data(), 0, nullptr, nullptr);
+
+        // inverse in place on the spectrum for C2C, into the input buffer for C2R
+    cl_mem ocl_round_trip = is_real ? ocl_input : ocl_output;
+
+    ocl_err |= OpenCLFFT::Execute( fft_plan, ocl_command_queue, OpenCLFFT::FFT_INVERSE, ocl_output, ocl_round_trip);
+    ocl_err |= clEnqueueReadBuffer( ocl_command_queue, ocl_round_trip, CL_TRUE, 0, input_size, round_trip.data(), 0, nullptr, nullptr);
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "OpenCLFFT::Execute() Failed." << ocl_err << "\n";
+        ReleaseTestObjects();
+        return false;
+    }
+
+    double forward_error = RelativeError( output.data(), expected.data(), output.size());
+    double inverse_error = RelativeError( round_trip.data(), expected_round_trip.data(), round_trip.size());
+
+    bool passed = ( forward_error < MAX_RELATIVE_ERROR) && ( inverse_error < MAX_RELATIVE_ERROR);
+
+    std::cout << ( is_real ? "R2C " : "C2C ") << test.width << " x " << test.height << " x " << test.batch
+              << " : forward error " << forward_error << ", round trip error " << inverse_error
+              << ( passed ? "  PASSED" : "  FAILED") << std::endl;
+
+    ReleaseTestObjects();
+
+    return passed;
+}
+
+/**
+ * @brief RunBenchmark(): size x size complex 2D FFT, GFlop/s counted as 5 N log2( N) for N = size * size.
+ */
+bool RunBenchmark( int size, int num_iterations)
+{
+    // function declaration
+    void ReleaseTestObjects();
+
+    // variable declaration
+    cl_int ocl_err;
+
+    // code
+    fft_plan = OpenCLFFT::CreatePlan( fft_library, OpenCLFFT::FFT_C2C, size, size, 1);
+    if( fft_plan == nullptr)
+    {
+        std::cerr << "OpenCLFFT::CreatePlan() Failed, size must be a power of 2.\n";
+        return false;
+    }
+
+    size_t buffer_size = OpenCLFFT::InputSize( fft_plan, OpenCLFFT::FFT_FORWARD);
+
+    ocl_input = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, buffer_size, nullptr, &ocl_err);
+    if( !ocl_input || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." << ocl_err << "\n";
+        ReleaseTestObjects();
+        return false;
+    }
+
+    ocl_output = clCreateBuffer( ocl_context, CL_MEM_READ_WRITE, buffer_size, nullptr, &ocl_err);
+    if( !ocl_output || ocl_err)
+    {
+        std::cerr << "clCreateBuffer() Failed." << ocl_err << "\n";
+        ReleaseTestObjects();
+        return false;
+    }
+
+        // warm-up
+    ocl_err = OpenCLFFT::Execute( fft_plan, ocl_command_queue, OpenCLFFT::FFT_FORWARD, ocl_input, ocl_output);
+    clFinish( ocl_command_queue);
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+    for( int i = 0; (i < num_iterations) && (ocl_err == CL_SUCCESS); ++i)
+    {
+        ocl_err = OpenCLFFT::Execute( fft_plan, ocl_command_queue, OpenCLFFT::FFT_FORWARD, ocl_input, ocl_output);
+    }
+    clFinish( ocl_command_queue);
+
+    std::chrono::steady_clock::time_point end = std::chrono::steady_clock::now();
+
+    if( ocl_err != CL_SUCCESS)
+    {
+        std::cerr << "OpenCLFFT::Execute() Failed." << ocl_err << "\n";
+        ReleaseTestObjects();
+        return false;
+    }
+
+    std::chrono::duration<double>  elapsed_seconds = ( end - start) / num_iterations;
+
+    double n = (double)size * size;
+    double gflops = 5.0 * n * log2( n) / elapsed_seconds.count() * 1.0e-9;
+
+    std::cout << "Time Required for " << size << " x " << size << " complex FFT by OpenCL is: "
+              << elapsed_seconds.count() * 1000.0 << "ms ( " << gflops << " GFlop/s)" << std::endl;
+
+    ReleaseTestObjects();
+
+    return true;
+}
+
+/**
+ * @brief cleanup()
+ */
+void  cleanup()
+{
+    // function declaration
+    void ReleaseTestObjects();
+
+    // code
+    ReleaseTestObjects();
+
+    if( fft_library)
+    {
+        OpenCLFFT::DeleteLibrary( fft_library);
+        fft_library = nullptr;
+    }
+
+    RELEASE_CL_OBJECT( ocl_command_queue, clReleaseCommandQueue);
+    RELEASE_CL_OBJECT( ocl_context, clReleaseContext);
+}
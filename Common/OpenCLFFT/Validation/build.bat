@@ -0,0 +1,5 @@
+CL.exe /EHsc /c /I"%CUDA_PATH%\include" /I"." Source.cpp OpenCLUtil.cpp ../OpenCLFFT.cpp
+
+LINK.exe /OUT:Source.exe /LIBPATH:"%CUDA_PATH%\lib\x64" opencl.lib Source.obj OpenCLUtil.obj OpenCLFFT.obj
+
+DEL Source.obj OpenCLUtil.obj OpenCLFFT.obj